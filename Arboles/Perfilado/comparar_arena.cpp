@@ -0,0 +1,224 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <ctime>
+#include "bin_tree.h"
+#include "n_tree.h"
+#include "n_tree_csr.h"
+
+// Nodos pedidos uno por uno al heap contra la arena de cada árbol (enableArena), con int y con
+// std::string:
+// - BinTree: armar un BST de [nodos] claves en orden al azar con insertBST, vaciarlo con makeEmpty
+//   y volver a armarlo (con arena reusa los bloques que dejó la primera vez);
+// - NTree: pasar a nodos un NTreeCSR de [nodos] nodos con padres al azar (toNTree arma directo en la
+//   arena del destino) y vaciarlo asignándole un árbol vacío.
+// Con int la arena se vacía de una vez; con std::string igual recorre los nodos para destruirlos.
+// Al final, el ciclo de ../main.cpp (makeEmpty, armar la sección desde sus dos recorridos y sumar el
+// MUP entre los alumnos) sobre entradas generadas, con el árbol de la sección en el heap y en arena.
+// Ahí casi todo el tiempo se va en leer las líneas y en los caminos entre alumnos, no en los nodos.
+// Uso: ./comparar_arena [nodos] [semilla]
+
+const int ALUMNOS = 10;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, double heap, double arena, bool iguales) {
+    std::cout << std::left << std::setw(36) << que << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << heap << std::setw(10) << arena
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+void titulo(const std::string& que) {
+    std::cout << std::endl << "== " << que << " ==" << std::endl;
+    std::cout << std::left << std::setw(36) << "s" << std::right << std::setw(10) << "heap"
+              << std::setw(10) << "arena" << std::endl;
+}
+
+std::string nombreAlumno(int i) {
+    std::ostringstream ss;
+    ss << "alumno" << i;
+    return ss.str();
+}
+
+std::vector<int> barajar(int nodos) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[((long)std::rand() * RAND_MAX + std::rand()) % (i + 1)]);
+    return claves;
+}
+
+// --- BinTree: armar, makeEmpty y volver a armar ---
+
+template <class T>
+void compararBinTree(const std::string& que, const std::vector<T>& claves) {
+    titulo(que);
+    double armar[2], vaciar[2], rearmar[2];
+    std::list<T> recorrido[2];
+    for (int modo = 0; modo < 2; modo++) {
+        BinTree<T> arbol;
+        if (modo == 1) arbol.enableArena();
+        std::clock_t reloj = std::clock();
+        for (size_t i = 0; i < claves.size(); i++) arbol.insertBST(claves[i]);
+        armar[modo] = segundosDesde(reloj);
+        recorrido[modo] = arbol.preOrder();
+        reloj = std::clock();
+        arbol.makeEmpty();
+        vaciar[modo] = segundosDesde(reloj);
+        reloj = std::clock();
+        for (size_t i = 0; i < claves.size(); i++) arbol.insertBST(claves[i]);
+        rearmar[modo] = segundosDesde(reloj);
+        // El destructor no se mide
+    }
+    bool iguales = recorrido[0] == recorrido[1];
+    fila("armar con insertBST", armar[0], armar[1], iguales);
+    fila("makeEmpty", vaciar[0], vaciar[1], true);
+    fila("armar otra vez tras makeEmpty", rearmar[0], rearmar[1], true);
+}
+
+// --- NTree: toNTree desde un NTreeCSR y vaciarlo ---
+
+template <class T>
+void compararNTree(const std::string& que, const std::vector<T>& valores) {
+    titulo(que);
+    std::list< std::pair<T, T> > aristas;
+    for (size_t i = 1; i < valores.size(); i++) aristas.push_back(std::make_pair(valores[std::rand() % i], valores[i]));
+    NTreeCSR<T> csr;
+    {
+        NTree<T> fuente = valores.size() > 1 ? NTree<T>(aristas) : NTree<T>(valores[0]);
+        csr.build(fuente);
+    }
+    aristas.clear();
+
+    double armar[2], vaciar[2];
+    std::list<T> recorrido[2];
+    for (int modo = 0; modo < 2; modo++) {
+        NTree<T> arbol;
+        if (modo == 1) arbol.enableArena();
+        std::clock_t reloj = std::clock();
+        csr.toNTree(arbol);
+        armar[modo] = segundosDesde(reloj);
+        recorrido[modo] = arbol.preOrder();
+        reloj = std::clock();
+        arbol = NTree<T>();
+        vaciar[modo] = segundosDesde(reloj);
+    }
+    fila("toNTree", armar[0], armar[1], recorrido[0] == recorrido[1] && recorrido[0] == csr.preOrder());
+    fila("vaciar (arbol = NTree<T>())", vaciar[0], vaciar[1], true);
+}
+
+// --- El ciclo de ../main.cpp ---
+
+// Un caso con 'secciones' secciones de 'nodos' alumnos, en el formato de ../entrada.txt: la
+// sección es un BST de nombres al azar, dada por inorden y preorden o postorden
+std::string generarEntrada(int secciones, int nodos) {
+    std::ostringstream entrada;
+    entrada << 1 << std::endl << secciones << std::endl;
+    for (int s = 0; s < secciones; s++) {
+        std::vector<int> claves = barajar(nodos);
+        BinTree<std::string> seccion;
+        for (int i = 0; i < nodos; i++) seccion.insertBST(nombreAlumno(claves[i]));
+        std::list<std::string> inorden = seccion.inOrder();
+        std::list<std::string> otro = s % 2 == 0 ? seccion.preOrder() : seccion.postOrder();
+        entrada << "INORDEN";
+        for (std::list<std::string>::iterator it = inorden.begin(); it != inorden.end(); ++it) entrada << " " << *it;
+        entrada << std::endl << (s % 2 == 0 ? "PREORDEN" : "POSTORDEN");
+        for (std::list<std::string>::iterator it = otro.begin(); it != otro.end(); ++it) entrada << " " << *it;
+        entrada << std::endl;
+        for (int a = 0; a < ALUMNOS; a++) entrada << (a > 0 ? " " : "") << nombreAlumno(std::rand() % nodos);
+        entrada << std::endl;
+    }
+    return entrada.str();
+}
+
+// Lo que hace ../main.cpp con la entrada, sin los mensajes de error; devuelve el MUP mayor del último caso
+int procesar(const std::string& texto, bool arena) {
+    std::istringstream entrada(texto);
+    BinTree<std::string> treeCase;
+    if (arena) treeCase.enableArena();
+    int cases = 0, n_trees = 0, max_MUP = 0;
+    std::string line1, line2, line_alumn, firstOrder, secondOrder, value;
+    std::list<std::string> LInorden, LOtro, LAlumn;
+
+    entrada >> cases;
+    for (int i = 0; i < cases; i++) {
+        max_MUP = 0;
+        entrada >> n_trees;
+        std::getline(entrada, line1);
+        for (int j = 0; j < n_trees; j++) {
+            LInorden.clear();
+            LOtro.clear();
+            LAlumn.clear();
+            treeCase.makeEmpty();
+
+            std::getline(entrada, line1);
+            std::getline(entrada, line2);
+            std::getline(entrada, line_alumn);
+            std::istringstream ss1(line1), ss2(line2), ss_alumn(line_alumn);
+            ss1 >> firstOrder;
+            ss2 >> secondOrder;
+            while (ss1 >> value) LInorden.push_back(value);
+            while (ss2 >> value) LOtro.push_back(value);
+            while (ss_alumn >> value) LAlumn.push_back(value);
+
+            if (secondOrder == "PREORDEN") treeCase.buildFromPreIn(LOtro, LInorden);
+            else treeCase.buildFromPostIn(LOtro, LInorden);
+
+            int count_MUP = 0;
+            for (std::list<std::string>::iterator a = LAlumn.begin(); a != LAlumn.end(); ++a) {
+                for (std::list<std::string>::iterator b = a; b != LAlumn.end(); ++b) {
+                    if (a == b) continue;
+                    int distance = treeCase.findPathBetweenNodes(*a, *b).size() - 2;
+                    count_MUP += distance * treeCase.getHeightDifference(*a, *b);
+                }
+            }
+            if (count_MUP > max_MUP) max_MUP = count_MUP;
+        }
+    }
+    return max_MUP;
+}
+
+void compararCiclo(int secciones, int nodos) {
+    std::string texto = generarEntrada(secciones, nodos);
+    std::clock_t reloj = std::clock();
+    int heap = procesar(texto, false);
+    double segundosHeap = segundosDesde(reloj);
+    reloj = std::clock();
+    int arena = procesar(texto, true);
+    double segundosArena = segundosDesde(reloj);
+    std::ostringstream caso;
+    caso << secciones << " secciones de " << nodos << " nodos";
+    fila(caso.str(), segundosHeap, segundosArena, heap == arena);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (nodos < 1) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::vector<int> enteros = barajar(nodos);
+    std::vector<std::string> nombres(nodos);
+    for (int i = 0; i < nodos; i++) nombres[i] = nombreAlumno(enteros[i]);
+    std::ostringstream caso;
+    caso << nodos << " nodos";
+    compararBinTree("BinTree<int>, " + caso.str(), enteros);
+    compararBinTree("BinTree<std::string>, " + caso.str(), nombres);
+    compararNTree("NTree<int>, " + caso.str(), enteros);
+    compararNTree("NTree<std::string>, " + caso.str(), nombres);
+
+    caso.str("");
+    caso << "ciclo de ../main.cpp, " << ALUMNOS << " alumnos por sección";
+    titulo(caso.str());
+    compararCiclo(40000, 100);
+    compararCiclo(2000, 2000);
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <stack>
+#include <string>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+#include "n_tree.h"
+#include "n_tree_csr.h"
+#include "n_tree_bp.h"
+
+// NTreeBP (paréntesis balanceados, 2 bits por nodo más directorios) contra nodos NodeNTree
+// enlazados por sons/bro: memoria por nodo y latencia de padre, primer hijo, siguiente hermano,
+// profundidad, tamaño de subárbol, LCA y findPathToNode. Los nodos no guardan al padre, así que
+// padre y profundidad con NodeNTree buscan desde la raíz, como tendría que hacerlo quien los use.
+// Con [nodos solo BP] > 0 arma además, en streaming, un NTreeBP de ese tamaño sin ningún NTree.
+// Uso: ./comparar_bp [nodos] [consultas] [nodos solo BP] [semilla]
+
+// operator new global que cuenta los bytes pedidos, para medir cada representación
+namespace {
+    size_t bytesEnUso = 0;
+}
+
+void* operator new(size_t bytes) throw(std::bad_alloc) {
+    size_t* bloque = static_cast<size_t*>(std::malloc(bytes + sizeof(size_t)));
+    if (bloque == NULL) throw std::bad_alloc();
+    *bloque = bytes;
+    bytesEnUso += bytes;
+    return bloque + 1;
+}
+
+void operator delete(void* p) throw() {
+    if (p == NULL) return;
+    size_t* bloque = static_cast<size_t*>(p) - 1;
+    bytesEnUso -= *bloque;
+    std::free(bloque);
+}
+
+typedef NodeNTree<int> Nodo;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void filaMemoria(const char* representacion, size_t bytes, int nodos) {
+    double porNodo = (double)bytes / nodos;
+    std::cout << std::left << std::setw(36) << representacion << std::right << std::fixed
+              << std::setw(14) << bytes << std::setw(12) << std::setprecision(2) << porNodo
+              << std::setw(16) << std::setprecision(2) << porNodo * 1e8 / (1 << 30) << std::endl;
+}
+
+void filaConsulta(const char* consulta, int cuantas, double nodos, double bp, bool iguales) {
+    double microNodos = nodos * 1e6 / cuantas, microBP = bp * 1e6 / cuantas;
+    std::cout << std::left << std::setw(30) << consulta << std::right << std::setw(10) << cuantas << std::fixed
+              << std::setw(14) << std::setprecision(3) << microNodos << std::setw(12) << microBP
+              << std::setw(11) << std::setprecision(1) << microNodos / (microBP > 0 ? microBP : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Consultas sobre NodeNTree: solo hay enlaces hacia abajo ---
+
+// Busca objetivo desde la raíz recordando padre y profundidad de cada nodo en la pila
+void buscarDesdeLaRaiz(Nodo* raiz, const Nodo* objetivo, Nodo*& padre, int& profundidad) {
+    std::stack< std::pair<Nodo*, std::pair<Nodo*, int> > > s; // Nodo, su padre y su profundidad
+    s.push(std::make_pair(raiz, std::make_pair((Nodo*)NULL, 0)));
+    while (!s.empty()) {
+        Nodo* actual = s.top().first;
+        Nodo* suPadre = s.top().second.first;
+        int suProfundidad = s.top().second.second;
+        s.pop();
+        if (actual == objetivo) {
+            padre = suPadre;
+            profundidad = suProfundidad;
+            return;
+        }
+        for (Nodo* hijo = actual->getSons(); hijo != NULL; hijo = hijo->getBro()) {
+            s.push(std::make_pair(hijo, std::make_pair(actual, suProfundidad + 1)));
+        }
+    }
+    padre = NULL;
+    profundidad = -1;
+}
+
+int tamanoDeSubarbol(const Nodo* nodo) {
+    int tamano = 0;
+    std::stack<const Nodo*> s;
+    s.push(nodo);
+    while (!s.empty()) {
+        const Nodo* actual = s.top();
+        s.pop();
+        tamano++;
+        for (const Nodo* hijo = actual->getSons(); hijo != NULL; hijo = hijo->getBro()) s.push(hijo);
+    }
+    return tamano;
+}
+
+void comparar(int nodos, int consultas) {
+    // Padre de cada nodo i al azar entre los anteriores; los hijos quedan en orden de llegada
+    std::vector<int> padres(nodos, -1);
+    std::list< std::pair<int, int> > aristas;
+    for (int i = 1; i < nodos; i++) {
+        padres[i] = std::rand() % i;
+        aristas.push_back(std::make_pair(padres[i], i));
+    }
+
+    std::cout << std::endl << "== Memoria, " << nodos << " nodos con valores int ==" << std::endl;
+    std::cout << std::left << std::setw(36) << "representación" << std::right << std::setw(14) << "bytes"
+              << std::setw(12) << "por nodo" << std::setw(16) << "1e8 nodos (GB)" << std::endl;
+
+    size_t antes = bytesEnUso;
+    std::vector<Nodo*> nodo(nodos);
+    std::vector<Nodo*> ultimoHijo(nodos, (Nodo*)NULL);
+    for (int i = 0; i < nodos; i++) {
+        nodo[i] = new Nodo(i);
+        if (i == 0) continue;
+        Nodo* padre = nodo[padres[i]];
+        if (ultimoHijo[padres[i]] == NULL) padre->setSons(nodo[i]);
+        else ultimoHijo[padres[i]]->setBro(nodo[i]);
+        ultimoHijo[padres[i]] = nodo[i];
+    }
+    filaMemoria("NodeNTree (sin contar malloc)", bytesEnUso - antes, nodos);
+    std::vector<Nodo*>().swap(ultimoHijo);
+
+    antes = bytesEnUso;
+    NTree<int>* arbol = new NTree<int>(aristas);
+    filaMemoria("NTree(aristas), con índice de nodos", bytesEnUso - antes, nodos);
+
+    antes = bytesEnUso;
+    NTreeCSR<int>* csr = new NTreeCSR<int>(*arbol);
+    filaMemoria("NTreeCSR", bytesEnUso - antes, nodos);
+
+    antes = bytesEnUso;
+    std::clock_t inicio = std::clock();
+    NTreeBP<int> bp(*csr);
+    double construir = segundosDesde(inicio);
+    filaMemoria("NTreeBP, estructura y valores", bytesEnUso - antes, nodos);
+    filaMemoria("NTreeBP, solo la estructura", bp.structureBytes(), nodos);
+    std::cout << "NTreeBP armado desde el CSR en " << std::setprecision(3) << construir << " s" << std::endl;
+    delete csr;
+
+    // Los ids del BP son el preorden; los valores son las etiquetas de los nodos
+    std::vector<int> id(nodos);
+    for (int i = 0; i < nodos; i++) id[bp.getInfo(i)] = i;
+    std::vector<int> azar(consultas), otro(consultas);
+    for (int i = 0; i < consultas; i++) {
+        azar[i] = std::rand() % nodos;
+        otro[i] = std::rand() % nodos;
+    }
+    // Las consultas que con NodeNTree recorren el árbol se hacen menos veces
+    int lentas = consultas / 1000 > 0 ? consultas / 1000 : 1;
+
+    std::cout << std::endl << "== Consultas (µs por consulta) ==" << std::endl;
+    std::cout << std::left << std::setw(30) << "consulta" << std::right << std::setw(10) << "consultas"
+              << std::setw(14) << "NodeNTree" << std::setw(12) << "NTreeBP" << std::setw(11) << "mejora" << std::endl;
+
+    // Preorden completo con primer hijo y siguiente hermano (el BP sube con getParent)
+    long sumaNodos = 0, sumaBP = 0;
+    inicio = std::clock();
+    std::stack<const Nodo*> pila;
+    pila.push(nodo[0]);
+    while (!pila.empty()) {
+        const Nodo* actual = pila.top();
+        pila.pop();
+        sumaNodos += actual->getInfo();
+        if (actual != nodo[0] && actual->getBro() != NULL) pila.push(actual->getBro());
+        if (actual->getSons() != NULL) pila.push(actual->getSons());
+    }
+    double tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    int v = 0;
+    while (v >= 0) {
+        sumaBP += bp.getInfo(v);
+        int siguiente = bp.getFirstChild(v);
+        while (siguiente < 0 && v >= 0) {
+            siguiente = bp.getNextSibling(v);
+            if (siguiente < 0) v = bp.getParent(v);
+        }
+        v = siguiente;
+    }
+    filaConsulta("recorrer todo (por nodo)", nodos, tiempoNodos, segundosDesde(inicio), sumaNodos == sumaBP);
+
+    long primerosNodos = 0, primerosBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        const Nodo* hijo = nodo[azar[i]]->getSons();
+        const Nodo* hermano = nodo[azar[i]]->getBro();
+        primerosNodos += (hijo != NULL ? hijo->getInfo() : -1) + (hermano != NULL ? hermano->getInfo() : -1);
+    }
+    tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        int hijo = bp.getFirstChild(id[azar[i]]);
+        int hermano = bp.getNextSibling(id[azar[i]]);
+        primerosBP += (hijo >= 0 ? bp.getInfo(hijo) : -1) + (hermano >= 0 ? bp.getInfo(hermano) : -1);
+    }
+    filaConsulta("primer hijo + sig. hermano", consultas, tiempoNodos, segundosDesde(inicio), primerosNodos == primerosBP);
+
+    // Padre y profundidad: con NodeNTree hay que buscar el nodo desde la raíz
+    long padresNodos = 0, padresBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) {
+        Nodo* padre;
+        int profundidad;
+        buscarDesdeLaRaiz(nodo[0], nodo[azar[i]], padre, profundidad);
+        padresNodos += (padre != NULL ? padre->getInfo() : -1) + profundidad;
+    }
+    tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) {
+        int padre = bp.getParent(id[azar[i]]);
+        padresBP += (padre >= 0 ? bp.getInfo(padre) : -1) + bp.getDepth(id[azar[i]]);
+    }
+    filaConsulta("padre + profundidad", lentas, tiempoNodos, segundosDesde(inicio), padresNodos == padresBP);
+
+    // Tamaño de subárbol: con NodeNTree se cuentan los descendientes
+    long tamanosNodos = 0, tamanosBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) tamanosNodos += tamanoDeSubarbol(nodo[azar[i]]);
+    tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) tamanosBP += bp.getSubtreeSize(id[azar[i]]);
+    filaConsulta("tamaño de subárbol", lentas, tiempoNodos, segundosDesde(inicio), tamanosNodos == tamanosBP);
+
+    // Por valor, con la interfaz de NTree: incluye encontrar los nodos
+    long ancestrosNTree = 0, ancestrosBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) ancestrosNTree += arbol->lowestCommonAncestor(azar[i], otro[i]);
+    tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) ancestrosBP += bp.lowestCommonAncestor(azar[i], otro[i]);
+    filaConsulta("LCA por valor (NTree)", lentas, tiempoNodos, segundosDesde(inicio), ancestrosNTree == ancestrosBP);
+
+    size_t caminosNTree = 0, caminosBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) caminosNTree += arbol->findPathToNode(azar[i]).size();
+    tiempoNodos = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) caminosBP += bp.findPathToNode(azar[i]).size();
+    filaConsulta("findPathToNode (NTree)", lentas, tiempoNodos, segundosDesde(inicio), caminosNTree == caminosBP);
+
+    // Por id, sin buscar los nodos: lo que el BP responde en O(log n)
+    ancestrosBP = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) ancestrosBP += bp.lowestCommonAncestorNode(id[azar[i]], id[otro[i]]);
+    double tiempoBP = segundosDesde(inicio);
+    std::cout << std::left << std::setw(30) << "LCA por id (solo BP)" << std::right << std::setw(10) << consultas
+              << std::setw(14) << "-" << std::setw(12) << std::setprecision(3) << tiempoBP * 1e6 / consultas << std::endl;
+
+    delete arbol;
+    for (int i = 0; i < nodos; i++) delete nodo[i]; // El destructor de NodeNTree no sigue los enlaces
+}
+
+// Árbol al azar escrito directo en preorden: después de abrir cada nodo se cierran 0, 1 o 2,
+// sin cerrar nunca la raíz antes del final
+void soloBP(int nodos, int consultas) {
+    std::cout << std::endl << "== NTreeBP en streaming, " << nodos << " nodos ==" << std::endl;
+    size_t antes = bytesEnUso;
+    std::clock_t inicio = std::clock();
+    NTreeBP<int> bp;
+    int abiertos = 0;
+    for (int i = 0; i < nodos; i++) {
+        bp.openNode(i);
+        abiertos++;
+        for (int cerrar = std::rand() % 3; cerrar > 0 && abiertos > 1; cerrar--, abiertos--) bp.closeNode();
+    }
+    while (abiertos-- > 0) bp.closeNode();
+    bp.finish();
+    std::cout << "armado en " << std::fixed << std::setprecision(2) << segundosDesde(inicio) << " s, "
+              << std::setprecision(1) << (bytesEnUso - antes) / 1048576.0 << " MB en total, "
+              << bp.structureBytes() / 1048576.0 << " MB de estructura" << std::endl;
+
+    std::vector<int> azar(consultas);
+    for (int i = 0; i < consultas; i++) azar[i] = std::rand() % nodos;
+    std::vector<int> padre(consultas), profundidad(consultas), tamano(consultas), ancestro(consultas);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        padre[i] = bp.getParent(azar[i]);
+        profundidad[i] = bp.getDepth(azar[i]);
+        tamano[i] = bp.getSubtreeSize(azar[i]);
+    }
+    double tiempo = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) ancestro[i] = bp.lowestCommonAncestorNode(azar[i], azar[(i + 1) % consultas]);
+    double tiempoLCA = segundosDesde(inicio);
+
+    // Sin otro árbol para comparar, se verifica la coherencia: el padre está un nivel arriba y su
+    // subárbol contiene al del nodo; el LCA es un ancestro de los dos (sus ids encierran los de ambos)
+    bool coherente = true;
+    for (int i = 0; i < consultas && coherente; i++) {
+        int v = azar[i], w = azar[(i + 1) % consultas], a = ancestro[i];
+        if (v != 0) {
+            coherente = padre[i] >= 0 && padre[i] < v && bp.getDepth(padre[i]) == profundidad[i] - 1
+                        && padre[i] + bp.getSubtreeSize(padre[i]) >= v + tamano[i];
+        }
+        coherente = coherente && a <= v && a <= w && v < a + bp.getSubtreeSize(a) && w < a + bp.getSubtreeSize(a);
+    }
+    std::cout << std::setprecision(3) << "padre + profundidad + tamaño: " << tiempo * 1e6 / consultas << " µs, LCA: "
+              << tiempoLCA * 1e6 / consultas << " µs por consulta" << (coherente ? "   ok" : "   FALLA") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int consultas = argc > 2 ? std::atoi(argv[2]) : 100000;
+    int grande = argc > 3 ? std::atoi(argv[3]) : 0;
+    std::srand(argc > 4 ? std::atoi(argv[4]) : 1);
+    if (nodos < 2 || consultas < 1 || grande < 0) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [consultas >= 1] [nodos solo BP >= 0] [semilla]" << std::endl;
+        return 1;
+    }
+    comparar(nodos, consultas);
+    if (grande > 0) soloBP(grande, consultas);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <sys/time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "bin_tree.h"
+
+// Carga masiva de un BST (buildBalancedBST: ordena en paralelo y enlaza en O(n)) contra insertBST
+// clave por clave, y unionBST/intersectionBST/differenceBST contra recorrer un árbol preguntando
+// con searchBST e insertando en el resultado. La carga se repite con 1, 2, 4 y 8 hilos
+// (TreeTaskPool::setThreads); con un solo núcleo no puede haber mejora por hilos.
+// Se mide tiempo de reloj, no de CPU, porque con varios hilos el de CPU se suma entre todos.
+// Uso: ./comparar_carga [claves] [semilla]
+
+// Que malloc ordene ahora los millones de bloques chicos que liberó la medición anterior: si no,
+// la siguiente paga ese trabajo (ver comparar_iteradores)
+void ordenarHeap() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+double segundosDeReloj() {
+    timeval ahora;
+    gettimeofday(&ahora, NULL);
+    return ahora.tv_sec + ahora.tv_usec / 1e6;
+}
+
+// Claves distintas al azar: una permutación de 0..2n-1 cortada en n, así que dos árboles
+// generados así comparten más o menos la mitad de las claves
+std::vector<int> clavesAlAzar(int cuantas) {
+    std::vector<int> claves(2 * cuantas);
+    for (int i = 0; i < 2 * cuantas; i++) claves[i] = i;
+    for (int i = 2 * cuantas - 1; i > 0; i--) std::swap(claves[i], claves[((long)std::rand() * RAND_MAX + std::rand()) % (i + 1)]);
+    claves.resize(cuantas);
+    return claves;
+}
+
+void fila(const std::string& que, double antes, double ahora, bool iguales) {
+    std::cout << std::left << std::setw(34) << que << std::right << std::fixed << std::setprecision(3)
+              << std::setw(14) << antes << std::setw(14) << ahora
+              << std::setw(10) << std::setprecision(1) << antes / (ahora > 0 ? ahora : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Sin las operaciones nuevas: recorrer uno, preguntar al otro e insertar en el resultado ---
+
+// Las claves de un árbol en orden al azar: insertadas en orden, o en un preorden filtrado, el
+// resultado degenera en cadenas largas
+std::vector<int> barajadas(const BinTree<int>& arbol) {
+    std::list<int> enOrden = arbol.inOrder();
+    std::vector<int> valores(enOrden.begin(), enOrden.end());
+    for (int i = (int)valores.size() - 1; i > 0; i--) std::swap(valores[i], valores[std::rand() % (i + 1)]);
+    return valores;
+}
+
+// valores: las claves de b barajadas
+BinTree<int> unionClavePorClave(const BinTree<int>& a, const std::vector<int>& valores) {
+    BinTree<int> resultado = a;
+    for (size_t i = 0; i < valores.size(); i++) {
+        if (!a.searchBST(valores[i])) resultado.insertBST(valores[i]);
+    }
+    return resultado;
+}
+
+// valores: las claves de a barajadas
+BinTree<int> filtrarClavePorClave(const std::vector<int>& valores, const BinTree<int>& b, bool quedarseConLasComunes) {
+    BinTree<int> resultado;
+    for (size_t i = 0; i < valores.size(); i++) {
+        if (b.searchBST(valores[i]) == quedarseConLasComunes) resultado.insertBST(valores[i]);
+    }
+    return resultado;
+}
+
+// Mide las dos versiones de una operación (0 unión, 1 intersección, 2 diferencia); barajar las
+// claves y liberar los resultados queda fuera de la medición. La versión por mezcla va primero:
+// medida después de la clave a clave, que deja millones de nodos sueltos por el heap, tardaba de
+// tres a cuatro veces más
+void medirConjunto(const char* que, const BinTree<int>& a, const BinTree<int>& b, int operacion) {
+    std::vector<int> valores = barajadas(operacion == 0 ? b : a);
+    ordenarHeap();
+    double inicio = segundosDeReloj();
+    BinTree<int> ahora = (operacion == 0) ? a.unionBST(b) : (operacion == 1) ? a.intersectionBST(b) : a.differenceBST(b);
+    double tiempoAhora = segundosDeReloj() - inicio;
+    ordenarHeap();
+    inicio = segundosDeReloj();
+    BinTree<int> antes = (operacion == 0) ? unionClavePorClave(a, valores) : filtrarClavePorClave(valores, b, operacion == 1);
+    double tiempoAntes = segundosDeReloj() - inicio;
+    fila(que, tiempoAntes, tiempoAhora, antes.inOrder() == ahora.inOrder());
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (n < 2) {
+        std::cerr << "Uso: " << argv[0] << " [claves >= 2] [semilla]" << std::endl;
+        return 1;
+    }
+    std::vector<int> claves = clavesAlAzar(n);
+    std::cout << n << " claves, " << TreeTaskPool::getThreads() << " hilos por defecto" << std::endl;
+
+    std::cout << std::endl << std::left << std::setw(34) << "carga (s de reloj)" << std::right << std::setw(14) << "insertBST"
+              << std::setw(14) << "masiva" << std::setw(11) << "mejora" << std::endl;
+    double inicio = segundosDeReloj();
+    BinTree<int> unoPorUno;
+    for (int i = 0; i < n; i++) unoPorUno.insertBST(claves[i]);
+    double tiempoUnoPorUno = segundosDeReloj() - inicio;
+    std::list<int> esperado = unoPorUno.inOrder();
+    std::cout << "altura con insertBST: " << unoPorUno.getHeight() << std::endl;
+    unoPorUno = BinTree<int>();
+
+    {
+        // Sin medir: la primera carga pide al sistema la memoria de los nodos, que las siguientes
+        // reusan; si no, el primer número de hilos paga sola esas páginas nuevas
+        BinTree<int> calentar;
+        calentar.buildBalancedBST(claves.begin(), claves.end());
+    }
+    int hilos[] = { 1, 2, 4, 8 };
+    for (int h = 0; h < 4; h++) {
+        TreeTaskPool::setThreads(hilos[h]);
+        inicio = segundosDeReloj();
+        BinTree<int> masivo;
+        masivo.buildBalancedBST(claves.begin(), claves.end());
+        double tiempo = segundosDeReloj() - inicio;
+        std::ostringstream que;
+        que << "buildBalancedBST, " << hilos[h] << " hilo" << (hilos[h] > 1 ? "s" : "") << " (altura " << masivo.getHeight() << ")";
+        fila(que.str(), tiempoUnoPorUno, tiempo, masivo.inOrder() == esperado);
+    }
+    TreeTaskPool::setThreads(0);
+
+    // Dos árboles de n claves que comparten más o menos la mitad
+    BinTree<int> a, b;
+    a.buildBalancedBST(claves.begin(), claves.end());
+    std::vector<int> otras = clavesAlAzar(n);
+    b.buildBalancedBST(otras.begin(), otras.end());
+    std::vector<int>().swap(claves);
+    std::vector<int>().swap(otras);
+
+    std::cout << std::endl << std::left << std::setw(34) << "conjuntos (s de reloj)" << std::right << std::setw(14) << "clave a clave"
+              << std::setw(14) << "por mezcla" << std::setw(11) << "mejora" << std::endl;
+    medirConjunto("unionBST", a, b, 0);
+    medirConjunto("intersectionBST", a, b, 1);
+    medirConjunto("differenceBST", a, b, 2);
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "bin_tree.h"
+#include "n_tree.h"
+
+// Subárboles compartidos (cuenta de referencias y copia al escribir) contra copiarlos enteros, como
+// hacían antes las copias, los constructores que componen árboles, getLeftSubtree/getRightSubtree
+// y getChildren. La copia entera de antes se rearma con la API pública, de la raíz a las hojas,
+// armando un árbol temporal por nodo, así que se pasa de lo que costaba la copia interna: medido
+// contra los árboles de antes, un 50% en BinTree y unas cinco veces en NTree.
+// Tres casos en BinTree y en NTree:
+// - componer t = T(i, t, t) COMPOSICIONES veces: 2^(COMPOSICIONES+1) - 1 nodos lógicos;
+// - pedir los subárboles de la raíz de ese árbol;
+// - copiar un árbol de [nodos] nodos e insertarle un valor, REPETICIONES veces. Antes es tan lento
+//   que se mide en MUESTRA repeticiones y se multiplica ("~" en la tabla).
+// Mide el tiempo y el pico de memoria pedida al heap durante cada caso (como comparar_iteradores).
+// Uso: ./comparar_compartido [nodos] [semilla]
+
+const int COMPOSICIONES = 20;
+const int REPETICIONES = 1000;
+const int MUESTRA = 10;
+
+// operator new global que lleva la cuenta de los bytes en uso y del máximo alcanzado
+namespace {
+    size_t bytesEnUso = 0;
+    size_t picoDeBytes = 0;
+}
+
+void* operator new(size_t bytes) throw(std::bad_alloc) {
+    size_t* bloque = static_cast<size_t*>(std::malloc(bytes + sizeof(size_t)));
+    if (bloque == NULL) throw std::bad_alloc();
+    *bloque = bytes;
+    bytesEnUso += bytes;
+    if (bytesEnUso > picoDeBytes) picoDeBytes = bytesEnUso;
+    return bloque + 1;
+}
+
+void operator delete(void* p) throw() {
+    if (p == NULL) return;
+    size_t* bloque = static_cast<size_t*>(p) - 1;
+    bytesEnUso -= *bloque;
+    std::free(bloque);
+}
+
+struct Medicion {
+    double segundos;
+    size_t bytes;
+};
+
+std::clock_t inicio;
+size_t base;
+
+void empezar() {
+    // Que malloc ordene ahora los bloques que liberó la medición anterior (ver comparar_iteradores)
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    base = bytesEnUso;
+    picoDeBytes = bytesEnUso;
+    inicio = std::clock();
+}
+
+Medicion terminar() {
+    Medicion m;
+    m.segundos = (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+    m.bytes = picoDeBytes - base;
+    return m;
+}
+
+void fila(const std::string& que, const Medicion& antes, const Medicion& ahora, bool estimado, bool iguales) {
+    std::ostringstream columna;
+    columna << std::fixed << std::setprecision(6) << (estimado ? "~" : "") << antes.segundos;
+    std::cout << std::left << std::setw(34) << que << std::right << std::setw(15) << columna.str()
+              << std::fixed << std::setprecision(6) << std::setw(12) << ahora.segundos
+              << std::setprecision(3) << std::setw(12) << antes.bytes / 1048576.0 << std::setw(12) << ahora.bytes / 1048576.0
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+void titulo(const std::string& que) {
+    std::cout << std::endl << "== " << que << " ==" << std::endl;
+    std::cout << std::left << std::setw(34) << "caso" << std::right << std::setw(15) << "antes (s)"
+              << std::setw(12) << "ahora (s)" << std::setw(12) << "antes (MB)" << std::setw(12) << "ahora (MB)" << std::endl;
+}
+
+// --- Las copias enteras de antes ---
+
+BinTree<int> copiaEntera(const BinTree<int>& arbol) {
+    if (arbol.isEmpty()) return BinTree<int>();
+    return BinTree<int>(arbol.getRootInfo(), copiaEntera(arbol.getLeftSubtree()), copiaEntera(arbol.getRightSubtree()));
+}
+
+NTree<int> copiaEntera(const NTree<int>& arbol) {
+    if (arbol.isEmpty()) return NTree<int>();
+    std::list< NTree<int> > hijos = arbol.getChildren();
+    std::list< NTree<int> > copias;
+    for (std::list< NTree<int> >::iterator it = hijos.begin(); it != hijos.end(); ++it) copias.push_back(copiaEntera(*it));
+    return NTree<int>(arbol.getRootInfo(), copias);
+}
+
+// --- T(i, t, t) en los dos árboles ---
+
+BinTree<int> componer(int raiz, const BinTree<int>& a, const BinTree<int>& b) {
+    return BinTree<int>(raiz, a, b);
+}
+
+NTree<int> componer(int raiz, const NTree<int>& a, const NTree<int>& b) {
+    std::list< NTree<int> > hijos;
+    hijos.push_back(a);
+    hijos.push_back(b);
+    return NTree<int>(raiz, hijos);
+}
+
+// Los subárboles de la raíz: los dos de BinTree o los hijos de NTree
+std::list< BinTree<int> > subarboles(const BinTree<int>& arbol) {
+    std::list< BinTree<int> > hijos;
+    hijos.push_back(arbol.getLeftSubtree());
+    hijos.push_back(arbol.getRightSubtree());
+    return hijos;
+}
+
+std::list< NTree<int> > subarboles(const NTree<int>& arbol) {
+    return arbol.getChildren();
+}
+
+// Un valor más: insertBST en BinTree, una hoja nueva bajo la raíz en NTree
+void insertar(BinTree<int>& arbol, int valor) {
+    arbol.insertBST(valor);
+}
+
+void insertar(NTree<int>& arbol, int valor) {
+    arbol.insertSubtree(NTree<int>(valor));
+}
+
+// El árbol para copiar: un BST con las claves en orden al azar, o un NTree con padres al azar
+void armar(BinTree<int>& arbol, int nodos) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[((long)std::rand() * RAND_MAX + std::rand()) % (i + 1)]);
+    for (int i = 0; i < nodos; i++) arbol.insertBST(claves[i]);
+}
+
+void armar(NTree<int>& arbol, int nodos) {
+    std::list< std::pair<int, int> > aristas;
+    for (int i = 1; i < nodos; i++) aristas.push_back(std::make_pair(std::rand() % i, i));
+    arbol = nodos > 1 ? NTree<int>(aristas) : NTree<int>(0);
+}
+
+template <class Tree>
+void comparar(const std::string& que, int nodos) {
+    titulo(que);
+
+    // T(i, t, t), copiando t dos veces por paso o compartiéndolo
+    empezar();
+    Tree antes(0);
+    for (int i = 1; i <= COMPOSICIONES; i++) antes = componer(i, copiaEntera(antes), copiaEntera(antes));
+    Medicion medidaAntes = terminar();
+    empezar();
+    Tree ahora(0);
+    for (int i = 1; i <= COMPOSICIONES; i++) ahora = componer(i, ahora, ahora);
+    Medicion medidaAhora = terminar();
+    std::ostringstream caso;
+    caso << "T(i, t, t) x" << COMPOSICIONES << " (" << ahora.getWeight() << " nodos)";
+    fila(caso.str(), medidaAntes, medidaAhora, false, antes.preOrder() == ahora.preOrder());
+
+    // Los subárboles de la raíz de ese árbol
+    empezar();
+    std::list<Tree> hijos = subarboles(ahora);
+    std::list<Tree> hijosAntes;
+    for (typename std::list<Tree>::iterator it = hijos.begin(); it != hijos.end(); ++it) hijosAntes.push_back(copiaEntera(*it));
+    medidaAntes = terminar();
+    hijosAntes.clear();
+    hijos.clear();
+    empezar();
+    hijos = subarboles(ahora);
+    medidaAhora = terminar();
+    bool iguales = hijos.size() == 2 && hijos.front().getWeight() == (ahora.getWeight() - 1) / 2;
+    fila("getChildren / get*Subtree", medidaAntes, medidaAhora, false, iguales);
+    hijos.clear();
+    antes = Tree();
+    ahora = Tree();
+
+    // Copiar e insertar, armado después de lo anterior para no desordenar el heap de esas mediciones.
+    // La copia de antes se mide MUESTRA veces
+    Tree grande;
+    armar(grande, nodos);
+    int n = grande.getWeight();
+    empezar();
+    for (int r = 0; r < MUESTRA; r++) {
+        Tree copia = copiaEntera(grande);
+        insertar(copia, -1 - r);
+    }
+    medidaAntes = terminar();
+    medidaAntes.segundos *= (double)REPETICIONES / MUESTRA;
+    empezar();
+    iguales = true;
+    for (int r = 0; r < REPETICIONES; r++) {
+        Tree copia = grande;
+        insertar(copia, -1 - r);
+        iguales = iguales && copia.getWeight() == n + 1;
+    }
+    medidaAhora = terminar();
+    caso.str("");
+    caso << "copiar " << n << " e insertar x" << REPETICIONES;
+    fila(caso.str(), medidaAntes, medidaAhora, true, iguales && grande.getWeight() == n);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (nodos < 1) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    comparar<BinTree<int> >("BinTree (BST aleatorio para copiar)", nodos);
+    comparar<NTree<int> >("NTree (padres aleatorios para copiar)", nodos);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "n_tree.h"
+#include "n_tree_csr.h"
+
+// NTree (nodos enlazados por sons/bro) contra NTreeCSR (arreglos de desplazamientos e índices)
+// en un árbol ancho (la raíz con muchos hijos) y en uno profundo (casi una cadena): recorridos,
+// getChildren y las conversiones en ambos sentidos. preOrder, postOrder... de NTree son recursivos:
+// con profundidades mucho mayores que la de por defecto pueden desbordar la pila.
+// Uso: ./comparar_csr [hijos de la raíz] [hojas por hijo] [profundidad] [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& consulta, double ntree, double csr, bool iguales) {
+    std::cout << std::left << std::setw(36) << consulta << std::right << std::fixed
+              << std::setw(12) << std::setprecision(5) << ntree << std::setw(12) << csr
+              << std::setw(10) << std::setprecision(1) << ntree / (csr > 0 ? csr : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Mide una consulta que devuelve una lista en los dos formatos y compara los resultados. Antes
+// arma las dos listas sin medir: así las dos mediciones reusan memoria ya pedida al sistema, y
+// la segunda no paga páginas nuevas por tener viva a la primera.
+#define COMPARAR_LISTA(nombre, consulta) { \
+    { std::list<int> a = arbol.consulta(), b = csr.consulta(); } \
+    std::clock_t inicio = std::clock(); \
+    std::list<int> enNTree = arbol.consulta(); \
+    double tiempoNTree = segundosDesde(inicio); \
+    inicio = std::clock(); \
+    std::list<int> enCSR = csr.consulta(); \
+    fila(nombre, tiempoNTree, segundosDesde(inicio), enNTree == enCSR); \
+}
+
+void comparar(const char* titulo, const NTree<int>& arbol) {
+    std::cout << std::endl << "== " << titulo << ", " << arbol.getWeight() << " nodos ==" << std::endl;
+    std::cout << std::left << std::setw(36) << "consulta" << std::right << std::setw(12) << "NTree (s)"
+              << std::setw(12) << "CSR (s)" << std::setw(11) << "mejora" << std::endl;
+
+    std::clock_t inicio = std::clock();
+    NTreeCSR<int> csr(arbol);
+    double construir = segundosDesde(inicio);
+    inicio = std::clock();
+    NTree<int> deVuelta;
+    csr.toNTree(deVuelta);
+    double convertir = segundosDesde(inicio);
+    std::cout << "NTree -> CSR " << std::setprecision(5) << construir << " s, CSR -> NTree " << convertir
+              << " s" << (deVuelta.preOrder() == arbol.preOrder() ? "   ok" : "   FALLA") << std::endl;
+
+    // Recorrer sin armar listas: iterador perezoso de NTree contra el tramo contiguo de valores del CSR
+    long sumaNTree = 0, sumaCSR = 0;
+    inicio = std::clock();
+    for (NTree<int>::const_iterator it = arbol.begin(); it != arbol.end(); ++it) sumaNTree += *it;
+    double tiempoNTree = segundosDesde(inicio);
+    inicio = std::clock();
+    TreeRange<std::vector<int>::const_iterator> tramo = csr.preOrderSlice(0);
+    for (std::vector<int>::const_iterator it = tramo.begin(); it != tramo.end(); ++it) sumaCSR += *it;
+    fila("sumar el preorden sin copiar", tiempoNTree, segundosDesde(inicio), sumaNTree == sumaCSR);
+
+    COMPARAR_LISTA("preOrder", preOrder);
+    COMPARAR_LISTA("postOrder", postOrder);
+    COMPARAR_LISTA("levelOrder", levelOrder);
+    COMPARAR_LISTA("getLeaves", getLeaves);
+
+    inicio = std::clock();
+    int alturaNTree = arbol.getHeight();
+    tiempoNTree = segundosDesde(inicio);
+    inicio = std::clock();
+    int alturaCSR = csr.getHeight();
+    fila("getHeight", tiempoNTree, segundosDesde(inicio), alturaNTree == alturaCSR);
+
+    // Hijos de la raíz: NTree arma una lista de árboles, CSR devuelve vistas sobre sus arreglos
+    sumaNTree = sumaCSR = 0;
+    inicio = std::clock();
+    std::list< NTree<int> > hijos = arbol.getChildren();
+    for (std::list< NTree<int> >::iterator it = hijos.begin(); it != hijos.end(); ++it) sumaNTree += it->getRootInfo();
+    tiempoNTree = segundosDesde(inicio);
+    inicio = std::clock();
+    std::vector< NTreeCSRView<int> > vistas = csr.getRoot().getChildren();
+    for (size_t i = 0; i < vistas.size(); i++) sumaCSR += vistas[i].getRootInfo();
+    fila("getChildren de la raíz", tiempoNTree, segundosDesde(inicio), sumaNTree == sumaCSR && hijos.size() == vistas.size());
+    hijos.clear();
+
+    // Bajar por el primer hijo hasta una hoja, pidiendo los hijos en cada nivel
+    int nivelesNTree = 0, nivelesCSR = 0;
+    inicio = std::clock();
+    NTree<int> actual = arbol;
+    while (true) {
+        std::list< NTree<int> > siguientes = actual.getChildren();
+        if (siguientes.empty()) break;
+        actual = siguientes.front();
+        nivelesNTree++;
+    }
+    tiempoNTree = segundosDesde(inicio);
+    inicio = std::clock();
+    NTreeCSRView<int> vista = csr.getRoot();
+    while (vista.childCount() > 0) {
+        vista = vista.getChild(1);
+        nivelesCSR++;
+    }
+    fila("getChildren bajando por el 1.er hijo", tiempoNTree, segundosDesde(inicio), nivelesNTree == nivelesCSR);
+}
+
+int main(int argc, char** argv) {
+    int ancho = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int hojas = argc > 2 ? std::atoi(argv[2]) : 100;
+    int profundidad = argc > 3 ? std::atoi(argv[3]) : 100000;
+    std::srand(argc > 4 ? std::atoi(argv[4]) : 1);
+    if (ancho < 1 || hojas < 0 || profundidad < 1) {
+        std::cerr << "Uso: " << argv[0] << " [hijos de la raíz >= 1] [hojas por hijo >= 0] [profundidad >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    // Ancho: la raíz con 'ancho' hijos, cada uno con 'hojas' hojas
+    std::list< std::pair<int, int> > aristas;
+    int siguiente = 1;
+    for (int i = 0; i < ancho; i++) {
+        int hijo = siguiente++;
+        aristas.push_back(std::make_pair(0, hijo));
+        for (int j = 0; j < hojas; j++) aristas.push_back(std::make_pair(hijo, siguiente++));
+    }
+    comparar("Árbol ancho", NTree<int>(aristas));
+
+    // Profundo: cada nodo cuelga de uno de los tres anteriores, así que la altura ronda la mitad
+    aristas.clear();
+    for (int i = 1; i <= profundidad; i++) {
+        int atras = 1 + std::rand() % 3;
+        aristas.push_back(std::make_pair(i > atras ? i - atras : 0, i));
+    }
+    comparar("Árbol profundo", NTree<int>(aristas));
+    return 0;
+}
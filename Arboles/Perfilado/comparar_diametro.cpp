@@ -0,0 +1,197 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "bin_tree.h"
+#include "n_tree.h"
+
+// getDiameterPath contra la versión anterior (FIND_DIAMETER + UPDATE_LONGEST_PATH, que copiaba
+// listas de ramas en cada nodo), en árboles aleatorios. La versión anterior ya no está en los
+// árboles: aquí se reescribe igual sobre un arreglo de hijos, con las mismas copias de listas.
+// Además se verifica la longitud actual con dos BFS sobre el mismo árbol.
+// Uso: ./comparar_diametro [nodos] [semilla]
+
+typedef std::vector< std::vector<int> > Hijos;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// --- Versión anterior ---
+
+void combinarCaminos(std::list<int>& resultado, std::list<int> camino1, std::list<int> camino2) {
+    int lca = 0;
+    bool lcaEncontrado = false;
+    while (!camino1.empty() && !camino2.empty() && camino1.front() == camino2.front()) {
+        lca = camino1.front();
+        lcaEncontrado = true;
+        camino1.pop_front();
+        camino2.pop_front();
+    }
+    resultado.clear();
+    std::vector<int> invertido(camino1.begin(), camino1.end());
+    for (int i = (int)invertido.size() - 1; i >= 0; --i) resultado.push_back(invertido[i]);
+    if (lcaEncontrado) resultado.push_back(lca);
+    resultado.insert(resultado.end(), camino2.begin(), camino2.end());
+}
+
+void actualizarMasLargo(std::list<int>& masLargo, std::list<int>& rama1, std::list<int>& rama2, const std::list<int>& nueva) {
+    std::list<int> diametro1, diametro2;
+    if (rama1.empty()) {
+        rama1 = nueva;
+        return;
+    }
+    combinarCaminos(diametro1, rama1, nueva);
+    if (rama2.empty()) {
+        rama2 = nueva;
+        std::list<int> inicial;
+        combinarCaminos(inicial, rama1, rama2);
+        if (inicial.size() > masLargo.size()) masLargo = inicial;
+        return;
+    }
+    combinarCaminos(diametro2, rama2, nueva);
+    if (diametro1.size() >= diametro2.size()) {
+        if (diametro1.size() > masLargo.size()) masLargo = diametro1;
+        rama2 = nueva;
+    } else {
+        if (diametro2.size() > masLargo.size()) masLargo = diametro2;
+        rama1 = nueva;
+    }
+}
+
+void buscarDiametro(const Hijos& hijos, int nodo, std::list<int>& masLargo, std::list<int>& rama1, std::list<int>& rama2, std::list<int>& actual) {
+    actual.push_back(nodo);
+    if (hijos[nodo].empty()) {
+        actualizarMasLargo(masLargo, rama1, rama2, actual);
+    } else {
+        for (size_t i = 0; i < hijos[nodo].size(); i++) {
+            std::list<int> copia1 = rama1, copia2 = rama2;
+            buscarDiametro(hijos, hijos[nodo][i], masLargo, copia1, copia2, actual);
+            rama1 = copia1;
+            rama2 = copia2;
+        }
+    }
+    actual.pop_back();
+}
+
+std::list<int> diametroAnterior(const Hijos& hijos, int raiz) {
+    std::list<int> masLargo, rama1, rama2, actual;
+    buscarDiametro(hijos, raiz, masLargo, rama1, rama2, actual);
+    if (masLargo.empty()) return rama1.size() >= rama2.size() ? rama1 : rama2;
+    return masLargo;
+}
+
+// --- Referencia exacta: el nodo más lejano de cualquiera es un extremo de un diámetro ---
+
+int masLejano(const Hijos& vecinos, int origen, int& distancia) {
+    std::vector<int> d(vecinos.size(), -1), cola(1, origen);
+    d[origen] = 0;
+    int ultimo = origen;
+    for (size_t i = 0; i < cola.size(); i++) {
+        ultimo = cola[i];
+        for (size_t j = 0; j < vecinos[ultimo].size(); j++) {
+            int v = vecinos[ultimo][j];
+            if (d[v] < 0) {
+                d[v] = d[ultimo] + 1;
+                cola.push_back(v);
+            }
+        }
+    }
+    distancia = d[ultimo];
+    return ultimo;
+}
+
+int nodosDelDiametro(const Hijos& hijos, int raiz) {
+    Hijos vecinos(hijos.size());
+    for (size_t p = 0; p < hijos.size(); p++) {
+        for (size_t i = 0; i < hijos[p].size(); i++) {
+            vecinos[p].push_back(hijos[p][i]);
+            vecinos[hijos[p][i]].push_back((int)p);
+        }
+    }
+    int distancia;
+    masLejano(vecinos, masLejano(vecinos, raiz, distancia), distancia);
+    return distancia + 1;
+}
+
+void fila(const char* arbol, int nodos, double anterior, double actual, size_t largoAnterior, size_t largoActual, int exacto) {
+    std::cout << std::left << std::setw(10) << arbol << std::right << std::setw(9) << nodos
+              << std::setw(14) << std::fixed << std::setprecision(4) << anterior << std::setw(12) << actual
+              << std::setw(10) << std::setprecision(1) << anterior / (actual > 0 ? actual : 1e-6) << "x"
+              << std::setw(14) << largoAnterior << std::setw(12) << largoActual
+              << (largoActual == (size_t)exacto ? "   ok" : "   FALLA") << std::endl;
+}
+
+// BST con las claves 0..nodos-1 en orden aleatorio
+void compararBinTree(int nodos) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+    BinTree<int> arbol;
+    Hijos hijos(nodos);
+    std::vector<int> izquierdo(nodos, -1), derecho(nodos, -1);
+    for (int i = 0; i < nodos; i++) {
+        arbol.insertBST(claves[i]);
+        if (i == 0) continue;
+        int p = claves[0];
+        while (true) {
+            int& siguiente = claves[i] < p ? izquierdo[p] : derecho[p];
+            if (siguiente < 0) {
+                siguiente = claves[i];
+                break;
+            }
+            p = siguiente;
+        }
+    }
+    for (int p = 0; p < nodos; p++) {
+        if (izquierdo[p] >= 0) hijos[p].push_back(izquierdo[p]);
+        if (derecho[p] >= 0) hijos[p].push_back(derecho[p]);
+    }
+
+    std::clock_t inicio = std::clock();
+    std::list<int> anterior = diametroAnterior(hijos, claves[0]);
+    double tiempoAnterior = segundosDesde(inicio);
+    inicio = std::clock();
+    std::list<int> actual = arbol.getDiameterPath();
+    double tiempoActual = segundosDesde(inicio);
+    fila("BinTree", nodos, tiempoAnterior, tiempoActual, anterior.size(), actual.size(), nodosDelDiametro(hijos, claves[0]));
+}
+
+// Árbol N-ario donde el padre de cada nodo i es uno anterior al azar
+void compararNTree(int nodos) {
+    std::list< std::pair<int, int> > aristas;
+    Hijos hijos(nodos);
+    for (int i = 1; i < nodos; i++) {
+        int padre = std::rand() % i;
+        aristas.push_back(std::make_pair(padre, i));
+        hijos[padre].push_back(i);
+    }
+    NTree<int> arbol(aristas);
+
+    std::clock_t inicio = std::clock();
+    std::list<int> anterior = diametroAnterior(hijos, 0);
+    double tiempoAnterior = segundosDesde(inicio);
+    inicio = std::clock();
+    std::list<int> actual = arbol.getDiameterPath();
+    double tiempoActual = segundosDesde(inicio);
+    fila("NTree", nodos, tiempoAnterior, tiempoActual, anterior.size(), actual.size(), nodosDelDiametro(hijos, 0));
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (nodos < 2) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [semilla]" << std::endl;
+        return 1;
+    }
+    std::cout << std::left << std::setw(10) << "tipo" << std::right << std::setw(9) << "nodos"
+              << std::setw(14) << "anterior (s)" << std::setw(12) << "actual (s)" << std::setw(11) << "mejora"
+              << std::setw(14) << "largo ant." << std::setw(12) << "largo act." << std::endl;
+    for (int n = nodos / 100 > 0 ? nodos / 100 : 1; n <= nodos; n *= 10) {
+        compararBinTree(n < 2 ? 2 : n);
+        compararNTree(n < 2 ? 2 : n);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <sys/time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "bin_tree.h"
+#include "n_tree.h"
+
+// fold en paralelo (tree_parallel.h) contra las operaciones secuenciales de siempre, en un BinTree
+// balanceado (buildBalancedBST) y en un NTree balanceado de ARIDAD hijos por nodo, de [nodos] nodos.
+// Cada folder se corre con 1, 2, 4 y 8 hilos (TreeTaskPool::setThreads) y su resultado se compara
+// con el secuencial: getWeight para la cantidad, getHeight para la altura, la suma del preorden
+// para la suma, getLeaves para las hojas y el tamaño de getLeaves para un folder propio que cuenta
+// hojas sin armar la lista. getWeight lee el tamaño que el árbol ya tiene guardado, así que su
+// columna es casi cero. TreeLeavesFold arma una lista por nodo y las empalma, así que con un hilo
+// tarda más que getLeaves. Con un solo núcleo no puede haber mejora por hilos: ahí se ve el costo de
+// repartir las tareas.
+// Se mide tiempo de reloj, no de CPU, porque con varios hilos el de CPU se suma entre todos.
+// Uso: ./comparar_fold [nodos]
+
+const int ARIDAD = 4;
+
+// Que malloc ordene ahora los bloques que liberó la medición anterior (ver comparar_carga)
+void ordenarHeap() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+double segundosDeReloj() {
+    timeval ahora;
+    gettimeofday(&ahora, NULL);
+    return ahora.tv_sec + ahora.tv_usec / 1e6;
+}
+
+const int HILOS[] = { 1, 2, 4, 8 };
+const int CUANTOS_HILOS = 4;
+
+void titulo(const std::string& que) {
+    std::cout << std::endl << "== " << que << " (s de reloj) ==" << std::endl;
+    std::cout << std::left << std::setw(30) << "folder" << std::right << std::setw(12) << "secuencial";
+    for (int h = 0; h < CUANTOS_HILOS; h++) {
+        std::ostringstream columna;
+        columna << HILOS[h] << (HILOS[h] > 1 ? " hilos" : " hilo");
+        std::cout << std::setw(10) << columna.str();
+    }
+    std::cout << std::endl;
+}
+
+void fila(const std::string& que, double secuencial, const double* paralelo, bool iguales) {
+    std::cout << std::left << std::setw(30) << que << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << secuencial;
+    for (int h = 0; h < CUANTOS_HILOS; h++) std::cout << std::setw(10) << paralelo[h];
+    std::cout << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Un folder propio: cuántas hojas hay, sin la lista de TreeLeavesFold
+struct ContarHojas {
+    typedef int Result;
+    Result empty() const { return 0; }
+    Result visit(const long&) const { return 1; }
+    void join(Result& parent, Result& child, bool first) const {
+        if (first) parent = 0; // Tiene hijos: no es hoja
+        parent += child;
+    }
+};
+
+// Un NTree balanceado con los valores primero..primero+nodos-1 en preorden
+NTree<long> armarNTree(long primero, long nodos) {
+    if (nodos == 1) return NTree<long>(primero);
+    std::list< NTree<long> > hijos;
+    long resto = nodos - 1, siguiente = primero + 1;
+    for (int k = 0; k < ARIDAD && resto > 0; k++) {
+        long tamanio = (resto + ARIDAD - k - 1) / (ARIDAD - k);
+        hijos.push_back(armarNTree(siguiente, tamanio));
+        siguiente += tamanio;
+        resto -= tamanio;
+    }
+    return NTree<long>(primero, hijos);
+}
+
+long sumar(const std::list<long>& valores) {
+    long suma = 0;
+    for (std::list<long>::const_iterator it = valores.begin(); it != valores.end(); ++it) suma += *it;
+    return suma;
+}
+
+// Corre 'folder' con cada cantidad de hilos y deja los tiempos en 'tiempos'; 'iguales' queda en
+// falso si algún resultado no es 'esperado'
+template <class Tree, class Folder>
+void medirFold(const Tree& arbol, const Folder& folder, const typename Folder::Result& esperado, double* tiempos, bool& iguales) {
+    iguales = true;
+    for (int h = 0; h < CUANTOS_HILOS; h++) {
+        TreeTaskPool::setThreads(HILOS[h]);
+        ordenarHeap();
+        double inicio = segundosDeReloj();
+        typename Folder::Result resultado = arbol.fold(folder);
+        tiempos[h] = segundosDeReloj() - inicio;
+        iguales = iguales && resultado == esperado;
+    }
+    TreeTaskPool::setThreads(0);
+}
+
+template <class Tree>
+void comparar(const std::string& que, const Tree& arbol) {
+    titulo(que);
+    double tiempos[CUANTOS_HILOS];
+    bool iguales;
+
+    arbol.fold(TreeCountFold<long>()); // Sin medir: que el árbol esté en caché igual para todos
+
+    double inicio = segundosDeReloj();
+    int cantidad = arbol.getWeight();
+    double secuencial = segundosDeReloj() - inicio;
+    medirFold(arbol, TreeCountFold<long>(), cantidad, tiempos, iguales);
+    fila("cantidad / getWeight", secuencial, tiempos, iguales);
+
+    inicio = segundosDeReloj();
+    int altura = arbol.getHeight();
+    secuencial = segundosDeReloj() - inicio;
+    medirFold(arbol, TreeHeightFold<long>(), altura, tiempos, iguales);
+    std::ostringstream caso;
+    caso << "altura / getHeight (" << altura << ")";
+    fila(caso.str(), secuencial, tiempos, iguales);
+
+    ordenarHeap();
+    inicio = segundosDeReloj();
+    long suma = sumar(arbol.preOrder());
+    secuencial = segundosDeReloj() - inicio;
+    long n = cantidad;
+    medirFold(arbol, TreeSumFold<long>(), suma, tiempos, iguales);
+    fila("suma / suma del preorden", secuencial, tiempos, iguales && suma == n * (n - 1) / 2);
+
+    ordenarHeap();
+    inicio = segundosDeReloj();
+    std::list<long> hojas = arbol.getLeaves();
+    secuencial = segundosDeReloj() - inicio;
+    medirFold(arbol, TreeLeavesFold<long>(), hojas, tiempos, iguales);
+    fila("hojas / getLeaves", secuencial, tiempos, iguales);
+
+    int cuantasHojas = (int)hojas.size();
+    hojas.clear();
+    ordenarHeap();
+    inicio = segundosDeReloj();
+    bool mismas = (int)arbol.getLeaves().size() == cuantasHojas;
+    secuencial = segundosDeReloj() - inicio;
+    medirFold(arbol, ContarHojas(), cuantasHojas, tiempos, iguales);
+    fila("propio (contar hojas)", secuencial, tiempos, iguales && mismas);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    if (nodos < 1) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 1]" << std::endl;
+        return 1;
+    }
+    std::cout << nodos << " nodos, " << TreeTaskPool::getThreads() << " hilos por defecto" << std::endl;
+
+    {
+        std::vector<long> claves(nodos);
+        for (int i = 0; i < nodos; i++) claves[i] = i;
+        BinTree<long> binario;
+        binario.buildBalancedBST(claves.begin(), claves.end());
+        std::vector<long>().swap(claves);
+        comparar("BinTree balanceado", binario);
+    }
+    ordenarHeap();
+    std::ostringstream que;
+    que << "NTree balanceado de " << ARIDAD << " hijos";
+    NTree<long> nario = armarNTree(0, nodos);
+    comparar(que.str(), nario);
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "n_tree.h"
+#include "tree_hld.h"
+
+// TreeHLD contra lo que hay sin él, con consultas generadas al azar: suma y máximo sobre el camino
+// entre dos nodos, suma de un subárbol y una mezcla de cambios de valor con consultas de camino.
+// Se compara con NTree::findPathBetweenNodes (arma la lista del camino y se suma) y con arreglos
+// de padres e hijos, que suben nodo por nodo hasta el LCA y recorren el subárbol entero.
+// En el árbol profundo findPathBetweenNodes recorre caminos de miles de nodos; por eso sus
+// consultas se hacen menos veces y la tabla muestra µs por consulta.
+// Uso: ./comparar_hld [nodos] [consultas] [nodos del árbol profundo] [semilla]
+
+typedef std::vector< std::vector<int> > Hijos;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& consulta, int cuantas, double antes, double hld, bool iguales) {
+    double microAntes = antes * 1e6 / cuantas, microHLD = hld * 1e6 / cuantas;
+    std::cout << std::left << std::setw(38) << consulta << std::right << std::setw(9) << cuantas << std::fixed
+              << std::setw(13) << std::setprecision(3) << microAntes << std::setw(11) << microHLD
+              << std::setw(11) << std::setprecision(1) << microAntes / (microHLD > 0 ? microHLD : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Sin HLD: arreglos de padres, profundidades e hijos ---
+
+struct Arreglos {
+    std::vector<int> padre, profundidad;
+    std::vector<long> valor;
+    Hijos hijos;
+
+    long sumaCamino(int a, int b) const {
+        long suma = 0;
+        while (a != b) {
+            if (profundidad[a] < profundidad[b]) std::swap(a, b);
+            suma += valor[a];
+            a = padre[a];
+        }
+        return suma + valor[a];
+    }
+
+    long maximoCamino(int a, int b) const {
+        long maximo = valor[a] > valor[b] ? valor[a] : valor[b];
+        while (a != b) {
+            if (profundidad[a] < profundidad[b]) std::swap(a, b);
+            a = padre[a];
+            if (valor[a] > maximo) maximo = valor[a];
+        }
+        return maximo;
+    }
+
+    long sumaSubarbol(int nodo) const {
+        long suma = 0;
+        std::vector<int> pila(1, nodo);
+        while (!pila.empty()) {
+            int actual = pila.back();
+            pila.pop_back();
+            suma += valor[actual];
+            pila.insert(pila.end(), hijos[actual].begin(), hijos[actual].end());
+        }
+        return suma;
+    }
+};
+
+void comparar(const char* titulo, const std::vector<int>& padres, int consultas) {
+    int nodos = (int)padres.size();
+    Arreglos arreglos;
+    arreglos.padre = padres;
+    arreglos.profundidad.assign(nodos, 0);
+    arreglos.valor.resize(nodos);
+    arreglos.hijos.resize(nodos);
+    std::list< std::pair<long, long> > aristas;
+    int altura = 0;
+    for (int i = 0; i < nodos; i++) {
+        arreglos.valor[i] = i;
+        if (i == 0) continue;
+        arreglos.profundidad[i] = arreglos.profundidad[padres[i]] + 1;
+        if (arreglos.profundidad[i] > altura) altura = arreglos.profundidad[i];
+        arreglos.hijos[padres[i]].push_back(i);
+        aristas.push_back(std::make_pair((long)padres[i], (long)i));
+    }
+    NTree<long> arbol(aristas);
+
+    std::clock_t inicio = std::clock();
+    TreeHLD<long> suma(arbol);
+    double construir = segundosDesde(inicio);
+    TreeHLD< long, TreePathMax<long> > maximo(arbol);
+    std::cout << std::endl << "== " << titulo << ", " << nodos << " nodos, altura " << altura << " (HLD armado en "
+              << std::fixed << std::setprecision(3) << construir << " s) ==" << std::endl;
+    std::cout << std::left << std::setw(38) << "consulta (µs por consulta)" << std::right << std::setw(9) << "consultas"
+              << std::setw(13) << "sin HLD" << std::setw(11) << "HLD" << std::setw(11) << "mejora" << std::endl;
+
+    // Los ids del HLD son el preorden; los valores iniciales son las etiquetas
+    std::vector<int> id(nodos);
+    for (int i = 0; i < nodos; i++) id[suma.getInfo(i)] = i;
+    std::vector<int> a(consultas), b(consultas);
+    for (int i = 0; i < consultas; i++) {
+        a[i] = std::rand() % nodos;
+        b[i] = std::rand() % nodos;
+    }
+    int pocas = consultas / 100 > 0 ? consultas / 100 : 1;
+
+    // Suma del camino por valor: findPathBetweenNodes arma la lista y se suma
+    long totalAntes = 0, totalHLD = 0;
+    inicio = std::clock();
+    for (int i = 0; i < pocas; i++) {
+        std::list<long> camino = arbol.findPathBetweenNodes(a[i], b[i]);
+        for (std::list<long>::iterator it = camino.begin(); it != camino.end(); ++it) totalAntes += *it;
+    }
+    double antes = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < pocas; i++) totalHLD += suma.queryPath(a[i], b[i]);
+    fila("suma de camino: findPathBetweenNodes", pocas, antes, segundosDesde(inicio), totalAntes == totalHLD);
+
+    totalAntes = totalHLD = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalAntes += arreglos.sumaCamino(a[i], b[i]);
+    antes = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalHLD += suma.queryPathNode(id[a[i]], id[b[i]]);
+    fila("suma de camino: subir por padres", consultas, antes, segundosDesde(inicio), totalAntes == totalHLD);
+
+    totalAntes = totalHLD = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalAntes += arreglos.maximoCamino(a[i], b[i]);
+    antes = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalHLD += maximo.queryPathNode(id[a[i]], id[b[i]]);
+    fila("máximo de camino: subir por padres", consultas, antes, segundosDesde(inicio), totalAntes == totalHLD);
+
+    totalAntes = totalHLD = 0;
+    inicio = std::clock();
+    for (int i = 0; i < pocas; i++) totalAntes += arreglos.sumaSubarbol(a[i]);
+    antes = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < pocas; i++) totalHLD += suma.querySubtreeNode(id[a[i]]);
+    fila("suma de subárbol: recorrerlo", pocas, antes, segundosDesde(inicio), totalAntes == totalHLD);
+
+    // Mitad cambios de valor, mitad sumas de camino; sin HLD el cambio es O(1)
+    totalAntes = totalHLD = 0;
+    std::vector<long> nuevos(consultas);
+    for (int i = 0; i < consultas; i++) nuevos[i] = std::rand() % 1000;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        if (i % 2 == 0) arreglos.valor[a[i]] = nuevos[i];
+        else totalAntes += arreglos.sumaCamino(a[i], b[i]);
+    }
+    antes = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        if (i % 2 == 0) suma.updateNode(id[a[i]], nuevos[i]);
+        else totalHLD += suma.queryPathNode(id[a[i]], id[b[i]]);
+    }
+    fila("mitad cambios, mitad sumas de camino", consultas, antes, segundosDesde(inicio), totalAntes == totalHLD);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int consultas = argc > 2 ? std::atoi(argv[2]) : 100000;
+    int profundo = argc > 3 ? std::atoi(argv[3]) : 100000;
+    std::srand(argc > 4 ? std::atoi(argv[4]) : 1);
+    if (nodos < 2 || consultas < 1 || profundo < 2) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [consultas >= 1] [nodos del árbol profundo >= 2] [semilla]" << std::endl;
+        return 1;
+    }
+
+    // Padre de cada nodo al azar entre los anteriores: altura logarítmica
+    std::vector<int> padres(nodos, -1);
+    for (int i = 1; i < nodos; i++) padres[i] = std::rand() % i;
+    comparar("Padres aleatorios", padres, consultas);
+
+    // Cada nodo cuelga de uno de los tres anteriores: altura cercana a la mitad de los nodos
+    padres.assign(profundo, -1);
+    for (int i = 1; i < profundo; i++) {
+        int atras = 1 + std::rand() % 3;
+        padres[i] = i > atras ? i - atras : 0;
+    }
+    comparar("Árbol profundo", padres, consultas);
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "bin_tree.h"
+#include "n_tree.h"
+
+// Iteradores perezosos contra las listas que devuelven preOrder(), inOrder(), getLeaves()...
+// Mide el tiempo y el pico de memoria pedida al heap durante cada consulta, en tres casos:
+// cortar la búsqueda apenas aparece un elemento, contar sin guardar nada y recorrer todo.
+// Uso: ./comparar_iteradores [nodos] [semilla]
+
+// operator new global que lleva la cuenta de los bytes en uso y del máximo alcanzado
+namespace {
+    size_t bytesEnUso = 0;
+    size_t picoDeBytes = 0;
+}
+
+void* operator new(size_t bytes) throw(std::bad_alloc) {
+    size_t* bloque = static_cast<size_t*>(std::malloc(bytes + sizeof(size_t)));
+    if (bloque == NULL) throw std::bad_alloc();
+    *bloque = bytes;
+    bytesEnUso += bytes;
+    if (bytesEnUso > picoDeBytes) picoDeBytes = bytesEnUso;
+    return bloque + 1;
+}
+
+void operator delete(void* p) throw() {
+    if (p == NULL) return;
+    size_t* bloque = static_cast<size_t*>(p) - 1;
+    bytesEnUso -= *bloque;
+    std::free(bloque);
+}
+
+struct Medicion {
+    double segundos;
+    size_t bytes;
+};
+
+std::clock_t inicio;
+size_t base;
+
+void empezar() {
+    // Que malloc ordene ahora los millones de bloques que liberó la lista anterior:
+    // si no, el primer pedido chico de la medición siguiente paga ese trabajo
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    base = bytesEnUso;
+    picoDeBytes = bytesEnUso;
+    inicio = std::clock();
+}
+
+Medicion terminar() {
+    Medicion m;
+    m.segundos = (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+    m.bytes = picoDeBytes - base;
+    return m;
+}
+
+void fila(const char* consulta, const Medicion& lista, const Medicion& iterador, bool iguales) {
+    std::cout << std::left << std::setw(34) << consulta << std::right << std::fixed
+              << std::setw(12) << std::setprecision(6) << lista.segundos << std::setw(12) << iterador.segundos
+              << std::setw(14) << lista.bytes << std::setw(12) << iterador.bytes
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Las mismas consultas sobre cualquiera de los dos árboles
+template <class Tree>
+void comparar(const char* titulo, const Tree& arbol) {
+    typedef typename Tree::const_iterator Iterador;
+    std::cout << std::endl << "== " << titulo << ", " << arbol.getWeight() << " nodos ==" << std::endl;
+    std::cout << std::left << std::setw(34) << "consulta" << std::right << std::setw(12) << "lista (s)"
+              << std::setw(12) << "iter. (s)" << std::setw(14) << "lista (B)" << std::setw(12) << "iter. (B)" << std::endl;
+
+    // El décimo elemento en preorden: la lista se arma entera aunque solo se miren diez
+    int buscado;
+    {
+        Iterador it = arbol.begin();
+        for (int i = 0; i < 9; i++) ++it;
+        buscado = *it;
+    }
+    empezar();
+    std::list<int> pre = arbol.preOrder();
+    bool enLista = std::find(pre.begin(), pre.end(), buscado) != pre.end();
+    pre.clear();
+    Medicion lista = terminar();
+    empezar();
+    bool enIterador = std::find(arbol.begin(), arbol.end(), buscado) != arbol.end();
+    Medicion iterador = terminar();
+    fila("buscar el 10.o de preorden", lista, iterador, enLista && enIterador);
+
+    // Contar hojas
+    empezar();
+    size_t hojasLista = arbol.getLeaves().size();
+    lista = terminar();
+    empezar();
+    TreeRange<Iterador> hojas = arbol.traverse(TRAVERSE_LEAVES);
+    size_t hojasIterador = std::distance(hojas.begin(), hojas.end());
+    iterador = terminar();
+    fila("contar hojas", lista, iterador, hojasLista == hojasIterador);
+
+    // Sumar todo el inorden
+    long sumaLista = 0, sumaIterador = 0;
+    empezar();
+    std::list<int> in = arbol.inOrder();
+    for (std::list<int>::iterator i = in.begin(); i != in.end(); ++i) sumaLista += *i;
+    in.clear();
+    lista = terminar();
+    empezar();
+    TreeRange<Iterador> todos = arbol.traverse(TRAVERSE_IN_ORDER);
+    for (Iterador i = todos.begin(); i != todos.end(); ++i) sumaIterador += *i;
+    iterador = terminar();
+    fila("sumar el inorden", lista, iterador, sumaLista == sumaIterador);
+
+    // Primer elemento mayor que la mitad en recorrido por niveles
+    int mitad = arbol.getWeight() / 2;
+    empezar();
+    std::list<int> niveles = arbol.levelOrder();
+    std::list<int>::iterator l = niveles.begin();
+    while (l != niveles.end() && *l <= mitad) ++l;
+    int primeroLista = (l != niveles.end()) ? *l : -1;
+    niveles.clear();
+    lista = terminar();
+    empezar();
+    TreeRange<Iterador> porNiveles = arbol.traverse(TRAVERSE_LEVEL_ORDER);
+    Iterador n = porNiveles.begin();
+    while (n != porNiveles.end() && *n <= mitad) ++n;
+    int primeroIterador = (n != porNiveles.end()) ? *n : -1;
+    iterador = terminar();
+    fila("primero > n/2 por niveles", lista, iterador, primeroLista == primeroIterador);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (nodos < 10) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 10] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+    BinTree<int> bst;
+    for (int i = 0; i < nodos; i++) bst.insertBST(claves[i]);
+    comparar("BinTree (BST aleatorio)", bst);
+
+    std::list< std::pair<int, int> > aristas;
+    for (int i = 1; i < nodos; i++) aristas.push_back(std::make_pair(std::rand() % i, i));
+    NTree<int> nario(aristas);
+    comparar("NTree (padres aleatorios)", nario);
+    return 0;
+}
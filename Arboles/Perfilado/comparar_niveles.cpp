@@ -0,0 +1,227 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "bin_tree.h"
+#include "n_tree.h"
+
+// getLevel con el índice de niveles contra la versión anterior, que hacía un BFS con marcas NULL
+// en cada llamada (y en NTree además pasaba cada valor a string y filtraba las marcas "-").
+// La versión anterior se reescribe igual sobre un arreglo de hijos que refleja el mismo árbol.
+// Uso: ./comparar_niveles [nodos] [consultas] [semilla]
+
+typedef std::vector< std::vector<int> > Hijos;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// --- Versiones anteriores ---
+
+std::list<int> nivelAnteriorBinTree(const Hijos& hijos, int raiz, int nivel) {
+    std::list<int> resultado;
+    std::queue<int> cola;
+    cola.push(raiz);
+    cola.push(-1);
+    int actual = 0;
+    while (!cola.empty()) {
+        int nodo = cola.front();
+        cola.pop();
+        if (nodo < 0) {
+            actual++;
+            if (cola.empty() || actual > nivel) break;
+            cola.push(-1);
+        } else {
+            if (actual == nivel) resultado.push_back(nodo);
+            for (size_t i = 0; i < hijos[nodo].size(); i++) cola.push(hijos[nodo][i]);
+        }
+    }
+    return resultado;
+}
+
+std::list<std::string> nivelAnteriorNTree(const Hijos& hijos, int raiz, int nivel) {
+    std::list<std::string> conMarcas, resultado;
+    std::queue<int> cola;
+    cola.push(raiz);
+    cola.push(-1);
+    while (cola.size() > 1) {
+        int nodo = cola.front();
+        cola.pop();
+        if (nodo < 0) {
+            conMarcas.push_back("-");
+            cola.push(-1);
+        } else {
+            std::ostringstream ss;
+            ss << nodo;
+            conMarcas.push_back(ss.str());
+            for (size_t i = 0; i < hijos[nodo].size(); i++) cola.push(hijos[nodo][i]);
+        }
+    }
+    int actual = 0;
+    for (std::list<std::string>::iterator it = conMarcas.begin(); it != conMarcas.end(); ++it) {
+        if (*it == "-") actual++;
+        else if (actual == nivel) resultado.push_back(*it);
+        else if (actual > nivel) break;
+    }
+    return resultado;
+}
+
+void encabezado(const char* titulo, int nodos, int altura) {
+    std::cout << std::endl << "== " << titulo << ", " << nodos << " nodos, altura " << altura << " ==" << std::endl;
+    std::cout << std::left << std::setw(40) << "consultas" << std::right << std::setw(14) << "anterior (s)"
+              << std::setw(12) << "actual (s)" << std::setw(11) << "mejora" << std::endl;
+}
+
+void fila(const std::string& consultas, double anterior, double actual, bool iguales) {
+    std::cout << std::left << std::setw(40) << consultas << std::right << std::fixed
+              << std::setw(14) << std::setprecision(4) << anterior << std::setw(12) << actual
+              << std::setw(10) << std::setprecision(1) << anterior / (actual > 0 ? actual : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+std::string texto(int consultas, const char* que) {
+    std::ostringstream ss;
+    ss << consultas << " " << que;
+    return ss.str();
+}
+
+// BST con las claves 0..nodos-1 en orden aleatorio; 'hijos' guarda la misma forma
+void agregarBST(Hijos& hijos, std::vector<int>& izquierdo, std::vector<int>& derecho, int raiz, int clave) {
+    if ((int)hijos.size() <= clave) {
+        hijos.resize(clave + 1);
+        izquierdo.resize(clave + 1, -1);
+        derecho.resize(clave + 1, -1);
+    }
+    if (clave == raiz) return;
+    int p = raiz;
+    while (true) {
+        int& siguiente = clave < p ? izquierdo[p] : derecho[p];
+        if (siguiente < 0) {
+            siguiente = clave;
+            break;
+        }
+        p = siguiente;
+    }
+    hijos[p].clear();
+    if (izquierdo[p] >= 0) hijos[p].push_back(izquierdo[p]);
+    if (derecho[p] >= 0) hijos[p].push_back(derecho[p]);
+}
+
+void compararBinTree(int nodos, int consultas) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+    BinTree<int> arbol;
+    Hijos hijos;
+    std::vector<int> izquierdo, derecho;
+    for (int i = 0; i < nodos; i++) {
+        arbol.insertBST(claves[i]);
+        agregarBST(hijos, izquierdo, derecho, claves[0], claves[i]);
+    }
+    int altura = arbol.getHeight();
+    encabezado("BinTree (BST aleatorio)", nodos, altura);
+
+    // Cada nivel una vez: la versión anterior recorre el árbol hasta ese nivel en cada llamada
+    size_t totalAnterior = 0, totalActual = 0;
+    std::clock_t inicio = std::clock();
+    for (int k = 0; k <= altura; k++) totalAnterior += nivelAnteriorBinTree(hijos, claves[0], k).size();
+    double anterior = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int k = 0; k <= altura; k++) totalActual += arbol.getLevel(k).size();
+    fila(texto(altura + 1, "niveles, uno por llamada"), anterior, segundosDesde(inicio), totalAnterior == (size_t)nodos && totalActual == (size_t)nodos);
+
+    // Niveles al azar sin cambios en el árbol: el índice se arma una sola vez
+    std::vector<int> niveles(consultas);
+    for (int i = 0; i < consultas; i++) niveles[i] = std::rand() % (altura + 1);
+    totalAnterior = totalActual = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalAnterior += nivelAnteriorBinTree(hijos, claves[0], niveles[i]).size();
+    anterior = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalActual += arbol.getLevel(niveles[i]).size();
+    fila(texto(consultas, "niveles al azar"), anterior, segundosDesde(inicio), totalAnterior == totalActual);
+
+    // Peor caso del índice: cada inserción lo invalida y la consulta siguiente lo rearma
+    totalAnterior = totalActual = 0;
+    double tiempoAnterior = 0, tiempoActual = 0;
+    for (int i = 0; i < consultas; i++) {
+        int clave = nodos + i;
+        arbol.insertBST(clave);
+        agregarBST(hijos, izquierdo, derecho, claves[0], clave);
+        int k = std::rand() % (altura + 1);
+        inicio = std::clock();
+        totalAnterior += nivelAnteriorBinTree(hijos, claves[0], k).size();
+        tiempoAnterior += segundosDesde(inicio);
+        inicio = std::clock();
+        totalActual += arbol.getLevel(k).size();
+        tiempoActual += segundosDesde(inicio);
+    }
+    fila(texto(consultas, "inserciones + nivel al azar"), tiempoAnterior, tiempoActual, totalAnterior == totalActual);
+}
+
+void compararNTree(int nodos, int consultas) {
+    std::list< std::pair<int, int> > aristas;
+    Hijos hijos(nodos);
+    for (int i = 1; i < nodos; i++) {
+        int padre = std::rand() % i;
+        aristas.push_back(std::make_pair(padre, i));
+        hijos[padre].push_back(i);
+    }
+    NTree<int> arbol(aristas);
+    int altura = arbol.getHeight();
+    encabezado("NTree (padres aleatorios)", nodos, altura);
+
+    size_t totalAnterior = 0, totalActual = 0;
+    std::clock_t inicio = std::clock();
+    for (int k = 0; k <= altura; k++) totalAnterior += nivelAnteriorNTree(hijos, 0, k).size();
+    double anterior = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int k = 0; k <= altura; k++) totalActual += arbol.getLevel(k).size();
+    fila(texto(altura + 1, "niveles, uno por llamada"), anterior, segundosDesde(inicio), totalAnterior == (size_t)nodos && totalActual == (size_t)nodos);
+
+    std::vector<int> niveles(consultas);
+    for (int i = 0; i < consultas; i++) niveles[i] = std::rand() % (altura + 1);
+    totalAnterior = totalActual = 0;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalAnterior += nivelAnteriorNTree(hijos, 0, niveles[i]).size();
+    anterior = segundosDesde(inicio);
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) totalActual += arbol.getLevel(niveles[i]).size();
+    fila(texto(consultas, "niveles al azar"), anterior, segundosDesde(inicio), totalAnterior == totalActual);
+
+    // insertSubtree cuelga una hoja nueva de la raíz e invalida el índice
+    totalAnterior = totalActual = 0;
+    double tiempoAnterior = 0, tiempoActual = 0;
+    for (int i = 0; i < consultas; i++) {
+        int valor = nodos + i;
+        arbol.insertSubtree(NTree<int>(valor));
+        hijos.push_back(std::vector<int>());
+        hijos[0].push_back(valor);
+        int k = std::rand() % (altura + 1);
+        inicio = std::clock();
+        totalAnterior += nivelAnteriorNTree(hijos, 0, k).size();
+        tiempoAnterior += segundosDesde(inicio);
+        inicio = std::clock();
+        totalActual += arbol.getLevel(k).size();
+        tiempoActual += segundosDesde(inicio);
+    }
+    fila(texto(consultas, "inserciones + nivel al azar"), tiempoAnterior, tiempoActual, totalAnterior == totalActual);
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int consultas = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (nodos < 2 || consultas < 1) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [consultas >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+    compararBinTree(nodos, consultas);
+    compararNTree(nodos, consultas);
+    return 0;
+}
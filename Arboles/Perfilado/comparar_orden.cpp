@@ -0,0 +1,204 @@
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "bin_tree.h"
+
+// Consultas de orden sobre el BST aumentado con tamaños de subárbol (countRange, kth, rank,
+// lowerBound, predecessor, successor, rangeCollect) contra la única forma que había antes:
+// armar inOrder() y filtrar la lista en cada consulta. Las claves son pares, así que la mitad de
+// las consultas busca valores ausentes. La versión con listas es O(n) por consulta, por eso
+// hace menos consultas y la tabla muestra µs por consulta.
+// Uso: ./comparar_orden [nodos] [consultas] [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& consulta, int lentas, double lista, int rapidas, double arbol, bool iguales) {
+    double microLista = lista * 1e6 / lentas, microArbol = arbol * 1e6 / rapidas;
+    std::cout << std::left << std::setw(30) << consulta << std::right << std::fixed
+              << std::setw(14) << std::setprecision(1) << microLista << std::setw(12) << std::setprecision(3) << microArbol
+              << std::setw(12) << std::setprecision(0) << microLista / (microArbol > 0 ? microArbol : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Versión con inOrder(): cada consulta arma y recorre la lista entera ---
+
+int contarEnLista(const BinTree<int>& arbol, int bajo, int alto) {
+    std::list<int> todos = arbol.inOrder();
+    int cuenta = 0;
+    for (std::list<int>::iterator it = todos.begin(); it != todos.end(); ++it) cuenta += (*it >= bajo && *it <= alto);
+    return cuenta;
+}
+
+int kEsimoEnLista(const BinTree<int>& arbol, int k) {
+    std::list<int> todos = arbol.inOrder();
+    std::list<int>::iterator it = todos.begin();
+    std::advance(it, k - 1);
+    return *it;
+}
+
+int rangoEnLista(const BinTree<int>& arbol, int valor) {
+    std::list<int> todos = arbol.inOrder();
+    int menores = 0;
+    for (std::list<int>::iterator it = todos.begin(); it != todos.end() && *it < valor; ++it) menores++;
+    return menores;
+}
+
+// Primer valor >= valor (o > valor si estricto); -1 si no hay
+int cotaEnLista(const BinTree<int>& arbol, int valor, bool estricto) {
+    std::list<int> todos = arbol.inOrder();
+    for (std::list<int>::iterator it = todos.begin(); it != todos.end(); ++it) {
+        if (*it > valor || (!estricto && *it == valor)) return *it;
+    }
+    return -1;
+}
+
+int anteriorEnLista(const BinTree<int>& arbol, int valor) {
+    std::list<int> todos = arbol.inOrder();
+    int anterior = -1;
+    for (std::list<int>::iterator it = todos.begin(); it != todos.end() && *it < valor; ++it) anterior = *it;
+    return anterior;
+}
+
+long juntarEnLista(const BinTree<int>& arbol, int bajo, int alto) {
+    std::list<int> todos = arbol.inOrder();
+    long suma = 0;
+    for (std::list<int>::iterator it = todos.begin(); it != todos.end(); ++it) {
+        if (*it >= bajo && *it <= alto) suma += *it;
+    }
+    return suma;
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int consultas = argc > 2 ? std::atoi(argv[2]) : 100000;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (nodos < 2 || consultas < 1) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [consultas >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = 2 * i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+    BinTree<int> arbol;
+    for (int i = 0; i < nodos; i++) arbol.insertBST(claves[i]);
+
+    int lentas = consultas / 10000 > 0 ? consultas / 10000 : 1;
+    std::vector<int> valor(consultas), ancho(consultas), k(consultas);
+    for (int i = 0; i < consultas; i++) {
+        valor[i] = std::rand() % (2 * nodos);
+        ancho[i] = std::rand() % 200; // Rangos de unas cien claves
+        k[i] = 1 + std::rand() % nodos;
+    }
+
+    std::cout << "BST aleatorio de " << nodos << " claves, altura " << arbol.getHeight() << std::endl;
+    std::cout << std::left << std::setw(30) << "consulta (µs por consulta)" << std::right << std::setw(14) << "inOrder()"
+              << std::setw(12) << "aumentado" << std::setw(13) << "mejora" << std::endl;
+
+    // Cada consulta se hace con las dos versiones sobre los primeros 'lentas' datos; el árbol
+    // aumentado repite además todas las consultas para medir su tiempo con más precisión
+    long lista = 0, aumentado = 0;
+    std::clock_t inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += contarEnLista(arbol, valor[i], valor[i] + ancho[i]);
+    double tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.countRange(valor[i], valor[i] + ancho[i]);
+    bool iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.countRange(valor[i], valor[i] + ancho[i]);
+    fila("countRange", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += kEsimoEnLista(arbol, k[i]);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.kth(k[i]);
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.kth(k[i]);
+    fila("kth", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += rangoEnLista(arbol, valor[i]);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.rank(valor[i]);
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.rank(valor[i]);
+    fila("rank", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    // lowerBound, predecessor y successor devuelven false cuando no hay valor: se cuenta como -1
+    int resultado;
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += cotaEnLista(arbol, valor[i], false);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.lowerBound(valor[i], resultado) ? resultado : -1;
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.lowerBound(valor[i], resultado) ? resultado : -1;
+    fila("lowerBound", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += anteriorEnLista(arbol, valor[i]);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.predecessor(valor[i], resultado) ? resultado : -1;
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.predecessor(valor[i], resultado) ? resultado : -1;
+    fila("predecessor", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += cotaEnLista(arbol, valor[i], true);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) aumentado += arbol.successor(valor[i], resultado) ? resultado : -1;
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) aumentado += arbol.successor(valor[i], resultado) ? resultado : -1;
+    fila("successor", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    // rangeCollect escribe en un iterador de salida; aquí en un vector que se reusa
+    std::vector<int> rango;
+    lista = aumentado = 0;
+    inicio = std::clock();
+    for (int i = 0; i < lentas; i++) lista += juntarEnLista(arbol, valor[i], valor[i] + ancho[i]);
+    tiempoLista = segundosDesde(inicio);
+    for (int i = 0; i < lentas; i++) {
+        rango.clear();
+        arbol.rangeCollect(valor[i], valor[i] + ancho[i], std::back_inserter(rango));
+        for (size_t j = 0; j < rango.size(); j++) aumentado += rango[j];
+    }
+    iguales = lista == aumentado;
+    inicio = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        rango.clear();
+        arbol.rangeCollect(valor[i], valor[i] + ancho[i], std::back_inserter(rango));
+        for (size_t j = 0; j < rango.size(); j++) aumentado += rango[j];
+    }
+    fila("rangeCollect (~100 claves)", lentas, tiempoLista, consultas, segundosDesde(inicio), iguales);
+
+    // Con cambios entre consultas: cada insertBST mantiene los tamaños, así que kth no se rearma
+    lista = aumentado = 0;
+    double tiempoAumentado = 0;
+    tiempoLista = 0;
+    for (int i = 0; i < lentas; i++) {
+        arbol.insertBST(2 * (nodos + i) + 1);
+        inicio = std::clock();
+        lista += kEsimoEnLista(arbol, k[i]);
+        tiempoLista += segundosDesde(inicio);
+        inicio = std::clock();
+        aumentado += arbol.kth(k[i]);
+        tiempoAumentado += segundosDesde(inicio);
+    }
+    fila("insertBST + kth alternados", lentas, tiempoLista, lentas, tiempoAumentado, lista == aumentado);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <list>
+#include <cstdlib>
+#include <ctime>
+#include "bin_tree.h"
+
+// Prueba de estrés: BinTree con forma de cadena (un nodo por nivel). Con funciones recursivas
+// la pila del proceso se desborda a unos cientos de miles de niveles; aquí nada debe fallar.
+// Uso: ./estres_cadena [nodos]  (por defecto 1e7; necesita unos 2 GB de memoria)
+
+int fallos = 0;
+std::clock_t inicio;
+
+void comprobar(bool condicion, const char* que) {
+    double segundos = (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+    std::cout << (condicion ? "ok    " : "FALLA ") << que << " (" << segundos << " s)" << std::endl;
+    if (!condicion) fallos++;
+    inicio = std::clock();
+}
+
+// Cadena con las claves 0..nodos-1 que sigue siendo un BST: cada nodo es el hijo derecho del
+// anterior (o el izquierdo, con 'izquierda'). Los subárboles se comparten al construir, así
+// que cada paso es O(1) en lugar de recorrer la cadena como lo haría insertBST.
+BinTree<int> cadena(int nodos, bool izquierda) {
+    BinTree<int> arbol, vacio;
+    if (izquierda) {
+        for (int i = 0; i < nodos; i++) arbol = BinTree<int>(i, arbol, vacio);
+    } else {
+        for (int i = nodos - 1; i >= 0; i--) arbol = BinTree<int>(i, vacio, arbol);
+    }
+    return arbol;
+}
+
+void estresDerecha(int n) {
+    std::cout << "== Cadena hacia la derecha, claves 0.." << n - 1 << " ==" << std::endl;
+    inicio = std::clock();
+    BinTree<int> arbol = cadena(n, false);
+    comprobar(arbol.getWeight() == n, "construcción y getWeight");
+    comprobar(arbol.getHeight() == n - 1, "getHeight");
+    {
+        std::list<int> l = arbol.preOrder();
+        comprobar((int)l.size() == n && l.front() == 0 && l.back() == n - 1, "preOrder");
+    }
+    {
+        std::list<int> l = arbol.inOrder();
+        comprobar((int)l.size() == n && l.front() == 0 && l.back() == n - 1, "inOrder");
+    }
+    {
+        std::list<int> l = arbol.postOrder();
+        comprobar((int)l.size() == n && l.front() == n - 1 && l.back() == 0, "postOrder");
+    }
+    {
+        std::list<int> l = arbol.levelOrder();
+        comprobar((int)l.size() == n && l.back() == n - 1, "levelOrder");
+    }
+    {
+        std::list<int> l = arbol.getLeaves();
+        comprobar(l.size() == 1 && l.front() == n - 1, "getLeaves");
+    }
+    {
+        std::list<int> l = arbol.getLevel(n - 1);
+        comprobar(l.size() == 1 && l.front() == n - 1, "getLevel del último nivel");
+    }
+    comprobar(arbol.searchBST(n - 1) && !arbol.searchBST(n), "searchBST hasta el fondo");
+    comprobar(arbol.findPathToNode(n - 1).size() == (size_t)n, "findPathToNode hasta el fondo");
+    comprobar(arbol.getHeightDifference(0, n - 1) == n - 1, "getHeightDifference");
+    comprobar(arbol.getDiameterPath().size() == (size_t)n, "getDiameterPath");
+
+    arbol.insertBST(n);
+    comprobar(arbol.getWeight() == n + 1 && arbol.getHeight() == n, "insertBST al final de la cadena");
+    {
+        // La copia comparte los nodos: insertar en ella copia el camino entero y deja intacto el original
+        BinTree<int> copia = arbol;
+        copia.insertBST(n + 1);
+        comprobar(copia.getHeight() == n + 1 && arbol.getHeight() == n && !arbol.searchBST(n + 1), "insertBST en una copia compartida");
+        copia.removeBST(n + 1);
+        comprobar(copia.getWeight() == n + 1 && copia.inOrder().back() == n, "removeBST al final de la copia");
+    }
+    comprobar(arbol.removeBST(n / 2) && !arbol.searchBST(n / 2) && arbol.getWeight() == n, "removeBST en el medio");
+    comprobar(arbol.removeBST(0) && arbol.getRootInfo() == 1, "removeBST de la raíz");
+    comprobar(arbol.kth(n - 1) == n && arbol.rank(n) == n - 2, "kth y rank");
+    arbol.makeEmpty();
+    comprobar(arbol.isEmpty(), "makeEmpty");
+}
+
+void estresIzquierda(int n) {
+    std::cout << "== Cadena hacia la izquierda, claves 0.." << n - 1 << " ==" << std::endl;
+    inicio = std::clock();
+    BinTree<int> arbol = cadena(n, true);
+    comprobar(arbol.getWeight() == n && arbol.getRootInfo() == n - 1, "construcción");
+    {
+        std::list<int> l = arbol.inOrder();
+        comprobar((int)l.size() == n && l.front() == 0 && l.back() == n - 1, "inOrder");
+    }
+    arbol.insertBST(-1);
+    comprobar(arbol.getHeight() == n && arbol.findPathToNode(-1).size() == (size_t)n + 1, "insertBST y findPathToNode al fondo");
+    comprobar(arbol.lowestCommonAncestor(-1, 0) == 0, "lowestCommonAncestor");
+    {
+        BinTree<int> copia;
+        copia.copyFromPointer(&arbol);
+        comprobar(copia.getWeight() == n + 1, "copyFromPointer");
+    }
+    comprobar(arbol.removeBST(-1) && arbol.getHeight() == n - 1, "removeBST al fondo");
+    // La destrucción al salir también recorre los n niveles
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    if (n < 2) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2]" << std::endl;
+        return 1;
+    }
+    estresDerecha(n);
+    estresIzquierda(n);
+    std::cout << (fallos == 0 ? "Todas las comprobaciones pasaron" : "Hubo comprobaciones fallidas") << std::endl;
+    return fallos == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <list>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include "bin_tree.h"
+#include "n_tree.h"
+#include "tree_stats.h"
+
+// Genera entradas y muestra cuánto cuesta cada operación de los árboles.
+// Uso: ./perfilado [nodos] [alumnos por sección] [semilla]
+
+std::string nombreAlumno(int i) {
+    std::ostringstream ss;
+    ss << "alumno" << i;
+    return ss.str();
+}
+
+void imprimirPerfil(const std::string& titulo) {
+    std::cout << std::endl << "== " << titulo << " ==" << std::endl;
+    TreeStats::get().report(std::cout);
+    TreeStats::get().reset();
+}
+
+// Lo mismo que hace ../main.cpp con una sección: reconstruir el árbol y sumar el MUP entre alumnos
+void perfilSeccion(int nodos, int alumnos) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+
+    BinTree<std::string> generador;
+    for (int i = 0; i < nodos; i++) generador.insertBST(nombreAlumno(claves[i]));
+    std::list<std::string> preorden = generador.preOrder(), inorden = generador.inOrder();
+    TreeStats::get().reset();    // Solo interesa la sección, no el árbol que generó las listas
+
+    BinTree<std::string> seccion;
+    seccion.buildFromPreIn(preorden, inorden);
+    std::list<std::string> lista;
+    for (int i = 0; i < alumnos; i++) lista.push_back(nombreAlumno(std::rand() % nodos));
+
+    long mup = 0;
+    for (std::list<std::string>::iterator i = lista.begin(); i != lista.end(); ++i) {
+        for (std::list<std::string>::iterator j = i; j != lista.end(); ++j) {
+            if (i == j) continue;
+            int distancia = seccion.findPathBetweenNodes(*i, *j).size() - 2;
+            mup += distancia * seccion.getHeightDifference(*i, *j);
+        }
+    }
+    std::cout << std::endl << "MUP de la sección: " << mup;
+    imprimirPerfil("Sección: buildFromPreIn + MUP entre alumnos");
+}
+
+// Inserciones, búsquedas y borrados en un BST aleatorio y en uno degenerado (claves ordenadas)
+void perfilBST(int nodos, bool ordenado) {
+    BinTree<int> arbol;
+    for (int i = 0; i < nodos; i++) arbol.insertBST(ordenado ? i : std::rand() % (4 * nodos));
+    for (int i = 0; i < nodos; i++) arbol.searchBST(std::rand() % (4 * nodos));
+    arbol.getHeight();
+    arbol.getLeaves();
+    std::list<int> inorden = arbol.inOrder();
+    std::vector<int> valores(inorden.begin(), inorden.end());
+    arbol.levelOrder();
+    arbol.getDiameterPath();
+    for (int i = 0; i < 100; i++) arbol.findPathToNode(valores[std::rand() % valores.size()]);
+    for (int i = 0; i < 100; i++) arbol.lowestCommonAncestor(valores[std::rand() % valores.size()], valores[std::rand() % valores.size()]);
+    for (int i = 0; i < nodos / 2; i++) arbol.removeBST(std::rand() % (4 * nodos));
+    imprimirPerfil(ordenado ? "BST degenerado (claves ordenadas)" : "BST aleatorio");
+}
+
+// Árbol N-ario con padres aleatorios armado desde una lista de aristas
+void perfilNTree(int nodos) {
+    std::list< std::pair<int, int> > aristas;
+    for (int i = 1; i < nodos; i++) aristas.push_back(std::make_pair(std::rand() % i, i));
+    NTree<int> arbol(aristas);
+    arbol.getHeight();
+    arbol.getLeaves();
+    arbol.preOrder();
+    arbol.levelOrder();
+    arbol.getDiameterPath();
+    for (int i = 0; i < 100; i++) arbol.findPathToNode(std::rand() % nodos);
+    for (int i = 0; i < 100; i++) arbol.lowestCommonAncestor(std::rand() % nodos, std::rand() % nodos);
+    for (int i = 0; i < 100; i++) arbol.findPathBetweenNodes(std::rand() % nodos, std::rand() % nodos);
+
+    std::list< NTree<int> > hijos;
+    hijos.push_back(NTree<int>(-1));
+    for (int i = 0; i < 100; i++) arbol.attachChildrenToNode(std::rand() % nodos, hijos);
+    NTree<int> copia = arbol;
+    for (int i = 0; i < 100; i++) copia.insertSubtree(NTree<int>(-2));
+    copia.removeSubtree(1);
+    imprimirPerfil("NTree desde aristas");
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int alumnos = argc > 2 ? std::atoi(argv[2]) : 40;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (nodos < 2 || alumnos < 0) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [alumnos por sección] [semilla]" << std::endl;
+        return 1;
+    }
+
+#ifndef TREE_INSTRUMENTATION
+    std::cerr << "Compilar con -DTREE_INSTRUMENTATION (ver makefile) para obtener los contadores" << std::endl;
+#endif
+
+    perfilSeccion(nodos, alumnos);
+    perfilBST(nodos, false);
+    perfilBST(nodos < 5000 ? nodos : 5000, true);   // Con claves ordenadas cada inserción recorre la cadena entera: O(n^2)
+    perfilNTree(nodos);
+    return 0;
+}
@@ -0,0 +1,410 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include "bin_tree.h"
+#include "n_tree.h"
+#include "tree_snapshot.h"
+
+// Pruebas de tree_snapshot.h: guarda árboles, los vuelve a cargar y los compara con el original
+// (convertidos en nodos y consultados en el archivo); después verifica que se rechacen archivos
+// truncados o corruptos. Al final compara el tiempo de carga contra reconstruir desde texto, como
+// hace Arboles/main.cpp con las líneas PREORDEN/INORDEN. Devuelve 1 si alguna prueba falla.
+// Uso: ./prueba_snapshot [nodos] [semilla]
+
+const char* RUTA_SNAPSHOT = "prueba_snapshot.bin";
+const char* RUTA_DANADO = "prueba_snapshot_danado.bin";
+const char* RUTA_TEXTO = "prueba_snapshot.txt";
+
+int fallas = 0;
+
+void verificar(const std::string& prueba, bool correcto) {
+    std::cout << std::left << std::setw(60) << prueba << " " << (correcto ? "ok" : "FALLA") << std::endl;
+    if (!correcto) fallas++;
+}
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+std::string texto(int valor) {
+    std::ostringstream ss;
+    ss << valor;
+    return ss.str();
+}
+
+// --- Árboles de prueba ---
+
+// BST de cadenas con las claves 0..nodos-1 en orden aleatorio (BinTree compara las cadenas)
+BinTree<std::string> bstAleatorio(int nodos) {
+    std::vector<int> claves(nodos);
+    for (int i = 0; i < nodos; i++) claves[i] = i;
+    for (int i = nodos - 1; i > 0; i--) std::swap(claves[i], claves[std::rand() % (i + 1)]);
+    BinTree<std::string> arbol;
+    for (int i = 0; i < nodos; i++) arbol.insertBST(texto(claves[i]));
+    return arbol;
+}
+
+// Forma al azar y valores repetidos: no es un BST, así que solo vale comparar la forma
+BinTree<int> binarioAleatorio(int nodos) {
+    if (nodos == 0) return BinTree<int>();
+    int izquierda = std::rand() % nodos;
+    return BinTree<int>(std::rand() % 10, binarioAleatorio(izquierda), binarioAleatorio(nodos - 1 - izquierda));
+}
+
+// Padre de cada nodo i elegido al azar entre los anteriores
+std::list< std::pair<int, int> > aristasAleatorias(int nodos) {
+    std::list< std::pair<int, int> > aristas;
+    for (int i = 1; i < nodos; i++) aristas.push_back(std::make_pair(std::rand() % i, i));
+    return aristas;
+}
+
+NTree<std::string> narioDeCadenas(const std::list< std::pair<int, int> >& aristas) {
+    std::list< std::pair<std::string, std::string> > conTexto;
+    for (std::list< std::pair<int, int> >::const_iterator it = aristas.begin(); it != aristas.end(); ++it) {
+        conTexto.push_back(std::make_pair(texto(it->first), texto(it->second)));
+    }
+    return NTree<std::string>(conTexto);
+}
+
+// --- Ida y vuelta ---
+
+template <class T>
+bool mismaFormaBinaria(const BinTree<T>& a, const BinTree<T>& b) {
+    return a.preOrder() == b.preOrder() && a.inOrder() == b.inOrder() && a.getWeight() == b.getWeight();
+}
+
+// Los ids del snapshot son el preorden: recorrerlos en el archivo da la misma lista que el árbol
+template <class T>
+bool preordenEnArchivo(const BinTreeSnapshot<T>& snapshot, const BinTree<T>& original) {
+    std::list<T> pre = original.preOrder();
+    int id = 0;
+    for (typename std::list<T>::iterator it = pre.begin(); it != pre.end(); ++it, ++id) {
+        if (!(SnapshotCodec<T>::toElem(snapshot.getInfo(id)) == *it)) return false;
+    }
+    return id == snapshot.getWeight();
+}
+
+template <class T>
+bool preordenEnArchivo(const NTreeSnapshot<T>& snapshot, const NTree<T>& original) {
+    std::list<T> pre = original.preOrder();
+    int id = 0;
+    for (typename std::list<T>::iterator it = pre.begin(); it != pre.end(); ++it, ++id) {
+        if (!(SnapshotCodec<T>::toElem(snapshot.getInfo(id)) == *it)) return false;
+    }
+    return id == snapshot.getWeight();
+}
+
+template <class T>
+void idaYVuelta(const std::string& nombre, const BinTree<T>& original) {
+    BinTreeSnapshot<T>::write(original, RUTA_SNAPSHOT);
+    BinTreeSnapshot<T> snapshot(RUTA_SNAPSHOT);
+    BinTree<T> cargado;
+    snapshot.toBinTree(cargado);
+    verificar(nombre + ": toBinTree igual al original", mismaFormaBinaria(original, cargado));
+    verificar(nombre + ": consultas en el archivo", snapshot.getWeight() == original.getWeight() && preordenEnArchivo(snapshot, original));
+}
+
+template <class T>
+void idaYVuelta(const std::string& nombre, const NTree<T>& original) {
+    NTreeSnapshot<T>::write(original, RUTA_SNAPSHOT);
+    NTreeSnapshot<T> snapshot(RUTA_SNAPSHOT);
+    NTree<T> cargado;
+    snapshot.toNTree(cargado);
+    verificar(nombre + ": toNTree igual al original", original.preOrder() == cargado.preOrder()
+              && original.postOrder() == cargado.postOrder() && original.getWeight() == cargado.getWeight());
+    verificar(nombre + ": consultas en el archivo", snapshot.getWeight() == original.getWeight() && preordenEnArchivo(snapshot, original));
+}
+
+void probarIdaYVuelta(int nodos) {
+    std::cout << std::endl << "== Ida y vuelta ==" << std::endl;
+    idaYVuelta("BinTree<string> vacío", BinTree<std::string>());
+    idaYVuelta("BinTree<string> de un nodo", BinTree<std::string>("raiz"));
+    BinTree<std::string> bst = bstAleatorio(nodos);
+    idaYVuelta("BinTree<string> BST aleatorio", bst);
+    {
+        BinTreeSnapshot<std::string> snapshot(RUTA_SNAPSHOT);
+        bool encontrados = true;
+        for (int i = 0; i < 1000 && encontrados; i++) {
+            std::string clave = texto(std::rand() % nodos);
+            int id = snapshot.searchBST(clave);
+            encontrados = id >= 0 && snapshot.getInfo(id) == clave;
+        }
+        verificar("BinTree<string> BST: searchBST en el archivo", encontrados && snapshot.searchBST("no esta") == -1);
+    }
+    idaYVuelta("BinTree<int> con forma al azar y repetidos", binarioAleatorio(1000));
+
+    std::list< std::pair<int, int> > aristas = aristasAleatorias(nodos);
+    idaYVuelta("NTree<int> vacío", NTree<int>());
+    idaYVuelta("NTree<int> padres aleatorios", NTree<int>(aristas));
+    idaYVuelta("NTree<string> padres aleatorios", narioDeCadenas(aristas));
+}
+
+// --- Archivos dañados ---
+
+std::vector<char> leerArchivo(const char* ruta) {
+    std::ifstream in(ruta, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+void escribirArchivo(const char* ruta, const std::vector<char>& bytes) {
+    std::ofstream out(ruta, std::ios::binary);
+    if (!bytes.empty()) out.write(&bytes[0], bytes.size());
+}
+
+void ponerEntero(std::vector<char>& bytes, size_t posicion, int valor) {
+    std::memcpy(&bytes[posicion * sizeof(int)], &valor, sizeof(int));
+}
+
+// Lee todo lo que el snapshot promete: la estructura completa y cada valor
+template <class T>
+void leerEntero(const BinTreeSnapshot<T>& snapshot) {
+    BinTree<T> arbol;
+    snapshot.toBinTree(arbol);
+    for (int i = 0; i < snapshot.getWeight(); i++) snapshot.getInfo(i);
+}
+
+template <class T>
+void leerEntero(const NTreeSnapshot<T>& snapshot) {
+    NTree<T> arbol;
+    snapshot.toNTree(arbol);
+    for (int i = 0; i < snapshot.getWeight(); i++) snapshot.getInfo(i);
+}
+
+// Un archivo dañado debe fallar con una excepción al cargarlo o al leerlo entero, nunca leer
+// fuera del archivo; una carga fallida deja el snapshot vacío
+template <class Snapshot>
+bool rechazado(const std::vector<char>& bytes) {
+    escribirArchivo(RUTA_DANADO, bytes);
+    Snapshot snapshot;
+    try {
+        snapshot.load(RUTA_DANADO);
+    } catch (const std::exception&) {
+        return snapshot.isEmpty();
+    }
+    try {
+        leerEntero(snapshot);
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// Encabezado de 8 enteros; la estructura empieza en el entero 8 (ver tree_snapshot.h)
+enum { MAGIA, VERSION, TIPO, CODEC, NODOS, ESTRUCTURA, BYTES_VALORES, INICIO_ESTRUCTURA = 8 };
+
+template <class Snapshot>
+void probarDanados(const std::string& nombre, const std::vector<char>& bueno, int enteroDeLaEstructura) {
+    verificar(nombre + ": el archivo sano se carga", !rechazado<Snapshot>(bueno));
+
+    size_t cortes[] = { 0, 3, 8 * sizeof(int) - 1, 8 * sizeof(int), bueno.size() / 2, bueno.size() - 1 };
+    bool truncados = true;
+    for (size_t i = 0; i < sizeof(cortes) / sizeof(cortes[0]); i++) {
+        truncados = truncados && rechazado<Snapshot>(std::vector<char>(bueno.begin(), bueno.begin() + cortes[i]));
+    }
+    verificar(nombre + ": truncado en 6 puntos", truncados);
+
+    std::vector<char> sobra = bueno;
+    sobra.push_back(0);
+    verificar(nombre + ": un byte de más", rechazado<Snapshot>(sobra));
+
+    int campos[] = { MAGIA, VERSION, TIPO, CODEC, NODOS, ESTRUCTURA, BYTES_VALORES };
+    const char* nombres[] = { "magia", "versión", "tipo de árbol", "tipo de valor", "cantidad de nodos", "largo de la estructura", "bytes de valores" };
+    for (int i = 0; i < 7; i++) {
+        std::vector<char> danado = bueno;
+        int valor;
+        std::memcpy(&valor, &danado[campos[i] * sizeof(int)], sizeof(int));
+        ponerEntero(danado, campos[i], valor + 1);
+        verificar(nombre + ": encabezado con " + nombres[i] + " + 1", rechazado<Snapshot>(danado));
+    }
+
+    // Un enlace que apunta a la raíz formaría un ciclo
+    std::vector<char> ciclo = bueno;
+    ponerEntero(ciclo, INICIO_ESTRUCTURA + enteroDeLaEstructura, 0);
+    verificar(nombre + ": enlace de la estructura hacia la raíz", rechazado<Snapshot>(ciclo));
+    std::vector<char> afuera = bueno;
+    ponerEntero(afuera, INICIO_ESTRUCTURA + enteroDeLaEstructura, 1 << 30);
+    verificar(nombre + ": enlace de la estructura fuera de rango", rechazado<Snapshot>(afuera));
+
+    // Tabla de cadenas: el primer desplazamiento de los valores apunta fuera de los caracteres
+    int estructura;
+    std::memcpy(&estructura, &bueno[ESTRUCTURA * sizeof(int)], sizeof(int));
+    size_t bytesEstructura = estructura * sizeof(int);
+    size_t valores = (INICIO_ESTRUCTURA * sizeof(int) + bytesEstructura + (8 - bytesEstructura % 8) % 8) / sizeof(int);
+    std::vector<char> tabla = bueno;
+    ponerEntero(tabla, valores + 1, 1 << 30);
+    verificar(nombre + ": tabla de cadenas corrupta", rechazado<Snapshot>(tabla));
+
+    // Bytes al azar en cualquier parte: puede quedar válido (un valor cambiado), pero nunca debe
+    // romper el programa; el sanitizador de direcciones es quien lo verifica de verdad
+    for (int i = 0; i < 200; i++) {
+        std::vector<char> ruido = bueno;
+        for (int j = 0; j < 4; j++) ruido[std::rand() % ruido.size()] = (char)std::rand();
+        rechazado<Snapshot>(ruido);
+    }
+    verificar(nombre + ": 200 archivos con bytes al azar sin romperse", true);
+}
+
+void probarArchivosDanados() {
+    std::cout << std::endl << "== Archivos dañados ==" << std::endl;
+    BinTreeSnapshot<std::string>::write(bstAleatorio(200), RUTA_SNAPSHOT);
+    std::vector<char> binario = leerArchivo(RUTA_SNAPSHOT);
+    // left[0] es el primer entero de la estructura binaria
+    probarDanados< BinTreeSnapshot<std::string> >("BinTree<string>", binario, 0);
+    verificar("BinTree<string> cargado como NTree", rechazado< NTreeSnapshot<std::string> >(binario));
+    verificar("BinTree<string> cargado como BinTree<int>", rechazado< BinTreeSnapshot<int> >(binario));
+
+    NTreeSnapshot<std::string>::write(narioDeCadenas(aristasAleatorias(200)), RUTA_SNAPSHOT);
+    std::vector<char> nario = leerArchivo(RUTA_SNAPSHOT);
+    // childIndex[0] va después de los n tamaños de subárbol y los n + 1 desplazamientos
+    probarDanados< NTreeSnapshot<std::string> >("NTree<string>", nario, 2 * 200 + 1);
+
+    verificar("archivo inexistente", rechazado< BinTreeSnapshot<int> >(std::vector<char>()) && std::remove(RUTA_DANADO) == 0
+              && rechazado< BinTreeSnapshot<int> >(std::vector<char>()));
+}
+
+// --- Tiempo de carga ---
+
+void fila(const std::string& caso, int nodos, double textoSegundos, double convertir, double enArchivo) {
+    std::cout << std::left << std::setw(10) << caso << std::right << std::setw(9) << nodos << std::fixed << std::setprecision(4)
+              << std::setw(12) << textoSegundos << std::setw(14) << convertir << std::setw(14) << enArchivo
+              << std::setw(10) << std::setprecision(1) << textoSegundos / (convertir > 0 ? convertir : 1e-6) << "x" << std::endl;
+}
+
+// Texto como el de entrada.txt: una línea PREORDEN y otra INORDEN, reconstruidas con buildFromPreIn
+void medirBinTree(int nodos) {
+    BinTree<std::string> original = bstAleatorio(nodos);
+    {
+        std::ofstream out(RUTA_TEXTO);
+        std::list<std::string> pre = original.preOrder(), in = original.inOrder();
+        out << "PREORDEN";
+        for (std::list<std::string>::iterator it = pre.begin(); it != pre.end(); ++it) out << " " << *it;
+        out << std::endl << "INORDEN";
+        for (std::list<std::string>::iterator it = in.begin(); it != in.end(); ++it) out << " " << *it;
+        out << std::endl;
+    }
+    BinTreeSnapshot<std::string>::write(original, RUTA_SNAPSHOT);
+
+    std::clock_t inicio = std::clock();
+    BinTree<std::string> desdeTexto;
+    {
+        std::ifstream in(RUTA_TEXTO);
+        std::string linea, orden, valor;
+        std::list<std::string> pre, ino;
+        std::getline(in, linea);
+        std::istringstream ss1(linea);
+        ss1 >> orden;
+        while (ss1 >> valor) pre.push_back(valor);
+        std::getline(in, linea);
+        std::istringstream ss2(linea);
+        ss2 >> orden;
+        while (ss2 >> valor) ino.push_back(valor);
+        desdeTexto.buildFromPreIn(pre, ino);
+    }
+    double textoSegundos = segundosDesde(inicio);
+
+    inicio = std::clock();
+    BinTree<std::string> desdeSnapshot;
+    {
+        BinTreeSnapshot<std::string> snapshot(RUTA_SNAPSHOT);
+        snapshot.toBinTree(desdeSnapshot);
+    }
+    double convertir = segundosDesde(inicio);
+
+    // Abrir y buscar 1000 claves sin armar nodos
+    inicio = std::clock();
+    int encontradas = 0;
+    {
+        BinTreeSnapshot<std::string> snapshot(RUTA_SNAPSHOT);
+        for (int i = 0; i < 1000; i++) encontradas += snapshot.searchBST(texto(i % nodos)) >= 0;
+    }
+    double enArchivo = segundosDesde(inicio);
+    fila("BinTree", nodos, textoSegundos, convertir, enArchivo);
+    if (!mismaFormaBinaria(desdeTexto, original) || !mismaFormaBinaria(desdeSnapshot, original) || encontradas != 1000) {
+        verificar("BinTree: los tres caminos dan el mismo árbol", false);
+    }
+}
+
+// Texto con una arista "padre hijo" por línea, reconstruido con el constructor de aristas
+void medirNTree(int nodos) {
+    std::list< std::pair<int, int> > aristas = aristasAleatorias(nodos);
+    NTree<std::string> original = narioDeCadenas(aristas);
+    {
+        std::ofstream out(RUTA_TEXTO);
+        for (std::list< std::pair<int, int> >::iterator it = aristas.begin(); it != aristas.end(); ++it) {
+            out << it->first << " " << it->second << std::endl;
+        }
+    }
+    NTreeSnapshot<std::string>::write(original, RUTA_SNAPSHOT);
+
+    std::clock_t inicio = std::clock();
+    NTree<std::string> desdeTexto;
+    {
+        std::ifstream in(RUTA_TEXTO);
+        std::list< std::pair<std::string, std::string> > leidas;
+        std::string padre, hijo;
+        while (in >> padre >> hijo) leidas.push_back(std::make_pair(padre, hijo));
+        desdeTexto = NTree<std::string>(leidas);
+    }
+    double textoSegundos = segundosDesde(inicio);
+
+    inicio = std::clock();
+    NTree<std::string> desdeSnapshot;
+    {
+        NTreeSnapshot<std::string> snapshot(RUTA_SNAPSHOT);
+        snapshot.toNTree(desdeSnapshot);
+    }
+    double convertir = segundosDesde(inicio);
+
+    // Abrir y bajar por el primer hijo hasta una hoja
+    inicio = std::clock();
+    int niveles = 0;
+    {
+        NTreeSnapshot<std::string> snapshot(RUTA_SNAPSHOT);
+        for (int nodo = 0; snapshot.childCount(nodo) > 0; nodo = snapshot.getChild(nodo, 1)) niveles++;
+    }
+    double enArchivo = segundosDesde(inicio);
+    fila("NTree", nodos, textoSegundos, convertir, enArchivo);
+    // El primer hijo de cada nodo es la primera arista que sale de él
+    std::vector<int> primerHijo(nodos, -1);
+    for (std::list< std::pair<int, int> >::reverse_iterator it = aristas.rbegin(); it != aristas.rend(); ++it) primerHijo[it->first] = it->second;
+    int esperados = 0;
+    for (int nodo = 0; primerHijo[nodo] >= 0; nodo = primerHijo[nodo]) esperados++;
+    if (desdeTexto.preOrder() != original.preOrder() || desdeSnapshot.preOrder() != original.preOrder() || niveles != esperados) {
+        verificar("NTree: los tres caminos dan el mismo árbol", false);
+    }
+}
+
+void medirCarga(int nodos) {
+    std::cout << std::endl << "== Tiempo de carga (s) ==" << std::endl;
+    std::cout << std::left << std::setw(10) << "árbol" << std::right << std::setw(9) << "nodos" << std::setw(12) << "texto"
+              << std::setw(14) << "snapshot" << std::setw(14) << "en archivo" << std::setw(11) << "mejora" << std::endl;
+    for (int n = nodos / 100 > 0 ? nodos / 100 : 1; n <= nodos; n *= 10) {
+        medirBinTree(n);
+        medirNTree(n);
+    }
+}
+
+int main(int argc, char** argv) {
+    int nodos = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (nodos < 2) {
+        std::cerr << "Uso: " << argv[0] << " [nodos >= 2] [semilla]" << std::endl;
+        return 1;
+    }
+    probarIdaYVuelta(nodos);
+    probarArchivosDanados();
+    medirCarga(nodos);
+    std::remove(RUTA_SNAPSHOT);
+    std::remove(RUTA_DANADO);
+    std::remove(RUTA_TEXTO);
+    std::cout << std::endl << (fallas == 0 ? "Todas las pruebas pasaron" : "Hay pruebas que fallaron") << std::endl;
+    return fallas == 0 ? 0 : 1;
+}
@@ -4,13 +4,21 @@
 #define BIN_TREE_H_
 
 #include "node_bin_tree.h"
+#include "bin_tree_iterator.h"
+#include "node_arena.h"
+#include "tree_parallel.h"
+#include "tree_stats.h"
 #include <iostream>
 #include <list>
 #include <queue>
+#include <stack>
+#include <utility>
 #include <cstddef>
 #include <stdexcept>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <iterator>
 
 // Maldito edwin que fue ese push chimbo?
 
@@ -23,16 +31,49 @@
 // Perdón seba :,( fue edwin te lo juro
 
 template <class elem> class BinTree;
+template <class elem> class BinTreeSnapshot;
 
 template <class elem>
 class BinTree{
+    friend class BinTreeSnapshot<elem>; // Writes and rebuilds the nodes directly
+
 private:
     NodeBinTree<elem> *root;
-    int weight;
-
-    NodeBinTree<elem>* COPY_NODES(const NodeBinTree<elem>* sourceNode) const;
-    void DESTROY_NODES(NodeBinTree<elem>* node);
-    int COUNT_NODES(const NodeBinTree<elem>* node) const;
+    mutable int weight; // -1 while unknown (after taking a shared subtree); getWeight reads the root's subtree size
+
+    // Nodes are reference counted and may be shared with other trees: copies and subtree
+    // extraction share instead of copying, and every mutation copies the shared nodes on
+    // its root-to-node path before writing (copy-on-write).
+
+    // Optional node storage (see enableArena). Arena nodes are never shared with another
+    // tree, since CLEAR drops the whole arena at once; they are copied instead.
+    NodeArena< NodeBinTree<elem> >* arena;
+
+    // Level index: every value in BFS order plus the offset where each level starts.
+    // Rebuilt lazily after any mutation, so getLevel is a slice copy in O(width).
+    mutable std::vector<elem> levelValues;
+    mutable std::vector<int> levelOffsets;
+    mutable bool levelIndexValid;
+
+    struct DiameterFrame {
+        NodeBinTree<elem>* node;
+        int stage;
+        int leftHeight;
+        int rightHeight;
+        DiameterFrame(NodeBinTree<elem>* n) : node(n), stage(0), leftHeight(-1), rightHeight(-1) {}
+    };
+
+    NodeBinTree<elem>* NEW_NODE(const elem& value); // Every node is allocated through here...
+    void FREE_NODE(NodeBinTree<elem>* node); // ...and freed through here
+    NodeBinTree<elem>* COPY_NODES(const NodeBinTree<elem>* sourceNode); // Deep copy into this tree's storage
+    void FREE_ALL(NodeBinTree<elem>* node); // Frees a whole tree; O(1) on an arena of trivially destructible elem
+    NodeBinTree<elem>* SHARE(NodeBinTree<elem>* node) const;
+    NodeBinTree<elem>* SHARE_FROM(const BinTree<elem>& owner, NodeBinTree<elem>* node); // SHARE, or COPY_NODES if an arena is involved
+    NodeBinTree<elem>* UNSHARE_NODE(NodeBinTree<elem>* node); // Private copy of a shared node, sharing its children
+    void DESTROY_NODES(NodeBinTree<elem>* node); // Drops one reference, freeing whatever no other tree uses
+    int SIZE(const NodeBinTree<elem>* node) const; // 0 for NULL
+    void UPDATE_SIZE(NodeBinTree<elem>* node) const; // After relinking node's children
+    int COUNT_BELOW(const elem& value, bool orEqual) const; // Values < value (<= with orEqual), in BST order
     void PRE_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const;
     void IN_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const;
     void POST_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const;
@@ -40,8 +81,12 @@ private:
     void GET_HEIGHT(NodeBinTree<elem>* node, int currentLevel, int& maxLevelReached) const;
     void GET_LEAVES(NodeBinTree<elem>* node, std::list<elem>& leafList) const;
     void CLEAR();
+    void INVALIDATE_CACHES();
+    void BUILD_LEVEL_INDEX() const;
     NodeBinTree<elem>* BUILD_FROM_PRE_IN_RECURSIVE(std::list<elem>& preOrderList, std::list<elem>& inOrderList);
     NodeBinTree<elem>* BUILD_FROM_POST_IN_RECURSIVE(std::list<elem>& postOrderList, std::list<elem>& inOrderList);
+    NodeBinTree<elem>* BUILD_BALANCED(const std::vector<elem>& sortedValues, int from, int to); // Middle of [from, to) as the root
+    void SORTED_VALUES(std::vector<elem>& values) const; // In-order into a vector
     void INSERT_BST(NodeBinTree<elem>* &node, const elem& value);
     bool SEARCH_BST(const NodeBinTree<elem>* node, const elem& value) const;
     NodeBinTree<elem>* FIND_MIN(NodeBinTree<elem>* node) const;
@@ -49,8 +94,8 @@ private:
     void FIND_PATH(NodeBinTree<elem>* node, std::list<elem>& currentPath, const elem& target, bool& found) const;
     void FIND_PATHS_TO_TWO(NodeBinTree<elem>* node, std::list<elem>& path1, std::list<elem>& path2, const elem& target1, const elem& target2, bool& found1, bool& found2) const;
     void COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> path1, std::list<elem> path2) const;
-    void UPDATE_LONGEST_PATH(std::list<elem>& currentLongest, std::list<elem>& path1, std::list<elem>& path2, const std::list<elem>& newBranch) const;
-    void FIND_DIAMETER(NodeBinTree<elem>* node, std::list<elem>& currentLongestPath, std::list<elem>& longestBranch1, std::list<elem>& longestBranch2, std::list<elem>& currentBranch) const;
+    int FIND_DIAMETER_APEX(NodeBinTree<elem>* node, NodeBinTree<elem>*& apex) const;
+    void DEEPEST_BRANCH(NodeBinTree<elem>* node, std::list<elem>& branch) const;
     int GET_NODE_LEVEL(NodeBinTree<elem>* node, const elem& target, int currentLevel) const;
 
 public:
@@ -65,6 +110,10 @@ public:
 
     bool isEmpty() const;
     void makeEmpty();
+
+    void enableArena(); // Moves the nodes into a per-tree arena: few large allocations, O(1) makeEmpty for arithmetic elem.
+    void disableArena(); // Moves the nodes back to individual heap allocations.
+    bool usesArena() const;
     int getWeight() const;
     elem getRootInfo() const;
 
@@ -76,17 +125,48 @@ public:
     std::list<elem> postOrder() const;
     std::list<elem> levelOrder() const;
     std::list<elem> getLevel(int level) const;
+    TreeRange<typename std::vector<elem>::const_iterator> getLevelSlice(int level) const;
+
+    typedef BinTreeIterator<elem> const_iterator;
+    const_iterator begin() const;
+    const_iterator begin(TreeTraversal order, int level = 0) const;
+    const_iterator end() const;
+    TreeRange<const_iterator> traverse(TreeTraversal order, int level = 0) const;
 
     int getHeight() const;
     std::list<elem> getLeaves() const;
 
+    // Bottom-up reduction with a folder from tree_parallel.h (count, height, sum, leaves, path)
+    // or a custom one; subtrees below cutoffDepth run as parallel tasks when built with TREE_PARALLEL.
+    template <class Folder>
+    typename Folder::Result fold(const Folder& folder, int cutoffDepth = -1) const;
+
     void insertBST(const elem& value);
     bool searchBST(const elem& value) const;
     bool removeBST(const elem& value);
 
+    // Order statistics for a tree in BST order, O(height) from the subtree sizes kept in every node
+    int countRange(const elem& low, const elem& high) const; // Values in [low, high]
+    elem kth(int k) const; // k-th smallest, 1-based; throws out_of_range
+    int rank(const elem& value) const; // Values smaller than value, so kth(rank(v) + 1) == v when v is present
+    bool lowerBound(const elem& value, elem& result) const; // Smallest value >= value
+    bool predecessor(const elem& value, elem& result) const; // Largest value < value
+    bool successor(const elem& value, elem& result) const; // Smallest value > value
+    template <class OutputIterator>
+    OutputIterator rangeCollect(const elem& low, const elem& high, OutputIterator out) const; // Values in [low, high] in order; O(height + output)
+
     void buildFromPreIn(std::list<elem> preOrderList, std::list<elem> inOrderList);
     void buildFromPostIn(std::list<elem> postOrderList, std::list<elem> inOrderList);
 
+    // Bulk loading and set operations in BST order. The keys are sorted (on threads with
+    // TREE_PARALLEL) and linked into a perfectly balanced tree in O(n); equal keys may end up
+    // on either side of each other, which every BST operation above allows.
+    template <class Iterator>
+    void buildBalancedBST(Iterator first, Iterator last);
+    BinTree<elem> unionBST(const BinTree<elem>& other) const; // Multiset semantics of std::set_union, O(n + m)
+    BinTree<elem> intersectionBST(const BinTree<elem>& other) const; // Same for std::set_intersection
+    BinTree<elem> differenceBST(const BinTree<elem>& other) const; // Same for std::set_difference
+
     std::list<elem> findPathToNode(const elem& target) const;
     std::list<elem> findPathBetweenNodes(const elem& value1, const elem& value2) const;
     elem lowestCommonAncestor(const elem& value1, const elem& value2) const;
@@ -95,53 +175,153 @@ public:
 };
 
 template <class elem>
-NodeBinTree<elem>* BinTree<elem>::COPY_NODES(const NodeBinTree<elem>* sourceNode) const{
+NodeBinTree<elem>* BinTree<elem>::NEW_NODE(const elem& value) {
+    TREE_STAT_ALLOCATION();
+    if (this->arena == NULL) return new NodeBinTree<elem>(value);
+    return new (this->arena->allocate()) NodeBinTree<elem>(value);
+}
+
+template <class elem>
+void BinTree<elem>::FREE_NODE(NodeBinTree<elem>* node) {
+    if (this->arena == NULL) {
+        delete node;
+    } else {
+        node->~NodeBinTree<elem>();
+        this->arena->deallocate(node);
+    }
+}
+
+template <class elem>
+NodeBinTree<elem>* BinTree<elem>::COPY_NODES(const NodeBinTree<elem>* sourceNode) {
     if (sourceNode == NULL) return NULL;
-    NodeBinTree<elem>* newNode = new NodeBinTree<elem>(sourceNode->getInfo());
-    newNode->setLeft(COPY_NODES(sourceNode->getLeft()));
-    newNode->setRight(COPY_NODES(sourceNode->getRight()));
-    return newNode;
+    NodeBinTree<elem>* newRoot = NEW_NODE(sourceNode->getInfo());
+    std::stack< std::pair<const NodeBinTree<elem>*, NodeBinTree<elem>*> > s;
+    s.push(std::make_pair(sourceNode, newRoot));
+    while (!s.empty()) {
+        const NodeBinTree<elem>* source = s.top().first;
+        NodeBinTree<elem>* copy = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        copy->setSize(source->getSize());
+        if (source->getLeft() != NULL) {
+            copy->setLeft(NEW_NODE(source->getLeft()->getInfo()));
+            s.push(std::make_pair((const NodeBinTree<elem>*)source->getLeft(), copy->getLeft()));
+        }
+        if (source->getRight() != NULL) {
+            copy->setRight(NEW_NODE(source->getRight()->getInfo()));
+            s.push(std::make_pair((const NodeBinTree<elem>*)source->getRight(), copy->getRight()));
+        }
+    }
+    return newRoot;
+}
+
+template <class elem>
+void BinTree<elem>::FREE_ALL(NodeBinTree<elem>* node) {
+    // Arena nodes belong to this tree alone, so with nothing to destroy the arena just rewinds
+    if (this->arena == NULL || !TrivialDestructor<elem>::value) DESTROY_NODES(node);
+    if (this->arena != NULL) this->arena->reset();
+}
+
+template <class elem>
+NodeBinTree<elem>* BinTree<elem>::SHARE_FROM(const BinTree<elem>& owner, NodeBinTree<elem>* node) {
+    if (this->arena != NULL || owner.arena != NULL) return COPY_NODES(node);
+    return SHARE(node);
+}
+
+template <class elem>
+NodeBinTree<elem>* BinTree<elem>::SHARE(NodeBinTree<elem>* node) const {
+    if (node != NULL) node->retain();
+    return node;
+}
+
+template <class elem>
+NodeBinTree<elem>* BinTree<elem>::UNSHARE_NODE(NodeBinTree<elem>* node) {
+    // The caller's link moves to the copy; the caller has already made the parent private
+    if (node == NULL || node->getRefCount() == 1) return node;
+    NodeBinTree<elem>* copy = NEW_NODE(node->getInfo());
+    copy->setLeft(SHARE(node->getLeft()));
+    copy->setRight(SHARE(node->getRight()));
+    copy->setSize(node->getSize());
+    node->release();
+    return copy;
 }
 
 template <class elem>
 void BinTree<elem>::DESTROY_NODES(NodeBinTree<elem>* node) {
-    if (node != NULL) {
-        DESTROY_NODES(node->getLeft());
-        DESTROY_NODES(node->getRight());
-        delete node;
+    // Rotate left children up until the current node has none, then delete it: O(1) extra space.
+    // Nodes claimed by this loop drop to refCount 0; a child still used elsewhere is only released.
+    if (node == NULL || !node->release()) return;
+    while (node != NULL) {
+        TREE_STAT_VISIT();
+        NodeBinTree<elem>* left = node->getLeft();
+        if (left != NULL) {
+            if (left->release()) {
+                node->setLeft(left->getRight());
+                left->setRight(node);
+                node = left;
+            } else {
+                node->setLeft(NULL);
+            }
+        } else {
+            NodeBinTree<elem>* right = node->getRight();
+            FREE_NODE(node);
+            if (right != NULL && right->getRefCount() > 0 && !right->release()) right = NULL;
+            node = right;
+        }
     }
 }
 
 template <class elem>
-int BinTree<elem>::COUNT_NODES(const NodeBinTree<elem>* node) const {
-    if (node == NULL) return 0;
-    return 1 + COUNT_NODES(node->getLeft()) + COUNT_NODES(node->getRight());
+int BinTree<elem>::SIZE(const NodeBinTree<elem>* node) const {
+    return (node == NULL) ? 0 : node->getSize();
+}
+
+template <class elem>
+void BinTree<elem>::UPDATE_SIZE(NodeBinTree<elem>* node) const {
+    node->setSize(1 + SIZE(node->getLeft()) + SIZE(node->getRight()));
+}
+
+template <class elem>
+int BinTree<elem>::COUNT_BELOW(const elem& value, bool orEqual) const {
+    int count = 0;
+    for (const NodeBinTree<elem>* node = this->root; node != NULL; ) {
+        TREE_STAT_VISIT();
+        if (TREE_STAT_COMPARE(node->getInfo() < value) || (orEqual && !TREE_STAT_COMPARE(value < node->getInfo()))) {
+            count += SIZE(node->getLeft()) + 1;
+            node = node->getRight();
+        } else {
+            node = node->getLeft();
+        }
+    }
+    return count;
 }
 
+// PRE_ORDER, IN_ORDER and POST_ORDER walk with the iterator's explicit stack. Morris threading
+// is not an option: it writes through right pointers, and with copy-on-write a node can be
+// reached twice within one tree (e.g. BinTree(e, t, t)) or be in use by another tree.
+
 template <class elem>
 void BinTree<elem>::PRE_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const {
-    if (node != NULL) {
-        resultList.push_back(node->getInfo());
-        PRE_ORDER(node->getLeft(), resultList);
-        PRE_ORDER(node->getRight(), resultList);
+    for (const_iterator it(node, TRAVERSE_PRE_ORDER); it != end(); ++it) {
+        TREE_STAT_VISIT();
+        resultList.push_back(*it);
     }
 }
 
 template <class elem>
 void BinTree<elem>::IN_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const {
-     if (node != NULL) {
-        IN_ORDER(node->getLeft(), resultList);
-        resultList.push_back(node->getInfo());
-        IN_ORDER(node->getRight(), resultList);
+    for (const_iterator it(node, TRAVERSE_IN_ORDER); it != end(); ++it) {
+        TREE_STAT_VISIT();
+        resultList.push_back(*it);
     }
 }
 
 template <class elem>
 void BinTree<elem>::POST_ORDER(NodeBinTree<elem>* node, std::list<elem>& resultList) const {
-     if (node != NULL) {
-        POST_ORDER(node->getLeft(), resultList);
-        POST_ORDER(node->getRight(), resultList);
-        resultList.push_back(node->getInfo());
+    for (const_iterator it(node, TRAVERSE_POST_ORDER); it != end(); ++it) {
+        TREE_STAT_VISIT();
+        resultList.push_back(*it);
     }
 }
 
@@ -152,6 +332,7 @@ void BinTree<elem>::LEVEL_ORDER_HELPER(NodeBinTree<elem>* node, std::list<elem>&
     q.push(node);
     while (!q.empty()) {
         NodeBinTree<elem>* current = q.front();
+        TREE_STAT_VISIT();
         q.pop();
         resultList.push_back(current->getInfo());
         if (current->getLeft() != NULL) q.push(current->getLeft());
@@ -161,41 +342,92 @@ void BinTree<elem>::LEVEL_ORDER_HELPER(NodeBinTree<elem>* node, std::list<elem>&
 
 template <class elem>
 void BinTree<elem>::GET_HEIGHT(NodeBinTree<elem>* node, int currentLevel, int& maxLevelReached) const {
-      if (node != NULL) {
-        if (currentLevel > maxLevelReached) maxLevelReached = currentLevel;
-        GET_HEIGHT(node->getLeft(), currentLevel + 1, maxLevelReached);
-        GET_HEIGHT(node->getRight(), currentLevel + 1, maxLevelReached);
+    if (node == NULL) return;
+    std::stack< std::pair<NodeBinTree<elem>*, int> > s;
+    s.push(std::make_pair(node, currentLevel));
+    while (!s.empty()) {
+        NodeBinTree<elem>* current = s.top().first;
+        int level = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        if (level > maxLevelReached) maxLevelReached = level;
+        if (current->getRight() != NULL) s.push(std::make_pair(current->getRight(), level + 1));
+        if (current->getLeft() != NULL) s.push(std::make_pair(current->getLeft(), level + 1));
     }
 }
 
 template <class elem>
 void BinTree<elem>::GET_LEAVES(NodeBinTree<elem>* node, std::list<elem>& leafList) const {
-     if (node != NULL) {
-        if (node->getLeft() == NULL && node->getRight() == NULL) {
-            leafList.push_back(node->getInfo());
+    if (node == NULL) return;
+    std::stack<NodeBinTree<elem>*> s;
+    s.push(node);
+    while (!s.empty()) {
+        NodeBinTree<elem>* current = s.top();
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        if (current->getLeft() == NULL && current->getRight() == NULL) {
+            leafList.push_back(current->getInfo());
         } else {
-            GET_LEAVES(node->getLeft(), leafList);
-            GET_LEAVES(node->getRight(), leafList);
+            if (current->getRight() != NULL) s.push(current->getRight());
+            if (current->getLeft() != NULL) s.push(current->getLeft());
         }
     }
 }
 
 template <class elem>
 void BinTree<elem>::CLEAR() {
-    DESTROY_NODES(root);
+    FREE_ALL(root);
     this->root = NULL;
     this->weight = 0;
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+void BinTree<elem>::INVALIDATE_CACHES() {
+    this->levelIndexValid = false;
+}
+
+template <class elem>
+void BinTree<elem>::BUILD_LEVEL_INDEX() const {
+    // BFS over a vector of nodes: the vector itself is the queue, and a level ends
+    // where the previous level's children stopped being appended
+    std::vector<NodeBinTree<elem>*> order;
+    levelValues.clear();
+    levelOffsets.clear();
+    if (this->root != NULL) {
+        order.reserve(this->weight > 0 ? this->weight : 1);
+        order.push_back(this->root);
+        levelOffsets.push_back(0);
+        size_t levelEnd = 1;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i == levelEnd) {
+                levelOffsets.push_back((int)i);
+                levelEnd = order.size();
+            }
+            TREE_STAT_VISIT();
+            if (order[i]->getLeft() != NULL) order.push_back(order[i]->getLeft());
+            if (order[i]->getRight() != NULL) order.push_back(order[i]->getRight());
+        }
+        levelValues.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) levelValues.push_back(order[i]->getInfo());
+    }
+    levelOffsets.push_back((int)levelValues.size());
+    levelIndexValid = true;
 }
 
 template <class elem>
 NodeBinTree<elem>* BinTree<elem>::BUILD_FROM_PRE_IN_RECURSIVE(std::list<elem>& preOrderList, std::list<elem>& inOrderList) {
+    TREE_STAT_RECURSION();
      if (preOrderList.empty() || inOrderList.empty()) return NULL;
+    TREE_STAT_VISIT();
     elem rootInfo = preOrderList.front();
     preOrderList.pop_front();
-    NodeBinTree<elem>* newNode = new NodeBinTree<elem>(rootInfo);
+    NodeBinTree<elem>* newNode = NEW_NODE(rootInfo);
     std::list<elem> leftInOrder, rightInOrder, leftPreOrder;
     typename std::list<elem>::iterator it = inOrderList.begin();
-    while (it != inOrderList.end() && *it != rootInfo) leftInOrder.push_back(*it++);
+    while (it != inOrderList.end() && TREE_STAT_COMPARE(*it != rootInfo)) leftInOrder.push_back(*it++);
     if (it != inOrderList.end()) it++;
     while (it != inOrderList.end()) rightInOrder.push_back(*it++);
     int leftSize = leftInOrder.size();
@@ -205,18 +437,21 @@ NodeBinTree<elem>* BinTree<elem>::BUILD_FROM_PRE_IN_RECURSIVE(std::list<elem>& p
     std::list<elem>& rightPreOrder = preOrderList;
     newNode->setLeft(BUILD_FROM_PRE_IN_RECURSIVE(leftPreOrder, leftInOrder));
     newNode->setRight(BUILD_FROM_PRE_IN_RECURSIVE(rightPreOrder, rightInOrder));
+    UPDATE_SIZE(newNode);
     return newNode;
 }
 
 template <class elem>
 NodeBinTree<elem>* BinTree<elem>::BUILD_FROM_POST_IN_RECURSIVE(std::list<elem>& postOrderList, std::list<elem>& inOrderList) {
+    TREE_STAT_RECURSION();
      if (postOrderList.empty() || inOrderList.empty()) return NULL;
+    TREE_STAT_VISIT();
     elem rootInfo = postOrderList.back();
     postOrderList.pop_back();
-    NodeBinTree<elem>* newNode = new NodeBinTree<elem>(rootInfo);
+    NodeBinTree<elem>* newNode = NEW_NODE(rootInfo);
     std::list<elem> leftInOrder, rightInOrder, leftPostOrder, rightPostOrder;
     typename std::list<elem>::iterator it = inOrderList.begin();
-    while (it != inOrderList.end() && *it != rootInfo) leftInOrder.push_back(*it++);
+    while (it != inOrderList.end() && TREE_STAT_COMPARE(*it != rootInfo)) leftInOrder.push_back(*it++);
     if (it != inOrderList.end()) it++;
     while (it != inOrderList.end()) rightInOrder.push_back(*it++);
     int leftSize = leftInOrder.size();
@@ -225,42 +460,74 @@ NodeBinTree<elem>* BinTree<elem>::BUILD_FROM_POST_IN_RECURSIVE(std::list<elem>&
     while(postIt != postOrderList.end()) rightPostOrder.push_back(*postIt++);
     newNode->setRight(BUILD_FROM_POST_IN_RECURSIVE(rightPostOrder, rightInOrder));
     newNode->setLeft(BUILD_FROM_POST_IN_RECURSIVE(leftPostOrder, leftInOrder));
+    UPDATE_SIZE(newNode);
+    return newNode;
+}
+
+template <class elem>
+NodeBinTree<elem>* BinTree<elem>::BUILD_BALANCED(const std::vector<elem>& sortedValues, int from, int to) {
+    TREE_STAT_RECURSION();
+    if (from >= to) return NULL;
+    TREE_STAT_VISIT();
+    int middle = from + (to - from) / 2;
+    NodeBinTree<elem>* newNode = NEW_NODE(sortedValues[middle]);
+    newNode->setLeft(BUILD_BALANCED(sortedValues, from, middle));
+    newNode->setRight(BUILD_BALANCED(sortedValues, middle + 1, to));
+    UPDATE_SIZE(newNode);
     return newNode;
 }
 
+template <class elem>
+void BinTree<elem>::SORTED_VALUES(std::vector<elem>& values) const {
+    values.reserve(values.size() + SIZE(this->root));
+    for (const_iterator it(this->root, TRAVERSE_IN_ORDER); it != end(); ++it) {
+        TREE_STAT_VISIT();
+        values.push_back(*it);
+    }
+}
+
 template <class elem>
 void BinTree<elem>::INSERT_BST(NodeBinTree<elem>* &node, const elem& value) {
+    // Walks down making the path private; every node on it gains exactly one descendant
     if (node == NULL) {
-         node = new NodeBinTree<elem>(value);
-         this->weight++;
-    } else if (value < node->getInfo()) {
-        NodeBinTree<elem>* leftChild = node->getLeft();
-        INSERT_BST(leftChild, value);
-        node->setLeft(leftChild);
-    } else {
-        NodeBinTree<elem>* rightChild = node->getRight();
-        INSERT_BST(rightChild, value);
-        node->setRight(rightChild);
+        node = NEW_NODE(value);
+        if (this->weight >= 0) this->weight++;
+        return;
+    }
+    node = UNSHARE_NODE(node);
+    NodeBinTree<elem>* current = node;
+    int depth = 0;
+    while (true) {
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(++depth);
+        current->setSize(current->getSize() + 1);
+        bool goLeft = TREE_STAT_COMPARE(value < current->getInfo());
+        NodeBinTree<elem>* child = goLeft ? current->getLeft() : current->getRight();
+        bool isNew = (child == NULL);
+        child = isNew ? NEW_NODE(value) : UNSHARE_NODE(child);
+        if (goLeft) current->setLeft(child);
+        else current->setRight(child);
+        if (isNew) break;
+        current = child;
     }
+    if (this->weight >= 0) this->weight++;
 }
 
 template <class elem>
 bool BinTree<elem>::SEARCH_BST(const NodeBinTree<elem>* node, const elem& value) const {
-     if (node == NULL) {
-        return false;
-    } else if (value == node->getInfo()) {
-        return true;
-    } else if (value < node->getInfo()) {
-        return SEARCH_BST(node->getLeft(), value);
-    } else {
-        return SEARCH_BST(node->getRight(), value);
+    while (node != NULL) {
+        TREE_STAT_VISIT();
+        if (TREE_STAT_COMPARE(value == node->getInfo())) return true;
+        node = TREE_STAT_COMPARE(value < node->getInfo()) ? node->getLeft() : node->getRight();
     }
+    return false;
 }
 
 template <class elem>
 NodeBinTree<elem>* BinTree<elem>::FIND_MIN(NodeBinTree<elem>* node) const {
      if (node == NULL) return NULL;
      while (node->getLeft() != NULL) {
+         TREE_STAT_VISIT();
          node = node->getLeft();
      }
      return node;
@@ -268,70 +535,109 @@ NodeBinTree<elem>* BinTree<elem>::FIND_MIN(NodeBinTree<elem>* node) const {
 
 template <class elem>
 NodeBinTree<elem>* BinTree<elem>::REMOVE_BST(NodeBinTree<elem>* node, const elem& value, bool& removed) {
-    if (node == NULL) return NULL;
-
-    if (value < node->getInfo()) {
-        node->setLeft(REMOVE_BST(node->getLeft(), value, removed));
-    } else if (value > node->getInfo()) {
-        node->setRight(REMOVE_BST(node->getRight(), value, removed));
-    } else {
-        removed = true;
-        this->weight--;
-
-        if (node->getLeft() == NULL) {
-            NodeBinTree<elem>* temp = node->getRight();
-            delete node;
-            return temp;
-        } else if (node->getRight() == NULL) {
-            NodeBinTree<elem>* temp = node->getLeft();
-            delete node;
-            return temp;
+    // 'value' must be in the tree (removeBST checks first), so sizes drop on the way down.
+    // A node with two children takes its successor's value, and the walk goes on to
+    // unlink that successor from the right subtree, where it has no left child.
+    NodeBinTree<elem>* newRoot = node;
+    NodeBinTree<elem>* parent = NULL;
+    bool fromLeft = false;
+    elem target = value;
+    int depth = 0;
+    while (node != NULL) {
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(++depth);
+        node = UNSHARE_NODE(node);
+        if (parent == NULL) newRoot = node;
+        else if (fromLeft) parent->setLeft(node);
+        else parent->setRight(node);
+
+        bool goLeft = TREE_STAT_COMPARE(target < node->getInfo());
+        if (!goLeft && !TREE_STAT_COMPARE(target > node->getInfo())) {
+            removed = true;
+            if (node->getLeft() == NULL || node->getRight() == NULL) {
+                NodeBinTree<elem>* child = (node->getLeft() == NULL) ? node->getRight() : node->getLeft();
+                FREE_NODE(node);
+                if (this->weight >= 0) this->weight--;
+                if (parent == NULL) newRoot = child;
+                else if (fromLeft) parent->setLeft(child);
+                else parent->setRight(child);
+                return newRoot;
+            }
+            target = FIND_MIN(node->getRight())->getInfo();
+            node->setInfo(target);
         }
-
-        NodeBinTree<elem>* temp = FIND_MIN(node->getRight());
-        node->setInfo(temp->getInfo());
-        bool dummy = false;
-        node->setRight(REMOVE_BST(node->getRight(), temp->getInfo(), dummy));
+        node->setSize(node->getSize() - 1);
+        parent = node;
+        fromLeft = goLeft;
+        node = goLeft ? node->getLeft() : node->getRight();
     }
-    return node;
+    return newRoot;
 }
 
+// FIND_PATH, FIND_PATHS_TO_TWO and GET_NODE_LEVEL are preorder searches with an explicit
+// stack of (node, children already tried): the stack is the current root-to-node path.
+
 template <class elem>
 void BinTree<elem>::FIND_PATH(NodeBinTree<elem>* node, std::list<elem>& currentPath, const elem& target, bool& found) const {
     if (node == NULL || found) return;
-    currentPath.push_back(node->getInfo());
-    if (node->getInfo() == target) {
-        found = true;
-        return;
+    std::vector< std::pair<NodeBinTree<elem>*, int> > s;
+    s.push_back(std::make_pair(node, 0));
+    while (!s.empty() && !found) {
+        std::pair<NodeBinTree<elem>*, int>& top = s.back();
+        NodeBinTree<elem>* current = top.first;
+        if (top.second == 0) {
+            TREE_STAT_VISIT();
+            TREE_STAT_DEPTH(s.size());
+            top.second = 1;
+            if (TREE_STAT_COMPARE(current->getInfo() == target)) found = true;
+            else if (current->getLeft() != NULL) s.push_back(std::make_pair(current->getLeft(), 0));
+        } else if (top.second == 1) {
+            top.second = 2;
+            if (current->getRight() != NULL) s.push_back(std::make_pair(current->getRight(), 0));
+        } else {
+            s.pop_back();
+        }
     }
-    FIND_PATH(node->getLeft(), currentPath, target, found);
-    if (found) return;
-    FIND_PATH(node->getRight(), currentPath, target, found);
-    if (found) return;
-    currentPath.pop_back();
+    if (!found) return;
+    for (size_t i = 0; i < s.size(); ++i) currentPath.push_back(s[i].first->getInfo());
 }
 
 template <class elem>
 void BinTree<elem>::FIND_PATHS_TO_TWO(NodeBinTree<elem>* node, std::list<elem>& path1, std::list<elem>& path2, const elem& target1, const elem& target2, bool& found1, bool& found2) const {
-     if (node == NULL || (found1 && found2)) return;
-     if (!found1) path1.push_back(node->getInfo());
-     if (!found2) path2.push_back(node->getInfo());
-     if (node->getInfo() == target1) found1 = true;
-     if (node->getInfo() == target2) found2 = true;
-     if (found1 && found2) return;
-     FIND_PATHS_TO_TWO(node->getLeft(), path1, path2, target1, target2, found1, found2);
-     if (found1 && found2) return;
-     FIND_PATHS_TO_TWO(node->getRight(), path1, path2, target1, target2, found1, found2);
-     if (found1 && found2) return;
-     if (!found1) path1.pop_back();
-     if (!found2) path2.pop_back();
+    // Each path is copied from the stack the first time its target is reached
+    if (node == NULL || (found1 && found2)) return;
+    std::vector< std::pair<NodeBinTree<elem>*, int> > s;
+    s.push_back(std::make_pair(node, 0));
+    while (!s.empty() && !(found1 && found2)) {
+        std::pair<NodeBinTree<elem>*, int>& top = s.back();
+        NodeBinTree<elem>* current = top.first;
+        if (top.second == 0) {
+            TREE_STAT_VISIT();
+            TREE_STAT_DEPTH(s.size());
+            top.second = 1;
+            if (!found1 && TREE_STAT_COMPARE(current->getInfo() == target1)) {
+                found1 = true;
+                for (size_t i = 0; i < s.size(); ++i) path1.push_back(s[i].first->getInfo());
+            }
+            if (!found2 && TREE_STAT_COMPARE(current->getInfo() == target2)) {
+                found2 = true;
+                for (size_t i = 0; i < s.size(); ++i) path2.push_back(s[i].first->getInfo());
+            }
+            if (current->getLeft() != NULL && !(found1 && found2)) s.push_back(std::make_pair(current->getLeft(), 0));
+        } else if (top.second == 1) {
+            top.second = 2;
+            if (current->getRight() != NULL) s.push_back(std::make_pair(current->getRight(), 0));
+        } else {
+            s.pop_back();
+        }
+    }
 }
 
 template <class elem>
 void BinTree<elem>::COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> path1, std::list<elem> path2) const {
     elem lca;
     bool lcaFound = false;
-    while (!path1.empty() && !path2.empty() && path1.front() == path2.front()) {
+    while (!path1.empty() && !path2.empty() && TREE_STAT_COMPARE(path1.front() == path2.front())) {
         lca = path1.front();
         lcaFound = true;
         path1.pop_front();
@@ -366,91 +672,121 @@ void BinTree<elem>::COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> p
 }
 
 template <class elem>
-void BinTree<elem>::UPDATE_LONGEST_PATH(std::list<elem>& currentLongest, std::list<elem>& path1, std::list<elem>& path2, const std::list<elem>& newBranch) const {
-    std::list<elem> diameter1, diameter2;
-    if (!path1.empty()) {
-        COMBINE_PATHS(diameter1, path1, newBranch);
-    } else {
-        path1 = newBranch;
-        return;
-    }
-    if (!path2.empty()) {
-        COMBINE_PATHS(diameter2, path2, newBranch);
-    } else {
-        path2 = newBranch;
-        std::list<elem> initialDiameter;
-        COMBINE_PATHS(initialDiameter, path1, path2);
-         if (initialDiameter.size() > currentLongest.size()) {
-             currentLongest = initialDiameter;
-         }
-         return;
-    }
-    if (diameter1.size() >= diameter2.size()) {
-        if (diameter1.size() > currentLongest.size()) {
-            currentLongest = diameter1;
-        }
-    } else {
-        if (diameter2.size() > currentLongest.size()) {
-            currentLongest = diameter2;
+int BinTree<elem>::FIND_DIAMETER_APEX(NodeBinTree<elem>* node, NodeBinTree<elem>*& apex) const {
+    // Postorder height propagation: each frame holds the heights of the children already finished
+    apex = NULL;
+    if (node == NULL) return -1;
+    int longest = -1;
+    std::vector<DiameterFrame> s;
+    s.push_back(DiameterFrame(node));
+    while (!s.empty()) {
+        DiameterFrame& frame = s.back();
+        if (frame.stage == 0) {
+            TREE_STAT_VISIT();
+            TREE_STAT_DEPTH(s.size());
+            frame.stage = 1;
+            if (frame.node->getLeft() != NULL) s.push_back(DiameterFrame(frame.node->getLeft()));
+        } else if (frame.stage == 1) {
+            frame.stage = 2;
+            if (frame.node->getRight() != NULL) s.push_back(DiameterFrame(frame.node->getRight()));
+        } else {
+            int through = (frame.leftHeight + 1) + (frame.rightHeight + 1);
+            if (through > longest) {
+                longest = through;
+                apex = frame.node;
+            }
+            int height = std::max(frame.leftHeight, frame.rightHeight) + 1;
+            NodeBinTree<elem>* finished = frame.node;
+            s.pop_back();
+            if (!s.empty()) {
+                if (s.back().node->getLeft() == finished) s.back().leftHeight = height;
+                else s.back().rightHeight = height;
+            }
         }
     }
-    if(diameter1.size() >= diameter2.size()) path2 = newBranch; else path1 = newBranch;
+    return longest;
 }
 
 template <class elem>
-void BinTree<elem>::FIND_DIAMETER(NodeBinTree<elem>* node, std::list<elem>& currentLongestPath, std::list<elem>& longestBranch1, std::list<elem>& longestBranch2, std::list<elem>& currentBranch) const {
+void BinTree<elem>::DEEPEST_BRANCH(NodeBinTree<elem>* node, std::list<elem>& branch) const {
+    // Walks down to the leftmost deepest node keeping only the current root-to-node path
     if (node == NULL) return;
-    currentBranch.push_back(node->getInfo());
-    if (node->getLeft() == NULL && node->getRight() == NULL) {
-        UPDATE_LONGEST_PATH(currentLongestPath, longestBranch1, longestBranch2, currentBranch);
-    } else {
-        std::list<elem> branch1_copy_l = longestBranch1, branch2_copy_l = longestBranch2;
-        FIND_DIAMETER(node->getLeft(), currentLongestPath, branch1_copy_l, branch2_copy_l, currentBranch);
-        longestBranch1 = branch1_copy_l; longestBranch2 = branch2_copy_l; // Update after left call
-        std::list<elem> branch1_copy_r = longestBranch1, branch2_copy_r = longestBranch2;
-        FIND_DIAMETER(node->getRight(), currentLongestPath, branch1_copy_r, branch2_copy_r, currentBranch);
-        longestBranch1 = branch1_copy_r; longestBranch2 = branch2_copy_r; // Update after right call
+    int height = -1;
+    GET_HEIGHT(node, 0, height);
+    std::vector<NodeBinTree<elem>*> path;
+    std::stack< std::pair<NodeBinTree<elem>*, int> > s;
+    s.push(std::make_pair(node, 0));
+    while (!s.empty()) {
+        NodeBinTree<elem>* current = s.top().first;
+        int depth = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        path.resize(depth);
+        path.push_back(current);
+        if (depth == height) break;
+        if (current->getRight() != NULL) s.push(std::make_pair(current->getRight(), depth + 1));
+        if (current->getLeft() != NULL) s.push(std::make_pair(current->getLeft(), depth + 1));
     }
-    currentBranch.pop_back();
+    for (size_t i = 0; i < path.size(); ++i) branch.push_back(path[i]->getInfo());
 }
 
 template <class elem>
 BinTree<elem>::BinTree() {
+    this->arena = NULL;
     this->root = NULL;
     this->weight = 0;
+    this->levelIndexValid = false;
 }
 
 template <class elem>
 BinTree<elem>::BinTree(elem e) {
-    this->root = new NodeBinTree<elem>(e);
+    this->arena = NULL;
+    this->root = NEW_NODE(e);
     this->weight = 1;
+    this->levelIndexValid = false;
 }
 
 template <class elem>
 BinTree<elem>::BinTree(const BinTree<elem>& otherTree) {
+    this->arena = (otherTree.arena != NULL) ? new NodeArena< NodeBinTree<elem> >() : NULL; // The copy keeps the storage option
     this->root = NULL;
     this->weight = 0;
+    this->levelIndexValid = false;
     *this = otherTree;
 }
 
 template <class elem>
 BinTree<elem>::BinTree(elem e, const BinTree<elem>& leftTree, const BinTree<elem>& rightTree) {
-    this->root = new NodeBinTree<elem>(e);
-    this->root->setLeft(COPY_NODES(leftTree.root));
-    this->root->setRight(COPY_NODES(rightTree.root));
-    this->weight = 1 + COUNT_NODES(this->root->getLeft()) + COUNT_NODES(this->root->getRight());
+    this->arena = NULL;
+    this->root = NEW_NODE(e);
+    this->root->setLeft(SHARE_FROM(leftTree, leftTree.root));
+    this->root->setRight(SHARE_FROM(rightTree, rightTree.root));
+    UPDATE_SIZE(this->root);
+    this->weight = (leftTree.weight >= 0 && rightTree.weight >= 0) ? 1 + leftTree.weight + rightTree.weight : -1;
+    this->levelIndexValid = false;
 }
 
 template <class elem>
 BinTree<elem>::~BinTree() {
-    DESTROY_NODES(this->root);
+    TREE_STAT_OPERATION("BinTree::~BinTree");
+    FREE_ALL(this->root);
+    delete this->arena;
 }
 
 template <class elem>
 BinTree<elem>& BinTree<elem>::operator=(const BinTree<elem>& otherTree) {
+    TREE_STAT_OPERATION("BinTree::operator=");
     if (this != &otherTree) {
-        CLEAR();
-        this->root = COPY_NODES(otherTree.root);
+        if (this->arena != NULL || otherTree.arena != NULL) {
+            // Arena nodes are copied, and only once CLEAR has rewound this tree's arena
+            CLEAR();
+            this->root = COPY_NODES(otherTree.root);
+        } else {
+            NodeBinTree<elem>* shared = SHARE_FROM(otherTree, otherTree.root);
+            CLEAR();
+            this->root = shared;
+        }
         this->weight = otherTree.weight;
     }
     return *this;
@@ -460,10 +796,8 @@ template <class elem>
 void BinTree<elem>::copyFromPointer(const BinTree<elem>* otherTreePtr) {
      if (otherTreePtr == NULL) {
          CLEAR();
-     } else if (this != otherTreePtr) {
-        CLEAR();
-        this->root = COPY_NODES(otherTreePtr->root);
-        this->weight = otherTreePtr->weight;
+     } else {
+        *this = *otherTreePtr;
      }
 }
 
@@ -474,6 +808,8 @@ bool BinTree<elem>::isEmpty() const {
 
 template <class elem>
 int BinTree<elem>::getWeight() const {
+    TREE_STAT_OPERATION("BinTree::getWeight");
+    if (this->weight < 0) this->weight = SIZE(this->root);
     return this->weight;
 }
 
@@ -487,8 +823,8 @@ template <class elem>
 BinTree<elem> BinTree<elem>::getLeftSubtree() const {
     BinTree<elem> leftSubtree;
     if (!isEmpty() && this->root->getLeft() != NULL) {
-        leftSubtree.root = COPY_NODES(this->root->getLeft());
-        leftSubtree.weight = leftSubtree.COUNT_NODES(leftSubtree.root);
+        leftSubtree.root = leftSubtree.SHARE_FROM(*this, this->root->getLeft());
+        leftSubtree.weight = -1;
     }
     return leftSubtree;
 }
@@ -497,103 +833,294 @@ template <class elem>
 BinTree<elem> BinTree<elem>::getRightSubtree() const {
      BinTree<elem> rightSubtree;
     if (!isEmpty() && this->root->getRight() != NULL) {
-        rightSubtree.root = COPY_NODES(this->root->getRight());
-        rightSubtree.weight = rightSubtree.COUNT_NODES(rightSubtree.root);
+        rightSubtree.root = rightSubtree.SHARE_FROM(*this, this->root->getRight());
+        rightSubtree.weight = -1;
     }
     return rightSubtree;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::preOrder() const {
+    TREE_STAT_OPERATION("BinTree::preOrder");
     std::list<elem> r; PRE_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::inOrder() const {
+    TREE_STAT_OPERATION("BinTree::inOrder");
     std::list<elem> r; IN_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::postOrder() const {
+    TREE_STAT_OPERATION("BinTree::postOrder");
     std::list<elem> r; POST_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::levelOrder() const {
+    TREE_STAT_OPERATION("BinTree::levelOrder");
     std::list<elem> r; LEVEL_ORDER_HELPER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::getLevel(int level) const {
-    std::list<elem> result;
-    if (isEmpty() || level < 0) return result;
-    std::queue<NodeBinTree<elem>*> q;
-    q.push(this->root);
-    q.push(NULL);
-    int currentLevel = 0;
-    while (!q.empty()) {
-        NodeBinTree<elem>* current = q.front();
-        q.pop();
-        if (current == NULL) {
-            currentLevel++;
-            if (q.empty() || currentLevel > level) break;
-            q.push(NULL);
-        } else {
-            if (currentLevel == level) {
-                result.push_back(current->getInfo());
-            }
-            if (current->getLeft() != NULL) q.push(current->getLeft());
-            if (current->getRight() != NULL) q.push(current->getRight());
-        }
+    TreeRange<typename std::vector<elem>::const_iterator> slice = getLevelSlice(level);
+    return std::list<elem>(slice.begin(), slice.end());
+}
+
+// The slice points into the level index and stays valid until the tree is modified
+template <class elem>
+TreeRange<typename std::vector<elem>::const_iterator> BinTree<elem>::getLevelSlice(int level) const {
+    TREE_STAT_OPERATION("BinTree::getLevelSlice");
+    if (!levelIndexValid) BUILD_LEVEL_INDEX();
+    if (level < 0 || level + 1 >= (int)levelOffsets.size()) {
+        return TreeRange<typename std::vector<elem>::const_iterator>(levelValues.end(), levelValues.end());
     }
-    return result;
+    return TreeRange<typename std::vector<elem>::const_iterator>(levelValues.begin() + levelOffsets[level],
+                                                                levelValues.begin() + levelOffsets[level + 1]);
+}
+
+template <class elem>
+typename BinTree<elem>::const_iterator BinTree<elem>::begin() const {
+    return const_iterator(this->root, TRAVERSE_PRE_ORDER);
+}
+
+template <class elem>
+typename BinTree<elem>::const_iterator BinTree<elem>::begin(TreeTraversal order, int level) const {
+    return const_iterator(this->root, order, level);
+}
+
+template <class elem>
+typename BinTree<elem>::const_iterator BinTree<elem>::end() const {
+    return const_iterator();
+}
+
+template <class elem>
+TreeRange<typename BinTree<elem>::const_iterator> BinTree<elem>::traverse(TreeTraversal order, int level) const {
+    return TreeRange<const_iterator>(begin(order, level), end());
 }
 
 template <class elem>
 int BinTree<elem>::getHeight() const {
+    TREE_STAT_OPERATION("BinTree::getHeight");
     int ml = -1; GET_HEIGHT(this->root, 0, ml); return ml;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::getLeaves() const {
+    TREE_STAT_OPERATION("BinTree::getLeaves");
     std::list<elem> r; GET_LEAVES(this->root, r); return r;
 }
 
 template <class elem>
 void BinTree<elem>::insertBST(const elem& value) {
+    TREE_STAT_OPERATION("BinTree::insertBST");
     INSERT_BST(this->root, value);
+    INVALIDATE_CACHES();
 }
 
 template <class elem>
 bool BinTree<elem>::searchBST(const elem& value) const {
+    TREE_STAT_OPERATION("BinTree::searchBST");
     return SEARCH_BST(this->root, value);
 }
 
 template <class elem>
 bool BinTree<elem>::removeBST(const elem& value) {
+    TREE_STAT_OPERATION("BinTree::removeBST");
      bool removed = false;
+     if (!SEARCH_BST(this->root, value)) return false; // Nothing to remove, so no path to copy
      this->root = REMOVE_BST(this->root, value, removed);
+     if (removed) INVALIDATE_CACHES();
      return removed;
 }
 
+template <class elem>
+int BinTree<elem>::countRange(const elem& low, const elem& high) const {
+    TREE_STAT_OPERATION("BinTree::countRange");
+    if (high < low) return 0;
+    return COUNT_BELOW(high, true) - COUNT_BELOW(low, false);
+}
+
+template <class elem>
+elem BinTree<elem>::kth(int k) const {
+    TREE_STAT_OPERATION("BinTree::kth");
+    if (k < 1 || k > SIZE(this->root)) throw std::out_of_range("kth() position out of range");
+    const NodeBinTree<elem>* node = this->root;
+    while (true) {
+        TREE_STAT_VISIT();
+        int leftSize = SIZE(node->getLeft());
+        if (k <= leftSize) {
+            node = node->getLeft();
+        } else if (k == leftSize + 1) {
+            return node->getInfo();
+        } else {
+            k -= leftSize + 1;
+            node = node->getRight();
+        }
+    }
+}
+
+template <class elem>
+int BinTree<elem>::rank(const elem& value) const {
+    TREE_STAT_OPERATION("BinTree::rank");
+    return COUNT_BELOW(value, false);
+}
+
+template <class elem>
+bool BinTree<elem>::lowerBound(const elem& value, elem& result) const {
+    TREE_STAT_OPERATION("BinTree::lowerBound");
+    const NodeBinTree<elem>* best = NULL;
+    for (const NodeBinTree<elem>* node = this->root; node != NULL; ) {
+        TREE_STAT_VISIT();
+        if (TREE_STAT_COMPARE(node->getInfo() < value)) {
+            node = node->getRight();
+        } else {
+            best = node;
+            node = node->getLeft();
+        }
+    }
+    if (best == NULL) return false;
+    result = best->getInfo();
+    return true;
+}
+
+template <class elem>
+bool BinTree<elem>::predecessor(const elem& value, elem& result) const {
+    TREE_STAT_OPERATION("BinTree::predecessor");
+    const NodeBinTree<elem>* best = NULL;
+    for (const NodeBinTree<elem>* node = this->root; node != NULL; ) {
+        TREE_STAT_VISIT();
+        if (TREE_STAT_COMPARE(node->getInfo() < value)) {
+            best = node;
+            node = node->getRight();
+        } else {
+            node = node->getLeft();
+        }
+    }
+    if (best == NULL) return false;
+    result = best->getInfo();
+    return true;
+}
+
+template <class elem>
+bool BinTree<elem>::successor(const elem& value, elem& result) const {
+    TREE_STAT_OPERATION("BinTree::successor");
+    const NodeBinTree<elem>* best = NULL;
+    for (const NodeBinTree<elem>* node = this->root; node != NULL; ) {
+        TREE_STAT_VISIT();
+        if (TREE_STAT_COMPARE(value < node->getInfo())) {
+            best = node;
+            node = node->getLeft();
+        } else {
+            node = node->getRight();
+        }
+    }
+    if (best == NULL) return false;
+    result = best->getInfo();
+    return true;
+}
+
+template <class elem>
+template <class OutputIterator>
+OutputIterator BinTree<elem>::rangeCollect(const elem& low, const elem& high, OutputIterator out) const {
+    TREE_STAT_OPERATION("BinTree::rangeCollect");
+    // In-order walk that never descends left of low and stops at the first value past high
+    std::stack<const NodeBinTree<elem>*> s;
+    const NodeBinTree<elem>* node = this->root;
+    while (true) {
+        while (node != NULL) {
+            TREE_STAT_VISIT();
+            if (TREE_STAT_COMPARE(node->getInfo() < low)) {
+                node = node->getRight();
+            } else {
+                s.push(node);
+                node = node->getLeft();
+            }
+        }
+        if (s.empty()) break;
+        node = s.top();
+        s.pop();
+        if (TREE_STAT_COMPARE(high < node->getInfo())) break;
+        *out++ = node->getInfo();
+        node = node->getRight();
+    }
+    return out;
+}
+
 template <class elem>
 void BinTree<elem>::buildFromPreIn(std::list<elem> preOrderList, std::list<elem> inOrderList) {
+    TREE_STAT_OPERATION("BinTree::buildFromPreIn");
      if (preOrderList.size() != inOrderList.size()) throw std::runtime_error("Mismatched list sizes in buildFromPreIn");
     CLEAR();
     this->root = BUILD_FROM_PRE_IN_RECURSIVE(preOrderList, inOrderList);
-    this->weight = COUNT_NODES(this->root);
+    this->weight = SIZE(this->root);
 }
 
 template <class elem>
 void BinTree<elem>::buildFromPostIn(std::list<elem> postOrderList, std::list<elem> inOrderList) {
+    TREE_STAT_OPERATION("BinTree::buildFromPostIn");
       if (postOrderList.size() != inOrderList.size()) throw std::runtime_error("Mismatched list sizes in buildFromPostIn");
     CLEAR();
     this->root = BUILD_FROM_POST_IN_RECURSIVE(postOrderList, inOrderList);
-    this->weight = COUNT_NODES(this->root);
+    this->weight = SIZE(this->root);
+}
+
+template <class elem>
+template <class Iterator>
+void BinTree<elem>::buildBalancedBST(Iterator first, Iterator last) {
+    TREE_STAT_OPERATION("BinTree::buildBalancedBST");
+    std::vector<elem> keys(first, last); // Copied before CLEAR, so the keys may come from this tree
+    TreeParallelSort<elem>::sort(keys);
+    CLEAR();
+    this->root = BUILD_BALANCED(keys, 0, (int)keys.size());
+    this->weight = (int)keys.size();
+}
+
+template <class elem>
+BinTree<elem> BinTree<elem>::unionBST(const BinTree<elem>& other) const {
+    TREE_STAT_OPERATION("BinTree::unionBST");
+    std::vector<elem> a, b, merged;
+    SORTED_VALUES(a);
+    other.SORTED_VALUES(b);
+    merged.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+    BinTree<elem> result;
+    result.root = result.BUILD_BALANCED(merged, 0, (int)merged.size());
+    result.weight = (int)merged.size();
+    return result;
+}
+
+template <class elem>
+BinTree<elem> BinTree<elem>::intersectionBST(const BinTree<elem>& other) const {
+    TREE_STAT_OPERATION("BinTree::intersectionBST");
+    std::vector<elem> a, b, common;
+    SORTED_VALUES(a);
+    other.SORTED_VALUES(b);
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+    BinTree<elem> result;
+    result.root = result.BUILD_BALANCED(common, 0, (int)common.size());
+    result.weight = (int)common.size();
+    return result;
+}
+
+template <class elem>
+BinTree<elem> BinTree<elem>::differenceBST(const BinTree<elem>& other) const {
+    TREE_STAT_OPERATION("BinTree::differenceBST");
+    std::vector<elem> a, b, remaining;
+    SORTED_VALUES(a);
+    other.SORTED_VALUES(b);
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(remaining));
+    BinTree<elem> result;
+    result.root = result.BUILD_BALANCED(remaining, 0, (int)remaining.size());
+    result.weight = (int)remaining.size();
+    return result;
 }
 
 template <class elem>
 std::list<elem> BinTree<elem>::findPathToNode(const elem& target) const {
+    TREE_STAT_OPERATION("BinTree::findPathToNode");
     std::list<elem> path;
     bool found = false;
     FIND_PATH(this->root, path, target, found);
@@ -603,6 +1130,7 @@ std::list<elem> BinTree<elem>::findPathToNode(const elem& target) const {
 
 template <class elem>
 std::list<elem> BinTree<elem>::findPathBetweenNodes(const elem& value1, const elem& value2) const {
+    TREE_STAT_OPERATION("BinTree::findPathBetweenNodes");
     std::list<elem> path1, path2, resultPath;
     bool found1 = false, found2 = false;
     FIND_PATHS_TO_TWO(this->root, path1, path2, value1, value2, found1, found2);
@@ -614,6 +1142,7 @@ std::list<elem> BinTree<elem>::findPathBetweenNodes(const elem& value1, const el
 
 template <class elem>
 elem BinTree<elem>::lowestCommonAncestor(const elem& value1, const elem& value2) const {
+    TREE_STAT_OPERATION("BinTree::lowestCommonAncestor");
     std::list<elem> path1, path2;
     bool found1 = false, found2 = false;
     FIND_PATHS_TO_TWO(this->root, path1, path2, value1, value2, found1, found2);
@@ -639,19 +1168,34 @@ elem BinTree<elem>::lowestCommonAncestor(const elem& value1, const elem& value2)
 
 template <class elem>
 std::list<elem> BinTree<elem>::getDiameterPath() const {
+    TREE_STAT_OPERATION("BinTree::getDiameterPath");
     std::list<elem> longestPath;
-    if (isEmpty()) return longestPath;
-    std::list<elem> branch1, branch2, currentBranch;
-    FIND_DIAMETER(this->root, longestPath, branch1, branch2, currentBranch);
-     if (longestPath.empty()) {
-        if(branch1.size() >= branch2.size()) return branch1;
-        else return branch2;
-     }
+    NodeBinTree<elem>* apex = NULL;
+    if (FIND_DIAMETER_APEX(this->root, apex) < 0) return longestPath;
+    std::list<elem> leftBranch, rightBranch;
+    DEEPEST_BRANCH(apex->getLeft(), leftBranch);
+    DEEPEST_BRANCH(apex->getRight(), rightBranch);
+    if (leftBranch.empty() || rightBranch.empty()) {
+        longestPath.push_back(apex->getInfo());
+        longestPath.splice(longestPath.end(), leftBranch.empty() ? rightBranch : leftBranch);
+        return longestPath;
+    }
+    leftBranch.reverse();
+    longestPath.splice(longestPath.end(), leftBranch);
+    longestPath.push_back(apex->getInfo());
+    longestPath.splice(longestPath.end(), rightBranch);
     return longestPath;
 }
 
+template <class elem>
+template <class Folder>
+typename Folder::Result BinTree<elem>::fold(const Folder& folder, int cutoffDepth) const {
+    return TreeFold<NodeBinTree<elem>, Folder>::run(this->root, folder, cutoffDepth);
+}
+
 template <class elem>
 int BinTree<elem>::getHeightDifference(const elem& value1, const elem& value2) const {
+    TREE_STAT_OPERATION("BinTree::getHeightDifference");
     int level1 = GET_NODE_LEVEL(this->root, value1, 0);
     int level2 = GET_NODE_LEVEL(this->root, value2, 0);
 
@@ -664,24 +1208,60 @@ int BinTree<elem>::getHeightDifference(const elem& value1, const elem& value2) c
 
 template <class elem>
 int BinTree<elem>::GET_NODE_LEVEL(NodeBinTree<elem>* node, const elem& target, int currentLevel) const {
-    if (node == NULL) {
-        return -1;
+    if (node == NULL) return -1;
+    std::stack< std::pair<NodeBinTree<elem>*, int> > s;
+    s.push(std::make_pair(node, currentLevel));
+    while (!s.empty()) {
+        NodeBinTree<elem>* current = s.top().first;
+        int level = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        if (TREE_STAT_COMPARE(current->getInfo() == target)) return level;
+        if (current->getRight() != NULL) s.push(std::make_pair(current->getRight(), level + 1));
+        if (current->getLeft() != NULL) s.push(std::make_pair(current->getLeft(), level + 1));
     }
-    if (node->getInfo() == target) {
-        return currentLevel;
-    }
-    int leftLevel = GET_NODE_LEVEL(node->getLeft(), target, currentLevel + 1);
-    if (leftLevel != -1) {
-        return leftLevel;
-    }
-    return GET_NODE_LEVEL(node->getRight(), target, currentLevel + 1);
+    return -1;
 }
 
 template <class elem>
 void BinTree<elem>::makeEmpty() {
+    TREE_STAT_OPERATION("BinTree::makeEmpty");
     CLEAR();
 }
 
+template <class elem>
+void BinTree<elem>::enableArena() {
+    if (this->arena != NULL) return;
+    NodeArena< NodeBinTree<elem> >* newArena = new NodeArena< NodeBinTree<elem> >();
+    NodeBinTree<elem>* heapRoot = this->root;
+    this->arena = newArena;
+    this->root = COPY_NODES(heapRoot);
+    this->arena = NULL;
+    DESTROY_NODES(heapRoot);
+    this->arena = newArena;
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+void BinTree<elem>::disableArena() {
+    if (this->arena == NULL) return;
+    NodeBinTree<elem>* arenaRoot = this->root;
+    NodeArena< NodeBinTree<elem> >* oldArena = this->arena;
+    this->arena = NULL;
+    this->root = COPY_NODES(arenaRoot);
+    this->arena = oldArena;
+    FREE_ALL(arenaRoot);
+    delete oldArena;
+    this->arena = NULL;
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+bool BinTree<elem>::usesArena() const {
+    return this->arena != NULL;
+}
+
 // Gracias StackOverflow
 
 template <class elem>
@@ -0,0 +1,160 @@
+#ifndef BIN_TREE_ITERATOR_H_
+#define BIN_TREE_ITERATOR_H_
+
+#include "node_bin_tree.h"
+#include "tree_traversal.h"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+// Forward iterator that walks a BinTree lazily. Depth-first orders keep O(h) frames;
+// level order keeps the current frontier. A default constructed iterator is the end.
+template <class elem>
+class BinTreeIterator {
+    private:
+        struct Frame {
+            const NodeBinTree<elem>* node;
+            int depth;
+            bool expanded; // Post-order: children already pushed
+            Frame(const NodeBinTree<elem>* n, int d) : node(n), depth(d), expanded(false) {}
+        };
+
+        TreeTraversal order;
+        int level;
+        const NodeBinTree<elem>* current;
+        int position; // Elements yielded before current: with shared subtrees one node can sit at several positions
+        std::vector<Frame> stack;
+        std::deque<const NodeBinTree<elem>*> queue;
+
+        void PUSH_LEFT_SPINE(const NodeBinTree<elem>* node);
+        void ADVANCE();
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef elem value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const elem* pointer;
+        typedef const elem& reference;
+
+        BinTreeIterator();
+        BinTreeIterator(const NodeBinTree<elem>* root, TreeTraversal order, int level = 0);
+
+        reference operator*() const;
+        pointer operator->() const;
+        BinTreeIterator<elem>& operator++();
+        BinTreeIterator<elem> operator++(int);
+        bool operator==(const BinTreeIterator<elem>& other) const;
+        bool operator!=(const BinTreeIterator<elem>& other) const;
+};
+
+template <class elem>
+BinTreeIterator<elem>::BinTreeIterator() : order(TRAVERSE_PRE_ORDER), level(0), current(NULL), position(0) {}
+
+template <class elem>
+BinTreeIterator<elem>::BinTreeIterator(const NodeBinTree<elem>* root, TreeTraversal order, int level)
+    : order(order), level(level), current(NULL), position(0) {
+    if (root == NULL || (order == TRAVERSE_LEVEL && level < 0)) return;
+    if (order == TRAVERSE_IN_ORDER) PUSH_LEFT_SPINE(root);
+    else if (order == TRAVERSE_LEVEL_ORDER) queue.push_back(root);
+    else stack.push_back(Frame(root, 0));
+    ADVANCE();
+}
+
+template <class elem>
+void BinTreeIterator<elem>::PUSH_LEFT_SPINE(const NodeBinTree<elem>* node) {
+    while (node != NULL) {
+        stack.push_back(Frame(node, 0));
+        node = node->getLeft();
+    }
+}
+
+template <class elem>
+void BinTreeIterator<elem>::ADVANCE() {
+    current = NULL;
+    switch (order) {
+        case TRAVERSE_IN_ORDER:
+            if (stack.empty()) return;
+            current = stack.back().node;
+            stack.pop_back();
+            PUSH_LEFT_SPINE(current->getRight());
+            return;
+        case TRAVERSE_LEVEL_ORDER:
+            if (queue.empty()) return;
+            current = queue.front();
+            queue.pop_front();
+            if (current->getLeft() != NULL) queue.push_back(current->getLeft());
+            if (current->getRight() != NULL) queue.push_back(current->getRight());
+            return;
+        case TRAVERSE_POST_ORDER:
+            while (!stack.empty()) {
+                Frame& top = stack.back();
+                if (top.expanded) {
+                    current = top.node;
+                    stack.pop_back();
+                    return;
+                }
+                top.expanded = true;
+                const NodeBinTree<elem>* node = top.node;
+                if (node->getRight() != NULL) stack.push_back(Frame(node->getRight(), 0));
+                if (node->getLeft() != NULL) stack.push_back(Frame(node->getLeft(), 0));
+            }
+            return;
+        default: // Pre-order walks, filtered for leaves or a single level
+            while (!stack.empty()) {
+                Frame top = stack.back();
+                stack.pop_back();
+                const NodeBinTree<elem>* node = top.node;
+                bool descend = (order != TRAVERSE_LEVEL || top.depth < level);
+                if (descend) {
+                    if (node->getRight() != NULL) stack.push_back(Frame(node->getRight(), top.depth + 1));
+                    if (node->getLeft() != NULL) stack.push_back(Frame(node->getLeft(), top.depth + 1));
+                }
+                if (order == TRAVERSE_PRE_ORDER
+                    || (order == TRAVERSE_LEAVES && node->getLeft() == NULL && node->getRight() == NULL)
+                    || (order == TRAVERSE_LEVEL && top.depth == level)) {
+                    current = node;
+                    return;
+                }
+            }
+            return;
+    }
+}
+
+template <class elem>
+typename BinTreeIterator<elem>::reference BinTreeIterator<elem>::operator*() const {
+    return current->getInfo();
+}
+
+template <class elem>
+typename BinTreeIterator<elem>::pointer BinTreeIterator<elem>::operator->() const {
+    return &current->getInfo();
+}
+
+template <class elem>
+BinTreeIterator<elem>& BinTreeIterator<elem>::operator++() {
+    ++position;
+    ADVANCE();
+    return *this;
+}
+
+template <class elem>
+BinTreeIterator<elem> BinTreeIterator<elem>::operator++(int) {
+    BinTreeIterator<elem> previous = *this;
+    ++position;
+    ADVANCE();
+    return previous;
+}
+
+template <class elem>
+bool BinTreeIterator<elem>::operator==(const BinTreeIterator<elem>& other) const {
+    // Every end iterator is equal, whatever it took to get there
+    return this->current == other.current && (this->current == NULL || this->position == other.position);
+}
+
+template <class elem>
+bool BinTreeIterator<elem>::operator!=(const BinTreeIterator<elem>& other) const {
+    return !(*this == other);
+}
+
+#endif // BIN_TREE_ITERATOR_H_
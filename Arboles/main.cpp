@@ -13,6 +13,8 @@ int main() {
     std::string line1, line2, line_alumn, firstOrder, secondOrder, value;
     std::list<std::string> LInorden, LPreorden, LPostorden, LAlumn;
 
+    treeCase.enableArena();     // Los nodos se reciclan entre secciones en lugar de pedirse uno a uno
+
     if (!(std::cin >> cases)) {         // Leer el número de casos
          std::cerr << "Error al leer el numero de casos." << std::endl;
          return 1;
@@ -133,6 +135,10 @@ int main() {
 
     }
 
+#ifdef TREE_INSTRUMENTATION
+    TreeStats::get().report(std::cerr);     // Perfil por operación, compilando con -DTREE_INSTRUMENTATION
+#endif
+
     return 0;
 }
 
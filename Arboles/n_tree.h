@@ -2,6 +2,10 @@
 #define N_TREE_H_
 
 #include "node_n_tree.h" // Includes corrected version
+#include "n_tree_iterator.h"
+#include "node_arena.h"
+#include "tree_parallel.h"
+#include "tree_stats.h"
 #include <iostream>
 #include <list>
 #include <queue>
@@ -9,33 +13,97 @@
 #include <cstddef>
 #include <stdexcept>
 #include <vector>
-#include <string>    // Needed for getLevel string conversion assumption
-#include <sstream> 
+#include <utility>
+#include <map>
 
 // Forward Declaration
 template <class elem> class NTree;
+template <class elem> class NTreeCSR;
+template <class elem> class NTreeSnapshot;
 
 template<class elem>
 class NTree
 {
+    friend class NTreeCSR<elem>; // Reads and rebuilds the sons/bro links directly
+    friend class NTreeSnapshot<elem>; // Rebuilds the nodes directly
+
 private:
     NodeNTree<elem> *root;
-    int weight; // Added for node count tracking
+    mutable int weight; // Node count; -1 while unknown (after taking shared subtrees), getWeight recounts it
+
+    // Nodes are reference counted and shared between trees: copies, getChildren and subtree
+    // composition share instead of copying, and a mutation first copies the shared nodes on
+    // its sons/bro path from the root (copy-on-write). nodesShared is set whenever this tree
+    // may reach a node another tree can reach too.
+    mutable bool nodesShared;
+
+    // Optional node storage (see enableArena); NULL means plain new/delete. Arena nodes are
+    // never shared, since CLEAR drops the whole arena at once: they are copied instead.
+    NodeArena< NodeNTree<elem> >* arena;
+
+    // Level index: values in BFS order plus the offset where each level starts, rebuilt lazily after a mutation
+    mutable std::vector<elem> levelValues;
+    mutable std::vector<int> levelOffsets;
+    mutable bool levelIndexValid;
+
+    // Optional value -> node index used by attachChildrenToNode. node is NULL while a value
+    // appears more than once, in which case lookups fall back to the pre-order search.
+    // A copy shares the nodes but not the index: it marks it stale and the first lookup rebuilds it.
+    struct IndexEntry {
+        NodeNTree<elem>* node;
+        int count;
+        IndexEntry() : node(NULL), count(0) {}
+    };
+    std::map<elem, IndexEntry> nodeIndex;
+    bool nodeIndexEnabled;
+    bool nodeIndexStale; // nodeIndex says nothing until REBUILD_NODE_INDEX; the INDEX_* helpers skip it
+
+    // Per-value state while building from an edge list
+    struct EdgeBuildEntry {
+        NodeNTree<elem>* node;
+        NodeNTree<elem>* lastChild;
+        bool hasParent;
+        EdgeBuildEntry() : node(NULL), lastChild(NULL), hasParent(false) {}
+    };
+
+    // Frame for the iterative diameter search: next child to visit and the two tallest child heights so far
+    struct DiameterFrame {
+        const NodeNTree<elem>* node;
+        const NodeNTree<elem>* nextChild;
+        int best1;
+        int best2;
+        DiameterFrame(const NodeNTree<elem>* n) : node(n), nextChild(n->getSons()), best1(-1), best2(-1) {}
+    };
 
     // --- Private Helper Method Declarations ---
-    NodeNTree<elem>* COPY_NODES(const NodeNTree<elem>* sourceNode) const;
-    void DESTROY_NODES(); // Iterative destructor helper
+    NodeNTree<elem>* NEW_NODE(const elem& value); // Allocates from the arena when there is one
+    void FREE_NODE(NodeNTree<elem>* node); // Reverse of NEW_NODE
+    NodeNTree<elem>* COPY_NODES(const NodeNTree<elem>* sourceNode); // Deep copy of node and its descendants, not its siblings
+    NodeNTree<elem>* SHARE(NodeNTree<elem>* node) const; // Adds a reference and returns node
+    NodeNTree<elem>* SHARE_AS_ROOT(const NTree<elem>& owner, const NodeNTree<elem>* node); // New node with node's info, sharing its children (copying them if an arena is involved)
+    NodeNTree<elem>* UNSHARE_NODE(NodeNTree<elem>* owner, bool asSon, NodeNTree<elem>* node); // Private copy of node, relinked from owner (NULL = root)
+    void UNSHARE_PATH(std::vector<NodeNTree<elem>*>& path); // Makes every node on a root-first sons/bro path private
+    void UNSHARE_ALL(); // Makes every node private, so in-place writes through the node index are safe
+    void RELEASE_NODES(NodeNTree<elem>* node); // Drops one reference to node, freeing whatever no one else uses
+    void DESTROY_NODES(); // Iterative destructor helper; O(1) on an arena of trivially destructible elem
     int COUNT_NODES(const NodeNTree<elem>* node) const;
     void PRE_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const;
     void IN_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const;
     void POST_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const;
     void LEVEL_ORDER_HELPER(const NodeNTree<elem>* node, std::list<elem>& resultList) const;
-    // Note: Assuming elem can be converted to std::string for getLevel marker logic
-    void LEVEL_ORDER_EXACT_HELPER(const NodeNTree<elem>* node, std::list<std::string>& resultList) const;
+    void BUILD_LEVEL_INDEX() const; // Fills levelValues/levelOffsets with one BFS
     void GET_HEIGHT(const NodeNTree<elem>* node, int currentLevel, int& maxLevelReached) const;
     void GET_LEAVES(const NodeNTree<elem>* node, std::list<elem>& leafList) const;
     void CLEAR();
+    void INVALIDATE_CACHES(); // Called by every mutation
     NodeNTree<elem>* FIND_NODE_PREORDER(NodeNTree<elem>* node, const elem& target) const; // Search helper
+    NodeNTree<elem>* FIND_NODE(const elem& target); // Index lookup when enabled, pre-order search otherwise
+    bool FIND_NODE_PATH(const elem& target, std::vector<NodeNTree<elem>*>& path) const; // sons/bro links from the root to target
+    void INDEX_NODE(NodeNTree<elem>* node); // No-ops while the index is disabled or stale
+    void INDEX_SUBTREE(NodeNTree<elem>* node); // Indexes node and its descendants, not node's siblings
+    void UNINDEX_NODE(const NodeNTree<elem>* node);
+    void UNINDEX_SUBTREE(const NodeNTree<elem>* node); // Reverse of INDEX_SUBTREE
+    void REBUILD_NODE_INDEX();
     void ATTACH_CHILDREN_HELPER(NodeNTree<elem>* parentNode, std::list< NTree<elem> >& childrenList); // Child attachment helper
 
     // Path Helpers
@@ -44,44 +112,64 @@ private:
 
     // Diameter Helpers
     void COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> path1, std::list<elem> path2) const;
-    void UPDATE_LONGEST_PATH(std::list<elem>& currentLongest, std::list<elem>& path1, std::list<elem>& path2, const std::list<elem>& newBranch) const;
-    void FIND_DIAMETER(const NodeNTree<elem>* node, std::list<elem>& currentLongestPath, std::list<elem>& longestBranch1, std::list<elem>& longestBranch2, std::list<elem>& currentBranch) const;
+    int FIND_DIAMETER_APEX(const NodeNTree<elem>* node, const NodeNTree<elem>*& apex) const; // Postorder height propagation, O(h) frames
+    int BRANCH_HEIGHT(const NodeNTree<elem>* node) const; // Height of node's subtree, ignoring node's siblings
+    void DEEPEST_BRANCH(const NodeNTree<elem>* node, std::list<elem>& branch) const; // Path from node down to its leftmost deepest descendant
+    int BRANCH_SIZE(const NodeNTree<elem>* node) const; // Nodes in node's subtree, ignoring node's siblings
 
 public:
     // --- Public Interface Declarations ---
     NTree(); // Creates an empty N-ary tree.
     NTree(elem e); // Creates a tree with a single root node.
-    NTree(const NTree<elem>& otherTree); // Creates a deep copy of another tree.
+    NTree(const NTree<elem>& otherTree); // Shares the other tree's nodes (copied on write).
     NTree(elem e, const std::list< NTree<elem> >& children); // Creates tree from root and list of child subtrees.
+    NTree(const std::list< std::pair<elem, elem> >& edges); // Builds from (parent, child) edges with the node index enabled; throws on duplicates or orphans.
     ~NTree(); // Destroys the tree and frees memory.
 
-    NTree<elem>& operator=(const NTree<elem>& otherTree); // Assigns a deep copy.
+    NTree<elem>& operator=(const NTree<elem>& otherTree); // Shares the other tree's nodes (copied on write).
     void copyFromPointer(const NTree<elem>* otherTreePtr); // Copies from a tree pointer.
 
     bool isEmpty() const; // Checks if the tree is empty.
     int getWeight() const; // Returns the total number of nodes.
     elem getRootInfo() const; // Returns the info from the root node.
 
-    std::list< NTree<elem> > getChildren() const; // Returns a list of deep copies of the root's child subtrees.
+    std::list< NTree<elem> > getChildren() const; // Returns the root's child subtrees, sharing their nodes.
 
-    void insertSubtree(const NTree<elem>& subtree); // Inserts a copy of subtree as the last child of the root.
+    void insertSubtree(const NTree<elem>& subtree); // Inserts subtree, shared, as the last child of the root.
     bool removeSubtree(int position); // Removes the child subtree at the given 1-based position; returns true if successful.
 
     std::list<elem> preOrder() const; // Returns list of elements in pre-order.
     std::list<elem> inOrder() const; // Returns list of elements in 'N-ary' in-order.
     std::list<elem> postOrder() const; // Returns list of elements in post-order.
     std::list<elem> levelOrder() const; // Returns list of elements in level-order.
-    std::list<std::string> getLevel(int level) const; // Returns list of elements (as strings) at specific level.
+    std::list<elem> getLevel(int level) const; // Returns list of elements at specific level, read from the level index.
+    TreeRange<typename std::vector<elem>::const_iterator> getLevelSlice(int level) const; // Same level without copying; valid until the tree changes.
+
+    typedef NTreeIterator<elem> const_iterator;
+    const_iterator begin() const; // Lazy pre-order iterator.
+    const_iterator begin(TreeTraversal order, int level = 0) const; // Lazy iterator over any traversal; level is used by TRAVERSE_LEVEL.
+    const_iterator end() const; // End iterator shared by every traversal.
+    TreeRange<const_iterator> traverse(TreeTraversal order, int level = 0) const; // begin/end pair for range-based loops.
 
     int getHeight() const; // Returns the height of the tree.
     std::list<elem> getLeaves() const; // Returns a list of leaf elements.
+    template <class Folder>
+    typename Folder::Result fold(const Folder& folder, int cutoffDepth = -1) const; // Bottom-up reduction (see tree_parallel.h); subtrees below cutoffDepth may run in parallel.
 
     std::list<elem> findPathToNode(const elem& target) const; // Returns path from root to target node.
     std::list<elem> findPathBetweenNodes(const elem& value1, const elem& value2) const; // Returns path between two nodes.
     elem lowestCommonAncestor(const elem& value1, const elem& value2) const; // Finds the lowest common ancestor.
     std::list<elem> getDiameterPath() const; // Returns the elements forming the diameter path.
 
-    bool attachChildrenToNode(const elem& parentValue, const std::list< NTree<elem> >& children); // Attaches copies of children to parent node.
+    bool attachChildrenToNode(const elem& parentValue, const std::list< NTree<elem> >& children); // Attaches children, shared, to parent node.
+
+    void enableNodeIndex(); // Builds the value -> node index; it is kept up to date by every mutation.
+    void disableNodeIndex(); // Drops the index; lookups go back to the pre-order search.
+    bool hasNodeIndex() const; // Whether the node index is enabled.
+
+    void enableArena(); // Moves the nodes into a per-tree arena: few large allocations, O(1) clearing for arithmetic elem.
+    void disableArena(); // Moves the nodes back to individual heap allocations.
+    bool usesArena() const; // Whether the nodes live in an arena.
 };
 
 // --- NTree Method Definitions ---
@@ -89,47 +177,158 @@ public:
 // --- Private Helpers ---
 
 template <class elem>
-NodeNTree<elem>* NTree<elem>::COPY_NODES(const NodeNTree<elem>* sourceNode) const {
+NodeNTree<elem>* NTree<elem>::NEW_NODE(const elem& value) {
+    TREE_STAT_ALLOCATION();
+    if (this->arena == NULL) return new NodeNTree<elem>(value);
+    return new (this->arena->allocate()) NodeNTree<elem>(value);
+}
+
+template <class elem>
+void NTree<elem>::FREE_NODE(NodeNTree<elem>* node) {
+    if (this->arena == NULL) {
+        delete node;
+    } else {
+        node->~NodeNTree<elem>();
+        this->arena->deallocate(node);
+    }
+}
+
+template <class elem>
+NodeNTree<elem>* NTree<elem>::COPY_NODES(const NodeNTree<elem>* sourceNode) {
     if (sourceNode == NULL) return NULL;
-    // Copy current node info, then recursively copy first child and next sibling
-    NodeNTree<elem>* newNode = new NodeNTree<elem>(sourceNode->getInfo());
-    newNode->setSons(COPY_NODES(sourceNode->getSons()));
-    newNode->setBro(COPY_NODES(sourceNode->getBro()));
+    NodeNTree<elem>* newRoot = NEW_NODE(sourceNode->getInfo());
+    std::stack< std::pair<const NodeNTree<elem>*, NodeNTree<elem>*> > s;
+    s.push(std::make_pair(sourceNode, newRoot));
+    while (!s.empty()) {
+        const NodeNTree<elem>* source = s.top().first;
+        NodeNTree<elem>* copy = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        if (source != sourceNode && source->getBro() != NULL) {
+            copy->setBro(NEW_NODE(source->getBro()->getInfo()));
+            s.push(std::make_pair((const NodeNTree<elem>*)source->getBro(), copy->getBro()));
+        }
+        if (source->getSons() != NULL) {
+            copy->setSons(NEW_NODE(source->getSons()->getInfo()));
+            s.push(std::make_pair((const NodeNTree<elem>*)source->getSons(), copy->getSons()));
+        }
+    }
+    return newRoot;
+}
+
+template <class elem>
+NodeNTree<elem>* NTree<elem>::SHARE(NodeNTree<elem>* node) const {
+    if (node != NULL) node->retain();
+    return node;
+}
+
+template <class elem>
+NodeNTree<elem>* NTree<elem>::SHARE_AS_ROOT(const NTree<elem>& owner, const NodeNTree<elem>* node) {
+    if (this->arena != NULL || owner.arena != NULL) return COPY_NODES(node);
+    // The root itself is not shared: its bro link must stay free for the tree it joins
+    NodeNTree<elem>* newNode = NEW_NODE(node->getInfo());
+    newNode->setSons(SHARE(node->getSons()));
+    if (newNode->getSons() != NULL) {
+        this->nodesShared = true;
+        owner.nodesShared = true;
+    }
     return newNode;
 }
 
 template <class elem>
-void NTree<elem>::DESTROY_NODES() {
-    // Iterative destruction using a stack (Pre-order traversal like)
-    if (this->root == NULL) return;
+NodeNTree<elem>* NTree<elem>::UNSHARE_NODE(NodeNTree<elem>* owner, bool asSon, NodeNTree<elem>* node) {
+    // owner must already be private; its link moves from node to the copy
+    if (node == NULL || node->getRefCount() == 1) return node;
+    NodeNTree<elem>* copy = NEW_NODE(node->getInfo());
+    copy->setSons(SHARE(node->getSons()));
+    copy->setBro(SHARE(node->getBro()));
+    if (owner == NULL) this->root = copy;
+    else if (asSon) owner->setSons(copy);
+    else owner->setBro(copy);
+    node->release(); // Still referenced elsewhere, never the last reference
+    if (this->nodeIndexEnabled && !this->nodeIndexStale) {
+        typename std::map<elem, IndexEntry>::iterator it = this->nodeIndex.find(copy->getInfo());
+        if (it != this->nodeIndex.end() && it->second.node == node) it->second.node = copy;
+    }
+    return copy;
+}
+
+template <class elem>
+void NTree<elem>::UNSHARE_PATH(std::vector<NodeNTree<elem>*>& path) {
+    for (size_t i = 0; i < path.size(); ++i) {
+        NodeNTree<elem>* owner = (i == 0) ? NULL : path[i - 1];
+        bool asSon = (owner != NULL && owner->getSons() == path[i]);
+        path[i] = UNSHARE_NODE(owner, asSon, path[i]);
+    }
+}
+
+template <class elem>
+void NTree<elem>::UNSHARE_ALL() {
+    // Top-down, so each copy's children become shared in turn and get copied when reached
+    if (this->root != NULL) {
+        UNSHARE_NODE(NULL, false, this->root);
+        std::stack<NodeNTree<elem>*> s;
+        s.push(this->root);
+        while (!s.empty()) {
+            NodeNTree<elem>* current = s.top(); s.pop();
+            if (current != this->root && current->getBro() != NULL) s.push(UNSHARE_NODE(current, false, current->getBro()));
+            if (current->getSons() != NULL) s.push(UNSHARE_NODE(current, true, current->getSons()));
+        }
+    }
+    this->nodesShared = false;
+}
+
+template <class elem>
+void NTree<elem>::RELEASE_NODES(NodeNTree<elem>* node) {
+    if (node == NULL) return;
     std::stack<NodeNTree<elem>*> s;
-    s.push(this->root);
+    s.push(node);
     while (!s.empty()) {
         NodeNTree<elem>* current = s.top();
+        TREE_STAT_VISIT();
         s.pop();
-        // Push children (siblings first, then first child) to process parent last implicitly
-        if (current->getBro() != NULL) {
-            s.push(current->getBro());
-        }
-        if (current->getSons() != NULL) {
-            s.push(current->getSons());
-        }
-        delete current; // Use delete
+        if (!current->release()) continue; // Another tree still uses it and everything below it
+        if (current->getBro() != NULL) s.push(current->getBro());
+        if (current->getSons() != NULL) s.push(current->getSons());
+        FREE_NODE(current);
     }
+}
+
+template <class elem>
+void NTree<elem>::DESTROY_NODES() {
+    // Arena nodes belong to this tree alone, so with no destructors to run the arena just rewinds
+    if (this->arena == NULL || !TrivialDestructor<elem>::value) RELEASE_NODES(this->root);
+    if (this->arena != NULL) this->arena->reset();
     this->root = NULL; // Important after deleting all nodes
     this->weight = 0;
+    this->nodesShared = false;
 }
 
 template <class elem>
 int NTree<elem>::COUNT_NODES(const NodeNTree<elem>* node) const {
     if (node == NULL) return 0;
-    // Count this node + nodes in first child's subtree + nodes in sibling's subtree
-    return 1 + COUNT_NODES(node->getSons()) + COUNT_NODES(node->getBro());
+    // Count this node + nodes in first child's subtree + nodes in sibling's subtree,
+    // with an explicit stack since long sibling chains would otherwise recurse once per node
+    int count = 0;
+    std::stack<const NodeNTree<elem>*> s;
+    s.push(node);
+    while (!s.empty()) {
+        const NodeNTree<elem>* current = s.top(); s.pop();
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size() + 1);
+        count++;
+        if (current->getBro() != NULL) s.push(current->getBro());
+        if (current->getSons() != NULL) s.push(current->getSons());
+    }
+    return count;
 }
 
 template <class elem>
 void NTree<elem>::PRE_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const {
+    TREE_STAT_RECURSION();
     if (node != NULL) {
+        TREE_STAT_VISIT();
         resultList.push_back(node->getInfo()); // Visit Root
         NodeNTree<elem>* child = node->getSons();
         while (child != NULL) { // Recurse on children (via siblings)
@@ -141,7 +340,9 @@ void NTree<elem>::PRE_ORDER(const NodeNTree<elem>* node, std::list<elem>& result
 
 template <class elem>
 void NTree<elem>::IN_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const {
+    TREE_STAT_RECURSION();
     if (node != NULL) {
+        TREE_STAT_VISIT();
         // 1. Recurse on the first child
         IN_ORDER(node->getSons(), resultList);
         // 2. Visit the root
@@ -159,7 +360,9 @@ void NTree<elem>::IN_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultL
 
 template <class elem>
 void NTree<elem>::POST_ORDER(const NodeNTree<elem>* node, std::list<elem>& resultList) const {
+    TREE_STAT_RECURSION();
     if (node != NULL) {
+        TREE_STAT_VISIT();
         // 1. Recurse on children (via siblings)
         NodeNTree<elem>* child = node->getSons();
         while (child != NULL) {
@@ -178,6 +381,7 @@ void NTree<elem>::LEVEL_ORDER_HELPER(const NodeNTree<elem>* node, std::list<elem
     q.push(node);
     while (!q.empty()) {
         const NodeNTree<elem>* current = q.front();
+        TREE_STAT_VISIT();
         q.pop();
         resultList.push_back(current->getInfo());
         // Enqueue all children of the current node
@@ -190,43 +394,38 @@ void NTree<elem>::LEVEL_ORDER_HELPER(const NodeNTree<elem>* node, std::list<elem
 }
 
 template <class elem>
-void NTree<elem>::LEVEL_ORDER_EXACT_HELPER(const NodeNTree<elem>* node, std::list<std::string>& resultList) const {
-    // Uses NULL marker in queue to detect level changes
-    if (node == NULL) return;
-    std::queue<const NodeNTree<elem>*> q;
-    q.push(node);
-    q.push(NULL); // Level End Marker
-
-    while (q.size() > 1) { // Continue while more than just the marker is present
-        const NodeNTree<elem>* current = q.front();
-        q.pop();
-
-        if (current == NULL) {
-            resultList.push_back("-"); // Add level separator string
-            q.push(NULL); // Add marker for the next level
-        } else {
-            // Convert element to string (requires elem to be convertible or overload needed)
-            // This part is tricky without C++11 to_string or specific type knowledge
-            // Assuming a simple stream insertion for demonstration
-            // Replace with appropriate conversion for your 'elem' type
-            std::ostringstream oss;
-            oss << current->getInfo();
-            resultList.push_back(oss.str());
-
-            // Enqueue children
-            NodeNTree<elem>* child = current->getSons();
-            while (child != NULL) {
-                q.push(child);
-                child = child->getBro();
+void NTree<elem>::BUILD_LEVEL_INDEX() const {
+    // The BFS order vector doubles as the queue; a level ends where the previous level's children stopped
+    std::vector<const NodeNTree<elem>*> order;
+    levelValues.clear();
+    levelOffsets.clear();
+    if (this->root != NULL) {
+        order.reserve(this->weight > 0 ? this->weight : 1);
+        order.push_back(this->root);
+        levelOffsets.push_back(0);
+        size_t levelEnd = 1;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i == levelEnd) {
+                levelOffsets.push_back((int)i);
+                levelEnd = order.size();
+            }
+            TREE_STAT_VISIT();
+            for (const NodeNTree<elem>* child = order[i]->getSons(); child != NULL; child = child->getBro()) {
+                order.push_back(child);
             }
         }
+        levelValues.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) levelValues.push_back(order[i]->getInfo());
     }
+    levelOffsets.push_back((int)levelValues.size());
+    levelIndexValid = true;
 }
 
-
 template <class elem>
 void NTree<elem>::GET_HEIGHT(const NodeNTree<elem>* node, int currentLevel, int& maxLevelReached) const {
+    TREE_STAT_RECURSION();
     if (node != NULL) {
+        TREE_STAT_VISIT();
         if (currentLevel > maxLevelReached) {
             maxLevelReached = currentLevel;
         }
@@ -241,7 +440,9 @@ void NTree<elem>::GET_HEIGHT(const NodeNTree<elem>* node, int currentLevel, int&
 
 template <class elem>
 void NTree<elem>::GET_LEAVES(const NodeNTree<elem>* node, std::list<elem>& leafList) const {
+    TREE_STAT_RECURSION();
     if (node != NULL) {
+        TREE_STAT_VISIT();
         if (node->getSons() == NULL) { // Leaf node condition
             leafList.push_back(node->getInfo());
         } else {
@@ -259,6 +460,14 @@ template <class elem>
 void NTree<elem>::CLEAR() {
     DESTROY_NODES(); // Use the iterative helper
     // root and weight are reset inside DESTROY_NODES
+    this->nodeIndex.clear();
+    this->nodeIndexStale = false; // Empty, and so is the index
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+void NTree<elem>::INVALIDATE_CACHES() {
+    this->levelIndexValid = false;
 }
 
 template <class elem>
@@ -266,54 +475,152 @@ NodeNTree<elem>* NTree<elem>::FIND_NODE_PREORDER(NodeNTree<elem>* node, const el
     if (node == NULL) {
         return NULL;
     }
-    if (node->getInfo() == target) {
-        return node;
-    }
-    // Search children
-    NodeNTree<elem>* child = node->getSons();
-    while(child != NULL) {
-        NodeNTree<elem>* foundNode = FIND_NODE_PREORDER(child, target);
-        if (foundNode != NULL) {
-            return foundNode; // Found in child's subtree
+    // Explicit stack so degenerate (chain) trees cannot overflow the call stack
+    std::stack<NodeNTree<elem>*> s;
+    s.push(node);
+    while (!s.empty()) {
+        NodeNTree<elem>* current = s.top(); s.pop();
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size() + 1);
+        if (TREE_STAT_COMPARE(current->getInfo() == target)) {
+            return current;
         }
-        child = child->getBro(); // Check next sibling
+        if (current != node && current->getBro() != NULL) s.push(current->getBro()); // Check next sibling later
+        if (current->getSons() != NULL) s.push(current->getSons()); // Search children first
     }
     return NULL; // Not found in this subtree
 }
 
 template <class elem>
-void NTree<elem>::ATTACH_CHILDREN_HELPER(NodeNTree<elem>* parentNode, std::list< NTree<elem> >& childrenList) {
-    if (parentNode == NULL || childrenList.empty()) {
-        return;
+NodeNTree<elem>* NTree<elem>::FIND_NODE(const elem& target) {
+    if (!this->nodeIndexEnabled) {
+        return FIND_NODE_PREORDER(this->root, target);
+    }
+    if (this->nodeIndexStale) REBUILD_NODE_INDEX();
+    typename std::map<elem, IndexEntry>::iterator it = this->nodeIndex.find(target);
+    if (it == this->nodeIndex.end()) {
+        return NULL;
     }
+    if (it->second.node == NULL) {
+        // Ambiguous (or was, until a duplicate was removed): same answer as the unindexed search
+        NodeNTree<elem>* found = FIND_NODE_PREORDER(this->root, target);
+        if (it->second.count == 1) it->second.node = found;
+        return found;
+    }
+    return it->second.node;
+}
+
+template <class elem>
+void NTree<elem>::INDEX_NODE(NodeNTree<elem>* node) {
+    if (!this->nodeIndexEnabled || this->nodeIndexStale) return;
+    IndexEntry& entry = this->nodeIndex[node->getInfo()];
+    entry.count++;
+    entry.node = (entry.count == 1) ? node : NULL;
+}
 
-    // Clear existing children of the parent first? Arbol_n seemed to replace.
-    // Let's assume replacement. Need a recursive delete for children first.
+template <class elem>
+void NTree<elem>::INDEX_SUBTREE(NodeNTree<elem>* node) {
+    if (!this->nodeIndexEnabled || this->nodeIndexStale || node == NULL) return;
     std::stack<NodeNTree<elem>*> s;
-    if(parentNode->getSons() != NULL) s.push(parentNode->getSons());
-    parentNode->setSons(NULL); // Detach children before deleting
+    s.push(node);
     while (!s.empty()) {
         NodeNTree<elem>* current = s.top(); s.pop();
-        if (current->getBro() != NULL) s.push(current->getBro());
+        INDEX_NODE(current);
+        if (current != node && current->getBro() != NULL) s.push(current->getBro());
+        if (current->getSons() != NULL) s.push(current->getSons());
+    }
+}
+
+template <class elem>
+void NTree<elem>::UNINDEX_NODE(const NodeNTree<elem>* node) {
+    if (!this->nodeIndexEnabled || this->nodeIndexStale) return;
+    typename std::map<elem, IndexEntry>::iterator it = this->nodeIndex.find(node->getInfo());
+    if (it == this->nodeIndex.end()) return;
+    if (--it->second.count == 0) {
+        this->nodeIndex.erase(it);
+    } else {
+        it->second.node = NULL; // Survivor unknown; FIND_NODE re-resolves it on demand
+    }
+}
+
+template <class elem>
+void NTree<elem>::UNINDEX_SUBTREE(const NodeNTree<elem>* node) {
+    if (!this->nodeIndexEnabled || this->nodeIndexStale || node == NULL) return;
+    std::stack<const NodeNTree<elem>*> s;
+    s.push(node);
+    while (!s.empty()) {
+        const NodeNTree<elem>* current = s.top(); s.pop();
+        UNINDEX_NODE(current);
+        if (current != node && current->getBro() != NULL) s.push(current->getBro());
         if (current->getSons() != NULL) s.push(current->getSons());
-        this->weight--; // Decrement weight for each deleted node
-        delete current;
     }
+}
 
-    // Attach new children
+template <class elem>
+bool NTree<elem>::FIND_NODE_PATH(const elem& target, std::vector<NodeNTree<elem>*>& path) const {
+    // Pre-order over the sons/bro links, keeping the chain of links that leads to the current node
+    path.clear();
+    if (this->root == NULL) return false;
+    std::stack< std::pair<NodeNTree<elem>*, int> > s;
+    s.push(std::make_pair(this->root, 0));
+    while (!s.empty()) {
+        NodeNTree<elem>* current = s.top().first;
+        int depth = s.top().second;
+        s.pop();
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size() + 1);
+        path.resize(depth);
+        path.push_back(current);
+        if (TREE_STAT_COMPARE(current->getInfo() == target)) return true;
+        if (depth > 0 && current->getBro() != NULL) s.push(std::make_pair(current->getBro(), depth + 1));
+        if (current->getSons() != NULL) s.push(std::make_pair(current->getSons(), depth + 1));
+    }
+    path.clear();
+    return false;
+}
+
+template <class elem>
+void NTree<elem>::REBUILD_NODE_INDEX() {
+    this->nodeIndex.clear();
+    this->nodeIndexStale = false;
+    INDEX_SUBTREE(this->root);
+}
+
+template <class elem>
+void NTree<elem>::ATTACH_CHILDREN_HELPER(NodeNTree<elem>* parentNode, std::list< NTree<elem> >& childrenList) {
+    // parentNode must already be private to this tree (see UNSHARE_PATH)
+    if (parentNode == NULL || childrenList.empty()) {
+        return;
+    }
+    INVALIDATE_CACHES();
+
+    // Replace the existing children: drop this tree's reference to them
+    NodeNTree<elem>* oldChildren = parentNode->getSons();
+    if (oldChildren != NULL) {
+        if (this->weight >= 0) this->weight -= COUNT_NODES(oldChildren); // Counts the whole sibling chain
+        for (NodeNTree<elem>* child = oldChildren; child != NULL; child = child->getBro()) {
+            UNINDEX_SUBTREE(child);
+        }
+        parentNode->setSons(NULL); // Detach children before releasing
+        RELEASE_NODES(oldChildren);
+    }
+
+    // Attach new children, sharing everything below each child root
     NodeNTree<elem>* lastNewSibling = NULL;
     while(!childrenList.empty()) {
         NTree<elem>& childTree = childrenList.front(); // Get reference to first child tree
-        NodeNTree<elem>* newChildNode = COPY_NODES(childTree.root); // Copy it
-        int childWeight = COUNT_NODES(newChildNode); // Count nodes in copied child
-        this->weight += childWeight; // Add to total weight
-
-        if (lastNewSibling == NULL) { // This is the first child
-            parentNode->setSons(newChildNode);
-        } else { // Link as sibling of the previous new child
-            lastNewSibling->setBro(newChildNode);
+        if (!childTree.isEmpty()) {
+            NodeNTree<elem>* newChildNode = SHARE_AS_ROOT(childTree, childTree.root);
+            if (this->weight >= 0) this->weight = (childTree.weight >= 0) ? this->weight + childTree.weight : -1;
+
+            if (lastNewSibling == NULL) { // This is the first child
+                parentNode->setSons(newChildNode);
+            } else { // Link as sibling of the previous new child
+                lastNewSibling->setBro(newChildNode);
+            }
+            lastNewSibling = newChildNode; // Update last added sibling
+            INDEX_SUBTREE(newChildNode);
         }
-        lastNewSibling = newChildNode; // Update last added sibling
 
         childrenList.pop_front(); // Remove from input list
     }
@@ -323,9 +630,11 @@ void NTree<elem>::ATTACH_CHILDREN_HELPER(NodeNTree<elem>* parentNode, std::list<
 // --- Path Helpers ---
 template <class elem>
 void NTree<elem>::FIND_PATH(const NodeNTree<elem>* node, std::list<elem>& currentPath, const elem& target, bool& found) const {
+    TREE_STAT_RECURSION();
     if (node == NULL || found) return;
+    TREE_STAT_VISIT();
     currentPath.push_back(node->getInfo());
-    if (node->getInfo() == target) { found = true; return; }
+    if (TREE_STAT_COMPARE(node->getInfo() == target)) { found = true; return; }
 
     NodeNTree<elem>* child = node->getSons();
     while (child != NULL && !found) {
@@ -340,13 +649,15 @@ void NTree<elem>::FIND_PATH(const NodeNTree<elem>* node, std::list<elem>& curren
 
 template <class elem>
 void NTree<elem>::FIND_PATHS_TO_TWO(const NodeNTree<elem>* node, std::list<elem>& path1, std::list<elem>& path2, const elem& target1, const elem& target2, bool& found1, bool& found2) const {
+     TREE_STAT_RECURSION();
      if (node == NULL || (found1 && found2)) return;
+     TREE_STAT_VISIT();
 
      if (!found1) path1.push_back(node->getInfo());
      if (!found2) path2.push_back(node->getInfo());
 
-     if (node->getInfo() == target1) found1 = true;
-     if (node->getInfo() == target2) found2 = true;
+     if (TREE_STAT_COMPARE(node->getInfo() == target1)) found1 = true;
+     if (TREE_STAT_COMPARE(node->getInfo() == target2)) found2 = true;
 
      if (found1 && found2) return;
 
@@ -365,7 +676,7 @@ template <class elem>
 void NTree<elem>::COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> path1, std::list<elem> path2) const {
     // Same logic as BinTree version
     elem lca; bool lcaFound = false;
-    while (!path1.empty() && !path2.empty() && path1.front() == path2.front()) {
+    while (!path1.empty() && !path2.empty() && TREE_STAT_COMPARE(path1.front() == path2.front())) {
         lca = path1.front(); lcaFound = true; path1.pop_front(); path2.pop_front();
     }
     resultPath.clear();
@@ -380,74 +691,136 @@ void NTree<elem>::COMBINE_PATHS(std::list<elem>& resultPath, std::list<elem> pat
 }
 
 template <class elem>
-void NTree<elem>::UPDATE_LONGEST_PATH(std::list<elem>& currentLongest, std::list<elem>& path1, std::list<elem>& path2, const std::list<elem>& newBranch) const {
-    // Same logic as BinTree version
-    std::list<elem> diameter1, diameter2;
-    if (!path1.empty()) { COMBINE_PATHS(diameter1, path1, newBranch); } else { path1 = newBranch; return; }
-    if (!path2.empty()) { COMBINE_PATHS(diameter2, path2, newBranch); } else {
-        path2 = newBranch; std::list<elem> initialDiameter; COMBINE_PATHS(initialDiameter, path1, path2);
-        if (initialDiameter.size() > currentLongest.size()) { currentLongest = initialDiameter; } return;
+int NTree<elem>::FIND_DIAMETER_APEX(const NodeNTree<elem>* node, const NodeNTree<elem>*& apex) const {
+    apex = NULL;
+    if (node == NULL) return -1;
+    int longest = -1;
+    std::vector<DiameterFrame> s;
+    s.push_back(DiameterFrame(node));
+    while (!s.empty()) {
+        DiameterFrame& frame = s.back();
+        if (frame.nextChild != NULL) {
+            const NodeNTree<elem>* child = frame.nextChild;
+            frame.nextChild = child->getBro();
+            TREE_STAT_VISIT();
+            TREE_STAT_DEPTH(s.size() + 1);
+            s.push_back(DiameterFrame(child));
+            continue;
+        }
+        // All children finished: the longest path through this node joins its two tallest branches
+        int through = (frame.best1 + 1) + (frame.best2 + 1);
+        if (through > longest) {
+            longest = through;
+            apex = frame.node;
+        }
+        int height = frame.best1 + 1;
+        s.pop_back();
+        if (!s.empty()) {
+            DiameterFrame& parent = s.back();
+            if (height > parent.best1) {
+                parent.best2 = parent.best1;
+                parent.best1 = height;
+            } else if (height > parent.best2) {
+                parent.best2 = height;
+            }
+        }
     }
-    if (diameter1.size() >= diameter2.size()) { if (diameter1.size() > currentLongest.size()) { currentLongest = diameter1; } }
-    else { if (diameter2.size() > currentLongest.size()) { currentLongest = diameter2; } }
-    if(diameter1.size() >= diameter2.size()) path2 = newBranch; else path1 = newBranch;
+    return longest;
+}
+
+template <class elem>
+int NTree<elem>::BRANCH_SIZE(const NodeNTree<elem>* node) const {
+    if (node == NULL) return 0;
+    return 1 + COUNT_NODES(node->getSons());
 }
 
 template <class elem>
-void NTree<elem>::FIND_DIAMETER(const NodeNTree<elem>* node, std::list<elem>& currentLongestPath, std::list<elem>& longestBranch1, std::list<elem>& longestBranch2, std::list<elem>& currentBranch) const {
+int NTree<elem>::BRANCH_HEIGHT(const NodeNTree<elem>* node) const {
+    if (node == NULL) return -1;
+    int height = 0;
+    std::stack< std::pair<const NodeNTree<elem>*, int> > s;
+    if (node->getSons() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)node->getSons(), 1));
+    while (!s.empty()) {
+        const NodeNTree<elem>* current = s.top().first;
+        int depth = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        if (depth > height) height = depth;
+        if (current->getBro() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getBro(), depth));
+        if (current->getSons() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getSons(), depth + 1));
+    }
+    return height;
+}
+
+template <class elem>
+void NTree<elem>::DEEPEST_BRANCH(const NodeNTree<elem>* node, std::list<elem>& branch) const {
     if (node == NULL) return;
-    currentBranch.push_back(node->getInfo());
-    if (node->getSons() == NULL) { // Leaf node check
-        UPDATE_LONGEST_PATH(currentLongestPath, longestBranch1, longestBranch2, currentBranch);
-    } else {
-        // Explore all children, updating branches
-        NodeNTree<elem>* child = node->getSons();
-         // Need separate branch states for each child exploration path
-        std::list<elem> b1_for_child = longestBranch1;
-        std::list<elem> b2_for_child = longestBranch2;
-        while (child != NULL) {
-            FIND_DIAMETER(child, currentLongestPath, b1_for_child, b2_for_child, currentBranch);
-            // How to update longestBranch1/2 based on child results?
-            // This logic from Arbol_n becomes complex here. A simpler diameter
-            // approach might be better, but adhering to Arbol_n's logic:
-            // We need to decide if the branches found down this child path
-            // should replace the current longest branches *for this level*.
-             longestBranch1 = b1_for_child; // Tentative update based on last child explored
-             longestBranch2 = b2_for_child; // Might not be correct overall update strategy
-             // Reset for next sibling? This requires careful state management.
-             b1_for_child = longestBranch1; // Pass potentially updated state to next sibling
-             b2_for_child = longestBranch2;
-            child = child->getBro();
-        }
+    int height = BRANCH_HEIGHT(node);
+    // path[d] is the current ancestor at depth d, so the branch is read off once the target depth is hit
+    std::vector<const NodeNTree<elem>*> path(1, node);
+    std::stack< std::pair<const NodeNTree<elem>*, int> > s;
+    if (height > 0) s.push(std::make_pair((const NodeNTree<elem>*)node->getSons(), 1));
+    while (!s.empty()) {
+        const NodeNTree<elem>* current = s.top().first;
+        int depth = s.top().second;
+        TREE_STAT_VISIT();
+        TREE_STAT_DEPTH(s.size());
+        s.pop();
+        path.resize(depth);
+        path.push_back(current);
+        if (depth == height) break;
+        if (current->getBro() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getBro(), depth));
+        if (current->getSons() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getSons(), depth + 1));
     }
-    currentBranch.pop_back();
+    for (size_t i = 0; i < path.size(); ++i) branch.push_back(path[i]->getInfo());
 }
 
 // --- Public Methods Definitions ---
 
 template <class elem>
 NTree<elem>::NTree() {
+    this->arena = NULL;
     this->root = NULL;
     this->weight = 0;
+    this->levelIndexValid = false;
+    this->nodeIndexEnabled = false;
+    this->nodeIndexStale = false;
+    this->nodesShared = false;
 }
 
 template <class elem>
 NTree<elem>::NTree(elem e) {
-    this->root = new NodeNTree<elem>(e);
+    this->arena = NULL;
+    this->root = NEW_NODE(e);
     this->weight = 1;
+    this->levelIndexValid = false;
+    this->nodeIndexEnabled = false;
+    this->nodeIndexStale = false;
+    this->nodesShared = false;
 }
 
 template <class elem>
 NTree<elem>::NTree(const NTree<elem>& otherTree) {
+    this->arena = (otherTree.arena != NULL) ? new NodeArena< NodeNTree<elem> >() : NULL; // The copy keeps the storage option
     this->root = NULL;
     this->weight = 0;
+    this->levelIndexValid = false;
+    this->nodeIndexEnabled = otherTree.nodeIndexEnabled;
+    this->nodeIndexStale = false;
+    this->nodesShared = false;
     *this = otherTree; // Use assignment operator
 }
 
 template <class elem>
 NTree<elem>::NTree(elem e, const std::list< NTree<elem> >& children) {
-    this->root = new NodeNTree<elem>(e);
+    this->arena = NULL;
+    this->root = NEW_NODE(e);
     this->weight = 1; // Start with root weight
+    this->levelIndexValid = false;
+    this->nodeIndexEnabled = false;
+    this->nodeIndexStale = false;
+    this->nodesShared = false;
     // Need mutable copy to pass to helper which modifies it
     std::list< NTree<elem> > childrenCopy = children;
     // Use a helper that correctly calculates weight delta? Simpler to recalculate.
@@ -456,17 +829,98 @@ NTree<elem>::NTree(elem e, const std::list< NTree<elem> >& children) {
     // this->weight = COUNT_NODES(this->root); // Ensure weight is correct
 }
 
+template <class elem>
+NTree<elem>::NTree(const std::list< std::pair<elem, elem> >& edges) {
+    TREE_STAT_OPERATION("NTree::NTree(edges)");
+    this->arena = NULL;
+    this->root = NULL;
+    this->weight = 0;
+    this->levelIndexValid = false;
+    this->nodeIndexEnabled = true;
+    this->nodeIndexStale = false;
+    this->nodesShared = false;
+    if (edges.empty()) return;
+
+    // One node per value; lastChild lets each edge append in O(1), so edge order becomes sibling order
+    typedef std::map<elem, EdgeBuildEntry> BuildMap;
+    BuildMap nodes;
+    const char* error = NULL;
+    for (typename std::list< std::pair<elem, elem> >::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+        EdgeBuildEntry& parent = nodes[it->first];
+        if (parent.node == NULL) parent.node = NEW_NODE(it->first);
+        EdgeBuildEntry& child = nodes[it->second];
+        if (child.node == NULL) child.node = NEW_NODE(it->second);
+        if (child.node == parent.node) {
+            error = "NTree edge list links a node to itself";
+            break;
+        }
+        if (child.hasParent) {
+            error = "NTree edge list gives a node two parents";
+            break;
+        }
+        child.hasParent = true;
+        if (parent.lastChild == NULL) parent.node->setSons(child.node);
+        else parent.lastChild->setBro(child.node);
+        parent.lastChild = child.node;
+    }
+
+    for (typename BuildMap::iterator it = nodes.begin(); it != nodes.end() && error == NULL; ++it) {
+        if (it->second.hasParent) continue;
+        if (this->root != NULL) error = "NTree edge list has more than one root";
+        else this->root = it->second.node;
+    }
+    if (error == NULL && this->root == NULL) error = "NTree edge list has no root";
+    if (error == NULL) {
+        // Every node has one parent, so the only way to miss nodes is a cycle detached from the root
+        this->weight = COUNT_NODES(this->root);
+        if (this->weight != (int)nodes.size()) error = "NTree edge list has nodes unreachable from the root";
+    }
+    if (error != NULL) {
+        // The links may be cyclic, so free through the map instead of walking them
+        for (typename BuildMap::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+            FREE_NODE(it->second.node);
+        }
+        this->root = NULL;
+        this->weight = 0;
+        throw std::runtime_error(error);
+    }
+
+    // Values are unique here and arrive sorted, so each insert is hinted at the end
+    IndexEntry entry;
+    entry.count = 1;
+    for (typename BuildMap::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        entry.node = it->second.node;
+        this->nodeIndex.insert(this->nodeIndex.end(), std::make_pair(it->first, entry));
+    }
+}
+
 template <class elem>
 NTree<elem>::~NTree() {
+    TREE_STAT_OPERATION("NTree::~NTree");
     DESTROY_NODES(); // Use iterative helper
+    delete this->arena;
 }
 
 template <class elem>
 NTree<elem>& NTree<elem>::operator=(const NTree<elem>& otherTree) {
+    TREE_STAT_OPERATION("NTree::operator=");
     if (this != &otherTree) {
-        CLEAR();
-        this->root = COPY_NODES(otherTree.root);
-        this->weight = otherTree.weight; // Weight matches copied structure
+        if (this->arena != NULL || otherTree.arena != NULL) {
+            // Arena nodes are copied, and only once CLEAR has rewound this tree's arena
+            CLEAR();
+            this->root = COPY_NODES(otherTree.root);
+        } else {
+            NodeNTree<elem>* shared = SHARE(otherTree.root); // Before CLEAR, in case this tree holds the last other reference
+            CLEAR();
+            this->root = shared;
+            if (shared != NULL) {
+                this->nodesShared = true;
+                otherTree.nodesShared = true;
+            }
+        }
+        this->weight = otherTree.weight;
+        // O(1) copy: the index is rebuilt by the first lookup, and mutations that avoid lookups never pay for it
+        this->nodeIndexStale = this->nodeIndexEnabled && this->root != NULL;
     }
     return *this;
 }
@@ -475,10 +929,8 @@ template <class elem>
 void NTree<elem>::copyFromPointer(const NTree<elem>* otherTreePtr) {
     if (otherTreePtr == NULL) {
         CLEAR();
-    } else if (this != otherTreePtr) {
-        CLEAR();
-        this->root = COPY_NODES(otherTreePtr->root);
-        this->weight = otherTreePtr->weight;
+    } else {
+        *this = *otherTreePtr;
     }
 }
 
@@ -489,6 +941,8 @@ bool NTree<elem>::isEmpty() const {
 
 template <class elem>
 int NTree<elem>::getWeight() const {
+    TREE_STAT_OPERATION("NTree::getWeight");
+    if (this->weight < 0) this->weight = COUNT_NODES(this->root);
     return this->weight;
 }
 
@@ -500,21 +954,16 @@ elem NTree<elem>::getRootInfo() const {
 
 template <class elem>
 std::list< NTree<elem> > NTree<elem>::getChildren() const {
+    TREE_STAT_OPERATION("NTree::getChildren");
     std::list< NTree<elem> > childrenList;
     if (!isEmpty()) {
         NodeNTree<elem>* currentChildNode = this->root->getSons();
         while (currentChildNode != NULL) {
-            // Create a temporary tree root for the child subtree
-            NTree<elem> childTree;
-            // Need to copy the *subtree* rooted at currentChildNode
-            // Temporarily detach siblings for correct copying? Arbol_n's approach was complex.
-            // Let's try a cleaner copy:
-            childTree.root = COPY_NODES(currentChildNode); // Copy the whole child structure
-            if(childTree.root) {
-               childTree.root->setBro(NULL); // Ensure copied child root has no siblings
-               childTree.weight = childTree.COUNT_NODES(childTree.root); // Set weight
-               childrenList.push_back(childTree);
-            }
+            // O(1) per child: a new root node sharing the child's own children
+            childrenList.push_back(NTree<elem>());
+            NTree<elem>& childTree = childrenList.back();
+            childTree.root = childTree.SHARE_AS_ROOT(*this, currentChildNode);
+            childTree.weight = -1; // Counted on demand
             currentChildNode = currentChildNode->getBro(); // Move to next sibling in original tree
         }
     }
@@ -524,117 +973,129 @@ std::list< NTree<elem> > NTree<elem>::getChildren() const {
 
 template <class elem>
 void NTree<elem>::insertSubtree(const NTree<elem>& subtree) {
+    TREE_STAT_OPERATION("NTree::insertSubtree");
     if (isEmpty() || subtree.isEmpty()) return; // Cannot insert into empty tree or insert empty tree
 
-    NodeNTree<elem>* newSubtreeRoot = COPY_NODES(subtree.root);
-    if (newSubtreeRoot == NULL) return; // Nothing to insert if copy failed
+    NodeNTree<elem>* newSubtreeRoot = SHARE_AS_ROOT(subtree, subtree.root);
 
-    int addedWeight = COUNT_NODES(newSubtreeRoot); // Weight of the copied subtree
-
-    NodeNTree<elem>* child = this->root->getSons();
+    // Copy-on-write along the root and its sibling chain up to the last child
+    NodeNTree<elem>* child = UNSHARE_NODE(NULL, false, this->root)->getSons();
     if (child == NULL) { // Root has no children yet
         this->root->setSons(newSubtreeRoot);
     } else { // Find the last sibling
+        child = UNSHARE_NODE(this->root, true, child);
         while (child->getBro() != NULL) {
-            child = child->getBro();
+            child = UNSHARE_NODE(child, false, child->getBro());
         }
         child->setBro(newSubtreeRoot); // Append new subtree
     }
-    this->weight += addedWeight; // Update weight
+    if (this->weight >= 0) this->weight = (subtree.weight >= 0) ? this->weight + subtree.weight : -1;
+    INDEX_SUBTREE(newSubtreeRoot);
+    INVALIDATE_CACHES();
 }
 
 template <class elem>
 bool NTree<elem>::removeSubtree(int position) {
+    TREE_STAT_OPERATION("NTree::removeSubtree");
     if (isEmpty() || position < 1 || this->root->getSons() == NULL) {
         return false; // Invalid position or no children
     }
+    // Check the position before copying anything
+    int childCount = 0;
+    for (const NodeNTree<elem>* child = this->root->getSons(); child != NULL && childCount < position; child = child->getBro()) {
+        childCount++;
+    }
+    if (childCount < position) {
+        return false; // Position out of bounds
+    }
 
     NodeNTree<elem>* nodeToRemove = NULL;
-    NodeNTree<elem>* prevSibling = NULL;
-    int currentPos = 1;
-
+    UNSHARE_NODE(NULL, false, this->root);
     if (position == 1) { // Removing the first child
         nodeToRemove = this->root->getSons();
-        this->root->setSons(nodeToRemove->getBro()); // Update root's first child
-    } else { // Removing a subsequent child
-        prevSibling = this->root->getSons();
-        currentPos = 2;
-        while (prevSibling != NULL && currentPos < position) {
-            prevSibling = prevSibling->getBro();
-            currentPos++;
-        }
-        // If prevSibling is NULL or we didn't reach the position's predecessor
-        if (prevSibling == NULL || prevSibling->getBro() == NULL) {
-            return false; // Position out of bounds
+        this->root->setSons(SHARE(nodeToRemove->getBro())); // Update root's first child
+    } else { // Removing a subsequent child: copy-on-write up to its predecessor
+        NodeNTree<elem>* prevSibling = UNSHARE_NODE(this->root, true, this->root->getSons());
+        for (int currentPos = 2; currentPos < position; currentPos++) {
+            prevSibling = UNSHARE_NODE(prevSibling, false, prevSibling->getBro());
         }
         nodeToRemove = prevSibling->getBro();
-        prevSibling->setBro(nodeToRemove->getBro()); // Link previous to next
+        prevSibling->setBro(SHARE(nodeToRemove->getBro())); // Link previous to next
     }
 
-    // Now destroy the removed subtree
-    if (nodeToRemove != NULL) {
-        nodeToRemove->setBro(NULL); // Isolate the subtree before destroying
-        // Need a recursive destructor helper that takes a node*
-        std::stack<NodeNTree<elem>*> s;
-        s.push(nodeToRemove);
-        int removedWeight = 0;
-        while(!s.empty()){
-            NodeNTree<elem>* curr = s.top(); s.pop();
-            if(curr->getBro() != NULL) s.push(curr->getBro());
-            if(curr->getSons() != NULL) s.push(curr->getSons());
-            delete curr;
-            removedWeight++;
-        }
-        this->weight -= removedWeight; // Update weight
-        return true;
-    }
-    return false; // Should not happen if logic above is correct
+    // Drop this tree's reference; the nodes are freed unless another tree shares them
+    if (this->weight >= 0) this->weight -= BRANCH_SIZE(nodeToRemove);
+    UNINDEX_SUBTREE(nodeToRemove);
+    RELEASE_NODES(nodeToRemove);
+    INVALIDATE_CACHES();
+    return true;
 }
 
 
 template <class elem>
 std::list<elem> NTree<elem>::preOrder() const {
+    TREE_STAT_OPERATION("NTree::preOrder");
     std::list<elem> r; PRE_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> NTree<elem>::inOrder() const {
+    TREE_STAT_OPERATION("NTree::inOrder");
     std::list<elem> r; IN_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> NTree<elem>::postOrder() const {
+    TREE_STAT_OPERATION("NTree::postOrder");
     std::list<elem> r; POST_ORDER(this->root, r); return r;
 }
 
 template <class elem>
 std::list<elem> NTree<elem>::levelOrder() const {
+    TREE_STAT_OPERATION("NTree::levelOrder");
     std::list<elem> r; LEVEL_ORDER_HELPER(this->root, r); return r;
 }
 
 template <class elem>
-std::list<std::string> NTree<elem>::getLevel(int level) const {
-    std::list<std::string> resultWithMarkers;
-    std::list<std::string> result;
-    LEVEL_ORDER_EXACT_HELPER(this->root, resultWithMarkers);
+std::list<elem> NTree<elem>::getLevel(int level) const {
+    TreeRange<typename std::vector<elem>::const_iterator> slice = getLevelSlice(level);
+    return std::list<elem>(slice.begin(), slice.end());
+}
 
-    int currentLevel = 0;
-    typename std::list<std::string>::const_iterator it = resultWithMarkers.begin();
-    while(it != resultWithMarkers.end()){
-        if (*it == "-") {
-            currentLevel++;
-        } else if (currentLevel == level) {
-            result.push_back(*it);
-        } else if (currentLevel > level) {
-            break;
-        }
-        ++it;
+template <class elem>
+TreeRange<typename std::vector<elem>::const_iterator> NTree<elem>::getLevelSlice(int level) const {
+    TREE_STAT_OPERATION("NTree::getLevelSlice");
+    if (!levelIndexValid) BUILD_LEVEL_INDEX();
+    if (level < 0 || level + 1 >= (int)levelOffsets.size()) {
+        return TreeRange<typename std::vector<elem>::const_iterator>(levelValues.end(), levelValues.end());
     }
-    return result;
+    return TreeRange<typename std::vector<elem>::const_iterator>(levelValues.begin() + levelOffsets[level],
+                                                                levelValues.begin() + levelOffsets[level + 1]);
+}
+
+template <class elem>
+typename NTree<elem>::const_iterator NTree<elem>::begin() const {
+    return const_iterator(this->root, TRAVERSE_PRE_ORDER);
+}
+
+template <class elem>
+typename NTree<elem>::const_iterator NTree<elem>::begin(TreeTraversal order, int level) const {
+    return const_iterator(this->root, order, level);
+}
+
+template <class elem>
+typename NTree<elem>::const_iterator NTree<elem>::end() const {
+    return const_iterator();
+}
+
+template <class elem>
+TreeRange<typename NTree<elem>::const_iterator> NTree<elem>::traverse(TreeTraversal order, int level) const {
+    return TreeRange<const_iterator>(begin(order, level), end());
 }
 
 template <class elem>
 int NTree<elem>::getHeight() const {
+    TREE_STAT_OPERATION("NTree::getHeight");
     int maxLevel = -1; // Empty tree height = -1
     GET_HEIGHT(this->root, 0, maxLevel); // Root at level 0
     return maxLevel;
@@ -642,11 +1103,19 @@ int NTree<elem>::getHeight() const {
 
 template <class elem>
 std::list<elem> NTree<elem>::getLeaves() const {
+    TREE_STAT_OPERATION("NTree::getLeaves");
     std::list<elem> r; GET_LEAVES(this->root, r); return r;
 }
 
+template <class elem>
+template <class Folder>
+typename Folder::Result NTree<elem>::fold(const Folder& folder, int cutoffDepth) const {
+    return TreeFold<NodeNTree<elem>, Folder>::run(this->root, folder, cutoffDepth);
+}
+
 template <class elem>
 std::list<elem> NTree<elem>::findPathToNode(const elem& target) const {
+    TREE_STAT_OPERATION("NTree::findPathToNode");
     std::list<elem> path; bool found = false;
     FIND_PATH(this->root, path, target, found);
     if (!found) path.clear();
@@ -655,6 +1124,7 @@ std::list<elem> NTree<elem>::findPathToNode(const elem& target) const {
 
 template <class elem>
 std::list<elem> NTree<elem>::findPathBetweenNodes(const elem& value1, const elem& value2) const {
+    TREE_STAT_OPERATION("NTree::findPathBetweenNodes");
     std::list<elem> p1, p2, res; bool f1=false, f2=false;
     FIND_PATHS_TO_TWO(this->root, p1, p2, value1, value2, f1, f2);
     if (f1 && f2) { COMBINE_PATHS(res, p1, p2); }
@@ -663,6 +1133,7 @@ std::list<elem> NTree<elem>::findPathBetweenNodes(const elem& value1, const elem
 
 template <class elem>
 elem NTree<elem>::lowestCommonAncestor(const elem& value1, const elem& value2) const {
+    TREE_STAT_OPERATION("NTree::lowestCommonAncestor");
     std::list<elem> path1, path2; bool f1=false, f2=false;
     FIND_PATHS_TO_TWO(this->root, path1, path2, value1, value2, f1, f2);
     if (!f1 || !f2) throw std::runtime_error("LCA: One or both elements not found");
@@ -677,34 +1148,140 @@ elem NTree<elem>::lowestCommonAncestor(const elem& value1, const elem& value2) c
 
 template <class elem>
 std::list<elem> NTree<elem>::getDiameterPath() const {
-    std::list<elem> longestPath; if (isEmpty()) return longestPath;
-    std::list<elem> branch1, branch2, currentBranch;
-    FIND_DIAMETER(this->root, longestPath, branch1, branch2, currentBranch);
-    if (longestPath.empty()) { return (branch1.size() >= branch2.size()) ? branch1 : branch2; }
+    TREE_STAT_OPERATION("NTree::getDiameterPath");
+    std::list<elem> longestPath;
+    const NodeNTree<elem>* apex = NULL;
+    if (FIND_DIAMETER_APEX(this->root, apex) < 0) return longestPath;
+
+    // Pick the two tallest children of the apex (earliest sibling wins ties)
+    const NodeNTree<elem>* first = NULL;
+    const NodeNTree<elem>* second = NULL;
+    int firstHeight = -1, secondHeight = -1;
+    for (const NodeNTree<elem>* child = apex->getSons(); child != NULL; child = child->getBro()) {
+        int h = BRANCH_HEIGHT(child);
+        if (h > firstHeight) {
+            second = first; secondHeight = firstHeight;
+            first = child; firstHeight = h;
+        } else if (h > secondHeight) {
+            second = child; secondHeight = h;
+        }
+    }
+
+    std::list<elem> branch1, branch2;
+    DEEPEST_BRANCH(first, branch1);
+    DEEPEST_BRANCH(second, branch2);
+    if (branch2.empty()) {
+        longestPath.push_back(apex->getInfo());
+        longestPath.splice(longestPath.end(), branch1);
+        return longestPath;
+    }
+    // Keep sibling order: the branch of the earlier child is written first, leaf to apex
+    bool firstIsEarlier = false;
+    for (const NodeNTree<elem>* child = apex->getSons(); child != NULL; child = child->getBro()) {
+        if (child == first) { firstIsEarlier = true; break; }
+        if (child == second) break;
+    }
+    if (!firstIsEarlier) branch1.swap(branch2);
+    branch1.reverse();
+    longestPath.splice(longestPath.end(), branch1);
+    longestPath.push_back(apex->getInfo());
+    longestPath.splice(longestPath.end(), branch2);
     return longestPath;
 }
 
 template <class elem>
 bool NTree<elem>::attachChildrenToNode(const elem& parentValue, const std::list< NTree<elem> >& children) {
+    TREE_STAT_OPERATION("NTree::attachChildrenToNode");
     if (children.empty()) return true; // Nothing to attach
 
-    NodeNTree<elem>* parentNode = FIND_NODE_PREORDER(this->root, parentValue);
+    // Make mutable copy as helper modifies list. Taken first: if this tree is among the
+    // children, the copy's references make the path below get copied instead of written
+    std::list< NTree<elem> > childrenCopy = children;
+    NodeNTree<elem>* parentNode = NULL;
+    if (!this->nodesShared) {
+        parentNode = FIND_NODE(parentValue); // Nothing is shared, so the node can be written in place
+    } else if (this->nodeIndexEnabled && !this->nodeIndexStale) {
+        // The index hands out the node but not its path, so make the whole tree private once
+        UNSHARE_ALL();
+        parentNode = FIND_NODE(parentValue);
+    } else {
+        std::vector<NodeNTree<elem>*> path;
+        if (FIND_NODE_PATH(parentValue, path)) {
+            UNSHARE_PATH(path);
+            parentNode = path.back();
+        }
+    }
     if (parentNode == NULL) {
         // Handle case where parentValue is meant to be the root and tree is empty
         if (isEmpty()) {
-            this->root = new NodeNTree<elem>(parentValue);
+            this->root = NEW_NODE(parentValue);
             this->weight = 1;
             parentNode = this->root;
+            INDEX_NODE(parentNode);
         } else {
             return false; // Parent node not found in non-empty tree
         }
     }
 
-    // Make mutable copy as helper modifies list
-    std::list< NTree<elem> > childrenCopy = children;
     ATTACH_CHILDREN_HELPER(parentNode, childrenCopy);
     // Weight is updated inside ATTACH_CHILDREN_HELPER now
     return true;
 }
 
-#endif // N_TREE_H_
\ No newline at end of file
+template <class elem>
+void NTree<elem>::enableNodeIndex() {
+    if (this->nodeIndexEnabled) return;
+    this->nodeIndexEnabled = true;
+    REBUILD_NODE_INDEX();
+}
+
+template <class elem>
+void NTree<elem>::disableNodeIndex() {
+    this->nodeIndexEnabled = false;
+    this->nodeIndexStale = false;
+    this->nodeIndex.clear();
+}
+
+template <class elem>
+void NTree<elem>::enableArena() {
+    if (this->arena != NULL) return;
+    NodeArena< NodeNTree<elem> >* newArena = new NodeArena< NodeNTree<elem> >();
+    NodeNTree<elem>* heapRoot = this->root;
+    this->arena = newArena;
+    this->root = COPY_NODES(heapRoot);
+    this->arena = NULL;
+    RELEASE_NODES(heapRoot);
+    this->arena = newArena;
+    this->nodesShared = false;
+    REBUILD_NODE_INDEX();
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+void NTree<elem>::disableArena() {
+    if (this->arena == NULL) return;
+    NodeArena< NodeNTree<elem> >* oldArena = this->arena;
+    int oldWeight = this->weight;
+    this->arena = NULL;
+    NodeNTree<elem>* heapRoot = COPY_NODES(this->root);
+    this->arena = oldArena;
+    DESTROY_NODES();
+    delete oldArena;
+    this->arena = NULL;
+    this->root = heapRoot;
+    this->weight = oldWeight;
+    REBUILD_NODE_INDEX();
+    INVALIDATE_CACHES();
+}
+
+template <class elem>
+bool NTree<elem>::usesArena() const {
+    return this->arena != NULL;
+}
+
+template <class elem>
+bool NTree<elem>::hasNodeIndex() const {
+    return this->nodeIndexEnabled;
+}
+
+#endif // N_TREE_H_
@@ -0,0 +1,524 @@
+#ifndef N_TREE_BP_H_
+#define N_TREE_BP_H_
+
+#include "n_tree_csr.h"
+#include <climits>
+#include <cstddef>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+// Byte lookup tables for the excess scans: bits are read from the least significant
+// end, an open paren (1) adds one and a close paren (0) subtracts one.
+struct BalancedParenTables {
+    signed char delta[256]; // Excess change over the whole byte
+    signed char minPrefix[256]; // Lowest excess reached after 1..8 of its bits
+
+    BalancedParenTables() {
+        for (int b = 0; b < 256; ++b) {
+            int excess = 0, lowest = 8;
+            for (int k = 0; k < 8; ++k) {
+                excess += ((b >> k) & 1) ? 1 : -1;
+                if (excess < lowest) lowest = excess;
+            }
+            delta[b] = (signed char)excess;
+            minPrefix[b] = (signed char)lowest;
+        }
+    }
+
+    static const BalancedParenTables& get() {
+        static const BalancedParenTables tables;
+        return tables;
+    }
+};
+
+// Read-only N-ary tree stored as balanced parentheses: a pre-order walk writes 1 on
+// entering a node and 0 on leaving it, so the structure costs 2 bits per node plus
+// about 20% of rank and range min-max directories. Node ids are pre-order ranks, the
+// same numbering as NTreeCSR; values are kept in a plain array in that order.
+//
+// Navigation works on the excess E(p) = opens - closes in bits [0, p]:
+//     a node's close is the first later position whose excess drops below the open's,
+//     its parent's open follows the last earlier position two levels up.
+// Both searches use a min tree over 512-bit blocks, so each primitive is O(log n).
+template <class elem>
+class NTreeBP {
+    private:
+        enum { WORD_BITS = 32, BLOCK_WORDS = 16, BLOCK_BITS = WORD_BITS * BLOCK_WORDS };
+
+        std::vector<unsigned int> bits;
+        int bitCount;
+        std::vector<elem> values;
+        std::vector<int> blockRank; // Opens before each block, plus the total at the end
+        std::vector<int> minTree; // Segment tree of each block's lowest excess; leaves start at leafBase
+        int leafBase;
+        int openDepth; // While building: nodes opened and not yet closed
+        bool built;
+
+        static int POPCOUNT(unsigned int word);
+        int BIT(int position) const;
+        int BYTE_AT(int position) const; // The 8 bits starting at a multiple of 8
+        int RANK1(int position) const; // Opens in [0, position)
+        int SELECT1(int rank) const; // Position of the open with that rank
+        int EXCESS(int position) const; // E(position); E(-1) = 0
+        int FWD_SCAN(int from, int to, int& excess, int target) const; // In one block; excess enters as E(from - 1)
+        int BWD_SCAN(int from, int to, int& excess, int target) const; // In one block, from down to to; excess enters as E(from)
+        int MIN_SCAN(int from, int to, int excess) const; // Lowest E in [from, to); excess is E(from - 1)
+        int NEXT_BLOCK_LE(int block, int target) const; // First block >= block whose minimum is <= target
+        int PREV_BLOCK_LE(int block, int target) const; // Last block <= block whose minimum is <= target
+        int FWD_SEARCH(int from, int target) const; // First q >= from with E(q) <= target, -1 if none
+        int BWD_SEARCH(int from, int target) const; // Last q <= from with E(q) <= target; -1 is the virtual start, -2 none
+        int RANGE_MIN(int from, int to) const; // Lowest E in [from, to]
+        int FIND_CLOSE(int position) const;
+        int ENCLOSE(int position) const; // Open of the parent, -1 for the root
+        void CHECK_NODE(int node) const;
+
+    public:
+        NTreeBP();
+        explicit NTreeBP(const NTree<elem>& tree);
+        explicit NTreeBP(const NTreeCSR<elem>& tree);
+
+        void build(const NTree<elem>& tree);
+        void build(const NTreeCSR<elem>& tree);
+
+        // Streaming construction for hierarchies too large to hold as an NTree first:
+        // openNode/closeNode in pre-order, then finish. Throws if the parentheses do not
+        // describe exactly one tree.
+        void clear();
+        void openNode(const elem& value);
+        void closeNode();
+        void finish();
+
+        bool isEmpty() const;
+        int getWeight() const;
+        size_t structureBytes() const; // Parentheses plus directories, values excluded
+
+        const elem& getInfo(int node) const;
+        int getParent(int node) const; // -1 for the root
+        int getFirstChild(int node) const; // -1 for a leaf
+        int getNextSibling(int node) const; // -1 for a last child
+        int getDepth(int node) const; // The root is at depth 0
+        int getSubtreeSize(int node) const;
+        int lowestCommonAncestorNode(int nodeA, int nodeB) const;
+
+        int findNode(const elem& value) const; // First match in pre-order, -1 if absent
+        std::list<elem> findPathToNode(const elem& target) const; // Same result as NTree::findPathToNode
+        elem lowestCommonAncestor(const elem& value1, const elem& value2) const; // Same result as NTree::lowestCommonAncestor
+};
+
+// --- Private Helpers ---
+
+template <class elem>
+int NTreeBP<elem>::POPCOUNT(unsigned int word) {
+    word = word - ((word >> 1) & 0x55555555u);
+    word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+    return (int)((((word + (word >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+
+template <class elem>
+int NTreeBP<elem>::BIT(int position) const {
+    return (bits[position / WORD_BITS] >> (position % WORD_BITS)) & 1u;
+}
+
+template <class elem>
+int NTreeBP<elem>::BYTE_AT(int position) const {
+    return (bits[position / WORD_BITS] >> (position % WORD_BITS)) & 0xFFu;
+}
+
+template <class elem>
+int NTreeBP<elem>::RANK1(int position) const {
+    int block = position / BLOCK_BITS;
+    int rank = blockRank[block];
+    int word = block * BLOCK_WORDS;
+    for (; word < position / WORD_BITS; ++word) rank += POPCOUNT(bits[word]);
+    if (position % WORD_BITS != 0) rank += POPCOUNT(bits[word] & ((1u << (position % WORD_BITS)) - 1u));
+    return rank;
+}
+
+template <class elem>
+int NTreeBP<elem>::SELECT1(int rank) const {
+    // Last block starting with at most rank opens, then words, then bits
+    int low = 0, high = (int)blockRank.size() - 2;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;
+        if (blockRank[middle] <= rank) low = middle;
+        else high = middle - 1;
+    }
+    int remaining = rank - blockRank[low];
+    int word = low * BLOCK_WORDS;
+    for (;; ++word) {
+        int count = POPCOUNT(bits[word]);
+        if (remaining < count) break;
+        remaining -= count;
+    }
+    unsigned int w = bits[word];
+    for (; remaining > 0; --remaining) w &= w - 1u; // Drop the lower opens
+    int bit = 0;
+    while (((w >> bit) & 1u) == 0) ++bit;
+    return word * WORD_BITS + bit;
+}
+
+template <class elem>
+int NTreeBP<elem>::EXCESS(int position) const {
+    return 2 * RANK1(position + 1) - (position + 1);
+}
+
+template <class elem>
+int NTreeBP<elem>::FWD_SCAN(int from, int to, int& excess, int target) const {
+    const BalancedParenTables& tables = BalancedParenTables::get();
+    while (from < to) {
+        if (from % 8 == 0 && from + 8 <= to) {
+            int byte = BYTE_AT(from);
+            if (excess + tables.minPrefix[byte] > target) {
+                excess += tables.delta[byte];
+                from += 8;
+                continue;
+            }
+        }
+        excess += BIT(from) ? 1 : -1;
+        if (excess <= target) return from;
+        ++from;
+    }
+    return -1;
+}
+
+template <class elem>
+int NTreeBP<elem>::BWD_SCAN(int from, int to, int& excess, int target) const {
+    const BalancedParenTables& tables = BalancedParenTables::get();
+    while (from >= to) {
+        if (from % 8 == 7 && from - 7 >= to) {
+            int byte = BYTE_AT(from - 7);
+            int before = excess - tables.delta[byte]; // E(from - 8)
+            if (before + tables.minPrefix[byte] > target) {
+                excess = before;
+                from -= 8;
+                continue;
+            }
+        }
+        if (excess <= target) return from;
+        excess -= BIT(from) ? 1 : -1;
+        --from;
+    }
+    return -1;
+}
+
+template <class elem>
+int NTreeBP<elem>::MIN_SCAN(int from, int to, int excess) const {
+    const BalancedParenTables& tables = BalancedParenTables::get();
+    int lowest = INT_MAX;
+    while (from < to) {
+        if (from % 8 == 0 && from + 8 <= to) {
+            int byte = BYTE_AT(from);
+            if (excess + tables.minPrefix[byte] < lowest) lowest = excess + tables.minPrefix[byte];
+            excess += tables.delta[byte];
+            from += 8;
+            continue;
+        }
+        excess += BIT(from) ? 1 : -1;
+        if (excess < lowest) lowest = excess;
+        ++from;
+    }
+    return lowest;
+}
+
+template <class elem>
+int NTreeBP<elem>::NEXT_BLOCK_LE(int block, int target) const {
+    if (block >= leafBase || minTree.empty()) return -1;
+    int i = leafBase + block;
+    while (minTree[i] > target) {
+        while (i & 1) i >>= 1; // Climb while we are a right child
+        if (i == 0) return -1;
+        ++i; // Next subtree to the right
+    }
+    while (i < leafBase) {
+        i = 2 * i;
+        if (minTree[i] > target) ++i;
+    }
+    return i - leafBase;
+}
+
+template <class elem>
+int NTreeBP<elem>::PREV_BLOCK_LE(int block, int target) const {
+    if (block < 0 || minTree.empty()) return -1;
+    int i = leafBase + block;
+    while (minTree[i] > target) {
+        while ((i & 1) == 0) i >>= 1; // Climb while we are a left child
+        if (i == 1) return -1;
+        --i; // Next subtree to the left
+    }
+    while (i < leafBase) {
+        i = 2 * i + 1;
+        if (minTree[i] > target) --i;
+    }
+    return i - leafBase;
+}
+
+template <class elem>
+int NTreeBP<elem>::FWD_SEARCH(int from, int target) const {
+    if (from >= bitCount) return -1;
+    int excess = EXCESS(from - 1);
+    int block = from / BLOCK_BITS;
+    int end = (block + 1) * BLOCK_BITS < bitCount ? (block + 1) * BLOCK_BITS : bitCount;
+    int found = FWD_SCAN(from, end, excess, target);
+    if (found >= 0) return found;
+    block = NEXT_BLOCK_LE(block + 1, target);
+    if (block < 0) return -1;
+    int start = block * BLOCK_BITS;
+    excess = 2 * blockRank[block] - start;
+    end = start + BLOCK_BITS < bitCount ? start + BLOCK_BITS : bitCount;
+    return FWD_SCAN(start, end, excess, target);
+}
+
+template <class elem>
+int NTreeBP<elem>::BWD_SEARCH(int from, int target) const {
+    if (from >= 0) {
+        int excess = EXCESS(from);
+        int block = from / BLOCK_BITS;
+        int found = BWD_SCAN(from, block * BLOCK_BITS, excess, target);
+        if (found >= 0) return found;
+        block = PREV_BLOCK_LE(block - 1, target);
+        if (block >= 0) {
+            int last = ((block + 1) * BLOCK_BITS < bitCount ? (block + 1) * BLOCK_BITS : bitCount) - 1;
+            excess = EXCESS(last);
+            return BWD_SCAN(last, block * BLOCK_BITS, excess, target);
+        }
+    }
+    return (target >= 0) ? -1 : -2;
+}
+
+template <class elem>
+int NTreeBP<elem>::RANGE_MIN(int from, int to) const {
+    int firstBlock = from / BLOCK_BITS, lastBlock = to / BLOCK_BITS;
+    if (firstBlock == lastBlock) return MIN_SCAN(from, to + 1, EXCESS(from - 1));
+    int lowest = MIN_SCAN(from, (firstBlock + 1) * BLOCK_BITS, EXCESS(from - 1));
+    int tail = MIN_SCAN(lastBlock * BLOCK_BITS, to + 1, 2 * blockRank[lastBlock] - lastBlock * BLOCK_BITS);
+    if (tail < lowest) lowest = tail;
+    // Whole blocks in between, bottom-up over the min tree
+    for (int l = leafBase + firstBlock + 1, r = leafBase + lastBlock - 1; l <= r; l = (l + 1) / 2, r = (r - 1) / 2) {
+        if ((l & 1) && minTree[l] < lowest) lowest = minTree[l];
+        if (!(r & 1) && minTree[r] < lowest) lowest = minTree[r];
+        if (l == r) break;
+    }
+    return lowest;
+}
+
+template <class elem>
+int NTreeBP<elem>::FIND_CLOSE(int position) const {
+    return FWD_SEARCH(position + 1, EXCESS(position) - 1);
+}
+
+template <class elem>
+int NTreeBP<elem>::ENCLOSE(int position) const {
+    if (position == 0) return -1;
+    return BWD_SEARCH(position - 1, EXCESS(position) - 2) + 1;
+}
+
+template <class elem>
+void NTreeBP<elem>::CHECK_NODE(int node) const {
+    if (!built || node < 0 || node >= (int)values.size()) throw std::out_of_range("NTreeBP node index out of range");
+}
+
+// --- Public Methods ---
+
+template <class elem>
+NTreeBP<elem>::NTreeBP() {
+    clear();
+}
+
+template <class elem>
+NTreeBP<elem>::NTreeBP(const NTree<elem>& tree) {
+    build(tree);
+}
+
+template <class elem>
+NTreeBP<elem>::NTreeBP(const NTreeCSR<elem>& tree) {
+    build(tree);
+}
+
+template <class elem>
+void NTreeBP<elem>::build(const NTree<elem>& tree) {
+    build(NTreeCSR<elem>(tree));
+}
+
+template <class elem>
+void NTreeBP<elem>::build(const NTreeCSR<elem>& tree) {
+    // Pre-order ids with subtree sizes say where every close goes
+    clear();
+    int n = tree.getWeight();
+    values.reserve(n);
+    bits.reserve((2 * n + WORD_BITS - 1) / WORD_BITS);
+    std::vector<int> subtreeEnds;
+    for (int i = 0; i < n; ++i) {
+        while (!subtreeEnds.empty() && subtreeEnds.back() <= i) {
+            closeNode();
+            subtreeEnds.pop_back();
+        }
+        openNode(tree.getInfo(i));
+        subtreeEnds.push_back(i + tree.getSubtreeSize(i));
+    }
+    for (size_t k = 0; k < subtreeEnds.size(); ++k) closeNode();
+    finish();
+}
+
+template <class elem>
+void NTreeBP<elem>::clear() {
+    bits.clear();
+    bitCount = 0;
+    values.clear();
+    blockRank.clear();
+    minTree.clear();
+    leafBase = 0;
+    openDepth = 0;
+    built = false;
+}
+
+template <class elem>
+void NTreeBP<elem>::openNode(const elem& value) {
+    if (built) throw std::runtime_error("NTreeBP is finished; clear it before building again");
+    if (openDepth == 0 && bitCount > 0) throw std::runtime_error("NTreeBP can only hold one root");
+    if (bitCount % WORD_BITS == 0) bits.push_back(0u);
+    bits.back() |= 1u << (bitCount % WORD_BITS);
+    bitCount++;
+    values.push_back(value);
+    openDepth++;
+}
+
+template <class elem>
+void NTreeBP<elem>::closeNode() {
+    if (built || openDepth == 0) throw std::runtime_error("NTreeBP closeNode without an open node");
+    if (bitCount % WORD_BITS == 0) bits.push_back(0u);
+    bitCount++;
+    openDepth--;
+}
+
+template <class elem>
+void NTreeBP<elem>::finish() {
+    if (built) return;
+    if (openDepth != 0) throw std::runtime_error("NTreeBP has nodes that were never closed");
+    int blocks = (bitCount + BLOCK_BITS - 1) / BLOCK_BITS;
+    bits.resize((size_t)blocks * BLOCK_WORDS, 0u); // Whole blocks keep the scans branch-free at the end
+    blockRank.assign(blocks + 1, 0);
+    leafBase = 1;
+    while (leafBase < blocks) leafBase *= 2;
+    minTree.assign(2 * leafBase, INT_MAX);
+    const BalancedParenTables& tables = BalancedParenTables::get();
+    int excess = 0;
+    for (int block = 0; block < blocks; ++block) {
+        blockRank[block] = (excess + block * BLOCK_BITS) / 2;
+        int end = (block + 1) * BLOCK_BITS < bitCount ? (block + 1) * BLOCK_BITS : bitCount;
+        int lowest = INT_MAX;
+        for (int p = block * BLOCK_BITS; p < end; ) {
+            if (p + 8 <= end) {
+                int byte = BYTE_AT(p);
+                if (excess + tables.minPrefix[byte] < lowest) lowest = excess + tables.minPrefix[byte];
+                excess += tables.delta[byte];
+                p += 8;
+            } else {
+                excess += BIT(p) ? 1 : -1;
+                if (excess < lowest) lowest = excess;
+                ++p;
+            }
+        }
+        minTree[leafBase + block] = lowest;
+    }
+    blockRank[blocks] = (int)values.size();
+    for (int i = leafBase - 1; i >= 1; --i) {
+        minTree[i] = minTree[2 * i] < minTree[2 * i + 1] ? minTree[2 * i] : minTree[2 * i + 1];
+    }
+    built = true;
+}
+
+template <class elem>
+bool NTreeBP<elem>::isEmpty() const {
+    return values.empty();
+}
+
+template <class elem>
+int NTreeBP<elem>::getWeight() const {
+    return (int)values.size();
+}
+
+template <class elem>
+size_t NTreeBP<elem>::structureBytes() const {
+    return bits.size() * sizeof(unsigned int) + blockRank.size() * sizeof(int) + minTree.size() * sizeof(int);
+}
+
+template <class elem>
+const elem& NTreeBP<elem>::getInfo(int node) const {
+    CHECK_NODE(node);
+    return values[node];
+}
+
+template <class elem>
+int NTreeBP<elem>::getParent(int node) const {
+    CHECK_NODE(node);
+    int parent = ENCLOSE(SELECT1(node));
+    return (parent < 0) ? -1 : RANK1(parent);
+}
+
+template <class elem>
+int NTreeBP<elem>::getFirstChild(int node) const {
+    CHECK_NODE(node);
+    int position = SELECT1(node);
+    return (position + 1 < bitCount && BIT(position + 1)) ? node + 1 : -1;
+}
+
+template <class elem>
+int NTreeBP<elem>::getNextSibling(int node) const {
+    CHECK_NODE(node);
+    int position = SELECT1(node);
+    int close = FIND_CLOSE(position);
+    return (close + 1 < bitCount && BIT(close + 1)) ? node + (close - position + 1) / 2 : -1;
+}
+
+template <class elem>
+int NTreeBP<elem>::getDepth(int node) const {
+    CHECK_NODE(node);
+    return EXCESS(SELECT1(node)) - 1;
+}
+
+template <class elem>
+int NTreeBP<elem>::getSubtreeSize(int node) const {
+    CHECK_NODE(node);
+    int position = SELECT1(node);
+    return (FIND_CLOSE(position) - position + 1) / 2;
+}
+
+template <class elem>
+int NTreeBP<elem>::lowestCommonAncestorNode(int nodeA, int nodeB) const {
+    CHECK_NODE(nodeA);
+    CHECK_NODE(nodeB);
+    if (nodeA == nodeB) return nodeA;
+    if (nodeB < nodeA) std::swap(nodeA, nodeB);
+    int first = SELECT1(nodeA), second = SELECT1(nodeB);
+    if (FIND_CLOSE(first) > second) return nodeA; // nodeA is an ancestor of nodeB
+    // The first minimum between them closes the child of the LCA that holds nodeA
+    int lowest = FWD_SEARCH(first, RANGE_MIN(first, second));
+    return RANK1(ENCLOSE(lowest + 1));
+}
+
+template <class elem>
+int NTreeBP<elem>::findNode(const elem& value) const {
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i] == value) return (int)i;
+    }
+    return -1;
+}
+
+template <class elem>
+std::list<elem> NTreeBP<elem>::findPathToNode(const elem& target) const {
+    std::list<elem> path;
+    for (int node = findNode(target); node >= 0; node = getParent(node)) {
+        path.push_front(values[node]);
+    }
+    return path;
+}
+
+template <class elem>
+elem NTreeBP<elem>::lowestCommonAncestor(const elem& value1, const elem& value2) const {
+    int node1 = findNode(value1), node2 = findNode(value2);
+    if (node1 < 0 || node2 < 0) throw std::runtime_error("LCA: One or both elements not found");
+    return values[lowestCommonAncestorNode(node1, node2)];
+}
+
+#endif // N_TREE_BP_H_
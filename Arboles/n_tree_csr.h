@@ -0,0 +1,287 @@
+#ifndef N_TREE_CSR_H_
+#define N_TREE_CSR_H_
+
+#include "n_tree.h"
+#include <cstddef>
+#include <list>
+#include <stack>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <class elem> class NTreeCSR;
+
+// Zero-copy handle to the subtree rooted at one node of an NTreeCSR.
+// Only valid while the NTreeCSR it points into is alive.
+template <class elem>
+class NTreeCSRView {
+    private:
+        const NTreeCSR<elem>* tree;
+        int node;
+    public:
+        NTreeCSRView() : tree(NULL), node(-1) {}
+        NTreeCSRView(const NTreeCSR<elem>* tree, int node) : tree(tree), node(node) {}
+
+        bool isEmpty() const { return tree == NULL || node < 0; }
+        int getNode() const { return node; }
+        const elem& getRootInfo() const { return tree->getInfo(node); }
+        int getWeight() const { return tree->getSubtreeSize(node); }
+        int childCount() const { return tree->childCount(node); }
+        NTreeCSRView<elem> getChild(int position) const { return NTreeCSRView<elem>(tree, tree->getChild(node, position)); }
+        std::vector< NTreeCSRView<elem> > getChildren() const;
+        // Nodes are numbered in pre-order, so a subtree's pre-order is a contiguous run of values
+        TreeRange<typename std::vector<elem>::const_iterator> preOrder() const { return tree->preOrderSlice(node); }
+        void toNTree(NTree<elem>& target) const { tree->toNTree(target, node); }
+};
+
+// Frozen N-ary tree in compressed sparse row form: node i (numbered in pre-order)
+// has its children at childIndex[childOffsets[i] .. childOffsets[i + 1]).
+template <class elem>
+class NTreeCSR {
+    private:
+        std::vector<elem> values;
+        std::vector<int> childOffsets;
+        std::vector<int> childIndex;
+        std::vector<int> subtreeSizes;
+
+        void CHECK_NODE(int node) const;
+
+    public:
+        NTreeCSR();
+        explicit NTreeCSR(const NTree<elem>& tree);
+
+        void build(const NTree<elem>& tree);
+        void toNTree(NTree<elem>& target) const;
+        void toNTree(NTree<elem>& target, int node) const;
+
+        bool isEmpty() const;
+        int getWeight() const;
+        NTreeCSRView<elem> getRoot() const;
+
+        const elem& getInfo(int node) const;
+        int childCount(int node) const;
+        int getChild(int node, int position) const; // 1-based position, like NTree::removeSubtree
+        const int* childrenBegin(int node) const;
+        const int* childrenEnd(int node) const;
+        int getSubtreeSize(int node) const;
+        TreeRange<typename std::vector<elem>::const_iterator> preOrderSlice(int node) const;
+
+        std::list<elem> preOrder() const;
+        std::list<elem> postOrder() const;
+        std::list<elem> levelOrder() const;
+        std::list<elem> getLeaves() const;
+        int getHeight() const;
+};
+
+template <class elem>
+std::vector< NTreeCSRView<elem> > NTreeCSRView<elem>::getChildren() const {
+    std::vector< NTreeCSRView<elem> > children;
+    children.reserve(childCount());
+    for (const int* it = tree->childrenBegin(node); it != tree->childrenEnd(node); ++it) {
+        children.push_back(NTreeCSRView<elem>(tree, *it));
+    }
+    return children;
+}
+
+template <class elem>
+NTreeCSR<elem>::NTreeCSR() {
+    childOffsets.push_back(0);
+}
+
+template <class elem>
+NTreeCSR<elem>::NTreeCSR(const NTree<elem>& tree) {
+    build(tree);
+}
+
+template <class elem>
+void NTreeCSR<elem>::CHECK_NODE(int node) const {
+    if (node < 0 || node >= (int)values.size()) throw std::out_of_range("NTreeCSR node index out of range");
+}
+
+template <class elem>
+void NTreeCSR<elem>::build(const NTree<elem>& tree) {
+    values.clear();
+    childOffsets.clear();
+    childIndex.clear();
+    subtreeSizes.clear();
+
+    // Pre-order walk over sons/bro links, remembering each node's parent id
+    std::vector<int> parents;
+    values.reserve(tree.getWeight());
+    parents.reserve(tree.getWeight());
+    if (tree.root != NULL) {
+        std::stack< std::pair<const NodeNTree<elem>*, int> > s;
+        s.push(std::make_pair((const NodeNTree<elem>*)tree.root, -1));
+        while (!s.empty()) {
+            const NodeNTree<elem>* current = s.top().first;
+            int parent = s.top().second;
+            s.pop();
+            int id = (int)values.size();
+            values.push_back(current->getInfo());
+            parents.push_back(parent);
+            if (parent >= 0 && current->getBro() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getBro(), parent));
+            if (current->getSons() != NULL) s.push(std::make_pair((const NodeNTree<elem>*)current->getSons(), id));
+        }
+    }
+
+    int n = (int)values.size();
+    childOffsets.assign(n + 1, 0);
+    for (int i = 1; i < n; ++i) childOffsets[parents[i] + 1]++;
+    for (int i = 0; i < n; ++i) childOffsets[i + 1] += childOffsets[i];
+    // Children show up in pre-order in sibling order, so filling in id order keeps sibling order
+    childIndex.resize(n > 0 ? n - 1 : 0);
+    std::vector<int> fill(childOffsets.begin(), childOffsets.end() - 1);
+    for (int i = 1; i < n; ++i) childIndex[fill[parents[i]]++] = i;
+
+    subtreeSizes.assign(n, 1);
+    for (int i = n - 1; i > 0; --i) subtreeSizes[parents[i]] += subtreeSizes[i];
+}
+
+template <class elem>
+void NTreeCSR<elem>::toNTree(NTree<elem>& target) const {
+    toNTree(target, 0);
+}
+
+template <class elem>
+void NTreeCSR<elem>::toNTree(NTree<elem>& target, int node) const {
+    if (!values.empty()) CHECK_NODE(node); // Before CLEAR, so a bad id leaves target untouched
+    target.CLEAR();
+    if (values.empty()) return;
+    // The subtree is the pre-order run [node, node + size), so node ids map to slots by offset
+    int size = subtreeSizes[node];
+    std::vector<NodeNTree<elem>*> nodes(size);
+    for (int i = 0; i < size; ++i) nodes[i] = target.NEW_NODE(values[node + i]); // Into target's arena when it has one
+    for (int i = 0; i < size; ++i) {
+        NodeNTree<elem>* previous = NULL;
+        for (int k = childOffsets[node + i]; k < childOffsets[node + i + 1]; ++k) {
+            NodeNTree<elem>* child = nodes[childIndex[k] - node];
+            if (previous == NULL) nodes[i]->setSons(child);
+            else previous->setBro(child);
+            previous = child;
+        }
+    }
+    target.root = nodes[0];
+    target.weight = size;
+    target.REBUILD_NODE_INDEX();
+}
+
+template <class elem>
+bool NTreeCSR<elem>::isEmpty() const {
+    return values.empty();
+}
+
+template <class elem>
+int NTreeCSR<elem>::getWeight() const {
+    return (int)values.size();
+}
+
+template <class elem>
+NTreeCSRView<elem> NTreeCSR<elem>::getRoot() const {
+    if (isEmpty()) return NTreeCSRView<elem>();
+    return NTreeCSRView<elem>(this, 0);
+}
+
+template <class elem>
+const elem& NTreeCSR<elem>::getInfo(int node) const {
+    CHECK_NODE(node);
+    return values[node];
+}
+
+template <class elem>
+int NTreeCSR<elem>::childCount(int node) const {
+    CHECK_NODE(node);
+    return childOffsets[node + 1] - childOffsets[node];
+}
+
+template <class elem>
+int NTreeCSR<elem>::getChild(int node, int position) const {
+    if (position < 1 || position > childCount(node)) throw std::out_of_range("NTreeCSR child position out of range");
+    return childIndex[childOffsets[node] + position - 1];
+}
+
+template <class elem>
+const int* NTreeCSR<elem>::childrenBegin(int node) const {
+    CHECK_NODE(node);
+    return childIndex.empty() ? NULL : &childIndex[0] + childOffsets[node];
+}
+
+template <class elem>
+const int* NTreeCSR<elem>::childrenEnd(int node) const {
+    CHECK_NODE(node);
+    return childIndex.empty() ? NULL : &childIndex[0] + childOffsets[node + 1];
+}
+
+template <class elem>
+int NTreeCSR<elem>::getSubtreeSize(int node) const {
+    CHECK_NODE(node);
+    return subtreeSizes[node];
+}
+
+template <class elem>
+TreeRange<typename std::vector<elem>::const_iterator> NTreeCSR<elem>::preOrderSlice(int node) const {
+    CHECK_NODE(node);
+    return TreeRange<typename std::vector<elem>::const_iterator>(values.begin() + node, values.begin() + node + subtreeSizes[node]);
+}
+
+template <class elem>
+std::list<elem> NTreeCSR<elem>::preOrder() const {
+    return std::list<elem>(values.begin(), values.end());
+}
+
+template <class elem>
+std::list<elem> NTreeCSR<elem>::postOrder() const {
+    // A node is emitted once every child in its CSR row has been emitted
+    std::list<elem> result;
+    if (isEmpty()) return result;
+    std::stack< std::pair<int, int> > s; // node, next child slot
+    s.push(std::make_pair(0, childOffsets[0]));
+    while (!s.empty()) {
+        int node = s.top().first;
+        int slot = s.top().second;
+        if (slot < childOffsets[node + 1]) {
+            s.top().second++;
+            s.push(std::make_pair(childIndex[slot], childOffsets[childIndex[slot]]));
+        } else {
+            result.push_back(values[node]);
+            s.pop();
+        }
+    }
+    return result;
+}
+
+template <class elem>
+std::list<elem> NTreeCSR<elem>::levelOrder() const {
+    std::list<elem> result;
+    if (isEmpty()) return result;
+    std::vector<int> order(1, 0);
+    order.reserve(values.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        result.push_back(values[order[i]]);
+        order.insert(order.end(), childrenBegin(order[i]), childrenEnd(order[i]));
+    }
+    return result;
+}
+
+template <class elem>
+std::list<elem> NTreeCSR<elem>::getLeaves() const {
+    std::list<elem> result;
+    for (int i = 0; i < (int)values.size(); ++i) {
+        if (childOffsets[i] == childOffsets[i + 1]) result.push_back(values[i]);
+    }
+    return result;
+}
+
+template <class elem>
+int NTreeCSR<elem>::getHeight() const {
+    // Parents precede children in pre-order, so depths fill in one forward pass
+    if (isEmpty()) return -1;
+    std::vector<int> depth(values.size(), 0);
+    int height = 0;
+    for (int i = 0; i < (int)values.size(); ++i) {
+        if (depth[i] > height) height = depth[i];
+        for (int k = childOffsets[i]; k < childOffsets[i + 1]; ++k) depth[childIndex[k]] = depth[i] + 1;
+    }
+    return height;
+}
+
+#endif // N_TREE_CSR_H_
@@ -0,0 +1,181 @@
+#ifndef N_TREE_ITERATOR_H_
+#define N_TREE_ITERATOR_H_
+
+#include "node_n_tree.h"
+#include "tree_traversal.h"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+// Forward iterator that walks an NTree lazily over its sons/bro links. Depth-first
+// orders keep O(h) frames (one pending sibling per level); level order keeps the
+// current frontier. A default constructed iterator is the end.
+template <class elem>
+class NTreeIterator {
+    private:
+        struct Frame {
+            const NodeNTree<elem>* node;
+            const NodeNTree<elem>* nextChild; // In-order: next child still to visit
+            int depth;
+            int stage; // In-order: 0 = new, 1 = first child done, 2 = root emitted
+            Frame(const NodeNTree<elem>* n, int d) : node(n), nextChild(NULL), depth(d), stage(0) {}
+        };
+
+        TreeTraversal order;
+        int level;
+        const NodeNTree<elem>* current;
+        int position; // Elements yielded before current: with shared subtrees one node can sit at several positions
+        std::vector<Frame> stack;
+        std::deque<const NodeNTree<elem>*> queue;
+
+        void PUSH_FIRST_CHILDREN(const NodeNTree<elem>* node);
+        void ADVANCE();
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef elem value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const elem* pointer;
+        typedef const elem& reference;
+
+        NTreeIterator();
+        NTreeIterator(const NodeNTree<elem>* root, TreeTraversal order, int level = 0);
+
+        reference operator*() const;
+        pointer operator->() const;
+        NTreeIterator<elem>& operator++();
+        NTreeIterator<elem> operator++(int);
+        bool operator==(const NTreeIterator<elem>& other) const;
+        bool operator!=(const NTreeIterator<elem>& other) const;
+};
+
+template <class elem>
+NTreeIterator<elem>::NTreeIterator() : order(TRAVERSE_PRE_ORDER), level(0), current(NULL), position(0) {}
+
+template <class elem>
+NTreeIterator<elem>::NTreeIterator(const NodeNTree<elem>* root, TreeTraversal order, int level)
+    : order(order), level(level), current(NULL), position(0) {
+    if (root == NULL || (order == TRAVERSE_LEVEL && level < 0)) return;
+    // The root's bro link is never followed: a tree root has no siblings
+    if (order == TRAVERSE_POST_ORDER) {
+        stack.push_back(Frame(root, 0));
+        PUSH_FIRST_CHILDREN(root->getSons());
+    } else if (order == TRAVERSE_LEVEL_ORDER) {
+        queue.push_back(root);
+    } else {
+        stack.push_back(Frame(root, 0));
+    }
+    ADVANCE();
+}
+
+template <class elem>
+void NTreeIterator<elem>::PUSH_FIRST_CHILDREN(const NodeNTree<elem>* node) {
+    // Post-order of an N-ary tree is the in-order of its sons/bro binary form
+    while (node != NULL) {
+        stack.push_back(Frame(node, 0));
+        node = node->getSons();
+    }
+}
+
+template <class elem>
+void NTreeIterator<elem>::ADVANCE() {
+    current = NULL;
+    switch (order) {
+        case TRAVERSE_POST_ORDER:
+            if (stack.empty()) return;
+            current = stack.back().node;
+            stack.pop_back();
+            if (!stack.empty()) PUSH_FIRST_CHILDREN(current->getBro());
+            return;
+        case TRAVERSE_LEVEL_ORDER:
+            if (queue.empty()) return;
+            current = queue.front();
+            queue.pop_front();
+            for (const NodeNTree<elem>* child = current->getSons(); child != NULL; child = child->getBro()) {
+                queue.push_back(child);
+            }
+            return;
+        case TRAVERSE_IN_ORDER:
+            // First child's subtree, then the node, then the remaining children
+            while (!stack.empty()) {
+                Frame& top = stack.back();
+                if (top.stage == 0) {
+                    top.stage = 1;
+                    if (top.node->getSons() != NULL) {
+                        stack.push_back(Frame(top.node->getSons(), 0));
+                        continue;
+                    }
+                }
+                if (top.stage == 1) {
+                    top.stage = 2;
+                    top.nextChild = (top.node->getSons() != NULL) ? top.node->getSons()->getBro() : NULL;
+                    current = top.node;
+                    return;
+                }
+                if (top.nextChild != NULL) {
+                    const NodeNTree<elem>* child = top.nextChild;
+                    top.nextChild = child->getBro();
+                    stack.push_back(Frame(child, 0));
+                } else {
+                    stack.pop_back();
+                }
+            }
+            return;
+        default: // Pre-order walks, filtered for leaves or a single level
+            while (!stack.empty()) {
+                Frame top = stack.back();
+                stack.pop_back();
+                const NodeNTree<elem>* node = top.node;
+                if (top.depth > 0 && node->getBro() != NULL) stack.push_back(Frame(node->getBro(), top.depth));
+                if (node->getSons() != NULL && (order != TRAVERSE_LEVEL || top.depth < level)) {
+                    stack.push_back(Frame(node->getSons(), top.depth + 1));
+                }
+                if (order == TRAVERSE_PRE_ORDER
+                    || (order == TRAVERSE_LEAVES && node->getSons() == NULL)
+                    || (order == TRAVERSE_LEVEL && top.depth == level)) {
+                    current = node;
+                    return;
+                }
+            }
+            return;
+    }
+}
+
+template <class elem>
+typename NTreeIterator<elem>::reference NTreeIterator<elem>::operator*() const {
+    return current->getInfo();
+}
+
+template <class elem>
+typename NTreeIterator<elem>::pointer NTreeIterator<elem>::operator->() const {
+    return &current->getInfo();
+}
+
+template <class elem>
+NTreeIterator<elem>& NTreeIterator<elem>::operator++() {
+    ++position;
+    ADVANCE();
+    return *this;
+}
+
+template <class elem>
+NTreeIterator<elem> NTreeIterator<elem>::operator++(int) {
+    NTreeIterator<elem> previous = *this;
+    ++position;
+    ADVANCE();
+    return previous;
+}
+
+template <class elem>
+bool NTreeIterator<elem>::operator==(const NTreeIterator<elem>& other) const {
+    // Every end iterator is equal, whatever it took to get there
+    return this->current == other.current && (this->current == NULL || this->position == other.position);
+}
+
+template <class elem>
+bool NTreeIterator<elem>::operator!=(const NTreeIterator<elem>& other) const {
+    return !(*this == other);
+}
+
+#endif // N_TREE_ITERATOR_H_
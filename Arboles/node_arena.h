@@ -0,0 +1,107 @@
+#ifndef NODE_ARENA_H_
+#define NODE_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Whether destroying a T can be skipped when its storage is thrown away. C++98 has no
+// type traits, so only built-in arithmetic and pointer types are known to be trivial.
+template <class T> struct TrivialDestructor { static const bool value = false; };
+template <class T> struct TrivialDestructor<T*> { static const bool value = true; };
+
+#define TRIVIAL_DESTRUCTOR(T) template <> struct TrivialDestructor<T> { static const bool value = true; };
+TRIVIAL_DESTRUCTOR(bool)
+TRIVIAL_DESTRUCTOR(char)
+TRIVIAL_DESTRUCTOR(signed char)
+TRIVIAL_DESTRUCTOR(unsigned char)
+TRIVIAL_DESTRUCTOR(wchar_t)
+TRIVIAL_DESTRUCTOR(short)
+TRIVIAL_DESTRUCTOR(unsigned short)
+TRIVIAL_DESTRUCTOR(int)
+TRIVIAL_DESTRUCTOR(unsigned int)
+TRIVIAL_DESTRUCTOR(long)
+TRIVIAL_DESTRUCTOR(unsigned long)
+TRIVIAL_DESTRUCTOR(float)
+TRIVIAL_DESTRUCTOR(double)
+TRIVIAL_DESTRUCTOR(long double)
+#undef TRIVIAL_DESTRUCTOR
+
+// Bump allocator for tree nodes. Storage comes in blocks that double in size, freed nodes
+// are recycled through a free list, and reset() forgets every node at once while keeping
+// the blocks for the next build. The arena never runs destructors; its owner does.
+template <class Node>
+class NodeArena {
+    private:
+        struct FreeSlot {
+            FreeSlot* next;
+        };
+
+        std::vector<Node*> blocks;
+        std::vector<size_t> capacities;
+        size_t currentBlock;
+        size_t used; // Slots handed out from blocks[currentBlock]
+        FreeSlot* freeList;
+
+        NodeArena(const NodeArena<Node>&); // Not copyable: nodes point into the blocks
+        NodeArena<Node>& operator=(const NodeArena<Node>&);
+
+    public:
+        NodeArena();
+        ~NodeArena();
+
+        void* allocate(); // Uninitialised storage for one Node
+        void deallocate(Node* node); // Storage of a node whose destructor already ran
+        void reset(); // Every node handed out so far is gone; blocks are kept
+        size_t blockCount() const;
+};
+
+template <class Node>
+NodeArena<Node>::NodeArena() : currentBlock(0), used(0), freeList(NULL) {}
+
+template <class Node>
+NodeArena<Node>::~NodeArena() {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        ::operator delete(blocks[i]);
+    }
+}
+
+template <class Node>
+void* NodeArena<Node>::allocate() {
+    if (freeList != NULL) {
+        FreeSlot* slot = freeList;
+        freeList = slot->next;
+        return slot;
+    }
+    if (currentBlock < blocks.size() && used == capacities[currentBlock]) {
+        currentBlock++;
+        used = 0;
+    }
+    if (currentBlock == blocks.size()) {
+        size_t capacity = blocks.empty() ? 256 : 2 * capacities.back();
+        blocks.push_back(static_cast<Node*>(::operator new(capacity * sizeof(Node))));
+        capacities.push_back(capacity);
+    }
+    return blocks[currentBlock] + used++;
+}
+
+template <class Node>
+void NodeArena<Node>::deallocate(Node* node) {
+    FreeSlot* slot = reinterpret_cast<FreeSlot*>(node);
+    slot->next = freeList;
+    freeList = slot;
+}
+
+template <class Node>
+void NodeArena<Node>::reset() {
+    currentBlock = 0;
+    used = 0;
+    freeList = NULL;
+}
+
+template <class Node>
+size_t NodeArena<Node>::blockCount() const {
+    return blocks.size();
+}
+
+#endif // NODE_ARENA_H_
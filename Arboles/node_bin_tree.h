@@ -99,6 +99,8 @@ class NodeBinTree{
         NodeBinTree<elem> *left;
         NodeBinTree<elem> *right;
         elem info;
+        int refCount; // Trees and parent nodes pointing here; shared nodes are copied before a write
+        int size; // Nodes in this subtree; BinTree updates it whenever it relinks children
     public:
         NodeBinTree();
         NodeBinTree(elem info);
@@ -112,14 +114,23 @@ class NodeBinTree{
         // Getters (Marked as const)
         NodeBinTree<elem>* getLeft() const; // ADDED const
         NodeBinTree<elem>* getRight() const; // ADDED const
-        elem getInfo() const; // ADDED const
+        const elem& getInfo() const; // By reference so tree iterators can hand it out
+
+        // Subtree size for order statistics
+        int getSize() const;
+        void setSize(int size);
+
+        // Reference counting for subtree sharing
+        int getRefCount() const;
+        void retain();
+        bool release(); // Returns true when the last reference is gone and the node must be deleted
 
 };
 
 // --- NodeBinTree Definitions ---
 
-template <class elem> NodeBinTree<elem>::NodeBinTree() : left(NULL), right(NULL) {}
-template <class elem> NodeBinTree<elem>::NodeBinTree(elem info) : info(info), left(NULL), right(NULL) {}
+template <class elem> NodeBinTree<elem>::NodeBinTree() : left(NULL), right(NULL), refCount(1), size(1) {}
+template <class elem> NodeBinTree<elem>::NodeBinTree(elem info) : left(NULL), right(NULL), info(info), refCount(1), size(1) {}
 template <class elem> NodeBinTree<elem>::~NodeBinTree() {} // BinTree manages deletion
 template <class elem> void NodeBinTree<elem>::setLeft(NodeBinTree<elem>* node) { this->left = node; }
 template <class elem> void NodeBinTree<elem>::setRight(NodeBinTree<elem>* node) { this->right = node; }
@@ -135,8 +146,15 @@ NodeBinTree<elem>* NodeBinTree<elem>::getRight() const { // ADDED const
     return this->right;
 }
 template <class elem>
-elem NodeBinTree<elem>::getInfo() const { // ADDED const
+const elem& NodeBinTree<elem>::getInfo() const {
     return this->info;
 }
 
+template <class elem> int NodeBinTree<elem>::getSize() const { return this->size; }
+template <class elem> void NodeBinTree<elem>::setSize(int size) { this->size = size; }
+
+template <class elem> int NodeBinTree<elem>::getRefCount() const { return this->refCount; }
+template <class elem> void NodeBinTree<elem>::retain() { this->refCount++; }
+template <class elem> bool NodeBinTree<elem>::release() { return --this->refCount == 0; }
+
 #endif // NODE_BIN_TREE_H_
\ No newline at end of file
@@ -10,6 +10,7 @@ class NodeNTree{
         NodeNTree<elem> *sons; // Pointer to the first child
         NodeNTree<elem> *bro;  // Pointer to the next sibling
         elem info;
+        int refCount; // Trees and nodes (via sons or bro) pointing here; shared nodes are copied before a write
     public:
         NodeNTree();
         NodeNTree(elem info);
@@ -26,7 +27,12 @@ class NodeNTree{
         // Getters (Marked as const)
         NodeNTree<elem>* getSons() const; // ADDED const
         NodeNTree<elem>* getBro() const;  // ADDED const
-        elem getInfo() const;             // ADDED const
+        const elem& getInfo() const;      // By reference so tree iterators can hand it out
+
+        // Reference counting for subtree sharing
+        int getRefCount() const;
+        void retain();
+        bool release(); // Returns true when the last reference is gone and the node must be deleted
 };
 
 // --- NodeNTree Definitions ---
@@ -36,6 +42,7 @@ NodeNTree<elem>::NodeNTree() {
     // Definition style changed
     this->sons = NULL;
     this->bro = NULL;
+    this->refCount = 1;
     // this->info = elem(); // Requires default constructible elem
 }
 
@@ -45,6 +52,7 @@ NodeNTree<elem>::NodeNTree(elem info) {
     this->info = info;
     this->sons = NULL;
     this->bro = NULL;
+    this->refCount = 1;
 }
 
 // Removed other constructor definitions as they were removed from declaration
@@ -80,8 +88,23 @@ NodeNTree<elem>* NodeNTree<elem>::getBro() const { // ADDED const
 }
 
 template <class elem>
-elem NodeNTree<elem>::getInfo() const { // ADDED const
+const elem& NodeNTree<elem>::getInfo() const {
     return this->info;
 }
 
+template <class elem>
+int NodeNTree<elem>::getRefCount() const {
+    return this->refCount;
+}
+
+template <class elem>
+void NodeNTree<elem>::retain() {
+    this->refCount++;
+}
+
+template <class elem>
+bool NodeNTree<elem>::release() {
+    return --this->refCount == 0;
+}
+
 #endif // NODE_N_TREE_H_
\ No newline at end of file
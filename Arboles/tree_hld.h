@@ -0,0 +1,315 @@
+#ifndef TREE_HLD_H_
+#define TREE_HLD_H_
+
+#include "bin_tree.h"
+#include "n_tree.h"
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Aggregates for TreeHLD. An Aggregate provides
+//     typedef ... Result;
+//     Result identity() const;                                 // Result of an empty range
+//     Result fromValue(const elem& value) const;               // A node on its own
+//     Result combine(const Result& a, const Result& b) const;  // Associative and commutative
+// Paths are assembled from chain pieces in no particular order, hence commutative.
+
+template <class elem>
+struct TreePathSum {
+    typedef elem Result;
+    Result identity() const { return elem(); }
+    Result fromValue(const elem& value) const { return value; }
+    Result combine(const Result& a, const Result& b) const { return a + b; }
+};
+
+template <class elem>
+struct TreePathMax { // identity is the lowest representable value, so elem must be arithmetic
+    typedef elem Result;
+    Result identity() const {
+        return std::numeric_limits<elem>::is_integer ? std::numeric_limits<elem>::min() : -std::numeric_limits<elem>::max();
+    }
+    Result fromValue(const elem& value) const { return value; }
+    Result combine(const Result& a, const Result& b) const { return (a < b) ? b : a; }
+};
+
+// Heavy-light decomposition of a BinTree or NTree for path and subtree aggregates with point
+// updates. Every node keeps to its heavy child (the one with the largest subtree), so any
+// root-to-node path crosses O(log n) chains; with the nodes laid out chain by chain, each
+// chain piece and each subtree is one range of a segment tree.
+//     queryPath: O(log^2 n)    querySubtree, update: O(log n)
+// Node ids are pre-order ranks, as in NTreeCSR. Lookups by value use the first node in
+// pre-order holding it, like findPathToNode. The tree is copied at build time; later
+// changes to it are not seen.
+template <class elem, class Aggregate = TreePathSum<elem> >
+class TreeHLD {
+    public:
+        typedef typename Aggregate::Result Result;
+
+    private:
+        // Folds a tree into its values in pre-order plus each node's subtree size
+        struct ShapeFold {
+            struct Result {
+                std::list<elem> values;
+                std::list<int> sizes;
+            };
+            Result empty() const { return Result(); }
+            Result visit(const elem& value) const {
+                Result r;
+                r.values.push_back(value);
+                r.sizes.push_back(1);
+                return r;
+            }
+            void join(Result& parent, Result& child, bool) const {
+                parent.sizes.front() += child.sizes.front();
+                parent.values.splice(parent.values.end(), child.values);
+                parent.sizes.splice(parent.sizes.end(), child.sizes);
+            }
+        };
+
+        Aggregate aggregate;
+        std::vector<elem> values; // By node id
+        std::vector<int> parents; // -1 for the root
+        std::vector<int> depths;
+        std::vector<int> subtreeSizes;
+        std::vector<int> chainHeads; // Topmost node of the node's chain
+        std::vector<int> positions; // Node id -> slot in the segment tree
+        std::vector<Result> segment; // Bottom-up segment tree; leaves at [n, 2n)
+        std::set< std::pair<elem, int> > valueIndex; // (value, node id), so the first node with a value is a lower_bound
+
+        void BUILD(const std::list<elem>& preOrderValues, const std::list<int>& preOrderSizes);
+        Result RANGE_QUERY(int from, int to) const; // Positions [from, to)
+        void CHECK_NODE(int node) const;
+
+    public:
+        explicit TreeHLD(const Aggregate& aggregate = Aggregate());
+        explicit TreeHLD(const BinTree<elem>& tree, const Aggregate& aggregate = Aggregate());
+        explicit TreeHLD(const NTree<elem>& tree, const Aggregate& aggregate = Aggregate());
+
+        void build(const BinTree<elem>& tree);
+        void build(const NTree<elem>& tree);
+
+        bool isEmpty() const;
+        int getWeight() const;
+        int findNode(const elem& value) const; // -1 if absent
+        const elem& getInfo(int node) const;
+        int getParent(int node) const; // -1 for the root
+        int getDepth(int node) const;
+
+        int lowestCommonAncestorNode(int nodeA, int nodeB) const;
+        Result queryPathNode(int nodeA, int nodeB) const; // Both ends included
+        Result querySubtreeNode(int node) const;
+        void updateNode(int node, const elem& value);
+
+        // By value; queries throw if a value is not in the tree, update returns false
+        elem lowestCommonAncestor(const elem& value1, const elem& value2) const;
+        Result queryPath(const elem& value1, const elem& value2) const;
+        Result querySubtree(const elem& value) const;
+        bool update(const elem& oldValue, const elem& newValue);
+};
+
+// --- Private Helpers ---
+
+template <class elem, class Aggregate>
+void TreeHLD<elem, Aggregate>::BUILD(const std::list<elem>& preOrderValues, const std::list<int>& preOrderSizes) {
+    int n = (int)preOrderValues.size();
+    values.assign(preOrderValues.begin(), preOrderValues.end());
+    subtreeSizes.assign(preOrderSizes.begin(), preOrderSizes.end());
+    parents.assign(n, -1);
+    depths.assign(n, 0);
+    chainHeads.assign(n, 0);
+    positions.assign(n, 0);
+    valueIndex.clear();
+
+    // In pre-order a node's children start right after it and follow each other by subtree size
+    std::vector<int> heavy(n, -1);
+    for (int v = 0; v < n; ++v) {
+        int bestSize = 0;
+        for (int child = v + 1; child < v + subtreeSizes[v]; child += subtreeSizes[child]) {
+            parents[child] = v;
+            depths[child] = depths[v] + 1;
+            if (subtreeSizes[child] > bestSize) {
+                bestSize = subtreeSizes[child];
+                heavy[v] = child;
+            }
+        }
+        valueIndex.insert(std::make_pair(values[v], v));
+    }
+
+    // Depth-first with the heavy child taken first: chains and subtrees become contiguous
+    std::vector<int> s;
+    if (n > 0) s.push_back(0);
+    int next = 0;
+    while (!s.empty()) {
+        int v = s.back();
+        s.pop_back();
+        positions[v] = next++;
+        chainHeads[v] = (parents[v] >= 0 && heavy[parents[v]] == v) ? chainHeads[parents[v]] : v;
+        for (int child = v + 1; child < v + subtreeSizes[v]; child += subtreeSizes[child]) {
+            if (child != heavy[v]) s.push_back(child);
+        }
+        if (heavy[v] >= 0) s.push_back(heavy[v]);
+    }
+
+    segment.assign(2 * n, aggregate.identity());
+    for (int v = 0; v < n; ++v) segment[n + positions[v]] = aggregate.fromValue(values[v]);
+    for (int i = n - 1; i >= 1; --i) segment[i] = aggregate.combine(segment[2 * i], segment[2 * i + 1]);
+}
+
+template <class elem, class Aggregate>
+typename TreeHLD<elem, Aggregate>::Result TreeHLD<elem, Aggregate>::RANGE_QUERY(int from, int to) const {
+    Result result = aggregate.identity();
+    int n = (int)values.size();
+    for (int l = from + n, r = to + n; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) result = aggregate.combine(result, segment[l++]);
+        if (r & 1) result = aggregate.combine(result, segment[--r]);
+    }
+    return result;
+}
+
+template <class elem, class Aggregate>
+void TreeHLD<elem, Aggregate>::CHECK_NODE(int node) const {
+    if (node < 0 || node >= (int)values.size()) throw std::out_of_range("TreeHLD node index out of range");
+}
+
+// --- Public Methods ---
+
+template <class elem, class Aggregate>
+TreeHLD<elem, Aggregate>::TreeHLD(const Aggregate& aggregate) : aggregate(aggregate) {
+}
+
+template <class elem, class Aggregate>
+TreeHLD<elem, Aggregate>::TreeHLD(const BinTree<elem>& tree, const Aggregate& aggregate) : aggregate(aggregate) {
+    build(tree);
+}
+
+template <class elem, class Aggregate>
+TreeHLD<elem, Aggregate>::TreeHLD(const NTree<elem>& tree, const Aggregate& aggregate) : aggregate(aggregate) {
+    build(tree);
+}
+
+template <class elem, class Aggregate>
+void TreeHLD<elem, Aggregate>::build(const BinTree<elem>& tree) {
+    typename ShapeFold::Result shape = tree.fold(ShapeFold(), 0);
+    BUILD(shape.values, shape.sizes);
+}
+
+template <class elem, class Aggregate>
+void TreeHLD<elem, Aggregate>::build(const NTree<elem>& tree) {
+    typename ShapeFold::Result shape = tree.fold(ShapeFold(), 0);
+    BUILD(shape.values, shape.sizes);
+}
+
+template <class elem, class Aggregate>
+bool TreeHLD<elem, Aggregate>::isEmpty() const {
+    return values.empty();
+}
+
+template <class elem, class Aggregate>
+int TreeHLD<elem, Aggregate>::getWeight() const {
+    return (int)values.size();
+}
+
+template <class elem, class Aggregate>
+int TreeHLD<elem, Aggregate>::findNode(const elem& value) const {
+    typename std::set< std::pair<elem, int> >::const_iterator it = valueIndex.lower_bound(std::make_pair(value, INT_MIN));
+    if (it == valueIndex.end() || value < it->first || it->first < value) return -1;
+    return it->second;
+}
+
+template <class elem, class Aggregate>
+const elem& TreeHLD<elem, Aggregate>::getInfo(int node) const {
+    CHECK_NODE(node);
+    return values[node];
+}
+
+template <class elem, class Aggregate>
+int TreeHLD<elem, Aggregate>::getParent(int node) const {
+    CHECK_NODE(node);
+    return parents[node];
+}
+
+template <class elem, class Aggregate>
+int TreeHLD<elem, Aggregate>::getDepth(int node) const {
+    CHECK_NODE(node);
+    return depths[node];
+}
+
+template <class elem, class Aggregate>
+int TreeHLD<elem, Aggregate>::lowestCommonAncestorNode(int nodeA, int nodeB) const {
+    CHECK_NODE(nodeA);
+    CHECK_NODE(nodeB);
+    // Lift whichever end has the deeper chain head until both are on one chain
+    while (chainHeads[nodeA] != chainHeads[nodeB]) {
+        if (depths[chainHeads[nodeA]] < depths[chainHeads[nodeB]]) std::swap(nodeA, nodeB);
+        nodeA = parents[chainHeads[nodeA]];
+    }
+    return (depths[nodeA] < depths[nodeB]) ? nodeA : nodeB;
+}
+
+template <class elem, class Aggregate>
+typename TreeHLD<elem, Aggregate>::Result TreeHLD<elem, Aggregate>::queryPathNode(int nodeA, int nodeB) const {
+    CHECK_NODE(nodeA);
+    CHECK_NODE(nodeB);
+    Result result = aggregate.identity();
+    while (chainHeads[nodeA] != chainHeads[nodeB]) {
+        if (depths[chainHeads[nodeA]] < depths[chainHeads[nodeB]]) std::swap(nodeA, nodeB);
+        result = aggregate.combine(result, RANGE_QUERY(positions[chainHeads[nodeA]], positions[nodeA] + 1));
+        nodeA = parents[chainHeads[nodeA]];
+    }
+    if (positions[nodeB] < positions[nodeA]) std::swap(nodeA, nodeB);
+    return aggregate.combine(result, RANGE_QUERY(positions[nodeA], positions[nodeB] + 1));
+}
+
+template <class elem, class Aggregate>
+typename TreeHLD<elem, Aggregate>::Result TreeHLD<elem, Aggregate>::querySubtreeNode(int node) const {
+    CHECK_NODE(node);
+    return RANGE_QUERY(positions[node], positions[node] + subtreeSizes[node]);
+}
+
+template <class elem, class Aggregate>
+void TreeHLD<elem, Aggregate>::updateNode(int node, const elem& value) {
+    CHECK_NODE(node);
+    valueIndex.erase(std::make_pair(values[node], node));
+    valueIndex.insert(std::make_pair(value, node));
+    values[node] = value;
+    int n = (int)values.size();
+    int i = n + positions[node];
+    segment[i] = aggregate.fromValue(value);
+    for (i >>= 1; i >= 1; i >>= 1) segment[i] = aggregate.combine(segment[2 * i], segment[2 * i + 1]);
+}
+
+template <class elem, class Aggregate>
+elem TreeHLD<elem, Aggregate>::lowestCommonAncestor(const elem& value1, const elem& value2) const {
+    int node1 = findNode(value1), node2 = findNode(value2);
+    if (node1 < 0 || node2 < 0) throw std::runtime_error("TreeHLD: One or both elements not found");
+    return values[lowestCommonAncestorNode(node1, node2)];
+}
+
+template <class elem, class Aggregate>
+typename TreeHLD<elem, Aggregate>::Result TreeHLD<elem, Aggregate>::queryPath(const elem& value1, const elem& value2) const {
+    int node1 = findNode(value1), node2 = findNode(value2);
+    if (node1 < 0 || node2 < 0) throw std::runtime_error("TreeHLD: One or both elements not found");
+    return queryPathNode(node1, node2);
+}
+
+template <class elem, class Aggregate>
+typename TreeHLD<elem, Aggregate>::Result TreeHLD<elem, Aggregate>::querySubtree(const elem& value) const {
+    int node = findNode(value);
+    if (node < 0) throw std::runtime_error("TreeHLD: Element not found");
+    return querySubtreeNode(node);
+}
+
+template <class elem, class Aggregate>
+bool TreeHLD<elem, Aggregate>::update(const elem& oldValue, const elem& newValue) {
+    int node = findNode(oldValue);
+    if (node < 0) return false;
+    updateNode(node, newValue);
+    return true;
+}
+
+#endif // TREE_HLD_H_
@@ -0,0 +1,468 @@
+#ifndef TREE_PARALLEL_H_
+#define TREE_PARALLEL_H_
+
+#include "node_bin_tree.h"
+#include "node_n_tree.h"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef TREE_PARALLEL // Compile with -DTREE_PARALLEL and link with -lpthread to run tasks on threads
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Runs a batch of independent tasks 0..taskCount-1. Each worker owns a contiguous range of
+// tasks, takes them from its back, and when it runs dry steals from the front of the others.
+// Without TREE_PARALLEL the tasks simply run in order on the calling thread.
+class TreeTaskPool {
+    public:
+        typedef void (*TaskFunction)(void* context, int task);
+
+        static void run(TaskFunction function, void* context, int taskCount);
+        static int getThreads(); // Defaults to the number of online CPUs (1 without TREE_PARALLEL)
+        static void setThreads(int threads); // Values below 1 restore the default
+
+    private:
+        static int& THREAD_SETTING();
+
+#ifdef TREE_PARALLEL
+        struct WorkerQueue {
+            pthread_mutex_t lock;
+            int begin; // Thieves take from here
+            int end; // The owner takes from here
+        };
+
+        struct Batch {
+            TaskFunction function;
+            void* context;
+            std::vector<WorkerQueue> queues;
+            pthread_mutex_t failureLock;
+            bool failed;
+        };
+
+        struct Worker {
+            Batch* batch;
+            int id;
+        };
+
+        static int TAKE(WorkerQueue& queue, bool fromFront); // -1 when the queue is empty
+        static void* WORK(void* worker);
+#endif
+};
+
+// Sorts a vector on TreeTaskPool: every thread sorts one run, then neighbouring runs are
+// merged pairwise in rounds. Small inputs or a single thread just use std::sort.
+template <class T>
+class TreeParallelSort {
+    public:
+        static void sort(std::vector<T>& values);
+
+    private:
+        enum { MIN_RUN = 1 << 14 }; // Below this a run is not worth a task
+
+        struct Batch {
+            std::vector<T>* values;
+            std::vector<size_t>* bounds; // Run k is [bounds[k], bounds[k + 1])
+            int width; // Runs per half in the current merge round
+        };
+
+        static void SORT_RUN(void* context, int task);
+        static void MERGE_RUNS(void* context, int task);
+};
+
+// Child enumeration used by the fold; one specialization per node type.
+template <class Node> struct TreeNodeChildren;
+
+template <class elem>
+struct TreeNodeChildren< NodeBinTree<elem> > {
+    struct Cursor {
+        const NodeBinTree<elem>* parent;
+        int stage; // 0: left next, 1: right next, 2: done
+    };
+    static Cursor begin(const NodeBinTree<elem>* node) {
+        Cursor cursor = { node, 0 };
+        return cursor;
+    }
+    static const NodeBinTree<elem>* next(Cursor& cursor) {
+        // By position, not pointer: a shared subtree can be both the left and the right child
+        while (cursor.stage < 2) {
+            const NodeBinTree<elem>* child = (cursor.stage == 0) ? cursor.parent->getLeft() : cursor.parent->getRight();
+            cursor.stage++;
+            if (child != NULL) return child;
+        }
+        return NULL;
+    }
+};
+
+template <class elem>
+struct TreeNodeChildren< NodeNTree<elem> > {
+    struct Cursor {
+        const NodeNTree<elem>* nextChild;
+    };
+    static Cursor begin(const NodeNTree<elem>* node) {
+        Cursor cursor = { node->getSons() };
+        return cursor;
+    }
+    static const NodeNTree<elem>* next(Cursor& cursor) {
+        const NodeNTree<elem>* child = cursor.nextChild;
+        if (child != NULL) cursor.nextChild = child->getBro();
+        return child;
+    }
+};
+
+// Bottom-up reduction over a tree. A Folder is a stateless class providing
+//     typedef ... Result;
+//     Result empty() const;                                   // Result for an empty tree
+//     Result visit(const elem& value) const;                  // A node on its own
+//     void join(Result& parent, Result& child, bool first) const; // Folds in each child, in order
+// join may take child's contents (it is not used again). Nodes up to cutoffDepth are folded
+// by the calling thread; every subtree rooted at cutoffDepth is a task for TreeTaskPool.
+// Children are always joined in tree order, so the result does not depend on scheduling.
+template <class Node, class Folder>
+class TreeFold {
+    public:
+        typedef typename Folder::Result Result;
+
+        static Result run(const Node* root, const Folder& folder, int cutoffDepth = -1); // -1 picks a depth from the thread count
+
+    private:
+        typedef TreeNodeChildren<Node> Children;
+
+        struct Frame {
+            const Node* node;
+            typename Children::Cursor cursor;
+            Result result;
+            bool hasChildren;
+        };
+
+        struct Batch {
+            const Folder* folder;
+            const std::vector<const Node*>* roots;
+            std::deque<Result>* results; // Not a vector: vector<bool> packs neighbours into one word
+        };
+
+        static int AUTO_CUTOFF(const Node* root);
+        static void COLLECT_TASK_ROOTS(const Node* root, int cutoffDepth, std::vector<const Node*>& roots);
+        static void FOLD(const Node* root, const Folder& folder, int cutoffDepth, std::deque<Result>* taskResults, Result& out);
+        static void RUN_TASK(void* context, int task);
+};
+
+// --- Ready-made folders ---
+
+template <class elem>
+struct TreeCountFold {
+    typedef int Result;
+    Result empty() const { return 0; }
+    Result visit(const elem&) const { return 1; }
+    void join(Result& parent, Result& child, bool) const { parent += child; }
+};
+
+template <class elem>
+struct TreeHeightFold { // Same convention as getHeight: a lone root is 0, an empty tree -1
+    typedef int Result;
+    Result empty() const { return -1; }
+    Result visit(const elem&) const { return 0; }
+    void join(Result& parent, Result& child, bool) const { if (child + 1 > parent) parent = child + 1; }
+};
+
+template <class elem>
+struct TreeSumFold {
+    typedef elem Result;
+    Result empty() const { return elem(); }
+    Result visit(const elem& value) const { return value; }
+    void join(Result& parent, Result& child, bool) const { parent += child; }
+};
+
+template <class elem>
+struct TreeLeavesFold { // Left to right, like getLeaves
+    typedef std::list<elem> Result;
+    Result empty() const { return Result(); }
+    Result visit(const elem& value) const { return Result(1, value); }
+    void join(Result& parent, Result& child, bool first) const {
+        if (first) parent.clear(); // Not a leaf after all
+        parent.splice(parent.end(), child);
+    }
+};
+
+template <class elem>
+struct TreePathFold { // Root-to-target path of the first match in pre-order, like findPathToNode
+    struct Result {
+        bool found;
+        std::list<elem> path; // Holds just the node's own value until a match is joined in
+        Result() : found(false) {}
+    };
+    elem target;
+    TreePathFold(const elem& target) : target(target) {}
+    Result empty() const { return Result(); }
+    Result visit(const elem& value) const {
+        Result r;
+        r.found = (value == target);
+        r.path.push_back(value);
+        return r;
+    }
+    void join(Result& parent, Result& child, bool) const {
+        if (parent.found || !child.found) return;
+        parent.found = true;
+        parent.path.splice(parent.path.end(), child.path);
+    }
+};
+
+// --- TreeTaskPool ---
+
+inline int& TreeTaskPool::THREAD_SETTING() {
+    static int threads = 0; // 0: not chosen yet
+    return threads;
+}
+
+inline int TreeTaskPool::getThreads() {
+    int& threads = THREAD_SETTING();
+    if (threads < 1) {
+#ifdef TREE_PARALLEL
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (int)online : 1;
+#else
+        threads = 1;
+#endif
+    }
+    return threads;
+}
+
+inline void TreeTaskPool::setThreads(int threads) {
+    THREAD_SETTING() = (threads < 1) ? 0 : threads;
+}
+
+#ifndef TREE_PARALLEL
+
+inline void TreeTaskPool::run(TaskFunction function, void* context, int taskCount) {
+    for (int task = 0; task < taskCount; ++task) function(context, task);
+}
+
+#else
+
+inline int TreeTaskPool::TAKE(WorkerQueue& queue, bool fromFront) {
+    int task = -1;
+    pthread_mutex_lock(&queue.lock);
+    if (queue.begin < queue.end) task = fromFront ? queue.begin++ : --queue.end;
+    pthread_mutex_unlock(&queue.lock);
+    return task;
+}
+
+inline void* TreeTaskPool::WORK(void* argument) {
+    Worker* worker = static_cast<Worker*>(argument);
+    Batch& batch = *worker->batch;
+    int queueCount = (int)batch.queues.size();
+    try {
+        for (;;) {
+            int task = TAKE(batch.queues[worker->id], false);
+            // Tasks never spawn tasks, so once every queue is empty the batch is done
+            for (int i = 1; task < 0 && i < queueCount; ++i) {
+                task = TAKE(batch.queues[(worker->id + i) % queueCount], true);
+            }
+            if (task < 0) break;
+            batch.function(batch.context, task);
+        }
+    } catch (...) {
+        pthread_mutex_lock(&batch.failureLock);
+        batch.failed = true;
+        pthread_mutex_unlock(&batch.failureLock);
+    }
+    return NULL;
+}
+
+inline void TreeTaskPool::run(TaskFunction function, void* context, int taskCount) {
+    int threads = getThreads();
+    if (threads > taskCount) threads = taskCount;
+    if (threads <= 1) {
+        for (int task = 0; task < taskCount; ++task) function(context, task);
+        return;
+    }
+
+    Batch batch;
+    batch.function = function;
+    batch.context = context;
+    batch.failed = false;
+    batch.queues.resize(threads);
+    pthread_mutex_init(&batch.failureLock, NULL);
+    std::vector<Worker> workers(threads);
+    for (int w = 0; w < threads; ++w) {
+        pthread_mutex_init(&batch.queues[w].lock, NULL);
+        batch.queues[w].begin = (int)((long)taskCount * w / threads);
+        batch.queues[w].end = (int)((long)taskCount * (w + 1) / threads);
+        workers[w].batch = &batch;
+        workers[w].id = w;
+    }
+
+    // The calling thread is worker 0; a worker that cannot be started leaves its range to be stolen
+    std::vector<pthread_t> handles(threads);
+    std::vector<bool> started(threads, false);
+    for (int w = 1; w < threads; ++w) {
+        started[w] = (pthread_create(&handles[w], NULL, WORK, &workers[w]) == 0);
+    }
+    WORK(&workers[0]);
+    for (int w = 1; w < threads; ++w) {
+        if (started[w]) pthread_join(handles[w], NULL);
+    }
+
+    for (int w = 0; w < threads; ++w) pthread_mutex_destroy(&batch.queues[w].lock);
+    pthread_mutex_destroy(&batch.failureLock);
+    if (batch.failed) throw std::runtime_error("TreeTaskPool task failed");
+}
+
+#endif
+
+// --- TreeParallelSort ---
+
+template <class T>
+void TreeParallelSort<T>::sort(std::vector<T>& values) {
+    int runs = TreeTaskPool::getThreads();
+    if (values.size() / MIN_RUN < (size_t)runs) runs = (int)(values.size() / MIN_RUN);
+    if (runs <= 1) {
+        std::sort(values.begin(), values.end());
+        return;
+    }
+    std::vector<size_t> bounds(runs + 1);
+    for (int k = 0; k <= runs; ++k) bounds[k] = values.size() * k / runs;
+    Batch batch = { &values, &bounds, 0 };
+    TreeTaskPool::run(SORT_RUN, &batch, runs);
+    for (batch.width = 1; batch.width < runs; batch.width *= 2) {
+        TreeTaskPool::run(MERGE_RUNS, &batch, (runs + 2 * batch.width - 1) / (2 * batch.width));
+    }
+}
+
+template <class T>
+void TreeParallelSort<T>::SORT_RUN(void* context, int task) {
+    Batch* batch = static_cast<Batch*>(context);
+    std::vector<size_t>& bounds = *batch->bounds;
+    std::sort(batch->values->begin() + bounds[task], batch->values->begin() + bounds[task + 1]);
+}
+
+template <class T>
+void TreeParallelSort<T>::MERGE_RUNS(void* context, int task) {
+    Batch* batch = static_cast<Batch*>(context);
+    std::vector<size_t>& bounds = *batch->bounds;
+    int runs = (int)bounds.size() - 1;
+    int first = 2 * batch->width * task;
+    int middle = std::min(first + batch->width, runs);
+    int last = std::min(first + 2 * batch->width, runs);
+    if (middle == last) return; // Odd run out, already in place
+    typename std::vector<T>::iterator begin = batch->values->begin();
+    std::inplace_merge(begin + bounds[first], begin + bounds[middle], begin + bounds[last]);
+}
+
+// --- TreeFold ---
+
+template <class Node, class Folder>
+typename TreeFold<Node, Folder>::Result TreeFold<Node, Folder>::run(const Node* root, const Folder& folder, int cutoffDepth) {
+    Result result = folder.empty();
+    if (root == NULL) return result;
+    if (cutoffDepth < 0) cutoffDepth = AUTO_CUTOFF(root);
+    if (cutoffDepth == 0 || TreeTaskPool::getThreads() <= 1) {
+        FOLD(root, folder, -1, NULL, result);
+        return result;
+    }
+
+    std::vector<const Node*> roots;
+    COLLECT_TASK_ROOTS(root, cutoffDepth, roots);
+    std::deque<Result> taskResults(roots.size());
+    Batch batch = { &folder, &roots, &taskResults };
+    TreeTaskPool::run(RUN_TASK, &batch, (int)roots.size());
+    FOLD(root, folder, cutoffDepth, &taskResults, result);
+    return result;
+}
+
+template <class Node, class Folder>
+int TreeFold<Node, Folder>::AUTO_CUTOFF(const Node* root) {
+    // Go down level by level until there are a few tasks per thread to even out the load
+    int threads = TreeTaskPool::getThreads();
+    if (threads <= 1) return 0;
+    std::vector<const Node*> level(1, root);
+    std::vector<const Node*> nextLevel;
+    int depth = 0;
+    while (!level.empty() && (int)level.size() < 8 * threads && depth < 32) {
+        nextLevel.clear();
+        for (size_t i = 0; i < level.size(); ++i) {
+            typename Children::Cursor cursor = Children::begin(level[i]);
+            for (const Node* child = Children::next(cursor); child != NULL; child = Children::next(cursor)) {
+                nextLevel.push_back(child);
+            }
+        }
+        if (nextLevel.empty()) break;
+        level.swap(nextLevel);
+        depth++;
+    }
+    return depth;
+}
+
+template <class Node, class Folder>
+void TreeFold<Node, Folder>::COLLECT_TASK_ROOTS(const Node* root, int cutoffDepth, std::vector<const Node*>& roots) {
+    // Same visiting order as FOLD, so task k is the k-th node FOLD finds at cutoffDepth
+    std::vector< std::pair<const Node*, int> > s;
+    s.push_back(std::make_pair(root, 0));
+    std::vector<const Node*> children;
+    while (!s.empty()) {
+        const Node* node = s.back().first;
+        int depth = s.back().second;
+        s.pop_back();
+        if (depth == cutoffDepth) {
+            roots.push_back(node);
+            continue;
+        }
+        children.clear();
+        typename Children::Cursor cursor = Children::begin(node);
+        for (const Node* child = Children::next(cursor); child != NULL; child = Children::next(cursor)) {
+            children.push_back(child);
+        }
+        for (size_t i = children.size(); i > 0; --i) s.push_back(std::make_pair(children[i - 1], depth + 1));
+    }
+}
+
+template <class Node, class Folder>
+void TreeFold<Node, Folder>::FOLD(const Node* root, const Folder& folder, int cutoffDepth, std::deque<Result>* taskResults, Result& out) {
+    // Iterative post-order. Frames live in a deque so results are never copied on growth.
+    // With taskResults, nodes at cutoffDepth take the next precomputed result instead.
+    std::deque<Frame> frames;
+    size_t nextTask = 0;
+    const Node* pending = root;
+    while (true) {
+        if (pending != NULL) {
+            frames.push_back(Frame());
+            Frame& frame = frames.back();
+            frame.node = pending;
+            frame.hasChildren = false;
+            if (taskResults != NULL && (int)frames.size() - 1 == cutoffDepth) {
+                std::swap(frame.result, (*taskResults)[nextTask++]);
+                frame.node = NULL; // Nothing left to visit below
+            } else {
+                frame.result = folder.visit(pending->getInfo());
+                frame.cursor = Children::begin(pending);
+            }
+        }
+        Frame& top = frames.back();
+        pending = (top.node != NULL) ? Children::next(top.cursor) : NULL;
+        if (pending != NULL) continue;
+
+        if (frames.size() == 1) {
+            std::swap(out, top.result);
+            return;
+        }
+        Frame& parent = frames[frames.size() - 2];
+        folder.join(parent.result, top.result, !parent.hasChildren);
+        parent.hasChildren = true;
+        frames.pop_back();
+    }
+}
+
+template <class Node, class Folder>
+void TreeFold<Node, Folder>::RUN_TASK(void* context, int task) {
+    Batch* batch = static_cast<Batch*>(context);
+    Result result;
+    FOLD((*batch->roots)[task], *batch->folder, -1, NULL, result);
+    std::swap((*batch->results)[task], result);
+}
+
+#endif // TREE_PARALLEL_H_
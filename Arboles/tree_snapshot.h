@@ -0,0 +1,639 @@
+#ifndef TREE_SNAPSHOT_H_
+#define TREE_SNAPSHOT_H_
+
+#include "bin_tree.h"
+#include "n_tree_csr.h"
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(TREE_SNAPSHOT_NO_MMAP)
+#define TREE_SNAPSHOT_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary snapshot of a BinTree or NTree, written once and then opened read-only with mmap
+// (or read into memory where mmap is unavailable). Queries read the file in place: no
+// parsing and no allocation per node.
+//
+// Layout, native byte order, nodes numbered in pre-order (root = 0):
+//     int header[8]      magic, version, kind, value codec tag, node count, structure ints, value bytes, 0
+//     int structure[]    BinTree: left[n], right[n] (-1 = none)
+//                        NTree: subtreeSizes[n], childOffsets[n + 1], childIndex[n - 1] (NTreeCSR arrays)
+//     padding to 8 bytes
+//     char values[]      written by SnapshotCodec<elem>
+
+// How values are stored. Only the types specialized below can be written to a snapshot.
+template <class T> struct SnapshotCodec;
+
+// Fixed-size values stored as a raw array
+template <class T, int Tag>
+struct ArithmeticSnapshotCodec {
+    typedef T View;
+    static const int TAG = Tag;
+
+    static void encode(const std::vector<T>& values, std::vector<char>& out) {
+        out.resize(values.size() * sizeof(T));
+        if (!values.empty()) std::memcpy(&out[0], &values[0], out.size());
+    }
+    static bool fits(const char*, int bytes, int count) {
+        return (long)bytes == (long)count * (long)sizeof(T);
+    }
+    static View get(const char* data, int, int, int index) {
+        T value;
+        std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+        return value;
+    }
+    static T toElem(const View& view) { return view; }
+    static int compare(const View& view, const T& value) { return (view < value) ? -1 : (value < view) ? 1 : 0; }
+};
+
+#define ARITHMETIC_SNAPSHOT_CODEC(T, TAG) template <> struct SnapshotCodec<T> : ArithmeticSnapshotCodec<T, TAG> {};
+ARITHMETIC_SNAPSHOT_CODEC(char, 1)
+ARITHMETIC_SNAPSHOT_CODEC(signed char, 2)
+ARITHMETIC_SNAPSHOT_CODEC(unsigned char, 3)
+ARITHMETIC_SNAPSHOT_CODEC(short, 4)
+ARITHMETIC_SNAPSHOT_CODEC(unsigned short, 5)
+ARITHMETIC_SNAPSHOT_CODEC(int, 6)
+ARITHMETIC_SNAPSHOT_CODEC(unsigned int, 7)
+ARITHMETIC_SNAPSHOT_CODEC(long, 8)
+ARITHMETIC_SNAPSHOT_CODEC(unsigned long, 9)
+ARITHMETIC_SNAPSHOT_CODEC(float, 10)
+ARITHMETIC_SNAPSHOT_CODEC(double, 11)
+ARITHMETIC_SNAPSHOT_CODEC(bool, 12)
+#undef ARITHMETIC_SNAPSHOT_CODEC
+
+// A string inside the snapshot; valid while the snapshot stays open
+struct SnapshotString {
+    const char* data;
+    int length;
+
+    std::string str() const { return std::string(data, length); }
+    bool operator==(const std::string& other) const { return (int)other.size() == length && std::memcmp(data, other.data(), length) == 0; }
+    bool operator!=(const std::string& other) const { return !(*this == other); }
+};
+
+// Strings as a string table: int offsets[n + 1] followed by the characters
+template <>
+struct SnapshotCodec<std::string> {
+    typedef SnapshotString View;
+    static const int TAG = 100;
+
+    static void encode(const std::vector<std::string>& values, std::vector<char>& out) {
+        size_t tableBytes = (values.size() + 1) * sizeof(int);
+        size_t charBytes = 0;
+        for (size_t i = 0; i < values.size(); ++i) charBytes += values[i].size();
+        out.resize(tableBytes + charBytes);
+        int offset = 0;
+        for (size_t i = 0; i <= values.size(); ++i) {
+            std::memcpy(&out[i * sizeof(int)], &offset, sizeof(int));
+            if (i == values.size()) break;
+            if (!values[i].empty()) std::memcpy(&out[tableBytes + offset], values[i].data(), values[i].size());
+            offset += (int)values[i].size();
+        }
+    }
+    static bool fits(const char* data, int bytes, int count) {
+        if ((long)bytes < ((long)count + 1) * (long)sizeof(int)) return false;
+        int tableBytes = (count + 1) * (int)sizeof(int);
+        int charBytes;
+        std::memcpy(&charBytes, data + count * sizeof(int), sizeof(int));
+        return charBytes == bytes - tableBytes;
+    }
+    static View get(const char* data, int bytes, int count, int index) {
+        // Offsets are checked here rather than at load time, so opening stays O(1)
+        int range[2];
+        std::memcpy(range, data + index * sizeof(int), sizeof(range));
+        int charBytes = bytes - (count + 1) * (int)sizeof(int);
+        if (range[0] < 0 || range[0] > range[1] || range[1] > charBytes) throw std::runtime_error("Snapshot string table is corrupt");
+        View view;
+        view.data = data + (count + 1) * sizeof(int) + range[0];
+        view.length = range[1] - range[0];
+        return view;
+    }
+    static std::string toElem(const View& view) { return view.str(); }
+    static int compare(const View& view, const std::string& value) {
+        int common = (view.length < (int)value.size()) ? view.length : (int)value.size();
+        int result = std::memcmp(view.data, value.data(), common);
+        if (result != 0) return result;
+        return (view.length < (int)value.size()) ? -1 : (view.length > (int)value.size()) ? 1 : 0;
+    }
+};
+
+// Read-only bytes of a snapshot file: mapped when possible, otherwise read into memory
+class SnapshotFile {
+    private:
+        const char* data;
+        size_t size;
+        bool mapped;
+        std::vector<char> buffer;
+
+        SnapshotFile(const SnapshotFile&); // Not copyable: views point into the mapping
+        SnapshotFile& operator=(const SnapshotFile&);
+
+    public:
+        SnapshotFile() : data(NULL), size(0), mapped(false) {}
+        ~SnapshotFile() { close(); }
+
+        void open(const std::string& path);
+        void close();
+        const char* getData() const { return data; }
+        size_t getSize() const { return size; }
+        bool isMapped() const { return mapped; }
+
+        static void write(const std::string& path, const std::vector<int>& header, const std::vector<int>& structure, const std::vector<char>& values);
+};
+
+inline void SnapshotFile::open(const std::string& path) {
+    close();
+#ifdef TREE_SNAPSHOT_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open snapshot " + path);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char*>(address);
+            size = (size_t)info.st_size;
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped) return;
+#endif
+    // Fallback: one read of the whole file
+    std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open snapshot " + path);
+    in.seekg(0, std::ios::end);
+    std::streamoff length = in.tellg();
+    in.seekg(0, std::ios::beg);
+    buffer.resize(length > 0 ? (size_t)length : 0);
+    if (!buffer.empty() && !in.read(&buffer[0], (std::streamsize)buffer.size())) throw std::runtime_error("Cannot read snapshot " + path);
+    data = buffer.empty() ? NULL : &buffer[0];
+    size = buffer.size();
+}
+
+inline void SnapshotFile::close() {
+#ifdef TREE_SNAPSHOT_MMAP
+    if (mapped) munmap(const_cast<char*>(data), size);
+#endif
+    std::vector<char>().swap(buffer);
+    data = NULL;
+    size = 0;
+    mapped = false;
+}
+
+inline void SnapshotFile::write(const std::string& path, const std::vector<int>& header, const std::vector<int>& structure, const std::vector<char>& values) {
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot create snapshot " + path);
+    out.write(reinterpret_cast<const char*>(&header[0]), header.size() * sizeof(int));
+    if (!structure.empty()) out.write(reinterpret_cast<const char*>(&structure[0]), structure.size() * sizeof(int));
+    static const char padding[8] = { 0 };
+    size_t structureBytes = structure.size() * sizeof(int);
+    out.write(padding, (8 - structureBytes % 8) % 8);
+    if (!values.empty()) out.write(&values[0], values.size());
+    if (!out) throw std::runtime_error("Cannot write snapshot " + path);
+}
+
+// Header fields shared by both snapshot kinds
+struct SnapshotLayout {
+    enum { MAGIC = 0x4c505453, VERSION = 1, KIND_BIN_TREE = 1, KIND_N_TREE = 2, HEADER_INTS = 8 };
+    enum { FIELD_MAGIC, FIELD_VERSION, FIELD_KIND, FIELD_TAG, FIELD_NODES, FIELD_STRUCTURE, FIELD_VALUE_BYTES };
+
+    static std::vector<int> header(int kind, int tag, int nodes, int structureInts, int valueBytes) {
+        std::vector<int> fields(HEADER_INTS, 0);
+        fields[FIELD_MAGIC] = MAGIC;
+        fields[FIELD_VERSION] = VERSION;
+        fields[FIELD_KIND] = kind;
+        fields[FIELD_TAG] = tag;
+        fields[FIELD_NODES] = nodes;
+        fields[FIELD_STRUCTURE] = structureInts;
+        fields[FIELD_VALUE_BYTES] = valueBytes;
+        return fields;
+    }
+
+    // Checks the header against the file size and returns the structure ints and the value bytes
+    static void open(const SnapshotFile& file, int kind, int tag, int& nodes, const int*& structure, const char*& values, int& valueBytes) {
+        const int* fields = reinterpret_cast<const int*>(file.getData());
+        if (file.getSize() < HEADER_INTS * sizeof(int) || fields[FIELD_MAGIC] != MAGIC || fields[FIELD_VERSION] != VERSION) {
+            throw std::runtime_error("Not a tree snapshot");
+        }
+        if (fields[FIELD_KIND] != kind || fields[FIELD_TAG] != tag) throw std::runtime_error("Snapshot holds a different tree or value type");
+        nodes = fields[FIELD_NODES];
+        int structureInts = fields[FIELD_STRUCTURE];
+        valueBytes = fields[FIELD_VALUE_BYTES];
+        size_t structureBytes = (size_t)structureInts * sizeof(int);
+        size_t valueOffset = HEADER_INTS * sizeof(int) + structureBytes + (8 - structureBytes % 8) % 8;
+        if (nodes < 0 || structureInts < nodes || valueBytes < 0 || valueOffset + (size_t)valueBytes != file.getSize()) {
+            throw std::runtime_error("Snapshot size does not match its header");
+        }
+        structure = fields + HEADER_INTS;
+        values = file.getData() + valueOffset;
+    }
+};
+
+template <class elem>
+class BinTreeSnapshot {
+    private:
+        typedef SnapshotCodec<elem> Codec;
+
+        SnapshotFile file;
+        int nodeCount;
+        const int* left;
+        const int* right;
+        const char* values;
+        int valueBytes;
+
+        BinTreeSnapshot(const BinTreeSnapshot<elem>&);
+        BinTreeSnapshot<elem>& operator=(const BinTreeSnapshot<elem>&);
+
+        void CHECK_NODE(int node) const;
+
+    public:
+        BinTreeSnapshot();
+        explicit BinTreeSnapshot(const std::string& path);
+
+        static void write(const BinTree<elem>& tree, const std::string& path);
+        void load(const std::string& path); // O(1) apart from the mapping itself
+        void toBinTree(BinTree<elem>& target) const; // Checks the structure and rebuilds real nodes
+
+        bool isEmpty() const;
+        int getWeight() const;
+        bool isMapped() const;
+        int getRoot() const; // -1 when empty
+        int getLeft(int node) const; // -1 when there is none
+        int getRight(int node) const;
+        typename Codec::View getInfo(int node) const;
+        int findNode(const elem& value) const; // First match in pre-order, -1 if absent
+        int searchBST(const elem& value) const; // O(height) for a tree written from a BST, -1 if absent
+};
+
+template <class elem>
+class NTreeSnapshot {
+    private:
+        typedef SnapshotCodec<elem> Codec;
+
+        SnapshotFile file;
+        int nodeCount;
+        const int* subtreeSizes;
+        const int* childOffsets;
+        const int* childIndex;
+        const char* values;
+        int valueBytes;
+
+        NTreeSnapshot(const NTreeSnapshot<elem>&);
+        NTreeSnapshot<elem>& operator=(const NTreeSnapshot<elem>&);
+
+        void CHECK_NODE(int node) const;
+        void CHILD_RANGE(int node, int& begin, int& end) const; // Throws if the offsets are corrupt
+
+    public:
+        NTreeSnapshot();
+        explicit NTreeSnapshot(const std::string& path);
+
+        static void write(const NTree<elem>& tree, const std::string& path);
+        static void write(const NTreeCSR<elem>& tree, const std::string& path);
+        void load(const std::string& path); // O(1) apart from the mapping itself
+        void toNTree(NTree<elem>& target) const; // Checks the structure and rebuilds real nodes
+
+        bool isEmpty() const;
+        int getWeight() const;
+        bool isMapped() const;
+        typename Codec::View getInfo(int node) const;
+        int childCount(int node) const;
+        int getChild(int node, int position) const; // 1-based position, like NTreeCSR
+        int getSubtreeSize(int node) const;
+        int findNode(const elem& value) const; // First match in pre-order, -1 if absent
+};
+
+// --- BinTreeSnapshot ---
+
+template <class elem>
+BinTreeSnapshot<elem>::BinTreeSnapshot() : nodeCount(0), left(NULL), right(NULL), values(NULL), valueBytes(0) {}
+
+template <class elem>
+BinTreeSnapshot<elem>::BinTreeSnapshot(const std::string& path) : nodeCount(0), left(NULL), right(NULL), values(NULL), valueBytes(0) {
+    load(path);
+}
+
+template <class elem>
+void BinTreeSnapshot<elem>::CHECK_NODE(int node) const {
+    if (node < 0 || node >= nodeCount) throw std::out_of_range("BinTreeSnapshot node index out of range");
+}
+
+template <class elem>
+void BinTreeSnapshot<elem>::write(const BinTree<elem>& tree, const std::string& path) {
+    // Pre-order numbering: a node's left child, if any, is the next id
+    std::vector<elem> nodeValues;
+    std::vector<int> lefts, rights;
+    std::stack< std::pair<const NodeBinTree<elem>*, int> > s; // Node and the link that receives its id: 2 * parent + side
+    if (tree.root != NULL) s.push(std::make_pair((const NodeBinTree<elem>*)tree.root, -1));
+    while (!s.empty()) {
+        const NodeBinTree<elem>* node = s.top().first;
+        int link = s.top().second;
+        s.pop();
+        int id = (int)nodeValues.size();
+        if (link >= 0) ((link % 2 == 0) ? lefts : rights)[link / 2] = id;
+        nodeValues.push_back(node->getInfo());
+        lefts.push_back(-1);
+        rights.push_back(-1);
+        if (node->getRight() != NULL) s.push(std::make_pair((const NodeBinTree<elem>*)node->getRight(), 2 * id + 1));
+        if (node->getLeft() != NULL) s.push(std::make_pair((const NodeBinTree<elem>*)node->getLeft(), 2 * id));
+    }
+
+    std::vector<int> structure(lefts);
+    structure.insert(structure.end(), rights.begin(), rights.end());
+    std::vector<char> encoded;
+    Codec::encode(nodeValues, encoded);
+    int n = (int)nodeValues.size();
+    SnapshotFile::write(path, SnapshotLayout::header(SnapshotLayout::KIND_BIN_TREE, Codec::TAG, n, 2 * n, (int)encoded.size()), structure, encoded);
+}
+
+template <class elem>
+void BinTreeSnapshot<elem>::load(const std::string& path) {
+    nodeCount = 0; // Stays empty if anything below throws
+    file.open(path);
+    int nodes = 0;
+    const int* structure = NULL;
+    try {
+        SnapshotLayout::open(file, SnapshotLayout::KIND_BIN_TREE, Codec::TAG, nodes, structure, values, valueBytes);
+        const int* fields = reinterpret_cast<const int*>(file.getData());
+        if (fields[SnapshotLayout::FIELD_STRUCTURE] != 2L * nodes || !Codec::fits(values, valueBytes, nodes)) {
+            throw std::runtime_error("BinTree snapshot sections do not match the node count");
+        }
+    } catch (...) {
+        file.close();
+        throw;
+    }
+    left = structure;
+    right = structure + nodes;
+    nodeCount = nodes;
+}
+
+template <class elem>
+void BinTreeSnapshot<elem>::toBinTree(BinTree<elem>& target) const {
+    target.CLEAR();
+    if (nodeCount == 0) return;
+    // Every link must name exactly the next pre-order id, which also rules out cycles; checked before any node is made
+    std::stack<int> s;
+    s.push(0);
+    int expected = 0;
+    while (!s.empty()) {
+        int node = s.top();
+        s.pop();
+        if (node != expected++ || node >= nodeCount) throw std::runtime_error("BinTree snapshot structure is corrupt");
+        if (right[node] != -1) s.push(right[node]);
+        if (left[node] != -1) s.push(left[node]);
+    }
+    if (expected != nodeCount) throw std::runtime_error("BinTree snapshot structure is corrupt");
+
+    std::vector<NodeBinTree<elem>*> nodes(nodeCount);
+    int made = 0;
+    try {
+        for (; made < nodeCount; ++made) nodes[made] = target.NEW_NODE(Codec::toElem(Codec::get(values, valueBytes, nodeCount, made)));
+    } catch (...) { // A corrupt value: the nodes made so far are not linked yet, so free them one by one
+        for (int i = 0; i < made; ++i) target.FREE_NODE(nodes[i]);
+        throw;
+    }
+    for (int i = nodeCount - 1; i >= 0; --i) { // Children have higher pre-order ids, so their sizes are ready
+        if (left[i] != -1) nodes[i]->setLeft(nodes[left[i]]);
+        if (right[i] != -1) nodes[i]->setRight(nodes[right[i]]);
+        target.UPDATE_SIZE(nodes[i]);
+    }
+    target.root = nodes[0];
+    target.weight = nodeCount;
+}
+
+template <class elem>
+bool BinTreeSnapshot<elem>::isEmpty() const {
+    return nodeCount == 0;
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::getWeight() const {
+    return nodeCount;
+}
+
+template <class elem>
+bool BinTreeSnapshot<elem>::isMapped() const {
+    return file.isMapped();
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::getRoot() const {
+    return (nodeCount > 0) ? 0 : -1;
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::getLeft(int node) const {
+    CHECK_NODE(node);
+    return left[node];
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::getRight(int node) const {
+    CHECK_NODE(node);
+    return right[node];
+}
+
+template <class elem>
+typename SnapshotCodec<elem>::View BinTreeSnapshot<elem>::getInfo(int node) const {
+    CHECK_NODE(node);
+    return Codec::get(values, valueBytes, nodeCount, node);
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::findNode(const elem& value) const {
+    for (int i = 0; i < nodeCount; ++i) {
+        if (Codec::compare(Codec::get(values, valueBytes, nodeCount, i), value) == 0) return i;
+    }
+    return -1;
+}
+
+template <class elem>
+int BinTreeSnapshot<elem>::searchBST(const elem& value) const {
+    int node = getRoot();
+    // Pre-order ids only grow going down, which bounds the walk even on a corrupt file
+    while (node >= 0 && node < nodeCount) {
+        int order = Codec::compare(Codec::get(values, valueBytes, nodeCount, node), value);
+        if (order == 0) return node;
+        int next = (order > 0) ? left[node] : right[node];
+        if (next <= node) return -1;
+        node = next;
+    }
+    return -1;
+}
+
+// --- NTreeSnapshot ---
+
+template <class elem>
+NTreeSnapshot<elem>::NTreeSnapshot() : nodeCount(0), subtreeSizes(NULL), childOffsets(NULL), childIndex(NULL), values(NULL), valueBytes(0) {}
+
+template <class elem>
+NTreeSnapshot<elem>::NTreeSnapshot(const std::string& path) : nodeCount(0), subtreeSizes(NULL), childOffsets(NULL), childIndex(NULL), values(NULL), valueBytes(0) {
+    load(path);
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::CHECK_NODE(int node) const {
+    if (node < 0 || node >= nodeCount) throw std::out_of_range("NTreeSnapshot node index out of range");
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::CHILD_RANGE(int node, int& begin, int& end) const {
+    CHECK_NODE(node);
+    begin = childOffsets[node];
+    end = childOffsets[node + 1];
+    if (begin < 0 || begin > end || end > nodeCount - 1) throw std::runtime_error("NTree snapshot child offsets are corrupt");
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::write(const NTree<elem>& tree, const std::string& path) {
+    write(NTreeCSR<elem>(tree), path);
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::write(const NTreeCSR<elem>& tree, const std::string& path) {
+    int n = tree.getWeight();
+    std::vector<elem> nodeValues;
+    std::vector<int> structure;
+    nodeValues.reserve(n);
+    structure.reserve(3 * n);
+    for (int i = 0; i < n; ++i) {
+        nodeValues.push_back(tree.getInfo(i));
+        structure.push_back(tree.getSubtreeSize(i));
+    }
+    int offset = 0;
+    for (int i = 0; i < n; ++i) {
+        structure.push_back(offset);
+        offset += tree.childCount(i);
+    }
+    structure.push_back(offset);
+    for (int i = 0; i < n; ++i) structure.insert(structure.end(), tree.childrenBegin(i), tree.childrenEnd(i));
+
+    std::vector<char> encoded;
+    Codec::encode(nodeValues, encoded);
+    SnapshotFile::write(path, SnapshotLayout::header(SnapshotLayout::KIND_N_TREE, Codec::TAG, n, (int)structure.size(), (int)encoded.size()), structure, encoded);
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::load(const std::string& path) {
+    nodeCount = 0; // Stays empty if anything below throws
+    file.open(path);
+    int nodes = 0;
+    const int* structure = NULL;
+    try {
+        SnapshotLayout::open(file, SnapshotLayout::KIND_N_TREE, Codec::TAG, nodes, structure, values, valueBytes);
+        const int* fields = reinterpret_cast<const int*>(file.getData());
+        if (fields[SnapshotLayout::FIELD_STRUCTURE] != ((nodes == 0) ? 1L : 3L * nodes) // sizes + offsets + (n - 1) children
+            || !Codec::fits(values, valueBytes, nodes)) {
+            throw std::runtime_error("NTree snapshot sections do not match the node count");
+        }
+    } catch (...) {
+        file.close();
+        throw;
+    }
+    subtreeSizes = structure;
+    childOffsets = structure + nodes;
+    childIndex = childOffsets + nodes + 1;
+    nodeCount = nodes;
+}
+
+template <class elem>
+void NTreeSnapshot<elem>::toNTree(NTree<elem>& target) const {
+    target.CLEAR();
+    if (nodeCount == 0) return;
+    // Each node's children must be the next pre-order ids; checked before any node is made
+    std::stack<int> s;
+    s.push(0);
+    int expected = 0;
+    while (!s.empty()) {
+        int node = s.top();
+        s.pop();
+        if (node != expected++ || node >= nodeCount) throw std::runtime_error("NTree snapshot structure is corrupt");
+        int begin, end;
+        CHILD_RANGE(node, begin, end);
+        for (int k = end; k > begin; --k) s.push(childIndex[k - 1]);
+    }
+    if (expected != nodeCount) throw std::runtime_error("NTree snapshot structure is corrupt");
+
+    std::vector<NodeNTree<elem>*> nodes(nodeCount);
+    int made = 0;
+    try {
+        for (; made < nodeCount; ++made) nodes[made] = target.NEW_NODE(Codec::toElem(Codec::get(values, valueBytes, nodeCount, made)));
+    } catch (...) { // A corrupt value: the nodes made so far are not linked yet, so free them one by one
+        for (int i = 0; i < made; ++i) target.FREE_NODE(nodes[i]);
+        throw;
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        NodeNTree<elem>* previous = NULL;
+        for (int k = childOffsets[i]; k < childOffsets[i + 1]; ++k) {
+            NodeNTree<elem>* child = nodes[childIndex[k]];
+            if (previous == NULL) nodes[i]->setSons(child);
+            else previous->setBro(child);
+            previous = child;
+        }
+    }
+    target.root = nodes[0];
+    target.weight = nodeCount;
+    target.REBUILD_NODE_INDEX();
+}
+
+template <class elem>
+bool NTreeSnapshot<elem>::isEmpty() const {
+    return nodeCount == 0;
+}
+
+template <class elem>
+int NTreeSnapshot<elem>::getWeight() const {
+    return nodeCount;
+}
+
+template <class elem>
+bool NTreeSnapshot<elem>::isMapped() const {
+    return file.isMapped();
+}
+
+template <class elem>
+typename SnapshotCodec<elem>::View NTreeSnapshot<elem>::getInfo(int node) const {
+    CHECK_NODE(node);
+    return Codec::get(values, valueBytes, nodeCount, node);
+}
+
+template <class elem>
+int NTreeSnapshot<elem>::childCount(int node) const {
+    int begin, end;
+    CHILD_RANGE(node, begin, end);
+    return end - begin;
+}
+
+template <class elem>
+int NTreeSnapshot<elem>::getChild(int node, int position) const {
+    int begin, end;
+    CHILD_RANGE(node, begin, end);
+    if (position < 1 || position > end - begin) throw std::out_of_range("NTreeSnapshot child position out of range");
+    return childIndex[begin + position - 1];
+}
+
+template <class elem>
+int NTreeSnapshot<elem>::getSubtreeSize(int node) const {
+    CHECK_NODE(node);
+    return subtreeSizes[node];
+}
+
+template <class elem>
+int NTreeSnapshot<elem>::findNode(const elem& value) const {
+    for (int i = 0; i < nodeCount; ++i) {
+        if (Codec::compare(Codec::get(values, valueBytes, nodeCount, i), value) == 0) return i;
+    }
+    return -1;
+}
+
+#endif // TREE_SNAPSHOT_H_
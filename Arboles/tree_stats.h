@@ -0,0 +1,144 @@
+#ifndef TREE_STATS_H_
+#define TREE_STATS_H_
+
+#include <cstddef>
+#include <ctime>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+
+// Per-operation cost counters for BinTree and NTree. Compile with -DTREE_INSTRUMENTATION
+// to collect them; otherwise every TREE_STAT_* macro expands to nothing and the trees
+// are unchanged. The report API below is always available, so callers need no #ifdef.
+//
+// Each public operation opens a scope; the node visits, node allocations, element
+// comparisons and deepest recursion (or explicit stack) seen while it runs are charged
+// to it. A public operation called from another one is charged separately, while its
+// time is also included in the caller's. The counters are not thread-safe: fold()
+// tasks running on threads under TREE_PARALLEL are not counted.
+
+struct TreeOpStats {
+    long calls;
+    long visits;
+    long allocations;
+    long comparisons;
+    int maxDepth; // Deepest recursion or explicit stack in any single call
+    double seconds; // Processor time, callees included
+
+    TreeOpStats() : calls(0), visits(0), allocations(0), comparisons(0), maxDepth(0), seconds(0.0) {}
+};
+
+class TreeStats {
+    private:
+        std::map<std::string, TreeOpStats> operations; // Entries are never erased: call sites keep pointers to them
+        TreeOpStats* current; // Operation being charged; "(outside operations)" between calls
+        int depth;
+
+        TreeStats() : depth(0) { current = &operations["(outside operations)"]; }
+        TreeStats(const TreeStats&);
+        TreeStats& operator=(const TreeStats&);
+
+    public:
+        static TreeStats& get() {
+            static TreeStats instance;
+            return instance;
+        }
+
+        TreeOpStats* operation(const std::string& name) { return &operations[name]; }
+        const std::map<std::string, TreeOpStats>& getOperations() const { return operations; }
+
+        void reset() {
+            for (std::map<std::string, TreeOpStats>::iterator it = operations.begin(); it != operations.end(); ++it) {
+                it->second = TreeOpStats();
+            }
+        }
+
+        // One line per operation that ran since the last reset; per-call averages after the totals
+        void report(std::ostream& out) const {
+#ifndef TREE_INSTRUMENTATION
+            out << "tree stats: built without -DTREE_INSTRUMENTATION" << std::endl;
+#endif
+            out << std::left << std::setw(36) << "operation" << std::right
+                << std::setw(10) << "calls" << std::setw(14) << "visits" << std::setw(12) << "allocs"
+                << std::setw(14) << "compares" << std::setw(8) << "depth" << std::setw(11) << "ms"
+                << std::setw(12) << "visits/call" << std::setw(13) << "compar/call" << std::endl;
+            for (std::map<std::string, TreeOpStats>::const_iterator it = operations.begin(); it != operations.end(); ++it) {
+                const TreeOpStats& s = it->second;
+                if (s.calls == 0 && s.visits == 0 && s.allocations == 0 && s.comparisons == 0) continue;
+                double calls = s.calls > 0 ? (double)s.calls : 1.0;
+                out << std::left << std::setw(36) << it->first << std::right
+                    << std::setw(10) << s.calls << std::setw(14) << s.visits << std::setw(12) << s.allocations
+                    << std::setw(14) << s.comparisons << std::setw(8) << s.maxDepth
+                    << std::setw(11) << std::fixed << std::setprecision(2) << s.seconds * 1000.0
+                    << std::setw(12) << std::setprecision(1) << s.visits / calls
+                    << std::setw(13) << s.comparisons / calls << std::endl;
+            }
+        }
+
+        // --- Used through the TREE_STAT_* macros ---
+        void visit() { current->visits++; }
+        void allocation() { current->allocations++; }
+        void comparison() { current->comparisons++; }
+        void reachDepth(int d) { if (d > current->maxDepth) current->maxDepth = d; }
+
+        friend class TreeOpScope;
+        friend class TreeRecursionScope;
+};
+
+// Charges everything until the end of the enclosing block to one operation
+class TreeOpScope {
+    private:
+        TreeOpStats* previous;
+        int previousDepth;
+        std::clock_t start;
+
+    public:
+        explicit TreeOpScope(TreeOpStats* stats) {
+            TreeStats& all = TreeStats::get();
+            stats->calls++;
+            previous = all.current;
+            previousDepth = all.depth;
+            all.current = stats;
+            all.depth = 0;
+            start = std::clock();
+        }
+        ~TreeOpScope() {
+            TreeStats& all = TreeStats::get();
+            all.current->seconds += (double)(std::clock() - start) / CLOCKS_PER_SEC;
+            all.current = previous;
+            all.depth = previousDepth;
+        }
+};
+
+// One level of a recursive helper
+class TreeRecursionScope {
+    public:
+        TreeRecursionScope() { TreeStats& all = TreeStats::get(); all.reachDepth(++all.depth); }
+        ~TreeRecursionScope() { TreeStats::get().depth--; }
+};
+
+inline bool TREE_STAT_COUNT_COMPARISON(bool result) {
+    TreeStats::get().comparison();
+    return result;
+}
+
+#ifdef TREE_INSTRUMENTATION
+#define TREE_STAT_OPERATION(name) \
+    static TreeOpStats* const treeOpStats_ = TreeStats::get().operation(name); \
+    TreeOpScope treeOpScope_(treeOpStats_)
+#define TREE_STAT_RECURSION() TreeRecursionScope treeRecursionScope_
+#define TREE_STAT_VISIT() TreeStats::get().visit()
+#define TREE_STAT_ALLOCATION() TreeStats::get().allocation()
+#define TREE_STAT_DEPTH(d) TreeStats::get().reachDepth((int)(d))
+#define TREE_STAT_COMPARE(condition) TREE_STAT_COUNT_COMPARISON(condition)
+#else
+#define TREE_STAT_OPERATION(name)
+#define TREE_STAT_RECURSION()
+#define TREE_STAT_VISIT() ((void)0)
+#define TREE_STAT_ALLOCATION() ((void)0)
+#define TREE_STAT_DEPTH(d) ((void)sizeof(d)) // Unevaluated; marks a depth counter kept only for it as used
+#define TREE_STAT_COMPARE(condition) (condition)
+#endif
+
+#endif // TREE_STATS_H_
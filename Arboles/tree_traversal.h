@@ -0,0 +1,29 @@
+#ifndef TREE_TRAVERSAL_H_
+#define TREE_TRAVERSAL_H_
+
+// Traversal orders shared by the lazy BinTree and NTree iterators.
+enum TreeTraversal {
+    TRAVERSE_PRE_ORDER,
+    TRAVERSE_IN_ORDER,
+    TRAVERSE_POST_ORDER,
+    TRAVERSE_LEVEL_ORDER,
+    TRAVERSE_LEAVES,
+    TRAVERSE_LEVEL // Only the nodes at one depth, left to right
+};
+
+// A begin/end pair over a traversal. Works with range-based for (C++11) and,
+// since the iterators model forward_iterator, with C++20 std::ranges algorithms.
+template <class Iterator>
+class TreeRange {
+    private:
+        Iterator first;
+        Iterator last;
+    public:
+        TreeRange(const Iterator& first, const Iterator& last) : first(first), last(last) {}
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+        bool empty() const { return first == last; }
+};
+
+#endif // TREE_TRAVERSAL_H_
@@ -0,0 +1,43 @@
+#ifndef GRAPHPARALLEL_H
+#define GRAPHPARALLEL_H
+
+#ifdef GRAPH_PARALLEL
+#include <pthread.h>
+#include <unistd.h> // For sysconf
+#endif
+
+// Number of threads used by the graph algorithms that can split their work (HeldKarp,
+// HamiltonSearch). Compile with -DGRAPH_PARALLEL and link with -lpthread to use them;
+// otherwise everything runs on the calling thread and getThreads() is always 1.
+class GraphParallel {
+public:
+    static int getThreads(); // Defaults to the number of online CPUs (1 without GRAPH_PARALLEL)
+    static void setThreads(int threads); // Values below 1 restore the default
+
+private:
+    static int& THREAD_SETTING();
+};
+
+inline int& GraphParallel::THREAD_SETTING() {
+    static int threads = 0; // 0: not chosen yet
+    return threads;
+}
+
+inline int GraphParallel::getThreads() {
+    int& threads = THREAD_SETTING();
+    if (threads < 1) {
+#ifdef GRAPH_PARALLEL
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (int)online : 1;
+#else
+        threads = 1;
+#endif
+    }
+    return threads;
+}
+
+inline void GraphParallel::setThreads(int threads) {
+    THREAD_SETTING() = (threads < 1) ? 0 : threads;
+}
+
+#endif // GRAPHPARALLEL_H
@@ -0,0 +1,307 @@
+#ifndef HAMILTONSEARCH_H
+#define HAMILTONSEARCH_H
+
+#include <vector>
+#include <set>
+#include <utility> // For std::pair
+#include <algorithm> // For std::stable_sort
+#include <climits> // For CHAR_BIT
+#include <cstddef> // For NULL
+
+#include "GraphParallel.h"
+
+// Backtracking search for Hamiltonian paths, shared by GraphD and GraphND. Vertices are
+// map indices and every set of vertices is a bitset of unsigned long words, so marking,
+// unmarking and the checks below touch a few words instead of lists of values.
+//
+// Before going deeper from a vertex, the search checks that the path can still be finished:
+// every unvisited vertex must have an arc coming from the current vertex or another unvisited
+// one, at most one of them (the last vertex) may have no arc to another unvisited vertex, and
+// all of them must be reachable from the current vertex through unvisited vertices. States
+// (current vertex, unvisited set) that were proven dead are remembered, up to MAX_DEAD_STATES,
+// because they can be reached again through a different order of the visited vertices.
+//
+// findFrom() tries successors in the order given, so it returns the same path as a plain
+// backtracking search. exists() only answers yes or no, so it tries the successor with the
+// fewest unvisited successors first (Warnsdorff's rule) and, compiled with -DGRAPH_PARALLEL,
+// gives start vertices to GraphParallel::getThreads() threads, stopping all of them as soon
+// as one finds a path.
+class HamiltonSearch {
+public:
+    enum { MAX_DEAD_STATES = 1 << 18 }; // About 25 MB of remembered states at 64 vertices
+
+    // 'successors[v]' lists the indices v has an arc to, in the order findFrom() must try them. Self-loops and repeated arcs are ignored.
+    explicit HamiltonSearch(const std::vector< std::vector<int> >& successors) : n((int)successors.size()) {
+        words = (n + WORD_BITS - 1) / WORD_BITS;
+        next.resize(n);
+        successorSet.assign(n, VertexSet(words, 0));
+        predecessorSet.assign(n, VertexSet(words, 0));
+        for (int v = 0; v < n; ++v) {
+            for (size_t i = 0; i < successors[v].size(); ++i) {
+                int u = successors[v][i];
+                if (u == v || HAS(successorSet[v], u)) continue;
+                next[v].push_back(u);
+                ADD(successorSet[v], u);
+                ADD(predecessorSet[u], v);
+            }
+        }
+    }
+
+    // Depth-first search from 'start'. Fills 'path' with the first Hamiltonian path in successor order. Returns false if there is none.
+    bool findFrom(int start, std::vector<int>& path) {
+        path.clear();
+        if (start < 0 || start >= n) return false;
+        VertexSet unvisited(words, 0);
+        for (int v = 0; v < n; ++v) ADD(unvisited, v);
+        REMOVE(unvisited, start);
+        path.push_back(start);
+        if (SEARCH(start, unvisited, n - 1, path, false, deadStates, NULL)) return true;
+        path.clear();
+        return false;
+    }
+
+    // Checks if the graph has a Hamiltonian path from any start vertex. Returns bool (false for an empty graph).
+    bool exists() {
+        if (n == 0) return false;
+        std::vector<int> starts;
+        if (!START_CANDIDATES(starts)) return false;
+
+#ifdef GRAPH_PARALLEL
+        int threads = GraphParallel::getThreads();
+        if (threads > (int)starts.size()) threads = (int)starts.size();
+        if (threads > 1) {
+            Batch batch;
+            batch.search = this;
+            batch.starts = &starts;
+            batch.nextStart = 0;
+            batch.found = 0;
+            pthread_mutex_init(&batch.lock, NULL);
+            std::vector<pthread_t> workers(threads);
+            std::vector<bool> started(threads, false);
+            for (int i = 1; i < threads; ++i) {
+                started[i] = pthread_create(&workers[i], NULL, WORK, &batch) == 0;
+            }
+            WORK(&batch); // Threads that could not start leave their starts to the others
+            for (int i = 1; i < threads; ++i) {
+                if (started[i]) pthread_join(workers[i], NULL);
+            }
+            pthread_mutex_destroy(&batch.lock);
+            return batch.found != 0;
+        }
+#endif
+        std::vector<int> path;
+        for (size_t i = 0; i < starts.size(); ++i) {
+            if (RUN_START(starts[i], path, deadStates, NULL)) return true;
+        }
+        return false;
+    }
+
+private:
+    typedef std::vector<unsigned long> VertexSet;
+    typedef std::set< std::pair<int, VertexSet> > DeadStates;
+
+    enum { WORD_BITS = sizeof(unsigned long) * CHAR_BIT };
+
+    int n;
+    int words; // Words in a VertexSet
+    std::vector< std::vector<int> > next; // Successors in the order to try them
+    std::vector<VertexSet> successorSet;
+    std::vector<VertexSet> predecessorSet;
+    DeadStates deadStates; // Shared by the sequential searches; each thread keeps its own
+
+    static bool HAS(const VertexSet& set, int v) { return (set[v / WORD_BITS] >> (v % WORD_BITS)) & 1ul; }
+    static void ADD(VertexSet& set, int v) { set[v / WORD_BITS] |= 1ul << (v % WORD_BITS); }
+    static void REMOVE(VertexSet& set, int v) { set[v / WORD_BITS] &= ~(1ul << (v % WORD_BITS)); }
+
+    // Checks if 'a' and 'b' have a vertex in common.
+    bool MEETS(const VertexSet& a, const VertexSet& b) const {
+        for (int w = 0; w < words; ++w) {
+            if (a[w] & b[w]) return true;
+        }
+        return false;
+    }
+
+    // Number of vertices in both 'a' and 'b'.
+    int COMMON_COUNT(const VertexSet& a, const VertexSet& b) const {
+        int count = 0;
+        for (int w = 0; w < words; ++w) {
+            for (unsigned long bits = a[w] & b[w]; bits != 0; bits &= bits - 1) count++;
+        }
+        return count;
+    }
+
+    // Checks that the unvisited vertices can still be chained after 'current' (see the class comment). O(V * words).
+    bool CAN_FINISH(int current, const VertexSet& unvisited) const {
+        VertexSet entry(unvisited); // Vertices an unvisited vertex may be entered from
+        ADD(entry, current);
+        int ends = 0;
+        for (int v = 0; v < n; ++v) {
+            if (!HAS(unvisited, v)) continue;
+            if (!MEETS(predecessorSet[v], entry)) return false;
+            if (!MEETS(successorSet[v], unvisited) && ++ends > 1) return false;
+        }
+
+        // Breadth-first search from 'current' over unvisited vertices, a whole frontier per round
+        VertexSet reached(words, 0), frontier(words, 0), grown(words, 0);
+        ADD(frontier, current);
+        bool growing = true;
+        while (growing) {
+            std::fill(grown.begin(), grown.end(), 0ul);
+            for (int v = 0; v < n; ++v) {
+                if (!HAS(frontier, v)) continue;
+                for (int w = 0; w < words; ++w) grown[w] |= successorSet[v][w];
+            }
+            growing = false;
+            for (int w = 0; w < words; ++w) {
+                frontier[w] = grown[w] & unvisited[w] & ~reached[w];
+                reached[w] |= frontier[w];
+                if (frontier[w]) growing = true;
+            }
+        }
+        return reached == unvisited;
+    }
+
+    // Lets the search of one thread give up once another thread has found a path.
+    struct Cancel {
+        int countdown; // Search steps until the next look at the shared flag
+        bool stopped;
+#ifdef GRAPH_PARALLEL
+        pthread_mutex_t* lock;
+        const int* found;
+#endif
+    };
+
+    // Checks if the search should give up. Takes the lock only every CANCEL_INTERVAL calls.
+    static bool CANCELLED(Cancel* cancel) {
+        const int CANCEL_INTERVAL = 1024;
+        if (cancel == NULL || cancel->stopped) return cancel != NULL;
+        if (--cancel->countdown > 0) return false;
+        cancel->countdown = CANCEL_INTERVAL;
+#ifdef GRAPH_PARALLEL
+        pthread_mutex_lock(cancel->lock);
+        cancel->stopped = *cancel->found != 0;
+        pthread_mutex_unlock(cancel->lock);
+#endif
+        return cancel->stopped;
+    }
+
+    // Extends 'path' (ending at 'current', with 'left' vertices still unvisited) to a Hamiltonian path. 'cancel' is NULL when running alone.
+    bool SEARCH(int current, VertexSet& unvisited, int left, std::vector<int>& path, bool warnsdorff, DeadStates& dead, Cancel* cancel) {
+        if (left == 0) return true;
+        if (CANCELLED(cancel)) return false;
+
+        std::pair<int, VertexSet> state(current, unvisited);
+        if (dead.find(state) != dead.end()) return false;
+
+        if (CAN_FINISH(current, unvisited)) {
+            std::vector<int> candidates;
+            for (size_t i = 0; i < next[current].size(); ++i) {
+                if (HAS(unvisited, next[current][i])) candidates.push_back(next[current][i]);
+            }
+            if (warnsdorff) {
+                std::vector< std::pair<int, int> > ranked; // (unvisited successors, candidate)
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    ranked.push_back(std::make_pair(COMMON_COUNT(successorSet[candidates[i]], unvisited), candidates[i]));
+                }
+                std::stable_sort(ranked.begin(), ranked.end(), FewerOnwardArcs());
+                for (size_t i = 0; i < ranked.size(); ++i) candidates[i] = ranked[i].second;
+            }
+
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                int u = candidates[i];
+                REMOVE(unvisited, u);
+                path.push_back(u);
+                if (SEARCH(u, unvisited, left - 1, path, warnsdorff, dead, cancel)) return true;
+                path.pop_back();
+                ADD(unvisited, u);
+            }
+        }
+
+        if (!(cancel && cancel->stopped) && dead.size() < (size_t)MAX_DEAD_STATES) {
+            dead.insert(state); // Only remembered when fully explored
+        }
+        return false;
+    }
+
+    // Orders Warnsdorff candidates by how many unvisited successors they have.
+    struct FewerOnwardArcs {
+        bool operator()(const std::pair<int, int>& a, const std::pair<int, int>& b) const {
+            return a.first < b.first;
+        }
+    };
+
+    // Start vertices worth trying for exists(), fewest predecessors first. A vertex without predecessors must be the start,
+    // so if there is one it is the only candidate. When every arc goes both ways, paths can be reversed and a vertex with a
+    // single neighbor must be one of the two ends, so it is enough to start there. Returns false when no path can exist.
+    bool START_CANDIDATES(std::vector<int>& starts) const {
+        bool symmetric = true;
+        for (int v = 0; v < n && symmetric; ++v) symmetric = successorSet[v] == predecessorSet[v];
+
+        std::vector< std::pair<int, int> > ranked; // (predecessors, vertex)
+        int forcedStarts = 0, leaves = 0;
+        for (int v = 0; v < n; ++v) {
+            int predecessors = COMMON_COUNT(predecessorSet[v], predecessorSet[v]);
+            if (predecessors == 0 && n > 1) {
+                if (++forcedStarts > 1) return false;
+                starts.assign(1, v);
+            }
+            if (symmetric && predecessors == 1) {
+                if (++leaves > 2) return false;
+                if (leaves == 1 && forcedStarts == 0) starts.assign(1, v);
+            }
+            ranked.push_back(std::make_pair(predecessors, v));
+        }
+        if (!starts.empty()) return true;
+        std::stable_sort(ranked.begin(), ranked.end(), FewerOnwardArcs());
+        for (size_t i = 0; i < ranked.size(); ++i) starts.push_back(ranked[i].second);
+        return true;
+    }
+
+    // Runs the Warnsdorff-ordered search from one start vertex.
+    bool RUN_START(int start, std::vector<int>& path, DeadStates& dead, Cancel* cancel) {
+        VertexSet unvisited(words, 0);
+        for (int v = 0; v < n; ++v) ADD(unvisited, v);
+        REMOVE(unvisited, start);
+        path.assign(1, start);
+        return SEARCH(start, unvisited, n - 1, path, true, dead, cancel);
+    }
+
+#ifdef GRAPH_PARALLEL
+    struct Batch {
+        HamiltonSearch* search;
+        const std::vector<int>* starts;
+        pthread_mutex_t lock; // Guards nextStart and found
+        size_t nextStart;
+        int found;
+    };
+
+    // Takes start vertices from the batch until they run out or some thread finds a path.
+    static void* WORK(void* argument) {
+        Batch* batch = static_cast<Batch*>(argument);
+        DeadStates dead; // std::set is not thread-safe, so each thread remembers its own dead states
+        std::vector<int> path;
+        Cancel cancel;
+        cancel.countdown = 1;
+        cancel.stopped = false;
+        cancel.lock = &batch->lock;
+        cancel.found = &batch->found;
+        while (true) {
+            pthread_mutex_lock(&batch->lock);
+            bool done = batch->found || batch->nextStart == batch->starts->size();
+            int start = done ? -1 : (*batch->starts)[batch->nextStart++];
+            pthread_mutex_unlock(&batch->lock);
+            if (done) break;
+
+            if (batch->search->RUN_START(start, path, dead, &cancel)) {
+                pthread_mutex_lock(&batch->lock);
+                batch->found = 1;
+                pthread_mutex_unlock(&batch->lock);
+                break;
+            }
+        }
+        return NULL;
+    }
+#endif
+};
+
+#endif // HAMILTONSEARCH_H
@@ -0,0 +1,159 @@
+#ifndef HELDKARP_H
+#define HELDKARP_H
+
+#include <vector>
+#include <limits> // For infinity, used as "no arc" / "no path"
+#include <cstddef> // For NULL
+
+#include "GraphParallel.h"
+
+// Held-Karp dynamic program for Hamiltonian paths, shared by GraphD and GraphND.
+// It works on a dense weight matrix of vertex indices: weights[v * n + u] is the weight
+// of the arc v->u, or noArc(). pathCost(v, S) is the cheapest (or dearest, when maximizing)
+// cost of a path that starts at v and visits exactly the vertices of the set S, so a whole
+// Hamiltonian path is pathCost(start, allVertices()) and the graphs rebuild it one vertex
+// at a time by looking for the arc that keeps that cost.
+//
+// Sets of k vertices only read sets of k - 1 vertices, so the table is filled one layer
+// of equal-size sets at a time. Compiled with -DGRAPH_PARALLEL, each layer is split among
+// GraphParallel::getThreads() threads. O(2^n * n^2) time and n * 2^(n-1) floats of memory:
+// about 185 MB at MAX_VERTICES (25 vertices would take 1.6 GB), so above it the graphs only backtrack.
+//
+// The table always costs its full 2^n * n^2, while branch and bound settles most graphs (a chain,
+// random weights) in a few thousand calls. So the graphs backtrack first, within searchBudget()
+// calls, and build the table only for the graphs that exhaust it: ties and bounds too weak to
+// prune, or no Hamiltonian path at all, which the bounds can never prove.
+class HeldKarp {
+public:
+    enum { MAX_VERTICES = 22 };
+
+    // Backtracking calls the graphs allow before building the table for 'n' vertices: a sixteenth of its
+    // n * 2^(n-1) cells, and a call costs about as much as a cell, so a search that runs out adds some 6%
+    // to the table's time. -1 (no limit) above MAX_VERTICES.
+    static long searchBudget(int n) {
+        if (n > MAX_VERTICES) return -1;
+        return 256 + (((long)n << n) >> 5);
+    }
+
+    // Value of a missing arc in the weight matrix.
+    static float noArc() { return std::numeric_limits<float>::infinity(); }
+
+    // Value of pathCost() when no such path exists.
+    static float noPath() { return std::numeric_limits<float>::infinity(); }
+
+    // Builds the table for 'n' vertices (at most MAX_VERTICES). Self-loops are ignored.
+    HeldKarp(const std::vector<float>& weights, int n, bool maximize) : weights(weights), n(n), maximize(maximize) {
+        half = (n > 0) ? (1u << (n - 1)) : 0;
+        table.assign((size_t)n * half, noPath());
+        for (int v = 0; v < n; ++v) {
+            table[(size_t)v * half] = 0.0f; // The path made of v alone
+        }
+        for (layer = 2; layer <= n; ++layer) {
+            RUN_LAYER();
+        }
+    }
+
+    // Set holding every vertex.
+    unsigned int allVertices() const {
+        return (n > 0) ? ((1u << n) - 1) : 0;
+    }
+
+    // Best cost of a path that starts at 'v' and visits exactly the vertices in 'set' ('v' must be in it). Returns noPath() if there is none.
+    float pathCost(int v, unsigned int set) const {
+        return table[(size_t)v * half + SQUEEZE(set, v)];
+    }
+
+    // Checks if cost 'a' is better than cost 'b' in the direction the table was built for.
+    bool isBetter(float a, float b) const {
+        return maximize ? a > b : a < b;
+    }
+
+private:
+    const std::vector<float>& weights;
+    std::vector<float> table; // table[v * half + SQUEEZE(S, v)] = pathCost(v, S)
+    unsigned int half;        // 2^(n-1): sets that contain a given vertex
+    int n;
+    bool maximize;
+    int layer;                // Size of the sets being filled
+    int workers;              // Threads sharing the current layer
+
+    HeldKarp(const HeldKarp&);
+    HeldKarp& operator=(const HeldKarp&);
+
+    // Removes bit 'v' from 'set', numbering the sets that contain v from 0 to 2^(n-1) - 1.
+    static unsigned int SQUEEZE(unsigned int set, int v) {
+        unsigned int low = set & ((1u << v) - 1);
+        return low | ((set >> (v + 1)) << v);
+    }
+
+    // Next larger set with the same number of vertices (Gosper's hack).
+    static unsigned int NEXT_SAME_SIZE(unsigned int set) {
+        unsigned int lowest = set & (~set + 1);
+        unsigned int ripple = set + lowest;
+        return (((ripple ^ set) >> 2) / lowest) | ripple;
+    }
+
+    // Fills pathCost(v, S) for every set S of 'layer' vertices whose position within the layer is 'worker' modulo 'workers'.
+    void FILL_LAYER(int worker) {
+        unsigned int end = 1u << n;
+        int position = 0;
+        for (unsigned int set = (1u << layer) - 1; set < end; set = NEXT_SAME_SIZE(set), ++position) {
+            if (position % workers != worker) continue;
+            for (int v = 0; v < n; ++v) {
+                if (!(set & (1u << v))) continue;
+                unsigned int rest = set & ~(1u << v);
+                const float* row = &weights[(size_t)v * n];
+                float best = noPath();
+                for (int u = 0; u < n; ++u) {
+                    if (!(rest & (1u << u)) || row[u] == noArc()) continue;
+                    float tail = table[(size_t)u * half + SQUEEZE(rest, u)];
+                    if (tail == noPath()) continue;
+                    float cost = row[u] + tail;
+                    if (best == noPath() || isBetter(cost, best)) best = cost;
+                }
+                table[(size_t)v * half + SQUEEZE(set, v)] = best;
+            }
+        }
+    }
+
+#ifdef GRAPH_PARALLEL
+    struct Worker {
+        HeldKarp* owner;
+        int id;
+    };
+
+    static void* WORK(void* argument) {
+        Worker* worker = static_cast<Worker*>(argument);
+        worker->owner->FILL_LAYER(worker->id);
+        return NULL;
+    }
+#endif
+
+    // Fills the current layer, on several threads when GRAPH_PARALLEL is defined and the graph is big enough to pay for them.
+    void RUN_LAYER() {
+        workers = 1;
+#ifdef GRAPH_PARALLEL
+        const int MIN_PARALLEL_VERTICES = 14; // Below this a whole table takes less than thread start-up
+        if (n >= MIN_PARALLEL_VERTICES) workers = GraphParallel::getThreads();
+        if (workers > 1) {
+            std::vector<Worker> work(workers);
+            std::vector<pthread_t> threads(workers);
+            std::vector<bool> started(workers, false);
+            for (int i = 1; i < workers; ++i) {
+                work[i].owner = this;
+                work[i].id = i;
+                started[i] = pthread_create(&threads[i], NULL, WORK, &work[i]) == 0;
+            }
+            FILL_LAYER(0);
+            for (int i = 1; i < workers; ++i) {
+                if (started[i]) pthread_join(threads[i], NULL);
+                else FILL_LAYER(i); // Could not start the thread: do its share here
+            }
+            return;
+        }
+#endif
+        FILL_LAYER(0);
+    }
+};
+
+#endif // HELDKARP_H
@@ -0,0 +1,243 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// arcExists / edgeExists con el índice de arcos ordenado por destino (búsqueda binaria, O(log deg))
+// contra recorrer la lista de adyacencia como hacían FIND_ARC_NODE y FIND_EDGE (O(deg)). La lista
+// de antes se arma aparte, con los mismos arcos y en el mismo orden que las listas del grafo; el
+// vértice se busca igual en las dos versiones. La mitad de las consultas son arcos que existen.
+// Con grado bajo la diferencia es chica: la búsqueda binaria salta de arco a vértice destino en
+// cada paso, y una lista de nueve arcos se recorre casi igual de rápido.
+// Después, el camino hamiltoniano de costo máximo por fuerza bruta, como era antes (getSuccessors y
+// getArcWeight por cada candidato), con el peso buscado en la lista o en el índice.
+// Uso: ./comparar_arcos [consultas] [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, int consultas, double lista, double indice, bool iguales) {
+    std::cout << std::left << std::setw(36) << que << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << consultas / lista / 1e6 << std::setw(12) << consultas / indice / 1e6
+              << std::setw(9) << std::setprecision(1) << lista / (indice > 0 ? indice : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Sin el índice: una lista de (destino, peso) por vértice, recorrida de punta a punta ---
+
+struct ListasDeAntes {
+    std::vector<int> valores; // Ordenados, como el mapa del grafo
+    std::vector< std::list< std::pair<int, float> > > arcos;
+
+    int indice(int valor) const {
+        std::vector<int>::const_iterator it = std::lower_bound(valores.begin(), valores.end(), valor);
+        return (it != valores.end() && *it == valor) ? (int)(it - valores.begin()) : -1;
+    }
+
+    // -1 si no hay arco, como getArcWeight
+    float peso(int origen, int destino) const {
+        int i = indice(origen);
+        if (i < 0) return -1.0f;
+        for (std::list< std::pair<int, float> >::const_iterator it = arcos[i].begin(); it != arcos[i].end(); ++it) {
+            if (it->first == destino) return it->second;
+        }
+        return -1.0f;
+    }
+
+    void agregar(int origen, int destino, float peso) {
+        arcos[indice(origen)].push_back(std::make_pair(destino, peso));
+    }
+};
+
+ListasDeAntes listasDe(GraphD<int>& grafo) {
+    ListasDeAntes listas;
+    listas.valores = grafo.getMap();
+    listas.arcos.resize(listas.valores.size());
+    std::list< ArcInfo<int> > arcos = grafo.getArcs(); // En el orden de las listas de adyacencia
+    for (std::list< ArcInfo<int> >::iterator it = arcos.begin(); it != arcos.end(); ++it) {
+        listas.agregar(it->source, it->destination, it->weight);
+    }
+    return listas;
+}
+
+// Pares (origen, destino): la mitad arcos que existen, la otra mitad al azar
+void consultas(const ListasDeAntes& listas, int cuantas, std::vector<int>& origen, std::vector<int>& destino) {
+    origen.resize(cuantas);
+    destino.resize(cuantas);
+    int n = (int)listas.valores.size();
+    for (int i = 0; i < cuantas; i++) {
+        int v = std::rand() % n;
+        origen[i] = listas.valores[v];
+        if (i % 2 == 0 && !listas.arcos[v].empty()) {
+            std::list< std::pair<int, float> >::const_iterator it = listas.arcos[v].begin();
+            std::advance(it, std::rand() % listas.arcos[v].size());
+            destino[i] = it->first;
+        } else {
+            destino[i] = listas.valores[std::rand() % n];
+        }
+    }
+}
+
+void compararConsultas(int vertices, int grado, int cuantas) {
+    // Las listas de antes se llenan a la par del grafo, arco por arco, para que sus nodos queden
+    // tan desparramados en memoria como los del grafo; los arcos nuevos van al frente, como en GraphD
+    GraphD<int> dirigido;
+    GraphND<int> noDirigido;
+    ListasDeAntes listasD, listasND;
+    for (int i = 0; i < vertices; i++) {
+        dirigido.addVertex(i);
+        noDirigido.addVertex(i);
+        listasD.valores.push_back(i);
+    }
+    listasND.valores = listasD.valores;
+    listasD.arcos.resize(vertices);
+    listasND.arcos.resize(vertices);
+    for (int i = 0; i < vertices; i++) {
+        for (int j = 0; j < grado; j++) {
+            int destino = std::rand() % vertices;
+            float peso = (float)(1 + std::rand() % 100);
+            int antes = dirigido.size();
+            dirigido.addArc(i, destino, peso);
+            if (dirigido.size() > antes) listasD.arcos[i].push_front(std::make_pair(destino, peso));
+            antes = noDirigido.getNumEdges();
+            if (j % 2 == 0 && destino != i) noDirigido.addEdge(i, destino, peso);
+            if (noDirigido.getNumEdges() > antes) {
+                listasND.arcos[i].push_front(std::make_pair(destino, peso));
+                listasND.arcos[destino].push_front(std::make_pair(i, peso));
+            }
+        }
+    }
+    std::vector<int> origen, destino;
+
+    consultas(listasD, cuantas, origen, destino);
+    long enLista = 0, enIndice = 0;
+    std::clock_t reloj = std::clock();
+    for (int i = 0; i < cuantas; i++) enLista += listasD.peso(origen[i], destino[i]) >= 0;
+    double lista = segundosDesde(reloj);
+    reloj = std::clock();
+    for (int i = 0; i < cuantas; i++) enIndice += dirigido.arcExists(origen[i], destino[i]);
+    std::ostringstream que;
+    que << "arcExists, " << vertices << " V, grado " << dirigido.size() / vertices;
+    fila(que.str(), cuantas, lista, segundosDesde(reloj), enLista == enIndice);
+
+    consultas(listasND, cuantas, origen, destino);
+    enLista = enIndice = 0;
+    reloj = std::clock();
+    for (int i = 0; i < cuantas; i++) enLista += listasND.peso(origen[i], destino[i]) >= 0;
+    lista = segundosDesde(reloj);
+    reloj = std::clock();
+    for (int i = 0; i < cuantas; i++) enIndice += noDirigido.edgeExists(origen[i], destino[i]);
+    que.str("");
+    que << "edgeExists, " << vertices << " V, grado " << 2 * noDirigido.getNumEdges() / vertices;
+    fila(que.str(), cuantas, lista, segundosDesde(reloj), enLista == enIndice);
+}
+
+// --- Camino hamiltoniano de costo máximo, la fuerza bruta de antes ---
+
+// Peso buscado en la lista o en el índice del grafo
+struct PesoEnLista {
+    const ListasDeAntes* listas;
+    float operator()(GraphD<int>&, int origen, int destino) const { return listas->peso(origen, destino); }
+};
+
+struct PesoEnIndice {
+    float operator()(GraphD<int>& grafo, int origen, int destino) const { return grafo.getArcWeight(origen, destino); }
+};
+
+template <typename Peso>
+void maximoDesde(GraphD<int>& grafo, const Peso& peso, int actual, std::vector<bool>& visitado, std::list<int>& camino, float costo,
+                 std::list<int>& mejor, float& maximo) {
+    int indice = grafo.getMapIndex(actual);
+    if (visitado[indice]) return;
+    visitado[indice] = true;
+    camino.push_back(actual);
+    if ((int)camino.size() == grafo.order()) {
+        if (maximo < 0 || costo > maximo) {
+            maximo = costo;
+            mejor = camino;
+        }
+    } else {
+        std::list<int> siguientes = grafo.getSuccessors(actual);
+        for (std::list<int>::iterator it = siguientes.begin(); it != siguientes.end(); ++it) {
+            float w = peso(grafo, actual, *it);
+            if (w >= 0) maximoDesde(grafo, peso, *it, visitado, camino, costo + w, mejor, maximo);
+        }
+    }
+    camino.pop_back();
+    visitado[indice] = false;
+}
+
+template <typename Peso>
+float caminoMaximo(GraphD<int>& grafo, const Peso& peso) {
+    std::list<int> camino, mejor;
+    std::vector<bool> visitado(grafo.order(), false);
+    float maximo = -1.0f;
+    for (int v = 0; v < grafo.order(); v++) maximoDesde(grafo, peso, grafo.getMapVertex(v), visitado, camino, 0.0f, mejor, maximo);
+    return maximo;
+}
+
+float costo(GraphD<int>& grafo, const std::list<int>& camino) {
+    float suma = 0.0f;
+    for (std::list<int>::const_iterator it = camino.begin(), siguiente = ++camino.begin(); siguiente != camino.end(); ++it, ++siguiente) {
+        suma += grafo.getArcWeight(*it, *siguiente);
+    }
+    return suma;
+}
+
+int main(int argc, char** argv) {
+    int cuantas = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (cuantas < 1) {
+        std::cerr << "Uso: " << argv[0] << " [consultas >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::cout << cuantas << " consultas" << std::endl;
+    std::cout << std::left << std::setw(36) << "consulta (millones por s)" << std::right << std::setw(12) << "lista"
+              << std::setw(12) << "índice" << std::setw(10) << "mejora" << std::endl;
+    compararConsultas(100000, 10, cuantas);
+    compararConsultas(2000, 440, cuantas);
+
+    std::cout << std::endl << std::left << std::setw(36) << "camino de costo máximo (s)" << std::right << std::setw(12) << "lista"
+              << std::setw(12) << "índice" << std::setw(10) << "mejora" << std::setw(12) << "actual" << std::endl;
+    for (int n = 8; n <= 10; n++) {
+        GraphD<int> completo;
+        for (int i = 0; i < n; i++) completo.addVertex(i);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (i != j) completo.addArc(i, j, (float)(1 + std::rand() % 100));
+            }
+        }
+        ListasDeAntes listas = listasDe(completo);
+        PesoEnLista enLista;
+        enLista.listas = &listas;
+        std::clock_t reloj = std::clock();
+        float maximoLista = caminoMaximo(completo, enLista);
+        double lista = segundosDesde(reloj);
+        reloj = std::clock();
+        float maximoIndice = caminoMaximo(completo, PesoEnIndice());
+        double indice = segundosDesde(reloj);
+        // Sin medir una vez: la primera reserva grande después de liberar los grafos de arriba paga
+        // que malloc junte los millones de bloques sueltos
+        std::list<int> camino = completo.findMaxCostHamiltonianPath();
+        reloj = std::clock();
+        camino = completo.findMaxCostHamiltonianPath(); // Held-Karp para estos tamaños
+        double actual = segundosDesde(reloj);
+        std::ostringstream que;
+        que << "completo de " << n << " vértices";
+        std::cout << std::left << std::setw(36) << que.str() << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << lista << std::setw(12) << indice
+                  << std::setw(9) << std::setprecision(1) << lista / (indice > 0 ? indice : 1e-6) << "x"
+                  << std::setw(12) << std::setprecision(4) << actual
+                  << (maximoLista == maximoIndice && costo(completo, camino) == maximoIndice ? "   ok" : "   FALLA") << std::endl;
+    }
+    return 0;
+}
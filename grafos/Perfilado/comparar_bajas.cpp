@@ -0,0 +1,152 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// Altas y bajas de vértices intercaladas: OPERACIONES veces addVertex de un valor nuevo con
+// ARCOS_POR_VERTICE arcos (en GraphD la mitad salen del vértice y la mitad entran) y removeVertex
+// de un vértice vivo al azar, sobre un grafo que arranca con V vértices de grado medio
+// ARCOS_POR_VERTICE. Ahora la baja sigue los arcos del vértice (la lista de adyacencia y los
+// predecesores) y desenlaza cada arco de la lista del vecino en O(1); le queda una búsqueda binaria
+// y un corrimiento en los vectores índice del vecino por arco, y un corrimiento O(V) del mapa.
+// Antes la baja buscaba el arco hacia el vértice en todos los demás (removeArc / removeEdge desde
+// cada vértice del mapa, O(V log grado) por baja): es tan lenta que se mide en las primeras
+// MUESTRA operaciones y se multiplica ("~" en la tabla).
+// "al azar": los arcos van a vértices vivos al azar. "concentradores": todos los arcos van y vienen
+// de CONCENTRADORES vértices fijos, así que las listas de los vecinos tienen decenas de miles de
+// arcos. Ahí lo que queda es el corrimiento de los índices de los concentradores, que crece con V.
+// Uso: ./comparar_bajas [semilla]
+
+const int OPERACIONES = 100000;
+const int ARCOS_POR_VERTICE = 10;
+const int CONCENTRADORES = 10;
+const int MUESTRA = 2000;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, double antes, double ahora, bool iguales) {
+    std::ostringstream columna;
+    columna << std::fixed << std::setprecision(2) << "~" << antes;
+    std::cout << std::left << std::setw(34) << que << std::right << std::setw(12) << columna.str()
+              << std::fixed << std::setprecision(3) << std::setw(10) << ahora
+              << std::setw(9) << std::setprecision(0) << antes / (ahora > 0 ? ahora : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Los dos grafos con la misma interfaz para el resto del programa
+struct Dirigido {
+    GraphD<int> grafo;
+
+    void agregarVertice(int v) { grafo.addVertex(v); }
+    // 'j' par: sale de 'a'; impar: entra a 'a'
+    void agregarArco(int a, int b, int j) { if (j % 2 == 0) grafo.addArc(a, b, 1.0f); else grafo.addArc(b, a, 1.0f); }
+    void quitar(int v) { grafo.removeVertex(v); }
+    // Como antes: el arco hacia 'v' se busca desde cada vértice del grafo
+    void quitarComoAntes(int v) {
+        std::vector<int> mapa = grafo.getMap();
+        for (size_t i = 0; i < mapa.size(); i++) grafo.removeArc(mapa[i], v);
+        grafo.removeVertex(v);
+    }
+    int vertices() { return grafo.order(); }
+    int arcos() { return grafo.size(); }
+};
+
+struct NoDirigido {
+    GraphND<int> grafo;
+
+    void agregarVertice(int v) { grafo.addVertex(v); }
+    void agregarArco(int a, int b, int) { if (a != b) grafo.addEdge(a, b, 1.0f); }
+    void quitar(int v) { grafo.removeVertex(v); }
+    void quitarComoAntes(int v) {
+        std::vector<int> mapa = grafo.getMap();
+        for (size_t i = 0; i < mapa.size(); i++) grafo.removeEdge(mapa[i], v);
+        grafo.removeVertex(v);
+    }
+    int vertices() { return grafo.getNumVertices(); }
+    int arcos() { return grafo.getNumEdges(); }
+};
+
+// Vecino del arco 'j' de un vértice: uno vivo al azar o uno de los concentradores (valores 0..CONCENTRADORES-1, nunca se quitan)
+int vecino(const std::vector<int>& vivos, bool concentradores, int j) {
+    return concentradores ? j % CONCENTRADORES : vivos[std::rand() % vivos.size()];
+}
+
+template <typename Grafo>
+void armar(Grafo& grafo, int v, bool concentradores, std::vector<int>& vivos) {
+    vivos.clear();
+    for (int i = 0; i < v; i++) {
+        grafo.agregarVertice(i);
+        vivos.push_back(i);
+    }
+    for (int i = 0; i < v; i++) {
+        for (int j = 0; j < ARCOS_POR_VERTICE; j++) grafo.agregarArco(i, vecino(vivos, concentradores, j), j);
+    }
+}
+
+// 'operaciones' altas y bajas intercaladas; la baja nunca toca un concentrador
+template <typename Grafo>
+double intercalar(Grafo& grafo, std::vector<int>& vivos, int& siguiente, int operaciones, bool concentradores, bool comoAntes) {
+    std::clock_t reloj = std::clock();
+    for (int op = 0; op < operaciones; op++) {
+        if (op % 2 == 0) {
+            int v = siguiente++;
+            grafo.agregarVertice(v);
+            for (int j = 0; j < ARCOS_POR_VERTICE; j++) grafo.agregarArco(v, vecino(vivos, concentradores, j), j);
+            vivos.push_back(v);
+        } else {
+            int desde = concentradores ? CONCENTRADORES : 0;
+            int i = desde + std::rand() % (vivos.size() - desde);
+            int v = vivos[i];
+            vivos[i] = vivos.back();
+            vivos.pop_back();
+            if (comoAntes) grafo.quitarComoAntes(v); else grafo.quitar(v);
+        }
+    }
+    return segundosDesde(reloj);
+}
+
+template <typename Grafo>
+void comparar(const std::string& que, int v, bool concentradores, unsigned semilla) {
+    std::vector<int> vivos;
+    int siguiente = v;
+    Grafo antes;
+    std::srand(semilla);
+    armar(antes, v, concentradores, vivos);
+    double segundosAntes = intercalar(antes, vivos, siguiente, MUESTRA, concentradores, true) * OPERACIONES / MUESTRA;
+
+    // Las mismas operaciones desde el mismo grafo; las primeras MUESTRA se comparan con las de antes
+    siguiente = v;
+    Grafo ahora;
+    std::srand(semilla);
+    armar(ahora, v, concentradores, vivos);
+    double segundos = intercalar(ahora, vivos, siguiente, MUESTRA, concentradores, false);
+    bool iguales = ahora.vertices() == antes.vertices() && ahora.arcos() == antes.arcos();
+    segundos += intercalar(ahora, vivos, siguiente, OPERACIONES - MUESTRA, concentradores, false);
+
+    std::ostringstream titulo;
+    titulo << que << ", " << v << " V";
+    fila(titulo.str(), segundosAntes, segundos, iguales);
+}
+
+int main(int argc, char** argv) {
+    unsigned semilla = argc > 1 ? std::atoi(argv[1]) : 1;
+
+    std::cout << OPERACIONES << " altas y bajas intercaladas, " << ARCOS_POR_VERTICE << " arcos por vértice (s)" << std::endl;
+    std::cout << std::left << std::setw(34) << "grafo" << std::right << std::setw(12) << "antes"
+              << std::setw(10) << "ahora" << std::setw(10) << "mejora" << std::endl;
+    int tamanios[] = { 20000, 100000 };
+    for (int i = 0; i < 2; i++) {
+        comparar<Dirigido>("GraphD al azar", tamanios[i], false, semilla);
+        comparar<Dirigido>("GraphD concentradores", tamanios[i], true, semilla);
+        comparar<NoDirigido>("GraphND al azar", tamanios[i], false, semilla);
+        comparar<NoDirigido>("GraphND concentradores", tamanios[i], true, semilla);
+    }
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// findHamiltonianPath de GraphD y GraphND (HamiltonSearch: conjuntos de bits, poda de los
+// caminos que ya no se pueden completar y estados muertos recordados) contra la vuelta atrás de
+// antes: marcas en std::vector<bool>, el camino en std::list y getSuccessors / getNeighbors
+// copiados en cada paso. La versión de antes pedía los vecinos con búsquedas lineales, así que se
+// queda corta respecto de lo que costaba. hasHamiltonianPath (orden de Warnsdorff, solo sí o no)
+// va aparte.
+// Grafos aleatorios de 20 a 60 vértices: con 3 arcos por vértice casi nunca hay camino y hay que
+// probarlo, con 8 casi siempre lo hay y con 5 se está en el medio. Los tiempos tienen colas largas
+// (la misma búsqueda tarda milisegundos en un grafo y minutos en otro parecido), así que cada
+// búsqueda corre en un proceso aparte y se corta a los LIMITE segundos: la columna dice "> " y
+// la última cuenta los cortes de cada columna (antes/ahora/hasPath). "camino" cuenta los grafos en
+// los que findHamiltonianPath encontró uno.
+// Uso: ./comparar_bitset [grafos por fila] [semilla]
+
+const int LIMITE = 2;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// --- Cada búsqueda en un proceso hijo, que manda el tiempo y el camino por un tubo ---
+
+struct Medida {
+    double segundos;
+    bool cortada;
+    std::list<int> camino;
+};
+
+bool leer(int tubo, void* destino, size_t bytes) {
+    char* p = static_cast<char*>(destino);
+    while (bytes > 0) {
+        ssize_t leidos = read(tubo, p, bytes);
+        if (leidos <= 0) return false;
+        p += leidos;
+        bytes -= leidos;
+    }
+    return true;
+}
+
+// 'busqueda()' devuelve un std::list<int>; si el hijo no termina en LIMITE segundos, la medida queda cortada
+template <typename Busqueda>
+Medida medir(Busqueda busqueda) {
+    Medida medida;
+    medida.segundos = LIMITE;
+    medida.cortada = true;
+    int tubo[2];
+    if (pipe(tubo) != 0) return medida;
+    std::cout.flush();
+    pid_t hijo = fork();
+    if (hijo == 0) {
+        close(tubo[0]);
+        alarm(LIMITE);
+        std::clock_t reloj = std::clock();
+        std::list<int> camino = busqueda();
+        double segundos = segundosDesde(reloj);
+        std::vector<int> datos(camino.begin(), camino.end());
+        int largo = (int)datos.size();
+        bool bien = write(tubo[1], &segundos, sizeof(segundos)) == (ssize_t)sizeof(segundos)
+                    && write(tubo[1], &largo, sizeof(largo)) == (ssize_t)sizeof(largo)
+                    && (largo == 0 || write(tubo[1], &datos[0], largo * sizeof(int)) == (ssize_t)(largo * sizeof(int)));
+        _exit(bien ? 0 : 1);
+    }
+    close(tubo[1]);
+    double segundos;
+    int largo;
+    if (hijo > 0 && leer(tubo[0], &segundos, sizeof(segundos)) && leer(tubo[0], &largo, sizeof(largo))) {
+        std::vector<int> datos(largo);
+        if (largo == 0 || leer(tubo[0], &datos[0], largo * sizeof(int))) {
+            medida.segundos = segundos;
+            medida.cortada = false;
+            medida.camino.assign(datos.begin(), datos.end());
+        }
+    }
+    close(tubo[0]);
+    if (hijo > 0) waitpid(hijo, NULL, 0);
+    return medida;
+}
+
+// --- La vuelta atrás de antes; 'vecinos' es getSuccessors o getNeighbors ---
+
+template <typename Grafo, typename Vecinos>
+void deAntes(Grafo& grafo, Vecinos vecinos, int actual, std::vector<bool>& visitado, std::list<int>& camino, bool& encontrado) {
+    if (encontrado) return;
+    int indice = grafo.getMapIndex(actual);
+    if (visitado[indice]) return;
+    visitado[indice] = true;
+    camino.push_back(actual);
+    if ((int)camino.size() == grafo.order()) {
+        encontrado = true;
+    } else {
+        std::list<int> siguientes = (grafo.*vecinos)(actual);
+        for (std::list<int>::iterator it = siguientes.begin(); it != siguientes.end() && !encontrado; ++it) {
+            deAntes(grafo, vecinos, *it, visitado, camino, encontrado);
+        }
+    }
+    if (!encontrado) {
+        camino.pop_back();
+        visitado[indice] = false;
+    }
+}
+
+// Desde cada vértice en orden del mapa, o solo desde 'inicio' si no es -1
+template <typename Grafo, typename Vecinos>
+struct BusquedaDeAntes {
+    Grafo* grafo;
+    Vecinos vecinos;
+    int inicio;
+
+    std::list<int> operator()() const {
+        std::list<int> camino;
+        std::vector<bool> visitado(grafo->order(), false);
+        bool encontrado = false;
+        for (int v = 0; v < grafo->order() && !encontrado; v++) {
+            if (inicio >= 0 && v != grafo->getMapIndex(inicio)) continue;
+            std::fill(visitado.begin(), visitado.end(), false);
+            camino.clear();
+            deAntes(*grafo, vecinos, grafo->getMap()[v], visitado, camino, encontrado);
+        }
+        return encontrado ? camino : std::list<int>();
+    }
+};
+
+// GraphND no tiene getMapIndex: el mismo nombre, para la búsqueda de arriba
+struct NoDirigido : public GraphND<int> {
+    int getMapIndex(int valor) const { return getVertexIndex(valor); }
+};
+
+// --- Lo de ahora ---
+
+// GraphD desde cualquier vértice, GraphND desde 'inicio'
+template <typename Grafo>
+struct BusquedaDeAhora {
+    Grafo* grafo;
+    int inicio;
+
+    std::list<int> operator()() const { return inicio < 0 ? grafo->findHamiltonianPath() : grafo->findHamiltonianPath(inicio); }
+};
+
+template <>
+std::list<int> BusquedaDeAhora<NoDirigido>::operator()() const { return grafo->findHamiltonianPath(inicio); }
+
+// hasHamiltonianPath, como un camino de un vértice si lo hay
+template <typename Grafo>
+struct Existe {
+    Grafo* grafo;
+
+    std::list<int> operator()() const { return grafo->hasHamiltonianPath() ? std::list<int>(1, 0) : std::list<int>(); }
+};
+
+struct Fila {
+    double antes, ahora, existe;
+    int cortesAntes, cortesAhora, cortesExiste, conCamino;
+    bool iguales;
+};
+
+std::string tiempo(double segundos, int cortes, int precision) {
+    std::ostringstream texto;
+    texto << std::fixed << std::setprecision(precision) << (cortes > 0 ? "> " : "") << segundos;
+    return texto.str();
+}
+
+// Las tres búsquedas sobre un grafo; 'inicio' -1 en GraphD (desde cualquier vértice)
+template <typename Grafo, typename Vecinos>
+void medirGrafo(Grafo& grafo, Vecinos vecinos, int inicio, Fila& fila) {
+    BusquedaDeAntes<Grafo, Vecinos> busquedaDeAntes = { &grafo, vecinos, inicio };
+    BusquedaDeAhora<Grafo> busquedaDeAhora = { &grafo, inicio };
+    Existe<Grafo> existe = { &grafo };
+    Medida antes = medir(busquedaDeAntes);
+    Medida ahora = medir(busquedaDeAhora);
+    Medida hay = medir(existe);
+    fila.antes += antes.segundos;
+    fila.ahora += ahora.segundos;
+    fila.existe += hay.segundos;
+    fila.cortesAntes += antes.cortada;
+    fila.cortesAhora += ahora.cortada;
+    fila.cortesExiste += hay.cortada;
+    fila.conCamino += !ahora.camino.empty();
+    if (!antes.cortada && !ahora.cortada) fila.iguales = fila.iguales && antes.camino == ahora.camino;
+    // GraphND busca desde un vértice: sin camino desde ahí puede haberlo desde otro
+    if (!ahora.cortada && !hay.cortada && (inicio < 0 || !ahora.camino.empty())) {
+        fila.iguales = fila.iguales && ahora.camino.empty() == hay.camino.empty();
+    }
+}
+
+void imprimir(const std::string& que, int vertices, int grado, const Fila& fila) {
+    std::ostringstream cortes;
+    cortes << fila.cortesAntes << "/" << fila.cortesAhora << "/" << fila.cortesExiste;
+    std::cout << std::left << std::setw(9) << que << std::right << std::setw(5) << vertices << std::setw(7) << grado
+              << std::setw(11) << tiempo(fila.antes, fila.cortesAntes, 3) << std::setw(12) << tiempo(fila.ahora, fila.cortesAhora, 4)
+              << std::setw(12) << tiempo(fila.existe, fila.cortesExiste, 4) << std::setw(8) << fila.conCamino << std::setw(10) << cortes.str()
+              << (fila.iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// 'grado' arcos al azar por vértice, en valores salteados (índice y valor no coinciden)
+void dirigido(int vertices, int grado, int grafos) {
+    Fila fila = { 0, 0, 0, 0, 0, 0, 0, true };
+    for (int g = 0; g < grafos; g++) {
+        GraphD<int> grafo;
+        for (int i = 0; i < vertices; i++) grafo.addVertex(3 * i + 1);
+        for (int i = 0; i < vertices; i++) {
+            for (int j = 0; j < grado; j++) grafo.addArc(3 * i + 1, 3 * (std::rand() % vertices) + 1, 1.0f);
+        }
+        medirGrafo(grafo, &GraphD<int>::getSuccessors, -1, fila);
+    }
+    imprimir("GraphD", vertices, grado, fila);
+}
+
+// Aristas al azar hasta un grado medio de 'grado', desde el vértice 1 (el primero)
+void noDirigido(int vertices, int grado, int grafos) {
+    Fila fila = { 0, 0, 0, 0, 0, 0, 0, true };
+    for (int g = 0; g < grafos; g++) {
+        NoDirigido grafo;
+        for (int i = 0; i < vertices; i++) grafo.addVertex(3 * i + 1);
+        while (2 * grafo.getNumEdges() < grado * vertices) {
+            int a = std::rand() % vertices, b = std::rand() % vertices;
+            if (a != b) grafo.addEdge(3 * a + 1, 3 * b + 1, 1.0f);
+        }
+        medirGrafo(grafo, &GraphND<int>::getNeighbors, 1, fila);
+    }
+    imprimir("GraphND", vertices, grado, fila);
+}
+
+int main(int argc, char** argv) {
+    int grafos = argc > 1 ? std::atoi(argv[1]) : 3;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (grafos < 1) {
+        std::cerr << "Uso: " << argv[0] << " [grafos por fila >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "s sumados sobre " << grafos << " grafos por fila, cada búsqueda cortada a los " << LIMITE << " s" << std::endl;
+    std::cout << std::left << std::setw(9) << "grafo" << std::right << std::setw(5) << "V" << std::setw(7) << "grado"
+              << std::setw(11) << "antes" << std::setw(12) << "ahora" << std::setw(12) << "hasPath"
+              << std::setw(8) << "camino" << std::setw(10) << "cortes" << std::endl;
+    int vertices[] = { 20, 30, 40, 50, 60 };
+    int grados[] = { 3, 5, 8 };
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 3; j++) dirigido(vertices[i], grados[j], grafos);
+    }
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 3; j++) noDirigido(vertices[i], grados[j], grafos);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <ctime>
+#include <sys/resource.h>
+#include "GraphD.h"
+
+// Componentes fuertemente conexas de GraphD (Tarjan iterativo sobre las listas de adyacencia)
+// en grafos de un millón de arcos. isStronglyConnected contra las dos versiones de antes, que
+// ahora la llaman: isStronglyConnectedDfs, un dfs desde cada vértice hasta que alguno no llega a
+// todos (O(V * (V + E))), y isStronglyConnectedKosaraju, que armaba el transpuesto entero y hacía
+// un dfs en cada grafo (y aceptaba grafos como a->b). Las dos se rearman con dfs y transpose.
+// Cuando el grafo es fuertemente conexo la de los V dfs no termina en un tiempo razonable: se
+// miden DFS_DE_MUESTRA y se multiplica por V ("~" en la tabla).
+// Antes no había componentes: stronglyConnectedComponents se compara con Kosaraju escrito con la
+// API pública (getSuccessors de cada vértice, transpose y getSuccessors del transpuesto), y se
+// comprueba que las dos den la misma partición.
+// Uso: ./comparar_componentes [semilla]
+
+const int DFS_DE_MUESTRA = 3;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, double antes, double ahora, bool estimado, bool iguales) {
+    std::ostringstream columna;
+    columna << std::fixed << std::setprecision(3) << (estimado ? "~" : "") << antes;
+    std::cout << std::left << std::setw(34) << que << std::right << std::setw(14) << columna.str()
+              << std::fixed << std::setprecision(3) << std::setw(10) << ahora
+              << std::setw(11) << std::setprecision(0) << antes / (ahora > 0 ? ahora : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Las dos numeraciones de componentes describen la misma partición de los vértices
+bool mismaParticion(const std::vector<int>& a, const std::vector<int>& b) {
+    if (a.size() != b.size()) return false;
+    std::map<int, int> deAaB, deBaA;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!deAaB.count(a[i])) deAaB[a[i]] = b[i];
+        if (!deBaA.count(b[i])) deBaA[b[i]] = a[i];
+        if (deAaB[a[i]] != b[i] || deBaA[b[i]] != a[i]) return false;
+    }
+    return true;
+}
+
+// --- Las de antes ---
+
+// Un dfs desde cada vértice hasta que uno no llegue a todos; 'tope' dfs como mucho. Devuelve cuántos hizo
+int dfsDesdeCadaVertice(GraphD<int>& grafo, int tope, bool& conexo) {
+    conexo = true;
+    int hechos = 0;
+    for (int v = 0; v < grafo.order() && hechos < tope; v++) {
+        hechos++;
+        if ((int)grafo.dfs(grafo.getMapVertex(v)).size() != grafo.order()) {
+            conexo = false;
+            break;
+        }
+    }
+    return hechos;
+}
+
+// Transpuesto entero, dfs desde el primer vértice y dfs en el transpuesto desde el último que alcanzó
+bool kosarajuDeAntes(GraphD<int>& grafo) {
+    GraphD<int> transpuesto;
+    grafo.transpose(transpuesto);
+    std::list<int> primero = grafo.dfs(grafo.getMapVertex(0));
+    if ((int)primero.size() != grafo.order()) return false;
+    return (int)transpuesto.dfs(primero.back()).size() == grafo.order();
+}
+
+// --- Kosaraju con la API pública ---
+
+// Índices de los sucesores de cada vértice, pedidos con getSuccessors
+void sucesores(GraphD<int>& grafo, std::vector< std::vector<int> >& lista) {
+    lista.assign(grafo.order(), std::vector<int>());
+    for (int v = 0; v < grafo.order(); v++) {
+        std::list<int> valores = grafo.getSuccessors(grafo.getMapVertex(v));
+        for (std::list<int>::iterator it = valores.begin(); it != valores.end(); ++it) lista[v].push_back(grafo.getMapIndex(*it));
+    }
+}
+
+// dfs iterativo desde 'inicio': agrega a 'salida' cada vértice al terminarlo y le pone 'marca' en 'componente'
+void dfsIterativo(const std::vector< std::vector<int> >& lista, int inicio, std::vector<int>& componente, int marca, std::vector<int>& salida) {
+    std::vector< std::pair<int, size_t> > pila; // (vértice, próximo sucesor)
+    componente[inicio] = marca;
+    pila.push_back(std::make_pair(inicio, (size_t)0));
+    while (!pila.empty()) {
+        int v = pila.back().first;
+        if (pila.back().second < lista[v].size()) {
+            int u = lista[v][pila.back().second++];
+            if (componente[u] == -1) {
+                componente[u] = marca;
+                pila.push_back(std::make_pair(u, (size_t)0));
+            }
+        } else {
+            salida.push_back(v);
+            pila.pop_back();
+        }
+    }
+}
+
+int kosarajuPorLaApi(GraphD<int>& grafo, std::vector<int>& componente) {
+    int n = grafo.order();
+    std::vector< std::vector<int> > lista;
+    sucesores(grafo, lista);
+    std::vector<int> orden, visto(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (visto[v] == -1) dfsIterativo(lista, v, visto, 0, orden);
+    }
+
+    GraphD<int> transpuesto;
+    grafo.transpose(transpuesto);
+    sucesores(transpuesto, lista); // Mismos valores, mismo mapa
+    componente.assign(n, -1);
+    int cuantas = 0;
+    std::vector<int> descarte;
+    for (int i = n - 1; i >= 0; i--) {
+        if (componente[orden[i]] == -1) dfsIterativo(lista, orden[i], componente, cuantas++, descarte);
+    }
+    return cuantas;
+}
+
+void comparar(const std::string& titulo, GraphD<int>& grafo) {
+    std::cout << std::endl << "== " << titulo << ": " << grafo.order() << " vértices, " << grafo.size() << " arcos ==" << std::endl;
+    std::cout << std::left << std::setw(34) << "s" << std::right << std::setw(14) << "antes"
+              << std::setw(10) << "ahora" << std::setw(12) << "mejora" << std::endl;
+
+    std::clock_t reloj = std::clock();
+    bool conexo = grafo.isStronglyConnected();
+    double ahora = segundosDesde(reloj);
+
+    reloj = std::clock();
+    bool conexoAntes;
+    int hechos = dfsDesdeCadaVertice(grafo, conexo ? DFS_DE_MUESTRA : grafo.order(), conexoAntes);
+    double antes = segundosDesde(reloj);
+    bool estimado = conexo && hechos < grafo.order();
+    if (estimado) antes = antes / hechos * grafo.order();
+    fila("isStronglyConnectedDfs", antes, ahora, estimado, conexoAntes == conexo);
+
+    reloj = std::clock();
+    bool kosaraju = kosarajuDeAntes(grafo);
+    antes = segundosDesde(reloj);
+    // La de antes podía decir que sí sin serlo; que no, nunca sin razón
+    fila("isStronglyConnectedKosaraju", antes, ahora, false, conexo ? kosaraju : true);
+
+    std::vector<int> componenteAntes, componente;
+    reloj = std::clock();
+    int cuantasAntes = kosarajuPorLaApi(grafo, componenteAntes);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    int cuantas = grafo.stronglyConnectedComponents(componente);
+    ahora = segundosDesde(reloj);
+    fila("componentes (Kosaraju por la API)", antes, ahora, false, cuantas == cuantasAntes && mismaParticion(componente, componenteAntes));
+    std::cout << cuantas << " componentes; fuertemente conexo: " << (conexo ? "sí" : "no") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+
+    // Los dfs de GraphD son recursivos y bajan hasta casi V niveles
+    rlimit pila;
+    getrlimit(RLIMIT_STACK, &pila);
+    if (pila.rlim_cur != RLIM_INFINITY && (pila.rlim_max == RLIM_INFINITY || pila.rlim_max > (rlim_t)1 << 30)) {
+        pila.rlim_cur = (rlim_t)1 << 30;
+        setrlimit(RLIMIT_STACK, &pila);
+    }
+
+    {
+        GraphD<int> grafo; // Una componente gigante y unos pocos vértices sin arcos de entrada o de salida
+        for (int i = 0; i < 100000; i++) grafo.addVertex(i);
+        while (grafo.size() < 1000000) grafo.addArc(std::rand() % 100000, std::rand() % 100000, 1.0f);
+        comparar("al azar", grafo);
+    }
+    {
+        GraphD<int> grafo; // Un anillo que los une a todos más arcos al azar: fuertemente conexo
+        for (int i = 0; i < 100000; i++) grafo.addVertex(i);
+        for (int i = 0; i < 100000; i++) grafo.addArc(i, (i + 1) % 100000, 1.0f);
+        while (grafo.size() < 1000000) grafo.addArc(std::rand() % 100000, std::rand() % 100000, 1.0f);
+        comparar("anillo y al azar", grafo);
+    }
+    {
+        GraphD<int> grafo; // Un solo anillo: el dfs baja un millón de niveles
+        for (int i = 0; i < 1000000; i++) grafo.addVertex(i);
+        for (int i = 0; i < 1000000; i++) grafo.addArc(i, (i + 1) % 1000000, 1.0f);
+        comparar("anillo", grafo);
+    }
+    return 0;
+}
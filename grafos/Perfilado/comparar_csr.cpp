@@ -0,0 +1,193 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <sys/resource.h>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// Recorridos de GraphD y GraphND sobre sus listas enlazadas contra los mismos recorridos sobre la
+// copia CSR que arma freeze() (GraphDCSR, GraphNDCSR), en grafos aleatorios de un millón de arcos.
+// Se cuenta aparte lo que tarda freeze(), y cada fila dice cuántas veces hay que recorrer la copia
+// para que congelar valga la pena. Uno de cada cien arcos de GraphD tiene peso negativo: los dos
+// dijkstra los saltan, y la tabla lo comprueba.
+// Uso: ./comparar_csr [vértices] [arcos] [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void encabezado(const std::string& titulo, double congelar) {
+    std::cout << std::endl << "== " << titulo << " (freeze: " << std::fixed << std::setprecision(3) << congelar << " s) ==" << std::endl;
+    std::cout << std::left << std::setw(24) << "recorrido (s)" << std::right << std::setw(12) << "listas" << std::setw(12) << "CSR"
+              << std::setw(10) << "mejora" << std::setw(14) << "Marcos/s CSR" << std::setw(10) << "amortiza" << std::endl;
+}
+
+// 'amortiza': recorridos tras los que freeze() se paga solo
+void fila(const std::string& que, double listas, double csr, long arcos, double congelar, bool iguales) {
+    double ahorro = listas - csr;
+    std::cout << std::left << std::setw(24) << que << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << listas << std::setw(12) << csr
+              << std::setw(9) << std::setprecision(1) << listas / (csr > 0 ? csr : 1e-6) << "x"
+              << std::setw(14) << arcos / (csr > 0 ? csr : 1e-6) / 1e6;
+    if (ahorro > 0) std::cout << std::setw(10) << (int)(congelar / ahorro) + 1;
+    else std::cout << std::setw(10) << "-";
+    std::cout << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Las dos numeraciones de componentes describen la misma partición de los vértices
+bool mismaParticion(const std::vector<int>& a, const std::vector<int>& b) {
+    if (a.size() != b.size()) return false;
+    std::map<int, int> deAaB, deBaA;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!deAaB.count(a[i])) deAaB[a[i]] = b[i];
+        if (!deBaA.count(b[i])) deBaA[b[i]] = a[i];
+        if (deAaB[a[i]] != b[i] || deBaA[b[i]] != a[i]) return false;
+    }
+    return true;
+}
+
+void dirigido(int vertices, long arcos) {
+    GraphD<int> grafo;
+    for (int i = 0; i < vertices; i++) grafo.addVertex(i);
+    for (long i = 0; i < arcos; i++) {
+        float peso = (std::rand() % 100 == 0) ? -1.0f : (float)(1 + std::rand() % 100);
+        grafo.addArc(std::rand() % vertices, std::rand() % vertices, peso); // Repetidos se ignoran
+    }
+    std::clock_t reloj = std::clock();
+    GraphDCSR<int> csr;
+    grafo.freeze(csr);
+    double congelar = segundosDesde(reloj);
+    long total = grafo.size();
+
+    std::ostringstream titulo;
+    titulo << "GraphD, " << vertices << " vértices, " << total << " arcos";
+    encabezado(titulo.str(), congelar);
+
+    reloj = std::clock();
+    std::list<int> antes = grafo.bfs(0);
+    double listas = segundosDesde(reloj);
+    reloj = std::clock();
+    std::list<int> ahora = csr.bfs(0);
+    fila("bfs", listas, segundosDesde(reloj), total, congelar, antes == ahora);
+
+    reloj = std::clock();
+    antes = grafo.dfs(0);
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    ahora = csr.dfs(0);
+    fila("dfs", listas, segundosDesde(reloj), total, congelar, antes == ahora);
+
+    reloj = std::clock();
+    std::vector<float> distanciaAntes = grafo.dijkstra(0);
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    std::vector<float> distancia = csr.dijkstra(0);
+    fila("dijkstra", listas, segundosDesde(reloj), total, congelar, distancia == distanciaAntes);
+
+    // Tarjan sobre las listas contra Kosaraju sobre la copia: numeran distinto, se compara la partición
+    std::vector<int> componenteAntes, componente;
+    reloj = std::clock();
+    int cuantasAntes = grafo.stronglyConnectedComponents(componenteAntes);
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    int cuantas = csr.stronglyConnectedComponents(componente);
+    fila("componentes fuertes", listas, segundosDesde(reloj), total, congelar, cuantas == cuantasAntes && mismaParticion(componente, componenteAntes));
+
+    reloj = std::clock();
+    bool conexoAntes = grafo.isStronglyConnected();
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    bool conexo = csr.isStronglyConnected();
+    fila("isStronglyConnected", listas, segundosDesde(reloj), total, congelar, conexo == conexoAntes);
+}
+
+void noDirigido(int vertices, long aristas) {
+    GraphND<int> grafo;
+    for (int i = 0; i < vertices; i++) grafo.addVertex(i);
+    for (long i = 0; i < aristas; i++) {
+        int a = std::rand() % vertices, b = std::rand() % vertices;
+        if (a != b) grafo.addEdge(a, b, (float)(1 + std::rand() % 100));
+    }
+    std::clock_t reloj = std::clock();
+    GraphNDCSR<int> csr;
+    grafo.freeze(csr);
+    double congelar = segundosDesde(reloj);
+    long total = 2L * grafo.getNumEdges(); // Cada arista está en las listas de sus dos extremos
+
+    std::ostringstream titulo;
+    titulo << "GraphND, " << vertices << " vértices, " << grafo.getNumEdges() << " aristas";
+    encabezado(titulo.str(), congelar);
+
+    reloj = std::clock();
+    std::list<int> antes = grafo.bfs(0);
+    double listas = segundosDesde(reloj);
+    reloj = std::clock();
+    std::list<int> ahora = csr.bfs(0);
+    fila("bfs", listas, segundosDesde(reloj), total, congelar, antes == ahora);
+
+    reloj = std::clock();
+    antes = grafo.dfs(0);
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    ahora = csr.dfs(0);
+    fila("dfs", listas, segundosDesde(reloj), total, congelar, antes == ahora);
+
+    reloj = std::clock();
+    std::vector<float> distanciaAntes = grafo.dijkstra(0);
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    std::vector<float> distancia = csr.dijkstra(0);
+    fila("dijkstra", listas, segundosDesde(reloj), total, congelar, distancia == distanciaAntes);
+
+    reloj = std::clock();
+    bool conexoAntes = grafo.isConnected();
+    listas = segundosDesde(reloj);
+    reloj = std::clock();
+    bool conexo = csr.isConnected();
+    fila("isConnected", listas, segundosDesde(reloj), total, congelar, conexo == conexoAntes);
+}
+
+// 0->1 (-2), 1->2 (1), 0->2 (5): sin el arco negativo 1 queda inalcanzable (-1) y 2 a 5, en los dos
+bool pesosNegativos() {
+    GraphD<int> grafo;
+    for (int i = 0; i < 3; i++) grafo.addVertex(i);
+    grafo.addArc(0, 1, -2.0f);
+    grafo.addArc(1, 2, 1.0f);
+    grafo.addArc(0, 2, 5.0f);
+    GraphDCSR<int> csr;
+    grafo.freeze(csr);
+    std::vector<float> esperado(3);
+    esperado[0] = 0.0f;
+    esperado[1] = -1.0f;
+    esperado[2] = 5.0f;
+    return grafo.dijkstra(0) == esperado && csr.dijkstra(0) == esperado;
+}
+
+int main(int argc, char** argv) {
+    int vertices = argc > 1 ? std::atoi(argv[1]) : 100000;
+    long arcos = argc > 2 ? std::atol(argv[2]) : 1000000;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (vertices < 2 || arcos < 1) {
+        std::cerr << "Uso: " << argv[0] << " [vértices >= 2] [arcos >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    // Los dfs de las listas son recursivos y bajan hasta casi V niveles
+    rlimit pila;
+    getrlimit(RLIMIT_STACK, &pila);
+    if (pila.rlim_cur != RLIM_INFINITY && (pila.rlim_max == RLIM_INFINITY || pila.rlim_max > (rlim_t)1 << 30)) {
+        pila.rlim_cur = (rlim_t)1 << 30;
+        setrlimit(RLIMIT_STACK, &pila);
+    }
+
+    std::cout << "dijkstra con arcos negativos (GraphD y GraphDCSR los saltan): " << (pesosNegativos() ? "ok" : "FALLA") << std::endl;
+    dirigido(vertices, arcos);
+    noDirigido(vertices, arcos / 2); // La mitad de aristas: el mismo millón de entradas en las listas
+    return 0;
+}
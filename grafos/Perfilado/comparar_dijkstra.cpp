@@ -0,0 +1,177 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+
+// dijkstra y shortestPathByWeight de GraphD (montículo binario con borrado perezoso, corte
+// temprano al fijar el destino) contra las versiones de antes, que sacaban los vértices de una
+// lista "pending" en orden de llegada y daban cada uno por terminado la primera vez que salía.
+// Eso es rápido pero deja distancias largas; por eso se mide también la lista sin esa marca, que
+// vuelve a procesar cada vértice mejorado y sí llega a las distancias correctas.
+// El grafo imita una red de calles: una grilla con arcos en los dos sentidos, pesos de 1 a 100 y
+// algunas cuadras cortadas. Las versiones con lista usan getSuccessors, getArcWeight y
+// getMapIndex de ahora (búsqueda binaria); las de antes además buscaban de forma lineal.
+// Uso: ./comparar_dijkstra [lado de la grilla] [consultas de a pares] [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, double lista, double heap, const std::string& nota) {
+    std::cout << std::left << std::setw(38) << que << std::right << std::fixed << std::setprecision(4)
+              << std::setw(12) << lista << std::setw(12) << heap
+              << std::setw(9) << std::setprecision(1) << lista / (heap > 0 ? heap : 1e-6) << "x   " << nota << std::endl;
+}
+
+// --- Con la lista "pending" ---
+
+// finalizarAlSacar: la versión de antes, que no vuelve a mirar un vértice ya sacado
+std::vector<float> dijkstraLista(GraphD<int>& grafo, int inicio, int fin, bool finalizarAlSacar, std::vector<int>& anterior) {
+    int n = grafo.order();
+    std::vector<float> distancia(n, -1.0f);
+    std::vector<bool> sacado(n, false);
+    anterior.assign(n, -1);
+    std::list<int> pendientes;
+    distancia[grafo.getMapIndex(inicio)] = 0.0f;
+    pendientes.push_back(inicio);
+    while (!pendientes.empty()) {
+        int actual = pendientes.front();
+        pendientes.pop_front();
+        int indice = grafo.getMapIndex(actual);
+        if (finalizarAlSacar) {
+            if (sacado[indice]) continue;
+            sacado[indice] = true;
+            if (actual == fin) break;
+        }
+        std::list<int> siguientes = grafo.getSuccessors(actual);
+        for (std::list<int>::iterator it = siguientes.begin(); it != siguientes.end(); ++it) {
+            int vecino = grafo.getMapIndex(*it);
+            float peso = grafo.getArcWeight(actual, *it);
+            if (peso < 0) continue;
+            float nueva = distancia[indice] + peso;
+            if (distancia[vecino] < 0 || nueva < distancia[vecino]) {
+                distancia[vecino] = nueva;
+                anterior[vecino] = indice;
+                pendientes.push_back(*it);
+            }
+        }
+    }
+    return distancia;
+}
+
+// Cuántas distancias difieren de las correctas
+int distintas(const std::vector<float>& a, const std::vector<float>& b) {
+    int cuenta = 0;
+    for (size_t i = 0; i < a.size(); i++) cuenta += (a[i] != b[i]);
+    return cuenta;
+}
+
+// Suma de los pesos de un camino, -1 si algún arco no existe
+float costo(const GraphD<int>& grafo, const std::list<int>& camino) {
+    float suma = 0.0f;
+    std::list<int>::const_iterator it = camino.begin(), siguiente = camino.begin();
+    if (siguiente != camino.end()) ++siguiente;
+    for (; siguiente != camino.end(); ++it, ++siguiente) {
+        float peso = grafo.getArcWeight(*it, *siguiente);
+        if (peso < 0) return -1.0f;
+        suma += peso;
+    }
+    return suma;
+}
+
+int main(int argc, char** argv) {
+    int lado = argc > 1 ? std::atoi(argv[1]) : 500;
+    int consultas = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (lado < 2 || consultas < 1) {
+        std::cerr << "Uso: " << argv[0] << " [lado >= 2] [consultas >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    // Vértice fila * lado + columna; cada cuadra existe en los dos sentidos, con pesos distintos, salvo el 5% cortado
+    GraphD<int> grafo;
+    for (int i = 0; i < lado * lado; i++) grafo.addVertex(i);
+    for (int f = 0; f < lado; f++) {
+        for (int c = 0; c < lado; c++) {
+            int v = f * lado + c;
+            if (c + 1 < lado && std::rand() % 20 != 0) {
+                grafo.addArc(v, v + 1, (float)(1 + std::rand() % 100));
+                grafo.addArc(v + 1, v, (float)(1 + std::rand() % 100));
+            }
+            if (f + 1 < lado && std::rand() % 20 != 0) {
+                grafo.addArc(v, v + lado, (float)(1 + std::rand() % 100));
+                grafo.addArc(v + lado, v, (float)(1 + std::rand() % 100));
+            }
+        }
+    }
+    int ultimo = lado * lado - 1;
+    std::cout << "Grilla de " << lado << "x" << lado << ": " << grafo.order() << " vértices, " << grafo.size() << " arcos" << std::endl;
+    std::cout << std::left << std::setw(38) << "consulta (s)" << std::right << std::setw(12) << "lista"
+              << std::setw(12) << "montículo" << std::setw(10) << "mejora" << std::endl;
+
+    // Distancias desde una esquina a todos
+    std::vector<int> anterior;
+    std::clock_t reloj = std::clock();
+    std::vector<float> correctas = grafo.dijkstra(0);
+    double heap = segundosDesde(reloj);
+    reloj = std::clock();
+    std::vector<float> deAntes = dijkstraLista(grafo, 0, -1, true, anterior);
+    double lista = segundosDesde(reloj);
+    std::ostringstream nota;
+    nota << distintas(deAntes, correctas) << " de " << grafo.order() << " distancias mal";
+    fila("dijkstra, lista de antes", lista, heap, nota.str());
+
+    reloj = std::clock();
+    std::vector<float> corregidas = dijkstraLista(grafo, 0, -1, false, anterior);
+    lista = segundosDesde(reloj);
+    nota.str("");
+    nota << distintas(corregidas, correctas) << " distancias mal";
+    fila("dijkstra, lista que reprocesa", lista, heap, nota.str());
+
+    // De a pares: la lista de antes corta al sacar el destino, el montículo al fijarlo
+    int vecino = grafo.getSuccessors(0).front();
+    int desde[] = { 0, 0 }, hasta[] = { ultimo, vecino };
+    const char* nombres[] = { "camino esquina a esquina", "camino a una cuadra" };
+    for (int q = 0; q < 2; q++) {
+        reloj = std::clock();
+        std::list<int> camino = grafo.shortestPathByWeight(desde[q], hasta[q]);
+        heap = segundosDesde(reloj);
+        reloj = std::clock();
+        dijkstraLista(grafo, desde[q], hasta[q], true, anterior);
+        lista = segundosDesde(reloj);
+        nota.str("");
+        nota << "costo " << costo(grafo, camino) << (costo(grafo, camino) == correctas[grafo.getMapIndex(hasta[q])] ? " ok" : " FALLA");
+        fila(nombres[q], lista, heap, nota.str());
+    }
+
+    // Pares al azar, con la distancia correcta calculada antes y fuera de la medición
+    std::vector<int> a(consultas), b(consultas);
+    std::vector<float> esperada(consultas);
+    for (int i = 0; i < consultas; i++) {
+        a[i] = std::rand() % grafo.order();
+        b[i] = std::rand() % grafo.order();
+        esperada[i] = grafo.dijkstra(a[i])[grafo.getMapIndex(b[i])];
+    }
+    int largas = 0, fallas = 0;
+    reloj = std::clock();
+    for (int i = 0; i < consultas; i++) {
+        largas += (dijkstraLista(grafo, a[i], b[i], true, anterior)[grafo.getMapIndex(b[i])] != esperada[i]);
+    }
+    lista = segundosDesde(reloj);
+    std::vector< std::list<int> > caminos(consultas);
+    reloj = std::clock();
+    for (int i = 0; i < consultas; i++) caminos[i] = grafo.shortestPathByWeight(a[i], b[i]);
+    heap = segundosDesde(reloj);
+    for (int i = 0; i < consultas; i++) fallas += (caminos[i].empty() ? esperada[i] >= 0 : costo(grafo, caminos[i]) != esperada[i]);
+    nota.str("");
+    nota << "lista: " << largas << " de " << consultas << " largos; montículo: " << (fallas == 0 ? "ok" : "FALLA");
+    std::ostringstream que;
+    que << consultas << " pares al azar";
+    fila(que.str(), lista, heap, nota.str());
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// Camino hamiltoniano de costo mínimo (y uno de máximo): la tabla de Held-Karp sola, como se
+// usaba antes para todo grafo de hasta 25 vértices, contra lo de ahora: ramificación y poda
+// primero, con HeldKarp::searchBudget() llamadas, y la tabla solo si la búsqueda se queda sin
+// presupuesto. La tabla se arma aquí con la clase HeldKarp y la matriz de pesos del grafo, sin
+// reconstruir el camino, así que se queda apenas corta respecto de lo de antes.
+// Los casos: cadenas y completos con todos los pesos iguales (el primer camino ya llega a la
+// cota, así que la poda corta todo lo demás), completos con pesos al azar (la cota es floja y
+// hace falta la tabla) y una clique con un vértice aislado (no hay camino, y la poda no lo puede
+// probar). En los dos últimos se paga la búsqueda perdida además de la tabla, un 5-10%.
+// Por encima de HeldKarp::MAX_VERTICES no hay tabla.
+// Uso: ./comparar_hamilton [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// 'tabla' negativo: no se armó
+void fila(const std::string& que, double tabla, double ahora, bool iguales) {
+    std::cout << std::left << std::setw(36) << que << std::right << std::fixed << std::setprecision(4);
+    if (tabla >= 0) {
+        std::cout << std::setw(12) << tabla << std::setw(12) << ahora
+                  << std::setw(9) << std::setprecision(1) << tabla / (ahora > 0 ? ahora : 1e-6) << "x";
+    } else {
+        std::cout << std::setw(12) << "-" << std::setw(12) << ahora << std::setw(10) << "-";
+    }
+    std::cout << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// Mejor costo según la tabla, desde 'inicio' (-1: cualquiera); HeldKarp::noPath() si no hay camino
+float costoTabla(const std::vector<float>& pesos, int n, bool maximizar, int inicio) {
+    HeldKarp costos(pesos, n, maximizar);
+    float mejor = HeldKarp::noPath();
+    for (int v = (inicio < 0 ? 0 : inicio); v < (inicio < 0 ? n : inicio + 1); v++) {
+        float costo = costos.pathCost(v, costos.allVertices());
+        if (costo != HeldKarp::noPath() && (mejor == HeldKarp::noPath() || costos.isBetter(costo, mejor))) mejor = costo;
+    }
+    return mejor;
+}
+
+// Matriz de pesos por índice, con los arcos negativos como faltantes (como HELD_KARP_PATH)
+std::vector<float> matrizDe(GraphD<int>& grafo) {
+    int n = grafo.order();
+    std::vector<float> pesos((size_t)n * n, HeldKarp::noArc());
+    std::list< ArcInfo<int> > arcos = grafo.getArcs();
+    for (std::list< ArcInfo<int> >::iterator it = arcos.begin(); it != arcos.end(); ++it) {
+        if (it->weight >= 0) pesos[(size_t)grafo.getMapIndex(it->source) * n + grafo.getMapIndex(it->destination)] = it->weight;
+    }
+    return pesos;
+}
+
+// Suma de los pesos del camino; HeldKarp::noPath() si está vacío
+template <typename Grafo, typename Peso>
+float costo(Grafo& grafo, const std::list<int>& camino, Peso peso) {
+    if (camino.empty()) return HeldKarp::noPath();
+    float suma = 0.0f;
+    for (std::list<int>::const_iterator it = camino.begin(), siguiente = ++camino.begin(); siguiente != camino.end(); ++it, ++siguiente) {
+        suma += (grafo.*peso)(*it, *siguiente);
+    }
+    return suma;
+}
+
+void comparar(const std::string& que, GraphD<int>& grafo, bool maximizar) {
+    std::vector<float> pesos = matrizDe(grafo);
+    double tabla = -1.0;
+    float esperado = HeldKarp::noPath();
+    if (grafo.order() <= HeldKarp::MAX_VERTICES) {
+        std::clock_t reloj = std::clock();
+        esperado = costoTabla(pesos, grafo.order(), maximizar, -1);
+        tabla = segundosDesde(reloj);
+    }
+    std::clock_t reloj = std::clock();
+    std::list<int> camino = maximizar ? grafo.findMaxCostHamiltonianPath() : grafo.findMinCostHamiltonianPath();
+    double ahora = segundosDesde(reloj);
+    float obtenido = costo(grafo, camino, &GraphD<int>::getArcWeight);
+    bool iguales = (tabla >= 0) ? obtenido == esperado : (int)camino.size() == grafo.order();
+    fila(que, tabla, ahora, iguales);
+}
+
+std::string nombre(const std::string& que, int n) {
+    std::ostringstream texto;
+    texto << que << " de " << n;
+    return texto.str();
+}
+
+// 0 -> 1 -> ... -> n-1: un único camino hamiltoniano
+void cadena(GraphD<int>& grafo, int n) {
+    for (int i = 0; i < n; i++) grafo.addVertex(i);
+    for (int i = 1; i < n; i++) grafo.addArc(i - 1, i, (float)(1 + std::rand() % 100));
+}
+
+// Todos los arcos; 'pesoFijo' > 0 los pone a todos iguales
+void completo(GraphD<int>& grafo, int n, float pesoFijo) {
+    for (int i = 0; i < n; i++) grafo.addVertex(i);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j) grafo.addArc(i, j, pesoFijo > 0 ? pesoFijo : (float)(1 + std::rand() % 100));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+
+    std::cout << "findMinCostHamiltonianPath (s); tabla sola: lo de antes, para todo grafo de hasta 25 vértices" << std::endl;
+    std::cout << std::left << std::setw(36) << "grafo" << std::right << std::setw(12) << "tabla sola"
+              << std::setw(12) << "ahora" << std::setw(10) << "mejora" << std::endl;
+    int cadenas[] = { 16, 20, 22, 26 };
+    for (int i = 0; i < 4; i++) {
+        GraphD<int> grafo;
+        cadena(grafo, cadenas[i]);
+        comparar(nombre("cadena", cadenas[i]), grafo, false);
+    }
+    int completos[] = { 12, 16, 18, 20, 22 };
+    for (int i = 0; i < 5; i++) {
+        GraphD<int> grafo;
+        completo(grafo, completos[i], 0.0f);
+        comparar(nombre("completo al azar", completos[i]), grafo, false);
+    }
+    GraphD<int> grande;
+    completo(grande, 20, 0.0f);
+    comparar("completo al azar de 20, máximo", grande, true);
+    int iguales[] = { 12, 16, 20 };
+    for (int i = 0; i < 3; i++) {
+        GraphD<int> grafo;
+        completo(grafo, iguales[i], 1.0f);
+        comparar(nombre("completo, pesos iguales", iguales[i]), grafo, false);
+    }
+    int cliques[] = { 12, 16, 20 };
+    for (int i = 0; i < 3; i++) {
+        GraphD<int> grafo;
+        completo(grafo, cliques[i] - 1, 0.0f);
+        grafo.addVertex(cliques[i] - 1); // Aislado: no hay camino
+        comparar(nombre("clique y un aislado", cliques[i]), grafo, false);
+    }
+
+    // GraphND, desde el vértice 0
+    std::cout << std::endl << std::left << std::setw(36) << "GraphND desde 0" << std::right << std::setw(12) << "tabla sola"
+              << std::setw(12) << "ahora" << std::setw(10) << "mejora" << std::endl;
+    int aristas[] = { 16, 20 };
+    for (int k = 0; k < 2; k++) {
+        int n = aristas[k];
+        GraphND<int> grafo;
+        for (int i = 0; i < n; i++) grafo.addVertex(i);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) grafo.addEdge(i, j, (float)(1 + std::rand() % 100));
+        }
+        std::vector<float> pesos((size_t)n * n, HeldKarp::noArc());
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (i != j) pesos[(size_t)i * n + j] = grafo.getEdgeWeight(i, j);
+            }
+        }
+        std::clock_t reloj = std::clock();
+        float esperado = costoTabla(pesos, n, false, 0);
+        double tabla = segundosDesde(reloj);
+        reloj = std::clock();
+        std::list<int> camino = grafo.findMinCostHamiltonianPath(0);
+        double ahora = segundosDesde(reloj);
+        fila(nombre("completo al azar", n), tabla, ahora, costo(grafo, camino, &GraphND<int>::getEdgeWeight) == esperado);
+    }
+    return 0;
+}
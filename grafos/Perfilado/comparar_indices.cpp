@@ -0,0 +1,167 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+#include "GraphND.h"
+
+// bfs y dijkstra de GraphD y GraphND con el índice de vértices por búsqueda binaria contra los
+// mismos recorridos buscando el índice de cada vecino de forma lineal en el mapa, como hacían
+// getMapIndex y getVertexIndex. Las versiones lineales piden los vecinos con getSuccessors /
+// getNeighbors, que ya encuentran el vértice por búsqueda binaria, así que se quedan cortas
+// respecto de lo que costaba antes (FIND_VERTEX_NODE también recorría la lista de vértices).
+// Uso: ./comparar_indices [vértices máximos] [arcos por vértice] [semilla]
+
+typedef std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > Heap;
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, int vertices, double antes, double ahora, bool iguales) {
+    std::cout << std::left << std::setw(20) << que << std::right << std::setw(10) << vertices << std::fixed << std::setprecision(3)
+              << std::setw(14) << antes << std::setw(14) << ahora
+              << std::setw(10) << std::setprecision(0) << antes / (ahora > 0 ? ahora : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+// --- Sin el índice: la posición de cada vecino se busca recorriendo el mapa ---
+
+int indiceLineal(const std::vector<int>& mapa, int valor) {
+    for (size_t i = 0; i < mapa.size(); i++) {
+        if (mapa[i] == valor) return (int)i;
+    }
+    return -1;
+}
+
+// El bfs de antes; vecinos() es getSuccessors o getNeighbors
+template <typename Grafo, typename Vecinos>
+std::list<int> bfsLineal(Grafo& grafo, const std::vector<int>& mapa, int inicio, Vecinos vecinos) {
+    std::list<int> recorrido, cola;
+    std::vector<bool> visitado(mapa.size(), false);
+    visitado[indiceLineal(mapa, inicio)] = true;
+    cola.push_back(inicio);
+    while (!cola.empty()) {
+        int actual = cola.front();
+        cola.pop_front();
+        recorrido.push_back(actual);
+        std::list<int> siguientes = (grafo.*vecinos)(actual);
+        for (std::list<int>::iterator it = siguientes.begin(); it != siguientes.end(); ++it) {
+            int indice = indiceLineal(mapa, *it);
+            if (!visitado[indice]) {
+                visitado[indice] = true;
+                cola.push_back(*it);
+            }
+        }
+    }
+    return recorrido;
+}
+
+// Dijkstra con montículo, pero con el índice lineal y el peso pedido arco por arco, como antes
+template <typename Grafo, typename Vecinos, typename Peso>
+std::vector<float> dijkstraLineal(Grafo& grafo, const std::vector<int>& mapa, int inicio, Vecinos vecinos, Peso peso) {
+    std::vector<float> distancia(mapa.size(), -1.0f);
+    std::vector<bool> listo(mapa.size(), false);
+    Heap heap;
+    distancia[indiceLineal(mapa, inicio)] = 0.0f;
+    heap.push(std::make_pair(0.0f, indiceLineal(mapa, inicio)));
+    while (!heap.empty()) {
+        int actual = heap.top().second;
+        heap.pop();
+        if (listo[actual]) continue;
+        listo[actual] = true;
+        std::list<int> siguientes = (grafo.*vecinos)(mapa[actual]);
+        for (std::list<int>::iterator it = siguientes.begin(); it != siguientes.end(); ++it) {
+            int indice = indiceLineal(mapa, *it);
+            float nueva = distancia[actual] + (grafo.*peso)(mapa[actual], *it);
+            if (!listo[indice] && (distancia[indice] < 0 || nueva < distancia[indice])) {
+                distancia[indice] = nueva;
+                heap.push(std::make_pair(nueva, indice));
+            }
+        }
+    }
+    return distancia;
+}
+
+// GraphND::dijkstra marca los inalcanzables con el máximo de float; GraphD, con -1
+std::vector<float> comoGraphD(std::vector<float> distancia) {
+    for (size_t i = 0; i < distancia.size(); i++) {
+        if (distancia[i] == std::numeric_limits<float>::max()) distancia[i] = -1.0f;
+    }
+    return distancia;
+}
+
+void comparar(int vertices, int grado) {
+    // Valores salteados y agregados en desorden, para que índice y valor no coincidan
+    std::vector<int> valores(vertices);
+    for (int i = 0; i < vertices; i++) valores[i] = 3 * i + 1;
+    for (int i = vertices - 1; i > 0; i--) std::swap(valores[i], valores[std::rand() % (i + 1)]);
+    GraphD<int> dirigido;
+    GraphND<int> noDirigido;
+    for (int i = 0; i < vertices; i++) {
+        dirigido.addVertex(valores[i]);
+        noDirigido.addVertex(valores[i]);
+    }
+    for (int i = 0; i < vertices; i++) {
+        for (int j = 0; j < grado; j++) {
+            int destino = valores[std::rand() % vertices];
+            float peso = (float)(1 + std::rand() % 100);
+            dirigido.addArc(valores[i], destino, peso);
+            if (j % 2 == 0) noDirigido.addEdge(valores[i], destino, peso); // Cada arista cuenta en los dos extremos
+        }
+    }
+    int inicio = valores[0];
+
+    std::clock_t reloj = std::clock();
+    std::list<int> recorridoAntes = bfsLineal(dirigido, dirigido.getMap(), inicio, &GraphD<int>::getSuccessors);
+    double antes = segundosDesde(reloj);
+    reloj = std::clock();
+    std::list<int> recorrido = dirigido.bfs(inicio);
+    fila("GraphD bfs", vertices, antes, segundosDesde(reloj), recorrido == recorridoAntes);
+
+    reloj = std::clock();
+    std::vector<float> distanciaAntes = dijkstraLineal(dirigido, dirigido.getMap(), inicio, &GraphD<int>::getSuccessors, &GraphD<int>::getArcWeight);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    std::vector<float> distancia = dirigido.dijkstra(inicio);
+    fila("GraphD dijkstra", vertices, antes, segundosDesde(reloj), distancia == distanciaAntes);
+
+    reloj = std::clock();
+    recorridoAntes = bfsLineal(noDirigido, noDirigido.getMap(), inicio, &GraphND<int>::getNeighbors);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    recorrido = noDirigido.bfs(inicio);
+    fila("GraphND bfs", vertices, antes, segundosDesde(reloj), recorrido == recorridoAntes);
+
+    reloj = std::clock();
+    distanciaAntes = dijkstraLineal(noDirigido, noDirigido.getMap(), inicio, &GraphND<int>::getNeighbors, &GraphND<int>::getEdgeWeight);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    distancia = comoGraphD(noDirigido.dijkstra(inicio));
+    fila("GraphND dijkstra", vertices, antes, segundosDesde(reloj), distancia == distanciaAntes);
+}
+
+int main(int argc, char** argv) {
+    int maximo = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int grado = argc > 2 ? std::atoi(argv[2]) : 4;
+    std::srand(argc > 3 ? std::atoi(argv[3]) : 1);
+    if (maximo < 10 || grado < 1) {
+        std::cerr << "Uso: " << argv[0] << " [vértices máximos >= 10] [arcos por vértice >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::cout << grado << " arcos salientes por vértice (GraphND: la mitad, como aristas)" << std::endl;
+    std::cout << std::left << std::setw(20) << "recorrido (s)" << std::right << std::setw(10) << "vértices"
+              << std::setw(14) << "lineal" << std::setw(14) << "binaria" << std::setw(11) << "mejora" << std::endl;
+    for (int vertices = 1000; vertices <= maximo; vertices *= 10) {
+        comparar(vertices, grado);
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <cstdlib>
+#include <ctime>
+#include "GraphND.h"
+
+// GraphND::dijkstra elige solo entre el montículo (O(E log V)) y el barrido de las V distancias
+// (O(V^2)): barrido solo si el grafo tiene el 90% o más de las aristas posibles. Para ver si la
+// regla acierta, los dos modos se corren aquí sobre la misma copia CSR (freeze), así que solo
+// cambia cómo se elige el próximo vértice. Se mide también GraphND::dijkstra tal como está, y la
+// versión de antes: el barrido, con getNeighbors y getEdgeWeight por cada vértice fijado (la de
+// antes además buscaba los índices de forma lineal). Al final, el corte temprano con pocos destinos.
+// Uso: ./comparar_modos [repeticiones] [semilla]
+
+typedef std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > Heap;
+
+const float INF = std::numeric_limits<float>::max();
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// La regla de GraphND::USE_DENSE_DIJKSTRA
+bool eligeBarrido(int vertices, long aristas) {
+    return vertices > 1 && 2.0 * aristas >= 0.9 * vertices * (vertices - 1.0);
+}
+
+// --- Los dos modos sobre la copia CSR ---
+
+std::vector<float> conMonticulo(const GraphNDCSR<int>& csr, int inicio) {
+    std::vector<float> distancia(csr.order(), INF);
+    std::vector<bool> fijado(csr.order(), false);
+    Heap heap;
+    distancia[inicio] = 0.0f;
+    heap.push(std::make_pair(0.0f, inicio));
+    while (!heap.empty()) {
+        int u = heap.top().second;
+        heap.pop();
+        if (fijado[u]) continue;
+        fijado[u] = true;
+        const float* peso = csr.weightsBegin(u);
+        for (const int* v = csr.neighborsBegin(u); v != csr.neighborsEnd(u); ++v, ++peso) {
+            if (!fijado[*v] && distancia[u] + *peso < distancia[*v]) {
+                distancia[*v] = distancia[u] + *peso;
+                heap.push(std::make_pair(distancia[*v], *v));
+            }
+        }
+    }
+    return distancia;
+}
+
+std::vector<float> conBarrido(const GraphNDCSR<int>& csr, int inicio) {
+    int n = csr.order();
+    std::vector<float> distancia(n, INF);
+    std::vector<bool> fijado(n, false);
+    distancia[inicio] = 0.0f;
+    while (true) {
+        int u = -1;
+        float menor = INF;
+        for (int v = 0; v < n; v++) {
+            if (!fijado[v] && distancia[v] < menor) {
+                menor = distancia[v];
+                u = v;
+            }
+        }
+        if (u == -1) break;
+        fijado[u] = true;
+        const float* peso = csr.weightsBegin(u);
+        for (const int* v = csr.neighborsBegin(u); v != csr.neighborsEnd(u); ++v, ++peso) {
+            if (!fijado[*v] && distancia[u] + *peso < distancia[*v]) distancia[*v] = distancia[u] + *peso;
+        }
+    }
+    return distancia;
+}
+
+// --- La de antes: barrido y vecinos pedidos por valor ---
+
+std::vector<float> deAntes(const GraphND<int>& grafo, int inicio) {
+    int n = grafo.order();
+    std::vector<float> distancia(n, INF);
+    std::vector<bool> fijado(n, false);
+    distancia[grafo.getVertexIndex(inicio)] = 0.0f;
+    for (int vuelta = 0; vuelta < n; vuelta++) {
+        int u = -1;
+        float menor = INF;
+        for (int v = 0; v < n; v++) {
+            if (!fijado[v] && distancia[v] <= menor) {
+                menor = distancia[v];
+                u = v;
+            }
+        }
+        if (u == -1 || distancia[u] == INF) break;
+        fijado[u] = true;
+        int valor = grafo.getVertexFromIndex(u);
+        std::list<int> vecinos = grafo.getNeighbors(valor);
+        for (std::list<int>::iterator it = vecinos.begin(); it != vecinos.end(); ++it) {
+            int v = grafo.getVertexIndex(*it);
+            float nueva = distancia[u] + grafo.getEdgeWeight(valor, *it);
+            if (!fijado[v] && nueva < distancia[v]) distancia[v] = nueva;
+        }
+    }
+    return distancia;
+}
+
+void armar(GraphND<int>& grafo, int vertices, long aristas) {
+    for (int i = 0; i < vertices; i++) grafo.addVertex(i);
+    // Un camino que los une a todos y el resto al azar (las repetidas se ignoran, así que se insiste)
+    for (int i = 1; i < vertices; i++) grafo.addEdge(i - 1, i, (float)(1 + std::rand() % 100));
+    while (grafo.getNumEdges() < aristas) {
+        int a = std::rand() % vertices, b = std::rand() % vertices;
+        if (a != b) grafo.addEdge(a, b, (float)(1 + std::rand() % 100));
+    }
+}
+
+void comparar(int vertices, long aristas, int repeticiones) {
+    GraphND<int> grafo;
+    armar(grafo, vertices, aristas);
+    GraphNDCSR<int> csr;
+    grafo.freeze(csr);
+    std::vector<int> inicio(repeticiones);
+    for (int i = 0; i < repeticiones; i++) inicio[i] = std::rand() % vertices;
+
+    std::vector<float> referencia, distancia;
+    bool iguales = true;
+    std::clock_t reloj = std::clock();
+    for (int i = 0; i < repeticiones; i++) distancia = conMonticulo(csr, inicio[i]);
+    double monticulo = segundosDesde(reloj) / repeticiones;
+    reloj = std::clock();
+    for (int i = 0; i < repeticiones; i++) referencia = conBarrido(csr, inicio[i]);
+    double barrido = segundosDesde(reloj) / repeticiones;
+    iguales = iguales && distancia == referencia;
+    reloj = std::clock();
+    for (int i = 0; i < repeticiones; i++) distancia = grafo.dijkstra(inicio[i]);
+    double automatico = segundosDesde(reloj) / repeticiones;
+    iguales = iguales && distancia == referencia;
+    reloj = std::clock();
+    distancia = deAntes(grafo, inicio[repeticiones - 1]);
+    double antes = segundosDesde(reloj);
+    iguales = iguales && distancia == referencia;
+
+    bool barre = eligeBarrido(vertices, grafo.getNumEdges());
+    bool acierta = (barre ? barrido : monticulo) <= 1.1 * (barre ? monticulo : barrido); // Con 10% de margen
+    std::cout << std::setw(8) << vertices << std::setw(10) << grafo.getNumEdges() << std::fixed << std::setprecision(4)
+              << std::setw(11) << antes << std::setw(11) << monticulo << std::setw(11) << barrido << std::setw(11) << automatico
+              << std::setw(12) << (barre ? "barrido" : "montículo") << (acierta ? "   acierta" : "   erra")
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int repeticiones = argc > 1 ? std::atoi(argv[1]) : 3;
+    std::srand(argc > 2 ? std::atoi(argv[2]) : 1);
+    if (repeticiones < 1) {
+        std::cerr << "Uso: " << argv[0] << " [repeticiones >= 1] [semilla]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "dijkstra completo desde un vértice al azar, s por corrida (antes: una corrida)" << std::endl;
+    std::cout << std::setw(8) << "V" << std::setw(10) << "E" << std::setw(11) << "antes" << std::setw(11) << "montículo"
+              << std::setw(11) << "barrido" << std::setw(11) << "GraphND" << std::setw(12) << "regla" << std::endl;
+    // De ralo a casi completo; el barrido de antes en 1e5 vértices tarda casi un minuto
+    int vertices[] = { 100000, 20000, 5000, 5000, 2000, 2000, 2000, 3000, 1000, 2000 };
+    long aristas[] = { 300000, 60000, 100000, 600000, 100000, 400000, 800000, 1600000, 480000, 1950000 };
+    for (int i = 0; i < 10; i++) comparar(vertices[i], aristas[i], repeticiones);
+
+    // Corte temprano: tres destinos, los vecinos de un vecino del origen, contra la corrida completa
+    GraphND<int> grafo;
+    armar(grafo, 100000, 300000);
+    int origen = std::rand() % 100000;
+    std::list<int> cerca = grafo.getNeighbors(origen);
+    std::list<int> destinos = grafo.getNeighbors(cerca.front());
+    destinos.resize(3, origen);
+    std::vector<int> anterior;
+    std::clock_t reloj = std::clock();
+    std::vector<float> completa = grafo.dijkstra(origen);
+    double todo = segundosDesde(reloj);
+    reloj = std::clock();
+    std::vector<float> parcial = grafo.dijkstra(origen, destinos, anterior);
+    double pocos = segundosDesde(reloj);
+    bool iguales = true;
+    for (std::list<int>::iterator it = destinos.begin(); it != destinos.end(); ++it) {
+        iguales = iguales && parcial[grafo.getVertexIndex(*it)] == completa[grafo.getVertexIndex(*it)];
+    }
+    std::cout << std::endl << "100000 vértices, 300000 aristas: dijkstra completo " << std::fixed << std::setprecision(4) << todo
+              << " s, hasta fijar 3 destinos cercanos " << pocos << " s" << (iguales ? "   ok" : "   FALLA") << std::endl;
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <iostream>
+#include <iomanip>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include "GraphD.h"
+
+// Predecesores de GraphD: ahora addArc los agrega al final del índice de cada vértice y
+// getPredecessors lo ordena la primera vez que se lo pide, contra el índice de antes, que se
+// mantenía ordenado con una inserción en cada addArc (O(grado de entrada), así que llenar un vértice
+// de grado k costaba O(k²)). El índice de antes se arma aquí al lado del grafo, que ya mantiene el
+// suyo, así que "antes" se pasa apenas de lo que costaba: lleva además el agregado al final.
+// Después, lo que usa los predecesores: la segunda pasada de Kosaraju (dfs sobre los predecesores
+// en lugar del transpuesto, la primera vez que se los pide) y el orden topológico de Kahn (inDegree
+// de cada vértice y getSuccessors). Antes se copian del índice a una lista como hacía
+// getPredecessors, pero sin buscar el vértice en el grafo, así que se queda corto: la mitad de lo
+// que tardaba getPredecessors de antes en estos grafos.
+// Uso: ./comparar_predecesores [semilla]
+
+double segundosDesde(std::clock_t inicio) {
+    return (double)(std::clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+void fila(const std::string& que, double antes, double ahora, bool iguales) {
+    std::cout << std::left << std::setw(34) << que << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << antes << std::setw(10) << ahora
+              << std::setw(9) << std::setprecision(1) << antes / (ahora > 0 ? ahora : 1e-6) << "x"
+              << (iguales ? "   ok" : "   FALLA") << std::endl;
+}
+
+typedef std::vector< std::pair<int, int> > Arcos;
+
+// --- El índice de antes: los predecesores de cada vértice, ordenados, insertados uno por uno ---
+
+struct IndiceDeAntes {
+    std::vector< std::vector<int> > predecesores;
+
+    void agregar(int origen, int destino) {
+        std::vector<int>& lista = predecesores[destino];
+        lista.insert(std::lower_bound(lista.begin(), lista.end(), origen), origen);
+    }
+};
+
+// Los vértices son 0..n-1, así que valor e índice coinciden
+void construir(GraphD<int>& grafo, int n, const Arcos& arcos, IndiceDeAntes* indice) {
+    for (int i = 0; i < n; i++) grafo.addVertex(i);
+    if (indice) indice->predecesores.assign(n, std::vector<int>());
+    for (size_t i = 0; i < arcos.size(); i++) {
+        int antes = grafo.size();
+        grafo.addArc(arcos[i].first, arcos[i].second, 1.0f);
+        if (indice && grafo.size() > antes) indice->agregar(arcos[i].first, arcos[i].second);
+    }
+}
+
+// dfs iterativo desde 'inicio': agrega a 'salida' cada vértice al terminarlo y le pone 'marca' en 'componente'
+void dfsIterativo(const std::vector< std::vector<int> >& lista, int inicio, std::vector<int>& componente, int marca, std::vector<int>& salida) {
+    std::vector< std::pair<int, size_t> > pila; // (vértice, próximo vecino)
+    componente[inicio] = marca;
+    pila.push_back(std::make_pair(inicio, (size_t)0));
+    while (!pila.empty()) {
+        int v = pila.back().first;
+        if (pila.back().second < lista[v].size()) {
+            int u = lista[v][pila.back().second++];
+            if (componente[u] == -1) {
+                componente[u] = marca;
+                pila.push_back(std::make_pair(u, (size_t)0));
+            }
+        } else {
+            salida.push_back(v);
+            pila.pop_back();
+        }
+    }
+}
+
+std::vector<int> aVector(const std::list<int>& valores) {
+    return std::vector<int>(valores.begin(), valores.end());
+}
+
+// Segunda pasada de Kosaraju sobre 'predecesores', en el orden de finalización de la primera
+int segundaPasada(const std::vector< std::vector<int> >& predecesores, const std::vector<int>& orden, std::vector<int>& componente) {
+    componente.assign(orden.size(), -1);
+    int cuantas = 0;
+    std::vector<int> descarte;
+    for (size_t i = orden.size(); i-- > 0; ) {
+        if (componente[orden[i]] == -1) dfsIterativo(predecesores, orden[i], componente, cuantas++, descarte);
+    }
+    return cuantas;
+}
+
+// Kahn con los grados de entrada dados; devuelve cuántos vértices pudo ordenar
+int kahn(GraphD<int>& grafo, std::vector<int> grados) {
+    std::queue<int> listos;
+    for (int v = 0; v < grafo.order(); v++) {
+        if (grados[v] == 0) listos.push(v);
+    }
+    int ordenados = 0;
+    while (!listos.empty()) {
+        int v = listos.front();
+        listos.pop();
+        ordenados++;
+        std::list<int> sucesores = grafo.getSuccessors(v);
+        for (std::list<int>::iterator it = sucesores.begin(); it != sucesores.end(); ++it) {
+            if (--grados[*it] == 0) listos.push(*it);
+        }
+    }
+    return ordenados;
+}
+
+void comparar(const std::string& titulo, int n, const Arcos& arcos) {
+    std::cout << std::endl << "== " << titulo << ": " << n << " vértices, " << arcos.size() << " arcos ==" << std::endl;
+    std::cout << std::left << std::setw(34) << "s" << std::right << std::setw(10) << "antes"
+              << std::setw(10) << "ahora" << std::setw(10) << "mejora" << std::endl;
+
+    IndiceDeAntes indice;
+    GraphD<int>* conIndice = new GraphD<int>();
+    std::clock_t reloj = std::clock();
+    construir(*conIndice, n, arcos, &indice);
+    double antes = segundosDesde(reloj);
+    delete conIndice; // Liberarlo no se mide
+    GraphD<int> grafo;
+    reloj = std::clock();
+    construir(grafo, n, arcos, NULL);
+    double ahora = segundosDesde(reloj);
+    double armar = antes, armarAhora = ahora; // Se imprime cuando se pueda comparar lo que dio getPredecessors
+
+    // Kosaraju: la primera pasada sobre getSuccessors, sin medir
+    std::vector< std::vector<int> > sucesores(n);
+    for (int v = 0; v < n; v++) sucesores[v] = aVector(grafo.getSuccessors(v));
+    std::vector<int> orden, visto(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (visto[v] == -1) dfsIterativo(sucesores, v, visto, 0, orden);
+    }
+    std::vector<int> componenteAntes, componente;
+    reloj = std::clock();
+    std::vector< std::vector<int> > predecesores(n);
+    for (int v = 0; v < n; v++) {
+        predecesores[v] = aVector(std::list<int>(indice.predecesores[v].begin(), indice.predecesores[v].end()));
+    }
+    int cuantasAntes = segundaPasada(predecesores, orden, componenteAntes);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    for (int v = 0; v < n; v++) predecesores[v] = aVector(grafo.getPredecessors(v));
+    int cuantas = segundaPasada(predecesores, orden, componente);
+    ahora = segundosDesde(reloj);
+    bool iguales = true;
+    for (int v = 0; v < n && iguales; v++) iguales = predecesores[v] == indice.predecesores[v];
+    fila("armar el grafo (addArc)", armar, armarAhora, iguales);
+    fila("Kosaraju, segunda pasada", antes, ahora, cuantas == cuantasAntes && componente == componenteAntes);
+
+    reloj = std::clock();
+    std::vector<int> grados(n);
+    for (int v = 0; v < n; v++) grados[v] = (int)indice.predecesores[v].size();
+    int ordenadosAntes = kahn(grafo, grados);
+    antes = segundosDesde(reloj);
+    reloj = std::clock();
+    for (int v = 0; v < n; v++) grados[v] = grafo.inDegree(v);
+    int ordenados = kahn(grafo, grados);
+    ahora = segundosDesde(reloj);
+    bool dag = !grafo.topologicalOrder().empty();
+    fila("Kahn (inDegree y getSuccessors)", antes, ahora, ordenados == ordenadosAntes && (ordenados == n) == dag);
+}
+
+int main(int argc, char** argv) {
+    std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+    const int n = 100000;
+    Arcos arcos;
+
+    for (int i = 0; i < 300000; i++) arcos.push_back(std::make_pair(std::rand() % n, std::rand() % n));
+    comparar("al azar", n, arcos);
+
+    arcos.clear();
+    for (int i = 0; i < 1000000; i++) arcos.push_back(std::make_pair(std::rand() % n, std::rand() % n));
+    comparar("al azar", n, arcos);
+
+    arcos.clear(); // Sin ciclos: de un vértice a otro mayor
+    for (int i = 0; i < 1000000; i++) {
+        int a = std::rand() % n, b = std::rand() % n;
+        if (a != b) arcos.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+    }
+    comparar("acíclico", n, arcos);
+
+    arcos.clear(); // Todos hacia el 0: un vértice de grado de entrada n - 1, en orden al azar
+    for (int i = 1; i < n; i++) arcos.push_back(std::make_pair(i, 0));
+    std::random_shuffle(arcos.begin(), arcos.end());
+    comparar("estrella de entrada", n, arcos);
+    return 0;
+}
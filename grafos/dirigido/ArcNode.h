@@ -10,19 +10,20 @@ private:
     float weight;                  // Weight of the arc
     VertexNode<Elem>* destinationVertex; // Pointer to the destination vertex of the arc
     ArcNode<Elem>* nextArc;        // Pointer to the next arc from the same source vertex
+    ArcNode<Elem>* prevArc;        // Pointer to the previous arc from the same source vertex (NULL at the head), for O(1) unlinking
 
 public:
     // -- Constructors --
 
     // Default constructor
-    ArcNode() : weight(0.0f), destinationVertex(NULL), nextArc(NULL) {}
+    ArcNode() : weight(0.0f), destinationVertex(NULL), nextArc(NULL), prevArc(NULL) {}
 
     // Constructor initializing weight
-    ArcNode(float w) : weight(w), destinationVertex(NULL), nextArc(NULL) {}
+    ArcNode(float w) : weight(w), destinationVertex(NULL), nextArc(NULL), prevArc(NULL) {}
 
     // Constructor initializing all members
     ArcNode(float w, VertexNode<Elem>* dest, ArcNode<Elem>* next)
-        : weight(w), destinationVertex(dest), nextArc(next) {}
+        : weight(w), destinationVertex(dest), nextArc(next), prevArc(NULL) {}
 
     // -- Getters --
 
@@ -35,6 +36,9 @@ public:
     // Returns a pointer to the next arc in the adjacency list.
     ArcNode<Elem>* getNextArc() const { return nextArc; }
 
+    // Returns a pointer to the previous arc in the adjacency list (NULL for the first one).
+    ArcNode<Elem>* getPrevArc() const { return prevArc; }
+
     // -- Setters --
 
     // Sets the weight of the arc.
@@ -45,6 +49,9 @@ public:
 
     // Sets the pointer to the next arc in the adjacency list.
     void setNextArc(ArcNode<Elem>* next) { nextArc = next; }
+
+    // Sets the pointer to the previous arc in the adjacency list.
+    void setPrevArc(ArcNode<Elem>* prev) { prevArc = prev; }
 };
 
 #endif // ARCNODE_H
\ No newline at end of file
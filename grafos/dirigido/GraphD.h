@@ -4,11 +4,17 @@
 #include <vector>
 #include <list>
 #include <cstddef>   // For NULL
-#include <algorithm> // For std::reverse, std::find
+#include <algorithm> // For std::reverse, std::find, std::lower_bound, std::sort
 #include <limits>    // Potentially for infinity, though using -1 as sentinel
+#include <queue>     // For std::priority_queue
+#include <functional> // For std::greater
+#include <utility>   // For std::pair
 
 #include "VertexNode.h"
 #include "ArcNode.h"
+#include "GraphDCSR.h"
+#include "../HeldKarp.h"
+#include "../HamiltonSearch.h"
 
 // Helper structure to return arc information
 template <typename elem>
@@ -30,100 +36,131 @@ struct ArcInfo {
 template <typename elem>
 class GraphD {
 private:
-    std::vector<elem> vertexMap;       // Map for index-based access
+    std::vector<elem> vertexMap;       // Map for index-based access, sorted like the vertex list
+    std::vector<VertexNode<elem>*> vertexNodes; // vertexNodes[i] is the node holding vertexMap[i]
     VertexNode<elem>* firstVertex;     // Pointer to the first vertex in the list
     int numVertices;                   // Count of vertices
     int numArcs;                       // Count of arcs
 
     // -- Private Helper Methods (UPPER_SNAKE_CASE) --
 
-    // Finds the vertex node *preceding* the one with 'value', or NULL if not found or list empty. If value is at head, returns firstVertex itself.
-    VertexNode<elem>* FIND_VERTEX_NODE_PREDECESSOR(const elem& value) const {
-        VertexNode<elem>* current = firstVertex;
-        VertexNode<elem>* previous = NULL;
+    // Position where 'value' is or would be inserted in vertexMap (binary search, the map is sorted).
+    int MAP_POSITION(const elem& value) const {
+        return (int)(std::lower_bound(vertexMap.begin(), vertexMap.end(), value) - vertexMap.begin());
+    }
+
+    // Finds the vertex node with the given value. Returns pointer to the node or NULL.
+    VertexNode<elem>* FIND_VERTEX_NODE(const elem& value) const {
+        int index = getMapIndex(value);
+        return (index >= 0) ? vertexNodes[index] : NULL;
+    }
+
 
-        if (!current) { // Empty list
-            return NULL;
+    // Orders arcs by the value of their destination vertex (arc index order).
+    struct ArcDestinationLess {
+        bool operator()(const ArcNode<elem>* arc, const elem& value) const {
+            return arc->getDestinationVertex()->getData() < value;
         }
-        if (current->getData() == value) { // Value is at the head
-            return firstVertex; // Return head itself as special case indicator
+        bool operator()(const ArcNode<elem>* a, const ArcNode<elem>* b) const {
+            return a->getDestinationVertex()->getData() < b->getDestinationVertex()->getData();
         }
+    };
+
+    // Finds the arc from 'sourceNode' to 'destValue' by binary search in its arc index (O(log deg)). Returns ArcNode* or NULL.
+    ArcNode<elem>* FIND_ARC_NODE(const VertexNode<elem>* sourceNode, const elem& destValue) const {
+        const std::vector<ArcNode<elem>*>& index = sourceNode->getArcIndex();
+        typename std::vector<ArcNode<elem>*>::const_iterator it = std::lower_bound(index.begin(), index.end(), destValue, ArcDestinationLess());
+        if (it != index.end() && (*it)->getDestinationVertex()->getData() == destValue) {
+            return *it;
+        }
+        return NULL;
+    }
 
-        previous = current;
-        current = current->getNextVertex();
+    // Orders vertex nodes by value, for sorting and binary searches in the predecessor indices.
+    struct VertexValueLess {
+        bool operator()(const VertexNode<elem>* node, const elem& value) const {
+            return node->getData() < value;
+        }
+        bool operator()(const VertexNode<elem>* a, const VertexNode<elem>* b) const {
+            return a->getData() < b->getData();
+        }
+    };
+
+    // Records 'sourceNode' as a predecessor of 'destNode' (after adding an arc between them). Appends in O(1) amortized;
+    // a source out of order only marks the index unsorted, SORT_PREDECESSORS fixes it when someone reads it.
+    void INDEX_PREDECESSOR(VertexNode<elem>* destNode, VertexNode<elem>* sourceNode) {
+        std::vector<VertexNode<elem>*>& index = destNode->getPredecessorIndex();
+        if (!index.empty() && sourceNode->getData() < index.back()->getData()) {
+            destNode->setPredecessorsSorted(false);
+        }
+        index.push_back(sourceNode);
+    }
 
-        while (current != NULL) {
-            if (current->getData() == value) {
-                return previous; // Found it, return the node before it
-            }
-             if (current->getData() > value) { // List is sorted, passed the spot
-                return NULL;
-            }
-            previous = current;
-            current = current->getNextVertex();
+    // Forgets 'sourceNode' as a predecessor of 'destNode' (when the arc between them goes away): a binary search if the
+    // index is sorted, else a search from the back. Erasing keeps the order either way.
+    void UNINDEX_PREDECESSOR(VertexNode<elem>* destNode, VertexNode<elem>* sourceNode) {
+        std::vector<VertexNode<elem>*>& index = destNode->getPredecessorIndex();
+        if (destNode->arePredecessorsSorted()) {
+            index.erase(std::lower_bound(index.begin(), index.end(), sourceNode->getData(), VertexValueLess()));
+        } else {
+            index.erase(std::find(index.rbegin(), index.rend(), sourceNode).base() - 1);
         }
-        return NULL; // Not found
     }
 
-    // Finds the vertex node with the given value. Returns pointer to the node or NULL.
-    VertexNode<elem>* FIND_VERTEX_NODE(const elem& value) const {
-         VertexNode<elem>* current = firstVertex;
-         while(current != NULL) {
-             if (current->getData() == value) {
-                 return current;
-             }
-              if (current->getData() > value) { // List is sorted
-                return NULL;
-            }
-             current = current->getNextVertex();
-         }
-         return NULL;
+    // Sorts the predecessor index of 'node' by value if arcs came in out of order (O(k log k) once per batch of additions).
+    void SORT_PREDECESSORS(VertexNode<elem>* node) const {
+        if (!node->arePredecessorsSorted()) {
+            std::vector<VertexNode<elem>*>& index = node->getPredecessorIndex();
+            std::sort(index.begin(), index.end(), VertexValueLess());
+            node->setPredecessorsSorted(true);
+        }
     }
 
+    // Adds 'arc' (already linked into the adjacency list of 'sourceNode') to its arc index, keeping it sorted.
+    void INDEX_ARC(VertexNode<elem>* sourceNode, ArcNode<elem>* arc) {
+        std::vector<ArcNode<elem>*>& index = sourceNode->getArcIndex();
+        index.insert(std::lower_bound(index.begin(), index.end(), arc->getDestinationVertex()->getData(), ArcDestinationLess()), arc);
+    }
 
-    // Finds an arc node in an adjacency list starting from 'startArc' pointing to 'destValue'. Returns ArcNode* or NULL.
-    ArcNode<elem>* FIND_ARC_NODE(ArcNode<elem>* startArc, const elem& destValue) const {
-        ArcNode<elem>* current = startArc;
-        while (current != NULL) {
-            if (current->getDestinationVertex() && current->getDestinationVertex()->getData() == destValue) {
-                return current;
-            }
-            current = current->getNextArc();
+    // Links 'arc' at the head of the adjacency list of 'sourceNode' (O(1)).
+    void LINK_ARC(VertexNode<elem>* sourceNode, ArcNode<elem>* arc) {
+        arc->setPrevArc(NULL);
+        arc->setNextArc(sourceNode->getAdjacencyList());
+        if (sourceNode->getAdjacencyList() != NULL) {
+            sourceNode->getAdjacencyList()->setPrevArc(arc);
         }
-        return NULL;
+        sourceNode->setAdjacencyList(arc);
     }
 
-    // Removes an arc pointing to 'destValue' from the adjacency list of 'sourceNode'. Returns true if removed, false otherwise.
+    // Removes an arc pointing to 'destValue' from the adjacency list of 'sourceNode': a binary search in its arc index, an O(1) unlink
+    // through the back-pointer, and erasing it from the arc index and from the destination's predecessor index (both shift their tail).
+    // Returns true if removed, false otherwise.
     bool REMOVE_ARC_NODE(VertexNode<elem>* sourceNode, const elem& destValue) {
-        if (!sourceNode || !sourceNode->getAdjacencyList()) {
+        if (!sourceNode) {
             return false;
         }
-
-        ArcNode<elem>* currentArc = sourceNode->getAdjacencyList();
-        ArcNode<elem>* prevArc = NULL;
-
-        // Check head of the adjacency list
-        if (currentArc->getDestinationVertex() && currentArc->getDestinationVertex()->getData() == destValue) {
-            sourceNode->setAdjacencyList(currentArc->getNextArc()); // Update head
-            delete currentArc;
-            numArcs--;
-            return true;
+        ArcNode<elem>* target = FIND_ARC_NODE(sourceNode, destValue); // Missing arcs are rejected without walking the list
+        if (!target) {
+            return false;
         }
 
-        // Check rest of the adjacency list
-        prevArc = currentArc;
-        currentArc = currentArc->getNextArc();
-        while (currentArc != NULL) {
-            if (currentArc->getDestinationVertex() && currentArc->getDestinationVertex()->getData() == destValue) {
-                prevArc->setNextArc(currentArc->getNextArc()); // Unlink
-                delete currentArc;
-                numArcs--;
-                return true;
-            }
-            prevArc = currentArc;
-            currentArc = currentArc->getNextArc();
+        // Unlink from the adjacency list, no walk needed
+        if (target->getPrevArc() == NULL) {
+            sourceNode->setAdjacencyList(target->getNextArc()); // Update head
+        } else {
+            target->getPrevArc()->setNextArc(target->getNextArc());
+        }
+        if (target->getNextArc() != NULL) {
+            target->getNextArc()->setPrevArc(target->getPrevArc());
         }
-        return false; // Arc not found
+
+        // Drop it from the arc index
+        std::vector<ArcNode<elem>*>& index = sourceNode->getArcIndex();
+        index.erase(std::lower_bound(index.begin(), index.end(), destValue, ArcDestinationLess()));
+        UNINDEX_PREDECESSOR(target->getDestinationVertex(), sourceNode);
+        delete target;
+        numArcs--;
+        return true;
     }
 
     // Recursive helper for Depth First Search traversal.
@@ -204,41 +241,33 @@ private:
         visitedInPath[currentIndex] = false;
     }
 
-    // Recursive helper for finding *a* Hamiltonian Path.
-    void HAMILTONIAN_PATH_HELPER(const elem& currentValue, std::vector<bool>& visited, std::list<elem>& currentPath, bool& found) {
-        if (found) return; // Stop if already found
-
-        int currentIndex = getMapIndex(currentValue);
-        if (currentIndex < 0 || visited[currentIndex]) return; // Already visited in this path
-
-        visited[currentIndex] = true;
-        currentPath.push_back(currentValue);
-
-        if (currentPath.size() == (size_t)numVertices) {
-            found = true; // Found a Hamiltonian path
-        } else {
-            std::list<elem> successors = getSuccessors(currentValue);
-            for (typename std::list<elem>::iterator it = successors.begin(); it != successors.end() && !found; ++it) {
-                HAMILTONIAN_PATH_HELPER(*it, visited, currentPath, found);
+    // Fills successors[index] with the map indices of the vertex's successors, in adjacency list order (the input of HamiltonSearch).
+    void SUCCESSOR_INDICES(std::vector< std::vector<int> >& successors) const {
+        successors.assign(numVertices, std::vector<int>());
+        for (int v = 0; v < numVertices; ++v) {
+            for (ArcNode<elem>* arc = vertexNodes[v]->getAdjacencyList(); arc != NULL; arc = arc->getNextArc()) {
+                if (arc->getDestinationVertex()) {
+                    successors[v].push_back(getMapIndex(arc->getDestinationVertex()->getData()));
+                }
             }
         }
-
-        // Backtrack only if path wasn't completed down this branch
-        if (!found) {
-            currentPath.pop_back();
-            visited[currentIndex] = false;
-        }
     }
 
-    // Recursive helper for finding the Minimum Cost Hamiltonian Path.
-    void MIN_COST_HAMILTONIAN_HELPER(const elem& currentValue, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& minCostFound) {
+    // Recursive helper for finding the Minimum Cost Hamiltonian Path (backtracking, tried before the Held-Karp table).
+    // 'remainingBound' is the sum of the cheapest incoming arc of every vertex not on the path yet, current included: each of
+    // them still has to be entered once, so branches that cannot beat minCostFound even at that price are cut.
+    // 'budget' counts the calls left (-1: no limit); once it reaches 0 the search unwinds and the caller builds the table.
+    void MIN_COST_HAMILTONIAN_HELPER(const elem& currentValue, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& minCostFound,
+                                     const std::vector<float>& cheapestIn, float remainingBound, long& budget) {
         int currentIndex = getMapIndex(currentValue);
-        if (currentIndex < 0 || visited[currentIndex]) return;
+        if (currentIndex < 0 || visited[currentIndex] || budget == 0) return;
+        if (budget > 0) --budget;
 
-         // Pruning (optional but good): If current cost exceeds best found, stop.
-         if (minCostFound >= 0 && currentCost >= minCostFound) {
-             return;
-         }
+        // Branch and bound: the rest of the path costs at least the cheapest way into each vertex left
+        remainingBound -= cheapestIn[currentIndex];
+        if (minCostFound >= 0 && currentCost + remainingBound >= minCostFound) {
+            return;
+        }
 
         visited[currentIndex] = true;
         currentPath.push_back(currentValue); // Path is built forward here
@@ -249,12 +278,14 @@ private:
                  bestPath = currentPath;
              }
         } else {
-            std::list<elem> successors = getSuccessors(currentValue);
-            for (typename std::list<elem>::iterator it = successors.begin(); it != successors.end(); ++it) {
-                 float weight = getArcWeight(currentValue, *it);
-                 if (weight >= 0) { // Check if arc exists
-                     MIN_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, currentCost + weight, bestPath, minCostFound);
+            // Weights come from the arcs being walked, so no lookup is needed per candidate
+            ArcNode<elem>* currentArc = vertexNodes[currentIndex]->getAdjacencyList();
+            while (currentArc != NULL) {
+                 float weight = currentArc->getWeight();
+                 if (currentArc->getDestinationVertex() && weight >= 0) { // Negative weights count as missing arcs
+                     MIN_COST_HAMILTONIAN_HELPER(currentArc->getDestinationVertex()->getData(), visited, currentPath, currentCost + weight, bestPath, minCostFound, cheapestIn, remainingBound, budget);
                  }
+                 currentArc = currentArc->getNextArc();
             }
         }
 
@@ -265,11 +296,20 @@ private:
     }
 
 
-    // Recursive helper for finding the Maximum Cost Hamiltonian Path.
-     void MAX_COST_HAMILTONIAN_HELPER(const elem& currentValue, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& maxCostFound) {
+    // Recursive helper for finding the Maximum Cost Hamiltonian Path (backtracking, tried before the Held-Karp table).
+    // 'remainingBound' is the sum of the dearest incoming arc of every vertex not on the path yet, current included.
+    // 'budget' as in MIN_COST_HAMILTONIAN_HELPER.
+     void MAX_COST_HAMILTONIAN_HELPER(const elem& currentValue, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& maxCostFound,
+                                      const std::vector<float>& dearestIn, float remainingBound, long& budget) {
         int currentIndex = getMapIndex(currentValue);
-        if (currentIndex < 0 || visited[currentIndex]) return;
+        if (currentIndex < 0 || visited[currentIndex] || budget == 0) return;
+        if (budget > 0) --budget;
 
+        // Branch and bound: the rest of the path cannot add more than the dearest way into each vertex left
+        remainingBound -= dearestIn[currentIndex];
+        if (maxCostFound >= 0 && currentCost + remainingBound <= maxCostFound) {
+            return;
+        }
 
         visited[currentIndex] = true;
         currentPath.push_back(currentValue); // Path is built forward
@@ -280,12 +320,13 @@ private:
                  bestPath = currentPath;
              }
         } else {
-            std::list<elem> successors = getSuccessors(currentValue);
-            for (typename std::list<elem>::iterator it = successors.begin(); it != successors.end(); ++it) {
-                 float weight = getArcWeight(currentValue, *it);
-                 if (weight >= 0) { // Check if arc exists
-                     MAX_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, currentCost + weight, bestPath, maxCostFound);
+            ArcNode<elem>* currentArc = vertexNodes[currentIndex]->getAdjacencyList();
+            while (currentArc != NULL) {
+                 float weight = currentArc->getWeight();
+                 if (currentArc->getDestinationVertex() && weight >= 0) { // Negative weights count as missing arcs
+                     MAX_COST_HAMILTONIAN_HELPER(currentArc->getDestinationVertex()->getData(), visited, currentPath, currentCost + weight, bestPath, maxCostFound, dearestIn, remainingBound, budget);
                  }
+                 currentArc = currentArc->getNextArc();
             }
         }
 
@@ -294,17 +335,184 @@ private:
         visited[currentIndex] = false;
     }
 
+    // Fills bound[index] with the cheapest (or, if 'dearest', the greatest) weight of an arc into each vertex, 0 if it has none. Returns the sum over all vertices.
+    float INCOMING_ARC_BOUNDS(std::vector<float>& bound, bool dearest) const {
+        bound.assign(numVertices, 0.0f);
+        std::vector<bool> seen(numVertices, false);
+        for (int v = 0; v < numVertices; ++v) {
+            for (ArcNode<elem>* arc = vertexNodes[v]->getAdjacencyList(); arc != NULL; arc = arc->getNextArc()) {
+                float weight = arc->getWeight();
+                if (!arc->getDestinationVertex() || weight < 0) continue;
+                int destIndex = getMapIndex(arc->getDestinationVertex()->getData());
+                if (!seen[destIndex] || (dearest ? weight > bound[destIndex] : weight < bound[destIndex])) {
+                    bound[destIndex] = weight;
+                    seen[destIndex] = true;
+                }
+            }
+        }
+        float sum = 0.0f;
+        for (int v = 0; v < numVertices; ++v) sum += bound[v];
+        return sum;
+    }
+
+    // Min (or max) cost Hamiltonian path with the Held-Karp table, starting at startIndex (-1: any vertex, first in map order on ties).
+    // The path is rebuilt forward taking, at each step, the first arc in adjacency list order that keeps the optimal cost, which is
+    // the path the backtracking helpers would have returned. Requires numVertices <= HeldKarp::MAX_VERTICES. Returns path or empty list.
+    std::list<elem> HELD_KARP_PATH(int startIndex, bool maximize) const {
+        std::list<elem> path;
+        int n = numVertices;
+        std::vector<float> weights((size_t)n * n, HeldKarp::noArc());
+        for (int v = 0; v < n; ++v) {
+            for (ArcNode<elem>* arc = vertexNodes[v]->getAdjacencyList(); arc != NULL; arc = arc->getNextArc()) {
+                if (arc->getDestinationVertex() && arc->getWeight() >= 0) { // Negative weights count as missing arcs
+                    weights[(size_t)v * n + getMapIndex(arc->getDestinationVertex()->getData())] = arc->getWeight();
+                }
+            }
+        }
+        HeldKarp costs(weights, n, maximize);
+
+        unsigned int left = costs.allVertices();
+        int current = -1;
+        float bestCost = HeldKarp::noPath();
+        for (int v = (startIndex < 0 ? 0 : startIndex); v < (startIndex < 0 ? n : startIndex + 1); ++v) {
+            float cost = costs.pathCost(v, left);
+            if (cost != HeldKarp::noPath() && (current < 0 || costs.isBetter(cost, bestCost))) {
+                current = v;
+                bestCost = cost;
+            }
+        }
+        if (current < 0) return path; // No Hamiltonian path
+
+        while (true) {
+            path.push_back(vertexMap[current]);
+            float target = costs.pathCost(current, left);
+            left &= ~(1u << current);
+            if (left == 0) break;
+            int next = -1;
+            for (ArcNode<elem>* arc = vertexNodes[current]->getAdjacencyList(); arc != NULL && next < 0; arc = arc->getNextArc()) {
+                if (!arc->getDestinationVertex() || arc->getWeight() < 0) continue;
+                int destIndex = getMapIndex(arc->getDestinationVertex()->getData());
+                if (!(left & (1u << destIndex))) continue;
+                float tail = costs.pathCost(destIndex, left);
+                if (tail != HeldKarp::noPath() && arc->getWeight() + tail == target) next = destIndex;
+            }
+            current = next;
+        }
+        return path;
+    }
+
+
+    // Dijkstra over map indices with a binary heap and lazy deletion (O((V+E) log V)). Fills distances (-1 if unreachable) and
+    // predecessors (index of the previous vertex on a shortest path, -1 for the start and unreached vertices). Arcs with
+    // negative weight are skipped, as getArcWeight() reports them like missing arcs. Stops once endIndex is settled (-1 runs to completion).
+    void DIJKSTRA_HEAP(int startIndex, int endIndex, std::vector<float>& distances, std::vector<int>& predecessors) const {
+        distances.assign(numVertices, -1.0f);
+        predecessors.assign(numVertices, -1);
+        if (startIndex < 0) return;
+
+        std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > heap;
+        std::vector<bool> settled(numVertices, false);
+        distances[startIndex] = 0.0f;
+        heap.push(std::make_pair(0.0f, startIndex));
+
+        while (!heap.empty()) {
+            int currentIndex = heap.top().second;
+            heap.pop();
+            if (settled[currentIndex]) continue; // Outdated entry, a shorter distance was already popped
+            settled[currentIndex] = true;
+            if (currentIndex == endIndex) break; // Its distance is final
+
+            ArcNode<elem>* currentArc = vertexNodes[currentIndex]->getAdjacencyList();
+            while (currentArc != NULL) {
+                float weight = currentArc->getWeight();
+                if (currentArc->getDestinationVertex() && weight >= 0) {
+                    int neighborIndex = getMapIndex(currentArc->getDestinationVertex()->getData());
+                    float newDist = distances[currentIndex] + weight;
+                    if (neighborIndex >= 0 && !settled[neighborIndex] && (distances[neighborIndex] < 0 || newDist < distances[neighborIndex])) {
+                        distances[neighborIndex] = newDist;
+                        predecessors[neighborIndex] = currentIndex;
+                        heap.push(std::make_pair(newDist, neighborIndex));
+                    }
+                }
+                currentArc = currentArc->getNextArc();
+            }
+        }
+    }
 
-    // Updates the internal vertex map based on the current vertex list.
+    // Rebuilds the vertex map and node index from the whole vertex list (addVertex/removeVertex update them in place).
     void UPDATE_MAP() {
         vertexMap.clear();
+        vertexNodes.clear();
         VertexNode<elem>* current = firstVertex;
         while (current != NULL) {
             vertexMap.push_back(current->getData());
+            vertexNodes.push_back(current);
             current = current->getNextVertex();
         }
     }
 
+    // Iterative Tarjan's algorithm over the adjacency lists (O((V+E) log V) with the map lookups, no recursion or transposed copy).
+    // Fills component[index] so that components are numbered in topological order of the condensation: every arc goes
+    // to the same component or a higher-numbered one. Returns the number of components.
+    int TARJAN_SCC(std::vector<int>& component) const {
+        component.assign(numVertices, -1);
+        std::vector<int> discovery(numVertices, -1); // DFS discovery time, -1 if not visited yet
+        std::vector<int> low(numVertices, 0);        // Earliest discovery time reachable through the DFS subtree
+        std::vector<bool> onStack(numVertices, false);
+        std::vector<int> sccStack;                   // Visited vertices whose component is still open
+        std::vector< std::pair<int, ArcNode<elem>*> > callStack; // (vertex, next arc to look at)
+        int time = 0;
+        int count = 0;
+
+        for (int root = 0; root < numVertices; ++root) {
+            if (discovery[root] >= 0) continue;
+            discovery[root] = low[root] = time++;
+            sccStack.push_back(root);
+            onStack[root] = true;
+            callStack.push_back(std::make_pair(root, vertexNodes[root]->getAdjacencyList()));
+
+            while (!callStack.empty()) {
+                int v = callStack.back().first;
+                ArcNode<elem>* arc = callStack.back().second;
+                if (arc != NULL) {
+                    callStack.back().second = arc->getNextArc();
+                    if (!arc->getDestinationVertex()) continue;
+                    int w = getMapIndex(arc->getDestinationVertex()->getData());
+                    if (discovery[w] < 0) { // Tree arc: descend
+                        discovery[w] = low[w] = time++;
+                        sccStack.push_back(w);
+                        onStack[w] = true;
+                        callStack.push_back(std::make_pair(w, vertexNodes[w]->getAdjacencyList()));
+                    } else if (onStack[w] && discovery[w] < low[v]) {
+                        low[v] = discovery[w];
+                    }
+                    continue;
+                }
+
+                // All arcs of v seen: close its component if v is the root of one, then return to the parent
+                callStack.pop_back();
+                if (low[v] == discovery[v]) {
+                    int w;
+                    do {
+                        w = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[w] = false;
+                        component[w] = count;
+                    } while (w != v);
+                    count++;
+                }
+                if (!callStack.empty()) {
+                    int parent = callStack.back().first;
+                    if (low[v] < low[parent]) low[parent] = low[v];
+                }
+            }
+        }
+
+        // Tarjan closes sink components first; reverse the numbering so sources come first
+        for (int v = 0; v < numVertices; ++v) component[v] = count - 1 - component[v];
+        return count;
+    }
+
 public:
     // -- Constructors and Destructor --
 
@@ -352,14 +560,11 @@ public:
     // Adds a vertex with the given value if it doesn't exist. Maintains sorted order. Returns void.
     void addVertex(const elem& value) {
         VertexNode<elem>* newNode = NULL; // Initialize to NULL
-        VertexNode<elem>* current = firstVertex;
-        VertexNode<elem>* previous = NULL;
 
-        // Find insertion point or check for existence
-        while (current != NULL && current->getData() < value) {
-            previous = current;
-            current = current->getNextVertex();
-        }
+        // Find insertion point or check for existence (the map mirrors the sorted list)
+        int position = MAP_POSITION(value);
+        VertexNode<elem>* current = ((size_t)position < vertexNodes.size()) ? vertexNodes[position] : NULL;
+        VertexNode<elem>* previous = (position > 0) ? vertexNodes[position - 1] : NULL;
 
         // Check if vertex already exists
         if (current != NULL && current->getData() == value) {
@@ -378,38 +583,33 @@ public:
         }
 
         numVertices++;
-        UPDATE_MAP(); // Update the map after adding a vertex
+        vertexMap.insert(vertexMap.begin() + position, value); // Keep map and node index aligned with the list
+        vertexNodes.insert(vertexNodes.begin() + position, newNode);
     }
 
-    // Removes the vertex with the given value and all incident arcs. Returns void.
+    // Removes the vertex with the given value and all incident arcs. Each incident arc costs a binary search and an O(1) unlink; erasing it
+    // from the neighbor's sorted index shifts that vector's tail (up to the neighbor's degree in pointers, one memmove), and the map vectors
+    // shift once (O(V), also a memmove). Returns void.
     void removeVertex(const elem& value) {
         VertexNode<elem>* nodeToRemove = NULL;
         VertexNode<elem>* prevNode = NULL;
 
         // 1. Find the node to remove and its predecessor
-        VertexNode<elem>* findResult = FIND_VERTEX_NODE_PREDECESSOR(value);
-
-        if (!findResult) return; // Vertex not found
+        int position = getMapIndex(value);
+        if (position < 0) return; // Vertex not found
 
-        if (findResult == firstVertex && firstVertex->getData() == value) { // Found at head
-             nodeToRemove = firstVertex;
-             prevNode = NULL; // Indicate it's the head
-        } else if (findResult->getNextVertex() && findResult->getNextVertex()->getData() == value) { // Found after predecessor
-             nodeToRemove = findResult->getNextVertex();
-             prevNode = findResult;
-        } else {
-             return; // Should not happen if FIND_VERTEX_NODE_PREDECESSOR is correct, but safety check
-        }
+        nodeToRemove = vertexNodes[position];
+        prevNode = (position > 0) ? vertexNodes[position - 1] : NULL; // NULL if it's the head
 
 
-        // 2. Remove all INCOMING arcs to 'nodeToRemove'
-        VertexNode<elem>* iteratorNode = firstVertex;
-        while (iteratorNode != NULL) {
-            if (iteratorNode != nodeToRemove) { // Don't try to remove arcs from the node itself yet
+        // 2. Remove all INCOMING arcs to 'nodeToRemove', found through its predecessor index (O(in-degree) arcs, not a pass over every vertex).
+        // Each removal also drops the source from that index; going from the back keeps those erases at its end.
+        std::vector<VertexNode<elem>*> predecessors(nodeToRemove->getPredecessorIndex());
+        for (size_t i = predecessors.size(); i-- > 0; ) {
+            if (predecessors[i] != nodeToRemove) { // Don't try to remove arcs from the node itself yet
                 // REMOVE_ARC_NODE handles decrementing numArcs if successful
-                REMOVE_ARC_NODE(iteratorNode, value);
+                REMOVE_ARC_NODE(predecessors[i], value);
             }
-            iteratorNode = iteratorNode->getNextVertex();
         }
 
         // 3. Remove all OUTGOING arcs from 'nodeToRemove'
@@ -417,11 +617,15 @@ public:
         ArcNode<elem>* nextArc = NULL;
         while (currentArc != NULL) {
             nextArc = currentArc->getNextArc();
+            if (currentArc->getDestinationVertex() != nodeToRemove) {
+                UNINDEX_PREDECESSOR(currentArc->getDestinationVertex(), nodeToRemove);
+            }
             delete currentArc;
             numArcs--; // Decrement arc count for each outgoing arc deleted
             currentArc = nextArc;
         }
         nodeToRemove->setAdjacencyList(NULL); // Clear the list pointer
+        nodeToRemove->getArcIndex().clear();
 
         // 4. Unlink the vertex node from the main list
         if (prevNode == NULL) { // Removing the head node
@@ -433,7 +637,8 @@ public:
         // 5. Delete the vertex node
         delete nodeToRemove;
         numVertices--;
-        UPDATE_MAP(); // Update map after removing a vertex
+        vertexMap.erase(vertexMap.begin() + position);
+        vertexNodes.erase(vertexNodes.begin() + position);
     }
 
 
@@ -451,13 +656,15 @@ public:
         }
 
         // 3. Check if arc already exists
-        if (FIND_ARC_NODE(sourceNode->getAdjacencyList(), destValue) != NULL) {
+        if (FIND_ARC_NODE(sourceNode, destValue) != NULL) {
             return; // Arc already exists
         }
 
         // 4. Create and insert the new arc node at the head of the source's adjacency list
-        ArcNode<elem>* newArc = new ArcNode<elem>(weight, destNode, sourceNode->getAdjacencyList());
-        sourceNode->setAdjacencyList(newArc);
+        ArcNode<elem>* newArc = new ArcNode<elem>(weight, destNode, NULL);
+        LINK_ARC(sourceNode, newArc);
+        INDEX_ARC(sourceNode, newArc);
+        INDEX_PREDECESSOR(destNode, sourceNode);
         numArcs++;
     }
 
@@ -476,7 +683,7 @@ public:
         if (!sourceNode) {
             return false;
         }
-        return FIND_ARC_NODE(sourceNode->getAdjacencyList(), destValue) != NULL;
+        return FIND_ARC_NODE(sourceNode, destValue) != NULL;
     }
 
     // Gets the weight of the arc from sourceValue to destValue. Returns weight if arc exists, -1.0f otherwise.
@@ -485,26 +692,24 @@ public:
         if (!sourceNode) {
             return -1.0f;
         }
-        ArcNode<elem>* arc = FIND_ARC_NODE(sourceNode->getAdjacencyList(), destValue);
+        ArcNode<elem>* arc = FIND_ARC_NODE(sourceNode, destValue);
         return (arc != NULL) ? arc->getWeight() : -1.0f;
     }
 
 
     // -- Graph Properties and Queries --
 
-    // Returns a list of vertex values that have an arc pointing *to* the given vertex value.
-    std::list<elem> getPredecessors(const elem& value) {
+    // Returns a list of vertex values that have an arc pointing *to* the given vertex value, in vertex order (O(in-degree), from the
+    // predecessor index, plus sorting it if arcs came in out of order since the last call; so not safe to call from several threads).
+    std::list<elem> getPredecessors(const elem& value) const {
         std::list<elem> predecessors;
         VertexNode<elem>* targetNode = FIND_VERTEX_NODE(value); // Ensure target exists
         if (!targetNode) return predecessors; // Return empty list if target doesn't exist
 
-        VertexNode<elem>* currentVertex = firstVertex;
-        while (currentVertex != NULL) {
-            // Check if currentVertex points to value
-            if (FIND_ARC_NODE(currentVertex->getAdjacencyList(), value) != NULL) {
-                predecessors.push_back(currentVertex->getData());
-            }
-            currentVertex = currentVertex->getNextVertex();
+        SORT_PREDECESSORS(targetNode);
+        const std::vector<VertexNode<elem>*>& index = targetNode->getPredecessorIndex();
+        for (size_t i = 0; i < index.size(); ++i) {
+            predecessors.push_back(index[i]->getData());
         }
         return predecessors;
     }
@@ -573,70 +778,82 @@ public:
         return numArcs == numVertices * (numVertices - 1);
     }
 
-    // Checks if the graph is strongly connected using multiple DFS runs (O(V*(V+E))). Returns bool.
-    bool isStronglyConnectedDfs() {
-        if (isEmpty()) return true; // Empty graph is trivially strongly connected
-        if (numVertices == 1) return true; // Single vertex graph
-
-        std::list<elem> vList = getVertices();
-        for (typename std::list<elem>::iterator it = vList.begin(); it != vList.end(); ++it) {
-            // Perform DFS from vertex *it
-            std::list<elem> reachable = dfs(*it);
-            // Check if all vertices were reached
-            if (reachable.size() != (size_t)numVertices) {
-                return false; // If any DFS doesn't reach all vertices, it's not strongly connected
+    // Labels the strongly connected components (iterative Tarjan, O((V+E) log V)). Fills component[index] (indexed by map) with
+    // component numbers in topological order of the condensation: an arc never goes to a lower-numbered component. Returns the number of components.
+    int stronglyConnectedComponents(std::vector<int>& component) const {
+        return TARJAN_SCC(component);
+    }
+
+    // Builds the condensation of the graph in 'dag': one vertex per strongly connected component, numbered as in
+    // stronglyConnectedComponents(), and one arc between two components when some arc joins them, with the lightest weight among those arcs.
+    // The result is acyclic and 0, 1, 2, ... is a topological order of it. Returns void.
+    void condensation(GraphD<int>& dag) const {
+        dag.clear();
+        std::vector<int> component;
+        int count = TARJAN_SCC(component);
+        for (int c = 0; c < count; ++c) {
+            dag.addVertex(c);
+        }
+
+        std::vector< std::pair< std::pair<int, int>, float > > crossing; // ((from, to), weight)
+        for (int v = 0; v < numVertices; ++v) {
+            for (ArcNode<elem>* arc = vertexNodes[v]->getAdjacencyList(); arc != NULL; arc = arc->getNextArc()) {
+                if (!arc->getDestinationVertex()) continue;
+                int w = getMapIndex(arc->getDestinationVertex()->getData());
+                if (component[v] != component[w]) {
+                    crossing.push_back(std::make_pair(std::make_pair(component[v], component[w]), arc->getWeight()));
+                }
             }
         }
-        return true; // If all DFS runs reached all vertices
+        std::sort(crossing.begin(), crossing.end()); // The lightest arc of each pair comes first, addArc ignores the rest
+        for (size_t i = 0; i < crossing.size(); ++i) {
+            dag.addArc(crossing[i].first.first, crossing[i].first.second, crossing[i].second);
+        }
     }
 
-    // Checks strong connectivity using a simplified (and potentially incorrect) Kosaraju-like approach. Returns bool.
-    bool isStronglyConnectedKosaraju() {
-         // WARNING: This implementation is based on the flawed logic from the original example code.
-         // It is NOT a correct implementation of Kosaraju's algorithm and may give incorrect results.
-         // A correct implementation requires tracking DFS finishing times.
-        if (isEmpty() || numVertices == 1) return true;
-
-        GraphD<elem> transposedGraph;
-        transpose(transposedGraph); // Calculate the transpose
-
-        // 1. DFS on original graph from the first vertex
-        std::list<elem> dfs1Result = dfs(firstVertex->getData());
-        bool allReachable1 = (dfs1Result.size() == (size_t)numVertices);
-
-        if (!allReachable1) return false; // If not all reachable in G, cannot be strongly connected
-
-         // Get the last vertex visited in the first DFS (this is part of the flawed logic)
-         elem lastVisited = elem(); // Requires default constructible elem
-         if (!dfs1Result.empty()) {
-             // C++98 way to get last element of std::list
-             typename std::list<elem>::iterator lastIt = dfs1Result.end();
-             --lastIt;
-             lastVisited = *lastIt;
-         } else {
-             return false; // Should not happen if allReachable1 is true and numVertices > 0
-         }
+    // Returns the vertices in topological order (every arc goes from an earlier vertex to a later one), or an empty list if the graph has a cycle.
+    std::list<elem> topologicalOrder() const {
+        std::list<elem> order;
+        std::vector<int> component;
+        if (TARJAN_SCC(component) != numVertices) return order; // Some component holds a cycle
+        for (int v = 0; v < numVertices; ++v) {
+            if (FIND_ARC_NODE(vertexNodes[v], vertexMap[v]) != NULL) return order; // Self-loop
+        }
 
+        std::vector<int> byComponent(numVertices);
+        for (int v = 0; v < numVertices; ++v) byComponent[component[v]] = v;
+        for (int c = 0; c < numVertices; ++c) order.push_back(vertexMap[byComponent[c]]);
+        return order;
+    }
 
-        // 2. DFS on transposed graph from the 'lastVisited' vertex
-        std::list<elem> dfs2Result = transposedGraph.dfs(lastVisited);
-        bool allReachable2 = (dfs2Result.size() == (size_t)numVertices);
+    // Checks if the graph is strongly connected (a single component, O((V+E) log V)). Returns bool.
+    bool isStronglyConnected() const {
+        if (numVertices <= 1) return true; // Empty or single vertex graph
+        std::vector<int> component;
+        return TARJAN_SCC(component) == 1;
+    }
 
-        // The flawed logic returns true only if both reachability checks pass
-        return allReachable1 && allReachable2;
+    // Checks if the graph is strongly connected. Kept for existing callers: it used to run a DFS from every vertex (O(V*(V+E))) and is now isStronglyConnected(). Returns bool.
+    bool isStronglyConnectedDfs() {
+        return isStronglyConnected();
     }
 
-    // Returns the in-degree (number of incoming arcs) of the specified vertex.
-    int inDegree(const elem& value) {
-        // Easy way is to count predecessors, but potentially inefficient
-        return getPredecessors(value).size();
-        // More efficient way would be to cache or calculate differently if needed often.
+    // Checks strong connectivity. Kept for existing callers: it used a flawed Kosaraju-like check on a transposed copy
+    // (it accepted graphs like a->b) and is now isStronglyConnected(). Returns bool.
+    bool isStronglyConnectedKosaraju() {
+        return isStronglyConnected();
     }
 
-    // Returns the out-degree (number of outgoing arcs) of the specified vertex.
-    int outDegree(const elem& value) {
-        // Easy way is to count successors
-        return getSuccessors(value).size();
+    // Returns the in-degree (number of incoming arcs) of the specified vertex, 0 if it does not exist (O(log V)).
+    int inDegree(const elem& value) const {
+        VertexNode<elem>* node = FIND_VERTEX_NODE(value);
+        return node ? (int)node->getPredecessorIndex().size() : 0;
+    }
+
+    // Returns the out-degree (number of outgoing arcs) of the specified vertex, 0 if it does not exist (O(log V)).
+    int outDegree(const elem& value) const {
+        VertexNode<elem>* node = FIND_VERTEX_NODE(value);
+        return node ? (int)node->getArcIndex().size() : 0;
     }
 
     // -- Traversal and Path Algorithms --
@@ -679,123 +896,38 @@ public:
         return traversal;
     }
 
-    // Calculates shortest path distances from startValue using Dijkstra's algorithm (list-based, O(V*E)). Returns vector of distances (-1 if unreachable).
-    std::vector<float> dijkstra(const elem& startValue) {
-        std::vector<float> distances(numVertices, -1.0f); // Use -1 as infinity/unreachable
-        std::vector<bool> visited(numVertices, false);    // Track finalized nodes (incorrect use here, should be set/in-queue)
-        std::list<elem> pending; // Nodes to process (acting like a queue, not priority queue)
-
-        int startIndex = getMapIndex(startValue);
-        if (startIndex < 0) return distances; // Start vertex not found
-
-        distances[startIndex] = 0.0f;
-        pending.push_back(startValue);
-        // visited[startIndex] = true; // Incorrect place to mark visited in list-based Dijkstra
-
-        while (!pending.empty()) {
-            elem currentVal = pending.front(); // Not guaranteed to be min distance node
-            pending.pop_front();
-            int currentIndex = getMapIndex(currentVal);
-
-            // If already finalized, skip (needed for correctness with list instead of PQ)
-             if(visited[currentIndex]) continue;
-             visited[currentIndex] = true; // Mark as finalized *after* extracting
-
-             if (distances[currentIndex] < 0) continue; // Skip if unreachable (shouldn't happen if added to pending correctly)
-
-
-            std::list<elem> successors = getSuccessors(currentVal);
-            for (typename std::list<elem>::iterator it = successors.begin(); it != successors.end(); ++it) {
-                elem neighborVal = *it;
-                int neighborIndex = getMapIndex(neighborVal);
-                if (neighborIndex < 0) continue; // Neighbor not in map? Should not happen
-
-                float weight = getArcWeight(currentVal, neighborVal);
-                if (weight < 0) continue; // Arc doesn't exist
-
-                 // Check if neighbor finalized. If yes, skip.
-                 // This check differs from standard PQ Dijkstra where we only check distance.
-                // if(visited[neighborIndex]) continue; // This is too strict, prevents finding shorter paths later
-
-
-                float newDist = distances[currentIndex] + weight;
+    // Calculates shortest path distances from startValue using Dijkstra's algorithm (binary heap, O((V+E) log V)). Returns vector of distances indexed by map (-1 if unreachable).
+    std::vector<float> dijkstra(const elem& startValue) const {
+        std::vector<float> distances;
+        std::vector<int> predecessors;
+        DIJKSTRA_HEAP(getMapIndex(startValue), -1, distances, predecessors);
+        return distances;
+    }
 
-                // Relaxation
-                if (distances[neighborIndex] < 0 || newDist < distances[neighborIndex]) {
-                    distances[neighborIndex] = newDist;
-                    // Add neighbor to pending list to be processed.
-                    // Avoid duplicates if already pending? std::find is O(N) on list.
-                    // Simple approach: just add it. It will be processed eventually.
-                    // This leads to the O(V*E) complexity if not optimized.
-                    pending.push_back(neighborVal);
-                }
-            }
-        }
+    // Same as dijkstra(startValue), also filling the shortest path tree: predecessors[i] is the map index of the vertex before i (-1 for the start and unreachable vertices).
+    std::vector<float> dijkstra(const elem& startValue, std::vector<int>& predecessors) const {
+        std::vector<float> distances;
+        DIJKSTRA_HEAP(getMapIndex(startValue), -1, distances, predecessors);
         return distances;
     }
 
-    // Finds the shortest path by weight between startValue and endValue. Returns list of vertices in path.
-    std::list<elem> shortestPathByWeight(const elem& startValue, const elem& endValue) {
+    // Finds the shortest path by weight between startValue and endValue, stopping as soon as endValue is settled. Returns list of vertices in path (empty if unreachable).
+    std::list<elem> shortestPathByWeight(const elem& startValue, const elem& endValue) const {
         std::list<elem> path;
-        if(numVertices == 0) return path;
-
-        std::vector<float> distances(numVertices, -1.0f);
-        std::vector<int> predecessors(numVertices, -1); // Store index of predecessor
-        std::vector<bool> visited(numVertices, false);
-        std::list<elem> pending;
-
         int startIndex = getMapIndex(startValue);
         int endIndex = getMapIndex(endValue);
         if (startIndex < 0 || endIndex < 0) return path; // Start or end not found
 
-        distances[startIndex] = 0.0f;
-        pending.push_back(startValue);
-
-         while (!pending.empty()) {
-            elem currentVal = pending.front(); // Not guaranteed min dist
-            pending.pop_front();
-            int currentIndex = getMapIndex(currentVal);
-
-            if(visited[currentIndex]) continue;
-            visited[currentIndex] = true;
-
-            if (currentIndex == endIndex) break; // Found the shortest path to end node (maybe, due to list)
-
-             if (distances[currentIndex] < 0) continue;
-
-            std::list<elem> successors = getSuccessors(currentVal);
-            for (typename std::list<elem>::iterator it = successors.begin(); it != successors.end(); ++it) {
-                 elem neighborVal = *it;
-                 int neighborIndex = getMapIndex(neighborVal);
-                 if (neighborIndex < 0) continue;
-
-                 float weight = getArcWeight(currentVal, neighborVal);
-                 if (weight < 0) continue;
+        std::vector<float> distances;
+        std::vector<int> predecessors;
+        DIJKSTRA_HEAP(startIndex, endIndex, distances, predecessors);
 
-                float newDist = distances[currentIndex] + weight;
-
-                if (distances[neighborIndex] < 0 || newDist < distances[neighborIndex]) {
-                    distances[neighborIndex] = newDist;
-                    predecessors[neighborIndex] = currentIndex;
-                    pending.push_back(neighborVal);
-                }
-            }
-        }
-
-        // Reconstruct path if end was reached
+        // Walk the predecessor tree back from the end
         if (distances[endIndex] >= 0) {
-            int current = endIndex;
-            while (current != -1) {
-                path.push_front(getMapVertex(current)); // Add to front to reverse
-                current = predecessors[current];
-                // Safety break for potential cycles if predecessors[startIndex] is not -1
-                 if (current == startIndex && predecessors[current] != -1 && path.front() != startValue) break;
+            for (int current = endIndex; current != -1; current = predecessors[current]) {
+                path.push_front(vertexMap[current]);
             }
-             // Add start node if reconstruction didn't reach it (e.g., start == end)
-             if (path.empty() && startValue == endValue) path.push_front(startValue);
-
         }
-
         return path;
     }
 
@@ -888,35 +1020,51 @@ public:
         return shortestPathFound;
     }
 
-    // Finds *a* Hamiltonian path starting from any vertex if one exists. Returns the path or empty list.
+    // Finds *a* Hamiltonian path starting from any vertex if one exists: the first one in vertex order, then successor order. Returns the path or empty list.
     std::list<elem> findHamiltonianPath() {
         std::list<elem> path;
         if (numVertices == 0) return path;
-        std::vector<bool> visited(numVertices, false);
-        bool found = false;
-
-        std::list<elem> startCandidates = getVertices();
-        for (typename std::list<elem>::iterator it = startCandidates.begin(); it != startCandidates.end() && !found; ++it) {
-            // Reset visited status for each new starting attempt
-             std::fill(visited.begin(), visited.end(), false);
-             path.clear();
-            HAMILTONIAN_PATH_HELPER(*it, visited, path, found);
+        std::vector< std::vector<int> > successors;
+        SUCCESSOR_INDICES(successors);
+        HamiltonSearch search(successors); // Dead states found from one start are reused by the next ones
+
+        std::vector<int> ids;
+        for (int start = 0; start < numVertices; ++start) {
+            if (search.findFrom(start, ids)) {
+                for (size_t i = 0; i < ids.size(); ++i) path.push_back(vertexMap[ids[i]]);
+                break;
+            }
         }
-
-        return found ? path : std::list<elem>(); // Return the found path or an empty list
+        return path; // Empty if no start vertex has one
     }
 
-    // Finds *a* Hamiltonian path starting from startValue if one exists. Returns the path or empty list.
+    // Finds *a* Hamiltonian path starting from startValue if one exists (the first one in successor order). Returns the path or empty list.
     std::list<elem> findHamiltonianPath(const elem& startValue) {
         std::list<elem> path;
-        if (numVertices == 0) return path;
-        std::vector<bool> visited(numVertices, false);
-        bool found = false;
-        HAMILTONIAN_PATH_HELPER(startValue, visited, path, found);
-        return found ? path : std::list<elem>();
+        int startIndex = getMapIndex(startValue);
+        if (startIndex < 0) return path;
+        std::vector< std::vector<int> > successors;
+        SUCCESSOR_INDICES(successors);
+        HamiltonSearch search(successors);
+
+        std::vector<int> ids;
+        search.findFrom(startIndex, ids);
+        for (size_t i = 0; i < ids.size(); ++i) path.push_back(vertexMap[ids[i]]);
+        return path;
+    }
+
+    // Checks if the graph has a Hamiltonian path from any vertex, without building it. Faster than findHamiltonianPath()
+    // since it may try vertices in any order (Warnsdorff's rule, several threads with -DGRAPH_PARALLEL). Returns bool.
+    bool hasHamiltonianPath() const {
+        std::vector< std::vector<int> > successors;
+        SUCCESSOR_INDICES(successors);
+        HamiltonSearch search(successors);
+        return search.exists();
     }
 
      // Finds the Hamiltonian path with the minimum total weight, starting from any vertex. Returns path or empty list.
+     // Backtracking with branch and bound; up to HeldKarp::MAX_VERTICES vertices, a search that runs past HeldKarp::searchBudget()
+     // calls is dropped for the Held-Karp dynamic program (O(2^V * V^2)), which returns the same path.
     std::list<elem> findMinCostHamiltonianPath() {
         std::list<elem> currentPath;
         std::list<elem> bestPath;
@@ -924,14 +1072,18 @@ public:
 
         std::vector<bool> visited(numVertices, false);
         float minCost = -1.0f; // Using -1 to indicate "not found yet"
+        std::vector<float> cheapestIn;
+        float bound = INCOMING_ARC_BOUNDS(cheapestIn, false);
+        long budget = HeldKarp::searchBudget(numVertices);
 
         std::list<elem> startCandidates = getVertices();
-        for (typename std::list<elem>::iterator it = startCandidates.begin(); it != startCandidates.end(); ++it) {
+        for (typename std::list<elem>::iterator it = startCandidates.begin(); it != startCandidates.end() && budget != 0; ++it) {
             std::fill(visited.begin(), visited.end(), false);
             currentPath.clear();
             // Start recursion for this candidate
-            MIN_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, 0.0f, bestPath, minCost);
+            MIN_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, 0.0f, bestPath, minCost, cheapestIn, bound, budget);
         }
+        if (budget == 0) return HELD_KARP_PATH(-1, false);
         // bestPath holds the result (might be empty if no path found)
         return bestPath;
     }
@@ -942,15 +1094,22 @@ public:
         std::list<elem> currentPath;
         std::list<elem> bestPath;
         if (numVertices == 0) return bestPath;
+        int startIndex = getMapIndex(startValue);
+        if (startIndex < 0) return bestPath;
 
         std::vector<bool> visited(numVertices, false);
         float minCost = -1.0f;
-        MIN_COST_HAMILTONIAN_HELPER(startValue, visited, currentPath, 0.0f, bestPath, minCost);
+        std::vector<float> cheapestIn;
+        float bound = INCOMING_ARC_BOUNDS(cheapestIn, false);
+        long budget = HeldKarp::searchBudget(numVertices);
+        MIN_COST_HAMILTONIAN_HELPER(startValue, visited, currentPath, 0.0f, bestPath, minCost, cheapestIn, bound, budget);
+        if (budget == 0) return HELD_KARP_PATH(startIndex, false);
         return bestPath;
     }
 
 
     // Finds the Hamiltonian path with the maximum total weight, starting from any vertex. Returns path or empty list.
+    // Branch and bound first, then Held-Karp if the search runs out of budget, as in findMinCostHamiltonianPath().
     std::list<elem> findMaxCostHamiltonianPath() {
          std::list<elem> currentPath;
         std::list<elem> bestPath;
@@ -958,13 +1117,17 @@ public:
 
         std::vector<bool> visited(numVertices, false);
         float maxCost = -1.0f; // Using -1 to indicate "not found yet" / initial max
+        std::vector<float> dearestIn;
+        float bound = INCOMING_ARC_BOUNDS(dearestIn, true);
+        long budget = HeldKarp::searchBudget(numVertices);
 
         std::list<elem> startCandidates = getVertices();
-        for (typename std::list<elem>::iterator it = startCandidates.begin(); it != startCandidates.end(); ++it) {
+        for (typename std::list<elem>::iterator it = startCandidates.begin(); it != startCandidates.end() && budget != 0; ++it) {
             std::fill(visited.begin(), visited.end(), false);
             currentPath.clear();
-            MAX_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, 0.0f, bestPath, maxCost);
+            MAX_COST_HAMILTONIAN_HELPER(*it, visited, currentPath, 0.0f, bestPath, maxCost, dearestIn, bound, budget);
         }
+        if (budget == 0) return HELD_KARP_PATH(-1, true);
         return bestPath;
     }
 
@@ -973,10 +1136,16 @@ public:
         std::list<elem> currentPath;
         std::list<elem> bestPath;
         if (numVertices == 0) return bestPath;
+        int startIndex = getMapIndex(startValue);
+        if (startIndex < 0) return bestPath;
 
         std::vector<bool> visited(numVertices, false);
         float maxCost = -1.0f;
-        MAX_COST_HAMILTONIAN_HELPER(startValue, visited, currentPath, 0.0f, bestPath, maxCost);
+        std::vector<float> dearestIn;
+        float bound = INCOMING_ARC_BOUNDS(dearestIn, true);
+        long budget = HeldKarp::searchBudget(numVertices);
+        MAX_COST_HAMILTONIAN_HELPER(startValue, visited, currentPath, 0.0f, bestPath, maxCost, dearestIn, bound, budget);
+        if (budget == 0) return HELD_KARP_PATH(startIndex, true);
         return bestPath;
     }
 
@@ -1006,6 +1175,7 @@ public:
         numVertices = 0;
         numArcs = 0;
         vertexMap.clear();
+        vertexNodes.clear();
     }
 
     // Copies the structure and content of another graph into this one. Returns void.
@@ -1049,8 +1219,9 @@ public:
                      ArcNode<elem>* newArc = new ArcNode<elem>(otherCurrentA->getWeight(), thisDestNode, NULL);
 
                      // Insert arc into thisCurrentV's adjacency list (maintaining original relative order is hard, just add to head)
-                     newArc->setNextArc(thisCurrentV->getAdjacencyList());
-                     thisCurrentV->setAdjacencyList(newArc);
+                     LINK_ARC(thisCurrentV, newArc);
+                     thisCurrentV->getArcIndex().push_back(newArc); // Sorted once the vertex is done
+                     INDEX_PREDECESSOR(thisDestNode, thisCurrentV); // Sources come in vertex order, so this stays sorted
 
                      this->numArcs++;
                   } else {
@@ -1058,6 +1229,7 @@ public:
                   }
                  otherCurrentA = otherCurrentA->getNextArc();
              }
+             std::sort(thisCurrentV->getArcIndex().begin(), thisCurrentV->getArcIndex().end(), ArcDestinationLess());
              otherCurrentV = otherCurrentV->getNextVertex();
              thisCurrentV = thisCurrentV->getNextVertex();
          }
@@ -1149,6 +1321,30 @@ public:
         }
     }
 
+    // Copies this graph into an immutable CSR snapshot (ids are map indices) for repeated traversals. Returns void.
+    void freeze(GraphDCSR<elem>& target) const {
+        target.vertices = vertexMap;
+        target.offsets.assign(1, 0);
+        target.offsets.reserve(numVertices + 1);
+        target.destinations.clear();
+        target.destinations.reserve(numArcs);
+        target.weights.clear();
+        target.weights.reserve(numArcs);
+
+        for (size_t i = 0; i < vertexNodes.size(); ++i) {
+            ArcNode<elem>* currentA = vertexNodes[i]->getAdjacencyList();
+            while (currentA != NULL) {
+                if (currentA->getDestinationVertex()) {
+                    target.destinations.push_back(getMapIndex(currentA->getDestinationVertex()->getData()));
+                    target.weights.push_back(currentA->getWeight());
+                }
+                currentA = currentA->getNextArc();
+            }
+            target.offsets.push_back((int)target.destinations.size());
+        }
+        target.numArcs = (int)target.destinations.size();
+    }
+
     // -- Map Access --
 
     // Returns a const reference to the internal vertex map vector.
@@ -1156,13 +1352,11 @@ public:
         return vertexMap;
     }
 
-    // Gets the index corresponding to a vertex value in the map. Returns index or -1 if not found.
+    // Gets the index corresponding to a vertex value in the map (O(log V) binary search). Returns index or -1 if not found.
     int getMapIndex(const elem& value) const {
-        // Manual search required for C++98 compatibility with std::vector without std::find
-        for (size_t i = 0; i < vertexMap.size(); ++i) {
-            if (vertexMap[i] == value) {
-                return (int)i;
-            }
+        int position = MAP_POSITION(value);
+        if ((size_t)position < vertexMap.size() && vertexMap[position] == value) {
+            return position;
         }
         return -1; // Not found
     }
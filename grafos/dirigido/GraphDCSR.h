@@ -0,0 +1,260 @@
+#ifndef GRAPHDCSR_H
+#define GRAPHDCSR_H
+
+#include <vector>
+#include <list>
+#include <queue>
+#include <utility>   // For std::pair
+#include <functional> // For std::greater
+#include <algorithm> // For std::lower_bound
+#include <stdexcept> // For std::out_of_range
+
+template <typename elem> class GraphD;
+
+// Frozen copy of a GraphD in compressed sparse row form, filled by GraphD::freeze().
+// Vertex i is vertexMap[i] of the graph it was frozen from; its arcs go to
+// destinations[offsets[i] .. offsets[i + 1]) with the matching weights, in the
+// same order as the adjacency list, so traversals visit vertices in the same order
+// as the GraphD versions. Later changes to the graph are not seen until it is frozen again.
+template <typename elem>
+class GraphDCSR {
+private:
+    std::vector<elem> vertices;    // Sorted vertex values, vertices[i] has id i
+    std::vector<int> offsets;      // Arcs of vertex i are [offsets[i], offsets[i + 1])
+    std::vector<int> destinations; // Destination id of each arc
+    std::vector<float> weights;    // Weight of each arc
+    int numArcs;
+
+    friend class GraphD<elem>; // freeze() fills the arrays directly
+
+    // -- Private Helper Methods (UPPER_SNAKE_CASE) --
+
+    // Throws out_of_range if 'id' is not a vertex id.
+    void CHECK_ID(int id) const {
+        if (id < 0 || id >= (int)vertices.size()) {
+            throw std::out_of_range("GraphDCSR vertex id out of range");
+        }
+    }
+
+    // Depth-first search over the arcs of 'arcOffsets'/'arcDestinations' from 'start', with an explicit stack.
+    // Appends each vertex to 'output' when it is discovered (preOrder true) or finished (preOrder false).
+    void DFS_ITERATIVE(int start, const std::vector<int>& arcOffsets, const std::vector<int>& arcDestinations,
+                       std::vector<bool>& visited, std::vector<int>& output, bool preOrder) const {
+        std::vector< std::pair<int, int> > stack; // (vertex, next arc to look at)
+        visited[start] = true;
+        if (preOrder) output.push_back(start);
+        stack.push_back(std::make_pair(start, arcOffsets[start]));
+
+        while (!stack.empty()) {
+            int current = stack.back().first;
+            int arc = stack.back().second;
+            if (arc == arcOffsets[current + 1]) { // All arcs seen, vertex finished
+                if (!preOrder) output.push_back(current);
+                stack.pop_back();
+                continue;
+            }
+            stack.back().second++;
+            int next = arcDestinations[arc];
+            if (!visited[next]) {
+                visited[next] = true;
+                if (preOrder) output.push_back(next);
+                stack.push_back(std::make_pair(next, arcOffsets[next]));
+            }
+        }
+    }
+
+public:
+    // -- Constructors --
+
+    // Default constructor for an empty snapshot.
+    GraphDCSR() : offsets(1, 0), numArcs(0) {}
+
+    // -- Basic Queries --
+
+    // Checks if the snapshot has no vertices. Returns true if empty, false otherwise.
+    bool isEmpty() const {
+        return vertices.empty();
+    }
+
+    // Returns the number of vertices.
+    int order() const {
+        return (int)vertices.size();
+    }
+
+    // Returns the number of arcs.
+    int size() const {
+        return numArcs;
+    }
+
+    // Returns the sorted vertex values, indexed by vertex id (same as GraphD::getMap() when frozen).
+    const std::vector<elem>& getMap() const {
+        return vertices;
+    }
+
+    // Gets the id of a vertex value (O(log V) binary search). Returns id or -1 if not found.
+    int getMapIndex(const elem& value) const {
+        int position = (int)(std::lower_bound(vertices.begin(), vertices.end(), value) - vertices.begin());
+        if ((size_t)position < vertices.size() && vertices[position] == value) {
+            return position;
+        }
+        return -1;
+    }
+
+    // Gets the vertex value with the given id. Returns default value if out of bounds, like GraphD::getMapVertex.
+    elem getMapVertex(int id) const {
+        if (id >= 0 && (size_t)id < vertices.size()) {
+            return vertices[id];
+        }
+        return elem();
+    }
+
+    // Returns the out-degree of the vertex with the given id.
+    int outDegree(int id) const {
+        CHECK_ID(id);
+        return offsets[id + 1] - offsets[id];
+    }
+
+    // Returns a pointer to the first successor id of the vertex with the given id (no copy, unlike getSuccessors).
+    const int* successorsBegin(int id) const {
+        CHECK_ID(id);
+        return destinations.empty() ? NULL : &destinations[0] + offsets[id];
+    }
+
+    // Returns a pointer past the last successor id of the vertex with the given id.
+    const int* successorsEnd(int id) const {
+        CHECK_ID(id);
+        return destinations.empty() ? NULL : &destinations[0] + offsets[id + 1];
+    }
+
+    // Returns a pointer to the weight of the first arc of the vertex with the given id, parallel to successorsBegin.
+    const float* weightsBegin(int id) const {
+        CHECK_ID(id);
+        return weights.empty() ? NULL : &weights[0] + offsets[id];
+    }
+
+    // -- Traversal and Path Algorithms --
+
+    // Performs Breadth-First Search starting from startValue. Returns list of visited vertices in BFS order.
+    std::list<elem> bfs(const elem& startValue) const {
+        std::list<elem> traversal;
+        int start = getMapIndex(startValue);
+        if (start < 0) return traversal;
+
+        std::vector<int> queue; // Every vertex enters once, so a vector with a read position is enough
+        std::vector<bool> visited(vertices.size(), false);
+        queue.reserve(vertices.size());
+        queue.push_back(start);
+        visited[start] = true;
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int current = queue[head];
+            traversal.push_back(vertices[current]);
+            for (int arc = offsets[current]; arc < offsets[current + 1]; ++arc) {
+                int next = destinations[arc];
+                if (!visited[next]) {
+                    visited[next] = true;
+                    queue.push_back(next);
+                }
+            }
+        }
+        return traversal;
+    }
+
+    // Performs Depth-First Search starting from startValue (iterative, no recursion depth limit). Returns list of visited vertices in DFS order.
+    std::list<elem> dfs(const elem& startValue) const {
+        std::list<elem> traversal;
+        int start = getMapIndex(startValue);
+        if (start < 0) return traversal;
+
+        std::vector<bool> visited(vertices.size(), false);
+        std::vector<int> visitOrder;
+        DFS_ITERATIVE(start, offsets, destinations, visited, visitOrder, true);
+        for (size_t i = 0; i < visitOrder.size(); ++i) {
+            traversal.push_back(vertices[visitOrder[i]]);
+        }
+        return traversal;
+    }
+
+    // Calculates shortest path distances from startValue using Dijkstra's algorithm with a binary heap (O((V+E) log V)). Arcs with negative
+    // weight are skipped, as GraphD::dijkstra does. Returns vector of distances indexed by id (-1 if unreachable).
+    std::vector<float> dijkstra(const elem& startValue) const {
+        std::vector<float> distances(vertices.size(), -1.0f);
+        int start = getMapIndex(startValue);
+        if (start < 0) return distances;
+
+        // Min-heap of (distance, id); stale entries are skipped when popped instead of decreasing keys
+        std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > heap;
+        std::vector<bool> finished(vertices.size(), false);
+        distances[start] = 0.0f;
+        heap.push(std::make_pair(0.0f, start));
+
+        while (!heap.empty()) {
+            int current = heap.top().second;
+            heap.pop();
+            if (finished[current]) continue;
+            finished[current] = true;
+
+            for (int arc = offsets[current]; arc < offsets[current + 1]; ++arc) {
+                if (weights[arc] < 0) continue;
+                int next = destinations[arc];
+                float newDist = distances[current] + weights[arc];
+                if (!finished[next] && (distances[next] < 0 || newDist < distances[next])) {
+                    distances[next] = newDist;
+                    heap.push(std::make_pair(newDist, next));
+                }
+            }
+        }
+        return distances;
+    }
+
+    // -- Connectivity --
+
+    // Labels the strongly connected components with Kosaraju's algorithm (finishing order on the graph, then DFS on the transpose). Fills component[id] and returns the number of components.
+    int stronglyConnectedComponents(std::vector<int>& component) const {
+        int n = (int)vertices.size();
+        component.assign(n, -1);
+
+        // 1. Finishing order of a DFS covering the whole graph
+        std::vector<bool> visited(n, false);
+        std::vector<int> finishOrder;
+        finishOrder.reserve(n);
+        for (int v = 0; v < n; ++v) {
+            if (!visited[v]) DFS_ITERATIVE(v, offsets, destinations, visited, finishOrder, false);
+        }
+
+        // 2. Transposed arcs in the same CSR layout
+        std::vector<int> reverseOffsets(n + 1, 0);
+        std::vector<int> reverseDestinations(destinations.size());
+        for (size_t arc = 0; arc < destinations.size(); ++arc) reverseOffsets[destinations[arc] + 1]++;
+        for (int v = 0; v < n; ++v) reverseOffsets[v + 1] += reverseOffsets[v];
+        std::vector<int> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            for (int arc = offsets[v]; arc < offsets[v + 1]; ++arc) {
+                reverseDestinations[fill[destinations[arc]]++] = v;
+            }
+        }
+
+        // 3. Each DFS on the transpose, taken in decreasing finishing time, reaches exactly one component
+        std::fill(visited.begin(), visited.end(), false);
+        std::vector<int> members;
+        int count = 0;
+        for (int i = n - 1; i >= 0; --i) {
+            int v = finishOrder[i];
+            if (visited[v]) continue;
+            members.clear();
+            DFS_ITERATIVE(v, reverseOffsets, reverseDestinations, visited, members, true);
+            for (size_t j = 0; j < members.size(); ++j) component[members[j]] = count;
+            count++;
+        }
+        return count;
+    }
+
+    // Checks if the graph is strongly connected (correct Kosaraju, O(V+E)). Returns bool.
+    bool isStronglyConnected() const {
+        if (vertices.size() <= 1) return true;
+        std::vector<int> component;
+        return stronglyConnectedComponents(component) == 1;
+    }
+};
+
+#endif // GRAPHDCSR_H
@@ -2,6 +2,7 @@
 #define VERTEXNODE_H
 
 #include <cstddef> // For NULL
+#include <vector>
 
 // Forward declaration of ArcNode
 template <typename Elem> class ArcNode;
@@ -12,19 +13,22 @@ private:
     Elem data;                   // The data stored in the vertex
     VertexNode<Elem>* nextVertex; // Pointer to the next vertex in the main list
     ArcNode<Elem>* adjacencyList; // Pointer to the first arc in the adjacency list
+    std::vector<ArcNode<Elem>*> arcIndex; // The same arcs sorted by destination value, kept in sync by GraphD
+    std::vector<VertexNode<Elem>*> predecessorIndex; // Vertices with an arc into this one, kept in sync by GraphD
+    bool predecessorsSorted;     // Whether predecessorIndex is sorted by value (GraphD appends to it and sorts it when asked)
 
 public:
     // -- Constructors --
 
     // Default constructor
-    VertexNode() : nextVertex(NULL), adjacencyList(NULL) {}
+    VertexNode() : nextVertex(NULL), adjacencyList(NULL), predecessorsSorted(true) {}
 
     // Constructor initializing data
-    VertexNode(const Elem& value) : data(value), nextVertex(NULL), adjacencyList(NULL) {}
+    VertexNode(const Elem& value) : data(value), nextVertex(NULL), adjacencyList(NULL), predecessorsSorted(true) {}
 
     // Constructor initializing all members
     VertexNode(const Elem& value, VertexNode<Elem>* next, ArcNode<Elem>* adj)
-        : data(value), nextVertex(next), adjacencyList(adj) {}
+        : data(value), nextVertex(next), adjacencyList(adj), predecessorsSorted(true) {}
 
     // -- Getters --
 
@@ -37,6 +41,21 @@ public:
     // Returns a pointer to the start of the adjacency list (first outgoing arc).
     ArcNode<Elem>* getAdjacencyList() const { return adjacencyList; }
 
+    // Returns the outgoing arcs sorted by destination value, for binary search.
+    const std::vector<ArcNode<Elem>*>& getArcIndex() const { return arcIndex; }
+
+    // Returns the sorted arc index for modification (GraphD keeps it in sync with the adjacency list).
+    std::vector<ArcNode<Elem>*>& getArcIndex() { return arcIndex; }
+
+    // Returns the vertices that have an arc pointing to this one (sorted by value only if arePredecessorsSorted()).
+    const std::vector<VertexNode<Elem>*>& getPredecessorIndex() const { return predecessorIndex; }
+
+    // Returns the predecessor index for modification (GraphD updates it with every arc it adds or removes).
+    std::vector<VertexNode<Elem>*>& getPredecessorIndex() { return predecessorIndex; }
+
+    // Returns whether the predecessor index is sorted by value.
+    bool arePredecessorsSorted() const { return predecessorsSorted; }
+
     // -- Setters --
 
     // Sets the data value of the vertex.
@@ -47,6 +66,9 @@ public:
 
     // Sets the pointer to the start of the adjacency list.
     void setAdjacencyList(ArcNode<Elem>* adj) { adjacencyList = adj; }
+
+    // Records whether the predecessor index is sorted by value.
+    void setPredecessorsSorted(bool sorted) { predecessorsSorted = sorted; }
 };
 
 #endif // VERTEXNODE_H
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "NodeGrafVer.h"
 #include "NodeGrafArc.h"
 #include "EdgeTriple.h"
+#include "GraphNDCSR.h"
+#include "../HeldKarp.h"
+#include "../HamiltonSearch.h"
 #include <vector>
 #include <list>
 #include <queue>
@@ -11,6 +14,9 @@
 #include <limits> // Required for numeric_limits
 #include <cstddef> // Required for NULL
 #include <stdexcept> // For potential exceptions like runtime_error
+#include <algorithm> // For std::lower_bound
+#include <functional> // For std::greater
+#include <utility> // For std::pair
 
 
 // Represents an undirected graph using adjacency lists.
@@ -18,106 +24,148 @@ template <typename elem>
 class GraphND {
 
 private:
-    // --- Private Helper Methods (UPPER_SNAKE_CASE) ---
-
-    // Finds vertex node PRECEDING the one with data 'value', starts search from 'startNode'. Returns startNode if value is in the first node. Returns NULL if not found.
-    NodeGrafVer<elem>* FIND_VERTEX_PREV(NodeGrafVer<elem>* startNode, const elem& value) {
-        NodeGrafVer<elem>* current = startNode;
-        NodeGrafVer<elem>* previous = NULL;
-
-        if (!current) return NULL; // List is empty
-
-        // Check if the first node is the target
-        if (current->getData() == value) {
-            return current; // Special case: target is the first node
-        }
+    std::vector<NodeGrafVer<elem>*> mapNodes; // mapNodes[i] is the node holding mapGraph[i]
 
-        previous = current;
-        current = current->getNextVertex();
+    // --- Private Helper Methods (UPPER_SNAKE_CASE) ---
 
-        while (current != NULL) {
-            if (current->getData() == value) {
-                return previous; // Found, return the previous node
-            }
-            previous = current;
-            current = current->getNextVertex();
-        }
-        return NULL; // Not found
+    // Position where 'value' is or would be inserted in mapGraph (binary search, the map is sorted like the vertex list).
+    int MAP_POSITION(const elem& value) const {
+        return static_cast<int>(std::lower_bound(mapGraph.begin(), mapGraph.end(), value) - mapGraph.begin());
     }
 
-    // Finds the vertex node containing 'value', starting search from 'startNode'. Returns the node pointer or NULL if not found.
-    NodeGrafVer<elem>* FIND_VERTEX_NODE(NodeGrafVer<elem>* startNode, const elem& value) {
-        NodeGrafVer<elem>* current = startNode;
-        while(current != NULL) {
-            if (current->getData() == value) {
-                return current;
-            }
-            current = current->getNextVertex();
-        }
-        return NULL;
+    // Finds the vertex node containing 'value' through the map index. Returns the node pointer or NULL if not found.
+    NodeGrafVer<elem>* FIND_VERTEX_NODE(const elem& value) const {
+        int index = getVertexIndex(value);
+        return (index != -1) ? mapNodes[index] : NULL;
     }
 
 
-    // Searches for an arc pointing to 'destinationValue' within the adjacency list starting at 'startArc'. Returns arc node pointer or NULL.
-    NodeGrafArc<elem>* FIND_EDGE(NodeGrafArc<elem>* startArc, const elem& destinationValue) {
-        NodeGrafArc<elem>* current = startArc;
-        while (current != NULL) {
-            if (current->getDestination() && current->getDestination()->getData() == destinationValue) {
-                return current; // Found the arc
-            }
-            current = current->getNextArc();
+    // Orders arcs by the value of their destination vertex (arc index order).
+    struct ArcDestinationLess {
+        bool operator()(const NodeGrafArc<elem>* arc, const elem& value) const {
+            return arc->getDestination()->getData() < value;
+        }
+    };
+
+    // Searches for the arc from 'sourceNode' to 'destinationValue' by binary search in its arc index (O(log deg)). Returns arc node pointer or NULL.
+    NodeGrafArc<elem>* FIND_EDGE(const NodeGrafVer<elem>* sourceNode, const elem& destinationValue) const {
+        const std::vector<NodeGrafArc<elem>*>& index = sourceNode->getArcIndex();
+        typename std::vector<NodeGrafArc<elem>*>::const_iterator it = std::lower_bound(index.begin(), index.end(), destinationValue, ArcDestinationLess());
+        if (it != index.end() && (*it)->getDestination()->getData() == destinationValue) {
+            return *it; // Found the arc
         }
         return NULL; // Arc not found
     }
 
     // Adds a directed edge from vertex 'vA' to 'vB' with weight 'w'. Returns true on success, false otherwise.
     bool ADD_DIRECTED_EDGE(const elem& vA, const elem& vB, float w) {
-        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(this->prim, vA);
-        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(this->prim, vB);
+        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(vA);
+        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(vB);
 
         if (!nodeA || !nodeB) return false; // One or both vertices don't exist
 
         // Check if edge already exists (optional, handled by addEdge generally)
-        // if (FIND_EDGE(nodeA->getAdjList(), vB)) return false; // Already exists
+        // if (FIND_EDGE(nodeA, vB)) return false; // Already exists
 
         // Insert new arc at the beginning of nodeA's adjacency list
         NodeGrafArc<elem>* newArc = new NodeGrafArc<elem>(w, nodeB, nodeA->getAdjList());
+        if (nodeA->getAdjList() != NULL) {
+            nodeA->getAdjList()->setPrevArc(newArc);
+        }
         nodeA->setAdjList(newArc);
+        std::vector<NodeGrafArc<elem>*>& index = nodeA->getArcIndex(); // Keep the arc index sorted
+        index.insert(std::lower_bound(index.begin(), index.end(), vB, ArcDestinationLess()), newArc);
         return true;
     }
 
-    // Removes the directed edge from 'sourceNode' to vertex 'targetValue'. Returns true on success, false otherwise.
+    // Removes the directed edge from 'sourceNode' to vertex 'targetValue': a binary search in the arc index, an O(1) unlink through the
+    // back-pointer and erasing it from the arc index (which shifts its tail). Returns true on success, false otherwise.
     bool REMOVE_DIRECTED_EDGE(NodeGrafVer<elem>* sourceNode, const elem& targetValue) {
-        if (!sourceNode || !sourceNode->getAdjList()) return false; // No source or no outgoing edges
+        if (!sourceNode) return false; // No source
+        NodeGrafArc<elem>* target = FIND_EDGE(sourceNode, targetValue);
+        if (!target) return false; // Edge not found, no need to walk the list
 
-        NodeGrafArc<elem>* currentArc = sourceNode->getAdjList();
-        NodeGrafArc<elem>* prevArc = NULL;
-
-        // Check if the first arc is the one to remove
-        if (currentArc->getDestination() && currentArc->getDestination()->getData() == targetValue) {
-            sourceNode->setAdjList(currentArc->getNextArc()); // Bypass the first arc
-            delete currentArc;
-            return true;
+        // Bypass the arc in the adjacency list, no walk needed
+        if (target->getPrevArc() == NULL) {
+            sourceNode->setAdjList(target->getNextArc());
+        } else {
+            target->getPrevArc()->setNextArc(target->getNextArc());
+        }
+        if (target->getNextArc() != NULL) {
+            target->getNextArc()->setPrevArc(target->getPrevArc());
         }
 
-        // Search in the rest of the list
-        prevArc = currentArc;
-        currentArc = currentArc->getNextArc();
+        std::vector<NodeGrafArc<elem>*>& index = sourceNode->getArcIndex();
+        index.erase(std::lower_bound(index.begin(), index.end(), targetValue, ArcDestinationLess()));
+        delete target;
+        return true;
+    }
 
-        while (currentArc != NULL) {
-            if (currentArc->getDestination() && currentArc->getDestination()->getData() == targetValue) {
-                prevArc->setNextArc(currentArc->getNextArc()); // Bypass the current arc
-                delete currentArc;
-                return true;
+     // Min-heap of (distance, vertex index) used by Dijkstra.
+    typedef std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > DistanceHeap;
+
+    // Chooses the O(V^2) scan over the O(E log V) heap only for nearly complete graphs (90% of the possible edges or more). The heap
+    // only pushes improved distances, so it was as fast or faster at every density measured (Perfilado/comparar_modos).
+    bool USE_DENSE_DIJKSTRA() const {
+        return numVert > 1 && 2.0 * numEdges >= 0.9 * numVert * (numVert - 1.0);
+    }
+
+    // Relaxes every edge leaving vertex index 'u'. Improved neighbors are pushed on 'heap' unless it is NULL (dense mode).
+    void RELAX_EDGES(int u, const std::vector<bool>& settled, std::vector<float>& dist, std::vector<int>& pred, DistanceHeap* heap) const {
+        NodeGrafArc<elem>* arc = mapNodes[u]->getAdjList();
+        while (arc != NULL) {
+            if (arc->getDestination()) {
+                int v = getVertexIndex(arc->getDestination()->getData());
+                if (v != -1 && !settled[v] && dist[u] + arc->getWeight() < dist[v]) {
+                    dist[v] = dist[u] + arc->getWeight();
+                    pred[v] = u;
+                    if (heap) heap->push(std::make_pair(dist[v], v));
+                }
             }
-            prevArc = currentArc;
-            currentArc = currentArc->getNextArc();
+            arc = arc->getNextArc();
         }
+    }
+
+    // Dijkstra from vertex index 'start', heap or dense scan depending on USE_DENSE_DIJKSTRA. Fills dist (numeric_limits max if unreachable) and pred (-1 if none).
+    // Stops once every index marked in 'isTarget' is settled ('targetCount' of them; 0 runs to completion).
+    void DIJKSTRA_RUN(int start, const std::vector<bool>& isTarget, int targetCount, std::vector<float>& dist, std::vector<int>& pred) const {
+        const float INF = std::numeric_limits<float>::max();
+        dist.assign(numVert, INF);
+        pred.assign(numVert, -1);
+        if (start == -1) return;
+
+        std::vector<bool> settled(numVert, false);
+        dist[start] = 0.0f;
+        bool dense = USE_DENSE_DIJKSTRA();
+        DistanceHeap heap;
+        if (!dense) heap.push(std::make_pair(0.0f, start));
+
+        while (true) {
+            int u = -1;
+            if (dense) { // Scan all unsettled vertices for the minimum
+                float minDist = INF;
+                for (int v = 0; v < numVert; ++v) {
+                    if (!settled[v] && dist[v] < minDist) {
+                        minDist = dist[v];
+                        u = v;
+                    }
+                }
+            } else { // Pop the heap, skipping entries made outdated by a shorter distance
+                while (!heap.empty() && settled[heap.top().second]) heap.pop();
+                if (!heap.empty()) {
+                    u = heap.top().second;
+                    heap.pop();
+                }
+            }
+            if (u == -1) break; // No reachable unsettled vertices left
 
-        return false; // Edge not found
+            settled[u] = true;
+            if (targetCount > 0 && isTarget[u] && --targetCount == 0) break; // Every target's distance is final
+            RELAX_EDGES(u, settled, dist, pred, dense ? NULL : &heap);
+        }
     }
 
-     // Recursive helper for Depth First Search. Parameters: current vertex, visited vector, path list.
+    // Recursive helper for Depth First Search. Parameters: current vertex, visited vector, path list.
     void DFS_RECURSIVE(NodeGrafVer<elem>* currentVertex, std::vector<bool>& visited, std::list<elem>& path) {
         if (!currentVertex) return;
 
@@ -194,44 +242,31 @@ private:
         visited[currentIndex] = false;
     }
 
-    // Recursive helper for Hamiltonian Path. Params: current, visited, path, found flag.
-    void HAMILTONIAN_PATH_RECURSIVE(NodeGrafVer<elem>* current, std::vector<bool>& visited, std::list<elem>& path, bool& found) {
-        if (found) return; // Stop if already found one
-
-        int currentIndex = getVertexIndex(current->getData());
-        path.push_back(current->getData());
-        visited[currentIndex] = true;
-
-        if (path.size() == numVert) {
-            found = true; // Found a Hamiltonian path
-            return;
-        }
-
-        NodeGrafArc<elem>* arc = current->getAdjList();
-        while (arc != NULL && !found) {
-             NodeGrafVer<elem>* neighbor = arc->getDestination();
-             int neighborIndex = getVertexIndex(neighbor->getData());
-             if (!visited[neighborIndex]) {
-                 HAMILTONIAN_PATH_RECURSIVE(neighbor, visited, path, found);
-             }
-             arc = arc->getNextArc();
-        }
-
-        // Backtrack if no path found from here or already found one
-        if (!found) {
-            path.pop_back();
-            visited[currentIndex] = false;
+    // Fills neighbors[index] with the indices of the vertex's neighbors, in adjacency list order (the input of HamiltonSearch).
+    void NEIGHBOR_INDICES(std::vector< std::vector<int> >& neighbors) const {
+        neighbors.assign(numVert, std::vector<int>());
+        for (int v = 0; v < numVert; ++v) {
+            for (NodeGrafArc<elem>* arc = mapNodes[v]->getAdjList(); arc != NULL; arc = arc->getNextArc()) {
+                neighbors[v].push_back(getVertexIndex(arc->getDestination()->getData()));
+            }
         }
     }
 
-    // Recursive helper for Min Cost Hamiltonian Path. Params: current, visited, path, currentCost, bestPath, minCost.
-    void MIN_COST_HAMILTONIAN_RECURSIVE(NodeGrafVer<elem>* current, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& minCost) {
+    // Recursive helper for Min Cost Hamiltonian Path (backtracking, tried before the Held-Karp table). Params: current, visited, path, currentCost, bestPath, minCost,
+    // cheapestIn (cheapest edge into each vertex), remainingBound (their sum over the vertices not on the path yet, current included)
+    // and budget (calls left, -1: no limit; at 0 the search unwinds and the caller builds the table).
+    void MIN_COST_HAMILTONIAN_RECURSIVE(NodeGrafVer<elem>* current, std::vector<bool>& visited, std::list<elem>& currentPath, float currentCost, std::list<elem>& bestPath, float& minCost,
+                                        const std::vector<float>& cheapestIn, float remainingBound, long& budget) {
+        if (budget == 0) return;
+        if (budget > 0) --budget;
         int currentIndex = getVertexIndex(current->getData());
+        remainingBound -= cheapestIn[currentIndex];
         currentPath.push_back(current->getData());
         visited[currentIndex] = true;
 
-        // Pruning: If current cost exceeds best found, stop
-        if (currentCost >= minCost) {
+        // Pruning: if every vertex left entered by its cheapest edge cannot beat the best found, stop. The cost so far
+        // alone is no bound: negative edges can still lower it
+        if (minCost != std::numeric_limits<float>::max() && currentCost + remainingBound >= minCost) {
             currentPath.pop_back();
             visited[currentIndex] = false;
             return;
@@ -252,7 +287,7 @@ private:
                 NodeGrafVer<elem>* neighbor = arc->getDestination();
                 int neighborIndex = getVertexIndex(neighbor->getData());
                 if (!visited[neighborIndex]) {
-                     MIN_COST_HAMILTONIAN_RECURSIVE(neighbor, visited, currentPath, currentCost + arc->getWeight(), bestPath, minCost);
+                     MIN_COST_HAMILTONIAN_RECURSIVE(neighbor, visited, currentPath, currentCost + arc->getWeight(), bestPath, minCost, cheapestIn, remainingBound, budget);
                 }
                 arc = arc->getNextArc();
             }
@@ -263,16 +298,58 @@ private:
         visited[currentIndex] = false;
     }
 
-    // Updates the internal mapGraph vector based on the current vertex list.
-    void UPDATE_MAP() {
-        mapGraph.clear();
-        NodeGrafVer<elem>* current = prim;
-        while (current != NULL) {
-            mapGraph.push_back(current->getData());
-            current = current->getNextVertex();
+    // Fills cheapestIn[index] with the lightest edge reaching each vertex (self-loops excluded, 0 if it has none). Returns the sum over all vertices.
+    float CHEAPEST_EDGE_BOUNDS(std::vector<float>& cheapestIn) const {
+        cheapestIn.assign(numVert, 0.0f);
+        std::vector<bool> seen(numVert, false);
+        for (int v = 0; v < numVert; ++v) {
+            for (NodeGrafArc<elem>* arc = mapNodes[v]->getAdjList(); arc != NULL; arc = arc->getNextArc()) {
+                int u = getVertexIndex(arc->getDestination()->getData());
+                if (u == v) continue;
+                if (!seen[u] || arc->getWeight() < cheapestIn[u]) {
+                    cheapestIn[u] = arc->getWeight();
+                    seen[u] = true;
+                }
+            }
         }
+        float sum = 0.0f;
+        for (int v = 0; v < numVert; ++v) sum += cheapestIn[v];
+        return sum;
     }
 
+    // Min cost Hamiltonian path from 'startIndex' with the Held-Karp table. Rebuilt forward taking, at each step, the first edge in
+    // adjacency list order that keeps the optimal cost, the path the backtracking search would return. Requires numVert <= HeldKarp::MAX_VERTICES.
+    std::list<elem> HELD_KARP_PATH(int startIndex) const {
+        std::list<elem> path;
+        int n = numVert;
+        std::vector<float> weights((size_t)n * n, HeldKarp::noArc());
+        for (int v = 0; v < n; ++v) {
+            for (NodeGrafArc<elem>* arc = mapNodes[v]->getAdjList(); arc != NULL; arc = arc->getNextArc()) {
+                weights[(size_t)v * n + getVertexIndex(arc->getDestination()->getData())] = arc->getWeight();
+            }
+        }
+        HeldKarp costs(weights, n, false);
+
+        unsigned int left = costs.allVertices();
+        if (costs.pathCost(startIndex, left) == HeldKarp::noPath()) return path; // No Hamiltonian path
+
+        int current = startIndex;
+        while (true) {
+            path.push_back(mapGraph[current]);
+            float target = costs.pathCost(current, left);
+            left &= ~(1u << current);
+            if (left == 0) break;
+            int next = -1;
+            for (NodeGrafArc<elem>* arc = mapNodes[current]->getAdjList(); arc != NULL && next < 0; arc = arc->getNextArc()) {
+                int u = getVertexIndex(arc->getDestination()->getData());
+                if (!(left & (1u << u))) continue;
+                float tail = costs.pathCost(u, left);
+                if (tail != HeldKarp::noPath() && arc->getWeight() + tail == target) next = u;
+            }
+            current = next;
+        }
+        return path;
+    }
 
 public:
     // --- Public Attributes (as requested, though private is often preferred) ---
@@ -312,14 +389,10 @@ public:
 
     // Adds a vertex with the given data if it doesn't already exist. Maintains sorted order. Returns true if added, false otherwise.
     void addVertex(const elem& data) {
-        NodeGrafVer<elem>* current = prim;
-        NodeGrafVer<elem>* previous = NULL;
-
-        // Find insertion point or check existence
-        while (current != NULL && current->getData() < data) {
-            previous = current;
-            current = current->getNextVertex();
-        }
+        // Find insertion point or check existence (the map mirrors the sorted list)
+        int position = MAP_POSITION(data);
+        NodeGrafVer<elem>* current = (static_cast<size_t>(position) < mapNodes.size()) ? mapNodes[position] : NULL;
+        NodeGrafVer<elem>* previous = (position > 0) ? mapNodes[position - 1] : NULL;
 
         // Check if vertex already exists
         if (current != NULL && current->getData() == data) {
@@ -336,14 +409,15 @@ public:
             previous->setNextVertex(newNode);
         }
         numVert++;
-        UPDATE_MAP();
+        mapGraph.insert(mapGraph.begin() + position, data); // Keep map and node index aligned with the list
+        mapNodes.insert(mapNodes.begin() + position, newNode);
     }
 
     // Adds an undirected edge between vertex vA and vB with weight w. Returns true if successful, false otherwise.
     void addEdge(const elem& vA, const elem& vB, float w) {
          // Ensure vertices exist before proceeding
-        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(prim, vA);
-        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(prim, vB);
+        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(vA);
+        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(vB);
 
         if (!nodeA || !nodeB) {
             // Optionally throw an exception or just return
@@ -352,7 +426,7 @@ public:
         }
 
         // Check if edge already exists (A->B) - sufficient for undirected check if addEdge enforces symmetry
-        if (FIND_EDGE(nodeA->getAdjList(), vB)) {
+        if (FIND_EDGE(nodeA, vB)) {
             return; // Edge already exists
         }
 
@@ -379,27 +453,24 @@ public:
         }
     }
 
-    // Removes the vertex with the given data and all incident edges.
+    // Removes the vertex with the given data and all incident edges. Each edge costs a binary search and an O(1) unlink in the neighbor's list;
+    // erasing it from the neighbor's arc index shifts that vector's tail (up to the neighbor's degree in pointers, one memmove), and the map
+    // vectors shift once (O(V), also a memmove).
     void removeVertex(const elem& data) {
-        NodeGrafVer<elem>* prevVertex = NULL;
-        NodeGrafVer<elem>* toDelete = prim;
-
         // Find the vertex and its predecessor
-        while(toDelete != NULL && toDelete->getData() != data) {
-            prevVertex = toDelete;
-            toDelete = toDelete->getNextVertex();
-        }
+        int position = getVertexIndex(data);
+        if (position == -1) return; // Vertex not found
 
-        if (!toDelete) return; // Vertex not found
+        NodeGrafVer<elem>* toDelete = mapNodes[position];
+        NodeGrafVer<elem>* prevVertex = (position > 0) ? mapNodes[position - 1] : NULL;
 
         // --- Step 1: Remove all edges pointing TO the vertex to be deleted ---
-        NodeGrafVer<elem>* currentVert = prim;
-        while (currentVert != NULL) {
-            if (currentVert != toDelete) { // Don't try to remove edges from the node itself yet
-                 REMOVE_DIRECTED_EDGE(currentVert, data);
+        // Edges are stored in both directions, so only its neighbors hold one: O(degree) instead of a pass over every vertex
+        for (NodeGrafArc<elem>* arc = toDelete->getAdjList(); arc != NULL; arc = arc->getNextArc()) {
+            if (arc->getDestination() != toDelete) { // Loops are removed with the vertex's own list below
+                 REMOVE_DIRECTED_EDGE(arc->getDestination(), data);
                  // Note: REMOVE_DIRECTED_EDGE does not decrement numEdges, handled later
             }
-            currentVert = currentVert->getNextVertex();
         }
 
         // --- Step 2: Remove all edges STARTING FROM the vertex to be deleted ---
@@ -419,6 +490,7 @@ public:
             currentArc = nextArc;
         }
         toDelete->setAdjList(NULL); // Clear the adjacency list pointer
+        toDelete->getArcIndex().clear();
 
         // --- Step 3: Remove the vertex node itself from the main list ---
         if (prevVertex == NULL) { // Deleting the first vertex
@@ -428,14 +500,15 @@ public:
         }
         delete toDelete;
         numVert--;
-        UPDATE_MAP();
+        mapGraph.erase(mapGraph.begin() + position);
+        mapNodes.erase(mapNodes.begin() + position);
     }
 
 
     // Removes the undirected edge between vA and vB.
     void removeEdge(const elem& vA, const elem& vB) {
-        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(prim, vA);
-        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(prim, vB);
+        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(vA);
+        NodeGrafVer<elem>* nodeB = FIND_VERTEX_NODE(vB);
 
         if (!nodeA || !nodeB) return; // Vertices not found
 
@@ -464,16 +537,16 @@ public:
 
     // Checks if a directed edge exists from vA to vB. Returns true if it exists, false otherwise.
     bool edgeExists(const elem& vA, const elem& vB) const {
-         NodeGrafVer<elem>* nodeA = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, vA); // C++98 const_cast needed for private find
+         NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(vA);
          if (!nodeA) return false;
-         return const_cast<GraphND<elem>*>(this)->FIND_EDGE(nodeA->getAdjList(), vB) != NULL;
+         return FIND_EDGE(nodeA, vB) != NULL;
     }
 
     // Gets the weight of the directed edge from vA to vB. Returns weight if exists, -1.0f otherwise.
     float getEdgeWeight(const elem& vA, const elem& vB) const {
-        NodeGrafVer<elem>* nodeA = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, vA);
+        NodeGrafVer<elem>* nodeA = FIND_VERTEX_NODE(vA);
          if (!nodeA) return -1.0f;
-         NodeGrafArc<elem>* arc = const_cast<GraphND<elem>*>(this)->FIND_EDGE(nodeA->getAdjList(), vB);
+         NodeGrafArc<elem>* arc = FIND_EDGE(nodeA, vB);
         return (arc != NULL) ? arc->getWeight() : -1.0f;
     }
 
@@ -503,7 +576,7 @@ public:
     // Returns a list of the data of all vertices adjacent to the given vertex. Returns empty list if vertex not found or no neighbors.
     std::list<elem> getNeighbors(const elem& vertexData) const {
         std::list<elem> neighbors;
-        NodeGrafVer<elem>* node = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, vertexData);
+        NodeGrafVer<elem>* node = FIND_VERTEX_NODE(vertexData);
         if (node) {
             NodeGrafArc<elem>* arc = node->getAdjList();
             while (arc != NULL) {
@@ -539,6 +612,7 @@ public:
         numVert = 0;
         numEdges = 0;
         mapGraph.clear();
+        mapNodes.clear();
     }
 
     // Checks if the graph has the number of edges required for a complete graph. Returns true if counts match, false otherwise. Note: Doesn't verify structure.
@@ -562,7 +636,7 @@ public:
         // Be careful with self-loops: they add 2 to the degree usually,
         // but getNeighbors currently only lists the neighbor once.
         // A more accurate degree count might iterate the adj list and add 2 for a loop.
-        NodeGrafVer<elem>* node = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, vertexData);
+        NodeGrafVer<elem>* node = FIND_VERTEX_NODE(vertexData);
         int degree = 0;
         if (node) {
             NodeGrafArc<elem>* arc = node->getAdjList();
@@ -665,8 +739,7 @@ public:
          // Set edge count explicitly after copying structure
          this->numEdges = other.numEdges;
 
-         // Update map after all additions (already done by addVertex)
-         // UPDATE_MAP(); // Map updated progressively by addVertex
+         // Map and node index were updated progressively by addVertex
     }
 
 
@@ -694,7 +767,7 @@ public:
         std::queue<NodeGrafVer<elem>*> q;
         std::vector<bool> visited(numVert, false);
 
-        NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
+        NodeGrafVer<elem>* startNode = FIND_VERTEX_NODE(startVertex);
         if (!startNode) return path; // Start vertex not found
 
         int startIndex = getVertexIndex(startVertex);
@@ -729,7 +802,7 @@ public:
     std::list<elem> dfs(const elem& startVertex) const {
         std::list<elem> path;
         std::vector<bool> visited(numVert, false);
-        NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
+        NodeGrafVer<elem>* startNode = FIND_VERTEX_NODE(startVertex);
 
         if (startNode) {
              // Need const_cast because private helpers aren't const
@@ -739,57 +812,63 @@ public:
     }
 
 
-    // Computes shortest paths from 'startVertex' using Dijkstra's algorithm. Returns vector of distances (indexed by mapGraph). Uses numeric_limits max for infinity.
+    // Computes shortest paths from 'startVertex' using Dijkstra's algorithm (binary heap, or the O(V^2) scan on nearly complete graphs). Returns vector of distances (indexed by mapGraph). Uses numeric_limits max for infinity.
     std::vector<float> dijkstra(const elem& startVertex) const {
-        const float INF = std::numeric_limits<float>::max();
-        std::vector<float> dist(numVert, INF);
-        // C++98 doesn't have std::priority_queue easily usable with custom comparators or pairs without more boilerplate.
-        // Simulate using a vector and finding min distance vertex each time.
-        std::vector<bool> visited(numVert, false);
-
-        int startIndex = getVertexIndex(startVertex);
-        if (startIndex == -1) {
-             // Return vector of Infs or throw error if start node not found
-             return dist;
-        }
-
-        dist[startIndex] = 0.0f;
+        std::vector<float> dist;
+        std::vector<int> pred;
+        DIJKSTRA_RUN(getVertexIndex(startVertex), std::vector<bool>(), 0, dist, pred);
+        return dist;
+    }
 
-        for (int count = 0; count < numVert; ++count) {
-            // Find vertex with minimum distance among unvisited vertices
-            float minDist = INF;
-            int u = -1; // index of min dist vertex
+    // Same as dijkstra(startVertex), also filling 'pred' with the index of the previous vertex on a shortest path (-1 for the start and unreachable vertices).
+    std::vector<float> dijkstra(const elem& startVertex, std::vector<int>& pred) const {
+        std::vector<float> dist;
+        DIJKSTRA_RUN(getVertexIndex(startVertex), std::vector<bool>(), 0, dist, pred);
+        return dist;
+    }
 
-            for (int v_idx = 0; v_idx < numVert; ++v_idx) {
-                if (!visited[v_idx] && dist[v_idx] <= minDist) {
-                    minDist = dist[v_idx];
-                    u = v_idx;
-                }
+    // Like dijkstra(startVertex, pred), but stops as soon as every vertex in 'targets' is settled. Only the targets' distances (and the paths to them) are guaranteed final.
+    std::vector<float> dijkstra(const elem& startVertex, const std::list<elem>& targets, std::vector<int>& pred) const {
+        std::vector<float> dist;
+        std::vector<bool> isTarget(numVert, false);
+        int targetCount = 0;
+        for (typename std::list<elem>::const_iterator it = targets.begin(); it != targets.end(); ++it) {
+            int index = getVertexIndex(*it);
+            if (index != -1 && !isTarget[index]) {
+                isTarget[index] = true;
+                targetCount++;
             }
+        }
+        if (targetCount == 0) { // Nothing to wait for: no search needed
+            dist.assign(numVert, std::numeric_limits<float>::max());
+            pred.assign(numVert, -1);
+            int start = getVertexIndex(startVertex);
+            if (start != -1) dist[start] = 0.0f;
+            return dist;
+        }
+        DIJKSTRA_RUN(getVertexIndex(startVertex), isTarget, targetCount, dist, pred);
+        return dist;
+    }
 
-            if (u == -1) break; // No reachable unvisited vertices left
-
-            visited[u] = true;
-            elem u_val = getVertexFromIndex(u); // Get vertex value from index
-            NodeGrafVer<elem>* u_node = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, u_val);
-
-            if (!u_node) continue; // Should exist if index is valid
-
-            // Update distances of adjacent vertices
-            NodeGrafArc<elem>* arc = u_node->getAdjList();
-            while(arc != NULL) {
-                NodeGrafVer<elem>* v_node = arc->getDestination();
-                 if (v_node) {
-                     int v_idx = getVertexIndex(v_node->getData());
-                     float weight = arc->getWeight();
-                     if (v_idx != -1 && !visited[v_idx] && dist[u] != INF && dist[u] + weight < dist[v_idx]) {
-                         dist[v_idx] = dist[u] + weight;
-                     }
-                 }
-                arc = arc->getNextArc();
+    // Finds the minimum weight path between 'startVertex' and 'endVertex', stopping once 'endVertex' is settled. Returns list of vertices in the path (empty if unreachable).
+    std::list<elem> shortestPathByWeight(const elem& startVertex, const elem& endVertex) const {
+        std::list<elem> path;
+        int start = getVertexIndex(startVertex);
+        int end = getVertexIndex(endVertex);
+        if (start == -1 || end == -1) return path;
+
+        std::vector<bool> isTarget(numVert, false);
+        isTarget[end] = true;
+        std::vector<float> dist;
+        std::vector<int> pred;
+        DIJKSTRA_RUN(start, isTarget, 1, dist, pred);
+
+        if (dist[end] != std::numeric_limits<float>::max()) {
+            for (int current = end; current != -1; current = pred[current]) {
+                path.push_front(mapGraph[current]);
             }
         }
-        return dist;
+        return path;
     }
 
 
@@ -798,7 +877,7 @@ public:
         std::list<elem> shortestPath;
         std::list<elem> currentPath;
         std::vector<bool> visited(numVert, false);
-        NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
+        NodeGrafVer<elem>* startNode = FIND_VERTEX_NODE(startVertex);
 
         if (startNode) {
             const_cast<GraphND<elem>*>(this)->SHORTEST_PATH_RECURSIVE(startNode, endVertex, visited, currentPath, shortestPath);
@@ -811,7 +890,7 @@ public:
          std::list<elem> longestPath;
          std::list<elem> currentPath;
          std::vector<bool> visited(numVert, false);
-         NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
+         NodeGrafVer<elem>* startNode = FIND_VERTEX_NODE(startVertex);
 
          if (startNode) {
              const_cast<GraphND<elem>*>(this)->LONGEST_PATH_RECURSIVE(startNode, endVertex, visited, currentPath, longestPath);
@@ -819,31 +898,45 @@ public:
          return longestPath;
     }
 
-    // Finds *a* Hamiltonian path starting from 'startVertex' (visits every vertex exactly once). Returns the path or empty list if none found.
+    // Finds *a* Hamiltonian path starting from 'startVertex' (visits every vertex exactly once), the first one in adjacency list order. Returns the path or empty list if none found.
     std::list<elem> findHamiltonianPath(const elem& startVertex) const {
         std::list<elem> path;
-        std::vector<bool> visited(numVert, false);
-        bool found = false;
-        NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
-
-        if (startNode) {
-            const_cast<GraphND<elem>*>(this)->HAMILTONIAN_PATH_RECURSIVE(startNode, visited, path, found);
-        }
+        int startIndex = getVertexIndex(startVertex);
+        if (startIndex < 0) return path;
+        std::vector< std::vector<int> > neighbors;
+        NEIGHBOR_INDICES(neighbors);
+        HamiltonSearch search(neighbors);
+
+        std::vector<int> ids;
+        search.findFrom(startIndex, ids);
+        for (size_t i = 0; i < ids.size(); ++i) path.push_back(mapGraph[ids[i]]);
+        return path; // Empty if none found
+    }
 
-        return found ? path : std::list<elem>(); // Return path if found, else empty list
+    // Checks if the graph has a Hamiltonian path from any vertex, without building it (Warnsdorff's rule, several threads with -DGRAPH_PARALLEL). Returns bool.
+    bool hasHamiltonianPath() const {
+        std::vector< std::vector<int> > neighbors;
+        NEIGHBOR_INDICES(neighbors);
+        HamiltonSearch search(neighbors);
+        return search.exists();
     }
 
      // Finds the Hamiltonian path with the minimum total weight starting from 'startVertex'. Returns the path or empty list if none found.
+     // Backtracking with branch and bound; up to HeldKarp::MAX_VERTICES vertices, a search that runs past HeldKarp::searchBudget()
+     // calls is dropped for the Held-Karp dynamic program (O(2^V * V^2)), which returns the same path.
      std::list<elem> findMinCostHamiltonianPath(const elem& startVertex) const {
         std::list<elem> bestPath;
         std::list<elem> currentPath;
+        int startIndex = getVertexIndex(startVertex);
+        if (startIndex < 0) return bestPath;
+
         std::vector<bool> visited(numVert, false);
         float minCost = std::numeric_limits<float>::max();
-        NodeGrafVer<elem>* startNode = const_cast<GraphND<elem>*>(this)->FIND_VERTEX_NODE(prim, startVertex);
-
-        if (startNode) {
-            const_cast<GraphND<elem>*>(this)->MIN_COST_HAMILTONIAN_RECURSIVE(startNode, visited, currentPath, 0.0f, bestPath, minCost);
-        }
+        std::vector<float> cheapestIn;
+        float bound = CHEAPEST_EDGE_BOUNDS(cheapestIn);
+        long budget = HeldKarp::searchBudget(numVert);
+        const_cast<GraphND<elem>*>(this)->MIN_COST_HAMILTONIAN_RECURSIVE(mapNodes[startIndex], visited, currentPath, 0.0f, bestPath, minCost, cheapestIn, bound, budget);
+        if (budget == 0) return HELD_KARP_PATH(startIndex);
 
         return (minCost == std::numeric_limits<float>::max()) ? std::list<elem>() : bestPath;
     }
@@ -900,18 +993,38 @@ public:
     }
 
 
+    // Copies the graph into an immutable CSR snapshot (indices match mapGraph) for repeated traversals.
+    void freeze(GraphNDCSR<elem>& target) const {
+        target.vertices = mapGraph;
+        target.offsets.assign(1, 0);
+        target.offsets.reserve(mapNodes.size() + 1);
+        target.neighbors.clear();
+        target.weights.clear();
+
+        for (size_t i = 0; i < mapNodes.size(); ++i) {
+            NodeGrafArc<elem>* arc = mapNodes[i]->getAdjList();
+            while (arc != NULL) {
+                if (arc->getDestination()) {
+                    target.neighbors.push_back(getVertexIndex(arc->getDestination()->getData()));
+                    target.weights.push_back(arc->getWeight());
+                }
+                arc = arc->getNextArc();
+            }
+            target.offsets.push_back(static_cast<int>(target.neighbors.size()));
+        }
+        target.numEdges = numEdges;
+    }
+
     // Returns the internal map vector.
     const std::vector<elem>& getMap() const {
         return mapGraph;
     }
 
-    // Gets the index corresponding to a vertex value in the map. Returns -1 if not found.
+    // Gets the index corresponding to a vertex value in the map (O(log V) binary search). Returns -1 if not found.
     int getVertexIndex(const elem& vertexData) const {
-        // C++98 doesn't have std::find easily applicable here without iterators
-        for (size_t i = 0; i < mapGraph.size(); ++i) {
-            if (mapGraph[i] == vertexData) {
-                return static_cast<int>(i);
-            }
+        int position = MAP_POSITION(vertexData);
+        if (static_cast<size_t>(position) < mapGraph.size() && mapGraph[position] == vertexData) {
+            return position;
         }
         return -1; // Not found
     }
@@ -0,0 +1,233 @@
+#ifndef GRAPHNDCSR_H_
+#define GRAPHNDCSR_H_
+
+#include <vector>
+#include <list>
+#include <queue>
+#include <utility> // For std::pair
+#include <functional> // For std::greater
+#include <limits> // Required for numeric_limits
+#include <algorithm> // For std::lower_bound
+#include <stdexcept> // For out_of_range
+
+template <typename elem> class GraphND;
+
+// Frozen copy of a GraphND in compressed sparse row form, filled by GraphND::freeze().
+// Vertex i is mapGraph[i] of the graph it was frozen from. Its neighbors are
+// neighbors[offsets[i] .. offsets[i + 1]), with the matching weights, in adjacency
+// list order, so every undirected edge appears once per endpoint (self-loops once).
+// Traversals visit vertices in the same order as the GraphND versions.
+template <typename elem>
+class GraphNDCSR {
+
+private:
+    std::vector<elem> vertices;   // Sorted vertex values, vertices[i] has id i
+    std::vector<int> offsets;     // Neighbors of vertex i are [offsets[i], offsets[i + 1])
+    std::vector<int> neighbors;   // Neighbor id of each directed half of an edge
+    std::vector<float> weights;   // Weight of each directed half of an edge
+    int numEdges;                 // Number of undirected edges, as in GraphND
+
+    friend class GraphND<elem>; // freeze() fills the arrays directly
+
+    // --- Private Helper Methods (UPPER_SNAKE_CASE) ---
+
+    // Throws out_of_range if 'index' is not a vertex index.
+    void CHECK_INDEX(int index) const {
+        if (index < 0 || static_cast<size_t>(index) >= vertices.size()) {
+            throw std::out_of_range("Index out of range in GraphNDCSR");
+        }
+    }
+
+    // Iterative DFS from 'start' with an explicit stack. Marks 'visited' and appends ids to 'path' in discovery order.
+    void DFS_ITERATIVE(int start, std::vector<bool>& visited, std::vector<int>& path) const {
+        std::vector< std::pair<int, int> > stack; // (vertex, next neighbor position)
+        visited[start] = true;
+        path.push_back(start);
+        stack.push_back(std::make_pair(start, offsets[start]));
+
+        while (!stack.empty()) {
+            int current = stack.back().first;
+            int position = stack.back().second;
+            if (position == offsets[current + 1]) {
+                stack.pop_back(); // All neighbors seen
+                continue;
+            }
+            stack.back().second++;
+            int next = neighbors[position];
+            if (!visited[next]) {
+                visited[next] = true;
+                path.push_back(next);
+                stack.push_back(std::make_pair(next, offsets[next]));
+            }
+        }
+    }
+
+public:
+    // --- Public Methods (lowerCamelCase) ---
+
+    // Default constructor: Creates an empty snapshot.
+    GraphNDCSR() : offsets(1, 0), numEdges(0) {}
+
+    // Checks if the snapshot is empty (contains no vertices). Returns true if empty, false otherwise.
+    bool isEmpty() const {
+        return vertices.empty();
+    }
+
+    // Returns the order (number of vertices) of the graph.
+    int order() const {
+        return static_cast<int>(vertices.size());
+    }
+
+    // Returns the number of vertices in the graph.
+    int getNumVertices() const {
+        return static_cast<int>(vertices.size());
+    }
+
+    // Returns the number of undirected edges in the graph.
+    int getNumEdges() const {
+        return numEdges;
+    }
+
+    // Returns the internal map vector (sorted vertex values indexed by id, same as GraphND::getMap() when frozen).
+    const std::vector<elem>& getMap() const {
+        return vertices;
+    }
+
+    // Gets the index corresponding to a vertex value (O(log V) binary search). Returns -1 if not found.
+    int getVertexIndex(const elem& vertexData) const {
+        int position = static_cast<int>(std::lower_bound(vertices.begin(), vertices.end(), vertexData) - vertices.begin());
+        if (static_cast<size_t>(position) < vertices.size() && vertices[position] == vertexData) {
+            return position;
+        }
+        return -1; // Not found
+    }
+
+    // Gets the vertex value corresponding to a given index. Throws out_of_range if index is invalid.
+    elem getVertexFromIndex(int index) const {
+        CHECK_INDEX(index);
+        return vertices[index];
+    }
+
+    // Returns the degree (number of adjacency entries) of the vertex with the given index. Throws out_of_range if index is invalid.
+    int vertexDegree(int index) const {
+        CHECK_INDEX(index);
+        return offsets[index + 1] - offsets[index];
+    }
+
+    // Returns a pointer to the first neighbor index of the given vertex index (no list copy, unlike getNeighbors).
+    const int* neighborsBegin(int index) const {
+        CHECK_INDEX(index);
+        return neighbors.empty() ? NULL : &neighbors[0] + offsets[index];
+    }
+
+    // Returns a pointer past the last neighbor index of the given vertex index.
+    const int* neighborsEnd(int index) const {
+        CHECK_INDEX(index);
+        return neighbors.empty() ? NULL : &neighbors[0] + offsets[index + 1];
+    }
+
+    // Returns a pointer to the weight of the first neighbor of the given vertex index, parallel to neighborsBegin.
+    const float* weightsBegin(int index) const {
+        CHECK_INDEX(index);
+        return weights.empty() ? NULL : &weights[0] + offsets[index];
+    }
+
+    // Performs Breadth-First Search starting from 'startVertex'. Returns list of visited vertices in BFS order.
+    std::list<elem> bfs(const elem& startVertex) const {
+        std::list<elem> path;
+        int start = getVertexIndex(startVertex);
+        if (start == -1) return path; // Start vertex not found
+
+        std::vector<int> q; // Each vertex is queued once, so a vector with a read position is enough
+        std::vector<bool> visited(vertices.size(), false);
+        q.reserve(vertices.size());
+        q.push_back(start);
+        visited[start] = true;
+
+        for (size_t head = 0; head < q.size(); ++head) {
+            int current = q[head];
+            path.push_back(vertices[current]);
+            for (int position = offsets[current]; position < offsets[current + 1]; ++position) {
+                int next = neighbors[position];
+                if (!visited[next]) {
+                    visited[next] = true;
+                    q.push_back(next);
+                }
+            }
+        }
+        return path;
+    }
+
+    // Performs Depth-First Search starting from 'startVertex' (iterative, no recursion depth limit). Returns list of visited vertices in DFS order.
+    std::list<elem> dfs(const elem& startVertex) const {
+        std::list<elem> path;
+        int start = getVertexIndex(startVertex);
+        if (start == -1) return path;
+
+        std::vector<bool> visited(vertices.size(), false);
+        std::vector<int> ids;
+        DFS_ITERATIVE(start, visited, ids);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            path.push_back(vertices[ids[i]]);
+        }
+        return path;
+    }
+
+    // Computes shortest paths from 'startVertex' using Dijkstra's algorithm with a binary heap (O((V+E) log V)). Returns vector of distances (indexed by map). Uses numeric_limits max for infinity.
+    std::vector<float> dijkstra(const elem& startVertex) const {
+        const float INF = std::numeric_limits<float>::max();
+        std::vector<float> dist(vertices.size(), INF);
+        int start = getVertexIndex(startVertex);
+        if (start == -1) return dist;
+
+        // Min-heap of (distance, index); outdated entries are skipped when popped (lazy deletion)
+        std::priority_queue< std::pair<float, int>, std::vector< std::pair<float, int> >, std::greater< std::pair<float, int> > > heap;
+        std::vector<bool> visited(vertices.size(), false);
+        dist[start] = 0.0f;
+        heap.push(std::make_pair(0.0f, start));
+
+        while (!heap.empty()) {
+            int u = heap.top().second;
+            heap.pop();
+            if (visited[u]) continue;
+            visited[u] = true;
+
+            for (int position = offsets[u]; position < offsets[u + 1]; ++position) {
+                int v = neighbors[position];
+                if (!visited[v] && dist[u] + weights[position] < dist[v]) {
+                    dist[v] = dist[u] + weights[position];
+                    heap.push(std::make_pair(dist[v], v));
+                }
+            }
+        }
+        return dist;
+    }
+
+    // Labels connected components: fills component[index] with a component number (in order of their smallest vertex). Returns the number of components.
+    int connectedComponents(std::vector<int>& component) const {
+        int n = static_cast<int>(vertices.size());
+        component.assign(n, -1);
+        std::vector<bool> visited(n, false);
+        std::vector<int> members;
+        int count = 0;
+        for (int v = 0; v < n; ++v) {
+            if (visited[v]) continue;
+            members.clear();
+            DFS_ITERATIVE(v, visited, members);
+            for (size_t i = 0; i < members.size(); ++i) component[members[i]] = count;
+            count++;
+        }
+        return count;
+    }
+
+    // Checks if the graph is connected. Returns true if connected, false otherwise.
+    bool isConnected() const {
+        if (vertices.size() <= 1) return true; // Empty or single vertex graph is connected
+        std::vector<bool> visited(vertices.size(), false);
+        std::vector<int> reached;
+        DFS_ITERATIVE(0, visited, reached);
+        return reached.size() == vertices.size();
+    }
+};
+
+#endif // GRAPHNDCSR_H_
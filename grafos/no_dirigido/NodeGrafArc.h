@@ -13,17 +13,18 @@ private:
     float weight;
     NodeGrafVer<elem>* destination; // Pointer to the destination vertex node
     NodeGrafArc<elem>* nextArc;     // Pointer to the next arc in the same adjacency list
+    NodeGrafArc<elem>* prevArc;     // Pointer to the previous arc in the same adjacency list (NULL at the head)
 
 public:
     // Default constructor.
-    NodeGrafArc() : weight(0.0f), destination(NULL), nextArc(NULL) {}
+    NodeGrafArc() : weight(0.0f), destination(NULL), nextArc(NULL), prevArc(NULL) {}
 
     // Constructor with weight.
-    NodeGrafArc(float w) : weight(w), destination(NULL), nextArc(NULL) {}
+    NodeGrafArc(float w) : weight(w), destination(NULL), nextArc(NULL), prevArc(NULL) {}
 
     // Constructor with all parameters.
     NodeGrafArc(float w, NodeGrafVer<elem>* dest, NodeGrafArc<elem>* next)
-        : weight(w), destination(dest), nextArc(next) {}
+        : weight(w), destination(dest), nextArc(next), prevArc(NULL) {}
 
     // Gets the weight of the arc.
     float getWeight() const { return weight; }
@@ -31,6 +32,8 @@ public:
     NodeGrafVer<elem>* getDestination() const { return destination; }
     // Gets the next arc in the adjacency list.
     NodeGrafArc<elem>* getNextArc() const { return nextArc; }
+    // Gets the previous arc in the adjacency list (NULL for the first one).
+    NodeGrafArc<elem>* getPrevArc() const { return prevArc; }
 
     // Sets the weight of the arc.
     void setWeight(float w) { weight = w; }
@@ -38,6 +41,8 @@ public:
     void setDestination(NodeGrafVer<elem>* dest) { destination = dest; }
     // Sets the next arc in the adjacency list.
     void setNextArc(NodeGrafArc<elem>* next) { nextArc = next; }
+    // Sets the previous arc in the adjacency list.
+    void setPrevArc(NodeGrafArc<elem>* prev) { prevArc = prev; }
 };
 
 #endif // NODE_GRAF_ARC_H_
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "NodeGrafArc.h" // Include arc definition
 #include <cstddef>      // For NULL
 #include <limits>
+#include <vector>
 
 // Represents a node in the main vertex list.
 template <typename elem>
@@ -12,6 +13,7 @@ private:
     elem data;
     NodeGrafVer<elem>* nextVertex; // Pointer to the next vertex in the main list
     NodeGrafArc<elem>* adjList;    // Pointer to the head of the adjacency list for this vertex
+    std::vector<NodeGrafArc<elem>*> arcIndex; // The same arcs sorted by destination value, kept in sync by GraphND
 
 public:
     // Default constructor.
@@ -39,6 +41,10 @@ public:
     NodeGrafVer<elem>* getNextVertex() const { return nextVertex; }
     // Gets the head of the adjacency list.
     NodeGrafArc<elem>* getAdjList() const { return adjList; }
+    // Gets the arcs sorted by destination value, for binary search.
+    const std::vector<NodeGrafArc<elem>*>& getArcIndex() const { return arcIndex; }
+    // Gets the sorted arc index for modification (GraphND keeps it in sync with the adjacency list).
+    std::vector<NodeGrafArc<elem>*>& getArcIndex() { return arcIndex; }
 
     // Sets the data for the vertex.
     void setData(elem d) { data = d; }